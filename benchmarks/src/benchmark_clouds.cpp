@@ -0,0 +1,195 @@
+#include "benchmark_clouds.hpp"
+
+// Processing
+#include <lidar_processing_lib/filtering/point_cloud_ingest.hpp> // ingestPointCloud
+
+// Utilities
+#include <utilities_lib/file_operations.hpp> // loadPointCloudDataFromBinFile
+
+// STL
+#include <algorithm> // std::min, std::max
+#include <array>     // std::array
+#include <cmath>     // std::tan, std::cos, std::sin, M_PI
+#include <cstdlib>   // std::getenv
+#include <random>    // std::mt19937, std::uniform_real_distribution, std::normal_distribution
+#include <stdexcept> // std::runtime_error
+#include <thread>    // std::thread
+
+namespace benchmarks
+{
+namespace
+{
+constexpr std::uint32_t NUMBER_OF_RINGS = 64U;
+constexpr float MIN_ELEVATION_DEG = -24.8F;
+constexpr float MAX_ELEVATION_DEG = 2.0F;
+constexpr float WALL_RANGE_M = 80.0F;
+constexpr float DEG_TO_RAD = static_cast<float>(M_PI / 180.0);
+
+// Box standing in an azimuth sector of one degree
+struct Obstacle final
+{
+    bool present;
+    float range;
+    float height;
+};
+
+std::string cloudName(const std::string &source, const std::uint32_t number_of_points)
+{
+    return source + "_" + std::to_string(number_of_points / 1000U) + "k";
+}
+
+std::unique_ptr<BenchmarkCloud> makeBenchmarkCloud(std::string name,
+                                                   std::vector<data_types_lib::CartesianReturn> points)
+{
+    auto benchmark_cloud = std::make_unique<BenchmarkCloud>();
+    benchmark_cloud->name = std::move(name);
+    benchmark_cloud->points = std::move(points);
+    lidar_processing_lib::filtering::ingestPointCloud(benchmark_cloud->view(), benchmark_cloud->cloud);
+    return benchmark_cloud;
+}
+} // namespace
+
+data_types_lib::PointCloudView BenchmarkCloud::view() const noexcept
+{
+    data_types_lib::PointCloudLayout layout;
+    layout.x_offset = offsetof(data_types_lib::CartesianReturn, x);
+    layout.y_offset = offsetof(data_types_lib::CartesianReturn, y);
+    layout.z_offset = offsetof(data_types_lib::CartesianReturn, z);
+    layout.intensity_offset = offsetof(data_types_lib::CartesianReturn, intensity);
+    layout.point_step = sizeof(data_types_lib::CartesianReturn);
+
+    const auto number_of_points = static_cast<std::uint32_t>(points.size());
+    return data_types_lib::PointCloudView{reinterpret_cast<const std::uint8_t *>(points.data()), number_of_points, 1U,
+                                          number_of_points * layout.point_step, layout};
+}
+
+std::vector<data_types_lib::CartesianReturn> makeSyntheticPoints(const std::uint32_t number_of_points,
+                                                                 const std::uint32_t seed)
+{
+    std::mt19937 generator{seed};
+    std::uniform_real_distribution<float> unit{0.0F, 1.0F};
+    std::normal_distribution<float> range_noise{0.0F, 0.02F};
+
+    std::array<Obstacle, 360U> obstacles{};
+    for (auto &obstacle : obstacles)
+    {
+        obstacle.present = (unit(generator) < (1.0F / 3.0F));
+        obstacle.range = 4.0F + (36.0F * unit(generator));
+        obstacle.height = 0.5F + (2.0F * unit(generator));
+    }
+
+    // Every column fires all rings, as the lasers of a spinning sensor
+    const std::uint32_t number_of_columns = (number_of_points + NUMBER_OF_RINGS - 1U) / NUMBER_OF_RINGS;
+    std::vector<data_types_lib::CartesianReturn> points;
+    points.reserve(number_of_points);
+    for (std::uint32_t i = 0U; i < number_of_points; ++i)
+    {
+        const std::uint32_t column = i / NUMBER_OF_RINGS;
+        const std::uint32_t ring = i % NUMBER_OF_RINGS;
+
+        const float azimuth =
+            static_cast<float>(-M_PI + ((2.0 * M_PI * column) / number_of_columns)) + (1e-4F * unit(generator));
+        const float elevation =
+            DEG_TO_RAD * (MIN_ELEVATION_DEG + (((MAX_ELEVATION_DEG - MIN_ELEVATION_DEG) * static_cast<float>(ring)) /
+                                               static_cast<float>(NUMBER_OF_RINGS - 1U)));
+        const float slope = std::tan(elevation);
+
+        // Horizontal range at which the beam meets the ground
+        const float ground_range = (slope < 0.0F) ? (SENSOR_HEIGHT_M / -slope) : WALL_RANGE_M;
+
+        const auto sector =
+            std::min(static_cast<std::size_t>((azimuth + M_PI) * (180.0 / M_PI)), obstacles.size() - 1U);
+        const Obstacle &obstacle = obstacles[sector];
+
+        float range = WALL_RANGE_M;
+        float z = WALL_RANGE_M * slope;
+        if (obstacle.present && (ground_range > obstacle.range) &&
+            ((obstacle.range * slope) <= (obstacle.height - SENSOR_HEIGHT_M)))
+        {
+            range = obstacle.range;
+            z = obstacle.range * slope;
+        }
+        else if (ground_range < WALL_RANGE_M)
+        {
+            range = ground_range;
+            z = -SENSOR_HEIGHT_M;
+        }
+
+        range += range_noise(generator);
+        points.push_back({range * std::cos(azimuth), range * std::sin(azimuth), z, unit(generator)});
+    }
+
+    return points;
+}
+
+std::vector<data_types_lib::CartesianReturn> resamplePoints(const std::vector<data_types_lib::CartesianReturn> &points,
+                                                            const std::uint32_t number_of_points)
+{
+    std::vector<data_types_lib::CartesianReturn> resampled_points;
+    resampled_points.reserve(number_of_points);
+    for (std::uint32_t i = 0U; i < number_of_points; ++i)
+    {
+        const std::size_t index = (number_of_points <= points.size())
+                                      ? ((static_cast<std::size_t>(i) * points.size()) / number_of_points)
+                                      : (i % points.size());
+        resampled_points.push_back(points[index]);
+    }
+    return resampled_points;
+}
+
+std::vector<std::unique_ptr<BenchmarkCloud>> makeBenchmarkClouds()
+{
+    std::vector<std::unique_ptr<BenchmarkCloud>> clouds;
+    for (const std::uint32_t number_of_points : CLOUD_SIZES)
+    {
+        clouds.push_back(
+            makeBenchmarkCloud(cloudName("synthetic", number_of_points), makeSyntheticPoints(number_of_points)));
+    }
+
+    const char *kitti_scan_path = std::getenv(KITTI_SCAN_ENVIRONMENT_VARIABLE);
+    if ((kitti_scan_path == nullptr) || (*kitti_scan_path == '\0'))
+    {
+        return clouds;
+    }
+
+    std::vector<data_types_lib::CartesianReturn> kitti_points;
+    utilities_lib::loadPointCloudDataFromBinFile(kitti_scan_path, kitti_points);
+    if (kitti_points.empty())
+    {
+        throw std::runtime_error(std::string{"Could not read the KITTI scan "} + kitti_scan_path);
+    }
+
+    for (const std::uint32_t number_of_points : CLOUD_SIZES)
+    {
+        clouds.push_back(
+            makeBenchmarkCloud(cloudName("kitti", number_of_points), resamplePoints(kitti_points, number_of_points)));
+    }
+    return clouds;
+}
+
+void collectObstacleIndices(const std::vector<data_types_lib::SegmentationLabel> &labels,
+                            std::vector<std::uint32_t> &indices)
+{
+    indices.clear();
+    for (std::size_t i = 0U; i < labels.size(); ++i)
+    {
+        if ((labels[i] == data_types_lib::SegmentationLabel::OBSTACLE) ||
+            (labels[i] == data_types_lib::SegmentationLabel::TRANSITIONAL_OBSTACLE))
+        {
+            indices.push_back(static_cast<std::uint32_t>(i));
+        }
+    }
+}
+
+std::vector<std::uint32_t> benchmarkThreadCounts()
+{
+    const std::uint32_t hardware_threads = std::max(std::thread::hardware_concurrency(), 1U);
+    std::vector<std::uint32_t> thread_counts;
+    for (std::uint32_t thread_count = 1U; thread_count < hardware_threads; thread_count *= 2U)
+    {
+        thread_counts.push_back(thread_count);
+    }
+    thread_counts.push_back(hardware_threads);
+    return thread_counts;
+}
+} // namespace benchmarks
@@ -0,0 +1,67 @@
+#ifndef BENCHMARK_CLOUDS_HPP
+#define BENCHMARK_CLOUDS_HPP
+
+// Data types
+#include <data_types_lib/cartesian_return.hpp>   // CartesianReturn
+#include <data_types_lib/point_cloud_soa.hpp>    // PointCloudSoA
+#include <data_types_lib/point_cloud_view.hpp>   // PointCloudView, PointCloudLayout
+#include <data_types_lib/segmentation_label.hpp> // SegmentationLabel
+
+// STL
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint32_t
+#include <memory>  // std::unique_ptr
+#include <string>  // std::string
+#include <vector>  // std::vector
+
+namespace benchmarks
+{
+// Cloud sizes of the macro-benchmarks, a VLP-32C, an HDL-64E and an OS1-128 scan
+constexpr std::uint32_t CLOUD_SIZES[] = {30'000U, 120'000U, 250'000U};
+
+// Seed of the synthetic scenes, fixed so that every run measures the same clouds
+constexpr std::uint32_t SYNTHETIC_SEED = 42U;
+
+// Height of the synthetic sensor above the ground, as in the node config
+constexpr float SENSOR_HEIGHT_M = 1.73F;
+
+// Path of a recorded KITTI velodyne scan (.bin), adds the recorded clouds to the benchmarks when set
+constexpr const char *KITTI_SCAN_ENVIRONMENT_VARIABLE = "LIDAR_BENCHMARK_KITTI_SCAN";
+
+/// @brief Cloud measured by the benchmarks, the structure-of-arrays cloud is derived from the raw points as the node
+/// ingests its input messages.
+struct BenchmarkCloud final
+{
+    // e.g. "synthetic_120k" or "kitti_120k"
+    std::string name;
+
+    std::vector<data_types_lib::CartesianReturn> points;
+    data_types_lib::PointCloudSoA cloud;
+
+    /// @brief View of the raw points with the layout of the KITTI velodyne scans.
+    data_types_lib::PointCloudView view() const noexcept;
+};
+
+/// @brief Generates a sensor-like scene seen from an HDL-64E at the sensor height: flat ground, boxes of random
+/// heights in a third of the azimuth sectors and a wall closing off the upward beams.
+/// @param number_of_points - Exact number of returns, spread over the 64 rings.
+std::vector<data_types_lib::CartesianReturn> makeSyntheticPoints(std::uint32_t number_of_points,
+                                                                 std::uint32_t seed = SYNTHETIC_SEED);
+
+/// @brief Resamples a recorded scan to the number of points, decimated evenly when smaller and repeated when larger.
+std::vector<data_types_lib::CartesianReturn> resamplePoints(const std::vector<data_types_lib::CartesianReturn> &points,
+                                                            std::uint32_t number_of_points);
+
+/// @brief Synthetic clouds of every size, followed by the recorded clouds when the KITTI scan is set.
+/// Clouds are heap allocated so that their views stay valid while the benchmarks are registered.
+std::vector<std::unique_ptr<BenchmarkCloud>> makeBenchmarkClouds();
+
+/// @brief Collects the indices of the OBSTACLE and TRANSITIONAL_OBSTACLE points, as the segmentation stage of the node.
+void collectObstacleIndices(const std::vector<data_types_lib::SegmentationLabel> &labels,
+                            std::vector<std::uint32_t> &indices);
+
+/// @brief Thread counts from one to the number of hardware threads, doubling.
+std::vector<std::uint32_t> benchmarkThreadCounts();
+} // namespace benchmarks
+
+#endif // BENCHMARK_CLOUDS_HPP
@@ -0,0 +1,114 @@
+#include "benchmark_suites.hpp"
+
+// Processing
+#include <lidar_processing_lib/clustering/cartesian_dbscan.hpp>              // CartesianDBSCAN
+#include <lidar_processing_lib/clustering/cartesian_euclidean_clusterer.hpp> // CartesianEuclideanClusterer
+#include <lidar_processing_lib/clustering/range_image_clusterer.hpp>         // RangeImageClusterer
+#include <lidar_processing_lib/filtering/point_cloud_ingest.hpp>             // selectPoints
+#include <lidar_processing_lib/segmentation/ransac_segmenter.hpp>            // RansacSegmenter
+
+// Benchmark
+#include <benchmark/benchmark.h>
+
+// STL
+#include <memory> // std::make_unique, std::unique_ptr
+#include <string> // std::string
+#include <vector> // std::vector
+
+namespace benchmarks
+{
+namespace
+{
+using lidar_processing_lib::clustering::CartesianDBSCAN;
+using lidar_processing_lib::clustering::CartesianEuclideanClusterer;
+using lidar_processing_lib::clustering::IClusterer;
+using lidar_processing_lib::clustering::RangeImageClusterer;
+using lidar_processing_lib::segmentation::RansacSegmenter;
+
+using ClusteringLabel = data_types_lib::ClusteringLabel;
+using SegmentationLabel = data_types_lib::SegmentationLabel;
+
+// Obstacle points of a cloud as the segmentation stage of the node passes them on, RANSAC is seeded so the points
+// are the same on every run
+struct ObstacleCloud final
+{
+    const BenchmarkCloud *source;
+    data_types_lib::PointCloudSoA cloud;
+};
+
+std::unique_ptr<ObstacleCloud> makeObstacleCloud(const BenchmarkCloud &source)
+{
+    auto obstacle_cloud = std::make_unique<ObstacleCloud>();
+    obstacle_cloud->source = &source;
+
+    RansacSegmenter segmenter{SENSOR_HEIGHT_M, ORTHOGONAL_DISTANCE_THRESHOLD, NUMBER_OF_ITERATIONS};
+    std::vector<SegmentationLabel> segmentation_labels;
+    segmenter.run(source.cloud, segmentation_labels);
+
+    std::vector<std::uint32_t> indices;
+    collectObstacleIndices(segmentation_labels, indices);
+    lidar_processing_lib::filtering::selectPoints(source.cloud, indices.data(), indices.size(),
+                                                  obstacle_cloud->cloud);
+    return obstacle_cloud;
+}
+
+// Obstacle clouds are kept alive until the benchmarks have run
+std::vector<std::unique_ptr<ObstacleCloud>> obstacle_clouds;
+
+void runClusterer(benchmark::State &state, IClusterer &clusterer, const data_types_lib::PointCloudSoA &cloud)
+{
+    std::vector<ClusteringLabel> labels;
+    for (auto _ : state)
+    {
+        clusterer.run(cloud, labels);
+        benchmark::DoNotOptimize(labels.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(cloud.size()));
+    state.counters["obstacle_points"] = static_cast<double>(cloud.size());
+}
+
+void registerClusteringBenchmark(const ObstacleCloud &obstacle_cloud, const std::string &algorithm,
+                                 const std::uint32_t thread_count)
+{
+    const std::string name = "Clusterer/" + algorithm + "/threads:" + std::to_string(thread_count) + "/" +
+                             obstacle_cloud.source->name;
+    benchmark::RegisterBenchmark(name.c_str(), [&obstacle_cloud, algorithm, thread_count](benchmark::State &state) {
+        IClusterer::UniquePtr clusterer;
+        if (algorithm == "euclidean")
+        {
+            clusterer = IClusterer::createUnique<CartesianEuclideanClusterer>(CLUSTER_TOLERANCE, MIN_CLUSTER_SIZE,
+                                                                              MAX_CLUSTER_SIZE);
+        }
+        else if (algorithm == "dbscan")
+        {
+            clusterer = IClusterer::createUnique<CartesianDBSCAN>(CLUSTER_TOLERANCE, MIN_CLUSTER_SIZE, thread_count);
+        }
+        else
+        {
+            clusterer = IClusterer::createUnique<RangeImageClusterer>(nullptr, ANGLE_THRESHOLD_DEG, MIN_CLUSTER_SIZE,
+                                                                      MAX_CLUSTER_SIZE);
+        }
+        runClusterer(state, *clusterer, obstacle_cloud.cloud);
+    })
+        ->Unit(benchmark::kMillisecond)
+        ->UseRealTime();
+}
+} // namespace
+
+void registerClusteringBenchmarks(const BenchmarkClouds &clouds)
+{
+    for (const auto &cloud : clouds)
+    {
+        obstacle_clouds.push_back(makeObstacleCloud(*cloud));
+        const ObstacleCloud &obstacle_cloud = *obstacle_clouds.back();
+
+        registerClusteringBenchmark(obstacle_cloud, "euclidean", 1U);
+        for (const std::uint32_t thread_count : benchmarkThreadCounts())
+        {
+            registerClusteringBenchmark(obstacle_cloud, "dbscan", thread_count);
+        }
+        registerClusteringBenchmark(obstacle_cloud, "range_image", 1U);
+    }
+}
+} // namespace benchmarks
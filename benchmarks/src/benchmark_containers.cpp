@@ -0,0 +1,142 @@
+// Utilities
+#include <utilities_lib/bounded_vector.hpp> // BoundedVector
+#include <utilities_lib/fifo_queue.hpp>     // FIFOQueue
+#include <utilities_lib/tlsf_allocator.hpp> // TLSFAllocator
+
+// Benchmark
+#include <benchmark/benchmark.h>
+
+// STL
+#include <array>   // std::array
+#include <cstddef> // std::byte, std::size_t
+#include <cstdint> // std::uint32_t
+#include <memory>  // std::allocator
+#include <queue>   // std::queue
+#include <random>  // std::mt19937, std::uniform_int_distribution
+#include <vector>  // std::vector
+
+// Micro-benchmarks of the utilities_lib containers, each against the standard container it replaces
+namespace
+{
+// Cloud sizes of the macro-benchmarks
+constexpr std::size_t MAX_NUMBER_OF_POINTS = 250'000U;
+
+void applyCloudSizes(benchmark::internal::Benchmark *benchmark)
+{
+    benchmark->Arg(30'000)->Arg(120'000)->Arg(250'000);
+}
+
+template <typename QueueT> QueueT makeQueue()
+{
+    return QueueT{};
+}
+
+// Queue without capacity does not grow, the capacity is doubled once full
+template <> utilities_lib::FIFOQueue<std::uint32_t> makeQueue()
+{
+    return utilities_lib::FIFOQueue<std::uint32_t>{1024U};
+}
+
+// Batches pushed and popped, as the breadth-first search of the clusterers uses the queue
+template <typename QueueT> void BM_QueuePushPop(benchmark::State &state)
+{
+    const auto batch_size = static_cast<std::uint32_t>(state.range(0));
+    QueueT queue = makeQueue<QueueT>();
+    for (auto _ : state)
+    {
+        for (std::uint32_t i = 0U; i < batch_size; ++i)
+        {
+            queue.push(i);
+        }
+        std::uint64_t sum = 0U;
+        while (!queue.empty())
+        {
+            sum += queue.front();
+            queue.pop();
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * batch_size);
+}
+
+BENCHMARK_TEMPLATE(BM_QueuePushPop, utilities_lib::FIFOQueue<std::uint32_t>)->Arg(64)->Arg(4096)->Arg(65536);
+BENCHMARK_TEMPLATE(BM_QueuePushPop, std::queue<std::uint32_t>)->Arg(64)->Arg(4096)->Arg(65536);
+
+// Per-point buffer filled and cleared every frame
+template <typename VectorT> void BM_VectorFillClear(benchmark::State &state)
+{
+    const auto number_of_points = static_cast<std::uint32_t>(state.range(0));
+    VectorT vector;
+    for (auto _ : state)
+    {
+        for (std::uint32_t i = 0U; i < number_of_points; ++i)
+        {
+            vector.push_back(static_cast<std::uint32_t>(i));
+        }
+        benchmark::DoNotOptimize(vector.data());
+        vector.clear();
+    }
+    state.SetItemsProcessed(state.iterations() * number_of_points);
+}
+
+BENCHMARK_TEMPLATE(BM_VectorFillClear, utilities_lib::BoundedVector<std::uint32_t, MAX_NUMBER_OF_POINTS>)
+    ->Apply(applyCloudSizes);
+BENCHMARK_TEMPLATE(BM_VectorFillClear, std::vector<std::uint32_t>)->Apply(applyCloudSizes);
+
+// Vector grown from empty every frame, one allocation per doubling
+template <typename AllocatorT> void BM_VectorGrowth(benchmark::State &state)
+{
+    const auto number_of_points = static_cast<std::uint32_t>(state.range(0));
+    for (auto _ : state)
+    {
+        std::vector<std::uint32_t, AllocatorT> vector;
+        for (std::uint32_t i = 0U; i < number_of_points; ++i)
+        {
+            vector.push_back(i);
+        }
+        benchmark::DoNotOptimize(vector.data());
+    }
+    state.SetItemsProcessed(state.iterations() * number_of_points);
+}
+
+BENCHMARK_TEMPLATE(BM_VectorGrowth, utilities_lib::TLSFAllocator<std::uint32_t>)->Apply(applyCloudSizes);
+BENCHMARK_TEMPLATE(BM_VectorGrowth, std::allocator<std::uint32_t>)->Apply(applyCloudSizes);
+
+// Allocations of random sizes freed in random order, a working set of 1024 live blocks
+template <typename AllocatorT> void BM_RandomAllocations(benchmark::State &state)
+{
+    constexpr std::size_t NUMBER_OF_BLOCKS = 1024U;
+    const auto max_block_size = static_cast<std::size_t>(state.range(0));
+
+    std::mt19937 generator{42U};
+    std::uniform_int_distribution<std::size_t> block_size_distribution{1U, max_block_size};
+    std::uniform_int_distribution<std::size_t> block_distribution{0U, NUMBER_OF_BLOCKS - 1U};
+
+    AllocatorT allocator;
+    std::array<std::byte *, NUMBER_OF_BLOCKS> blocks{};
+    std::array<std::size_t, NUMBER_OF_BLOCKS> block_sizes{};
+    for (std::size_t block = 0U; block < NUMBER_OF_BLOCKS; ++block)
+    {
+        block_sizes[block] = block_size_distribution(generator);
+        blocks[block] = allocator.allocate(block_sizes[block]);
+    }
+
+    for (auto _ : state)
+    {
+        const std::size_t block = block_distribution(generator);
+        allocator.deallocate(blocks[block], block_sizes[block]);
+        block_sizes[block] = block_size_distribution(generator);
+        blocks[block] = allocator.allocate(block_sizes[block]);
+        benchmark::DoNotOptimize(blocks[block]);
+    }
+
+    for (std::size_t block = 0U; block < NUMBER_OF_BLOCKS; ++block)
+    {
+        allocator.deallocate(blocks[block], block_sizes[block]);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_TEMPLATE(BM_RandomAllocations, utilities_lib::TLSFAllocator<std::byte>)->Arg(64)->Arg(4096)->Arg(65536);
+BENCHMARK_TEMPLATE(BM_RandomAllocations, std::allocator<std::byte>)->Arg(64)->Arg(4096)->Arg(65536);
+} // namespace
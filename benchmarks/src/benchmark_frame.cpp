@@ -0,0 +1,123 @@
+#include "benchmark_suites.hpp"
+
+// Processing
+#include <lidar_processing_lib/clustering/cartesian_euclidean_clusterer.hpp> // CartesianEuclideanClusterer
+#include <lidar_processing_lib/clustering/range_image_clusterer.hpp>         // RangeImageClusterer
+#include <lidar_processing_lib/filtering/convex_quad_crop.hpp>               // ConvexQuadCrop
+#include <lidar_processing_lib/filtering/point_cloud_ingest.hpp>             // ingestPointCloud, selectPoints
+#include <lidar_processing_lib/segmentation/depth_image.hpp>                 // DepthImage
+#include <lidar_processing_lib/segmentation/depth_image_segmenter.hpp>       // DepthImageSegmenter
+#include <lidar_processing_lib/segmentation/ransac_segmenter.hpp>            // RansacSegmenter
+
+// Benchmark
+#include <benchmark/benchmark.h>
+
+// STL
+#include <array>  // std::array
+#include <memory> // std::make_shared
+#include <string> // std::string
+#include <vector> // std::vector
+
+namespace benchmarks
+{
+namespace
+{
+using lidar_processing_lib::clustering::CartesianEuclideanClusterer;
+using lidar_processing_lib::clustering::RangeImageClusterer;
+using lidar_processing_lib::filtering::ConvexQuadCrop;
+using lidar_processing_lib::segmentation::DepthImage;
+using lidar_processing_lib::segmentation::DepthImageSegmenter;
+using lidar_processing_lib::segmentation::RansacSegmenter;
+
+using ClusteringLabel = data_types_lib::ClusteringLabel;
+using SegmentationLabel = data_types_lib::SegmentationLabel;
+
+// Crop of the node config, the contour of the vehicle and the maximum distance
+constexpr std::array<lidar_processing_lib::filtering::QuadCorner, ConvexQuadCrop::NUMBER_OF_CORNERS> CROP_CORNERS{
+    {{2.79F, 0.8F}, {2.79F, -0.8F}, {-1.62F, -0.8F}, {-1.62F, 0.8F}}};
+constexpr float MAX_DISTANCE = 80.0F;
+
+// Buffers of a frame, reused across iterations as the node reuses its frames
+struct FrameBuffers final
+{
+    lidar_processing_lib::filtering::CropIndices crop_indices;
+    data_types_lib::PointCloudSoA cropped_cloud;
+    std::vector<SegmentationLabel> segmentation_labels;
+    std::vector<std::uint32_t> obstacle_indices;
+    data_types_lib::PointCloudSoA obstacle_cloud;
+    std::vector<ClusteringLabel> clustering_labels;
+};
+
+void cropFrame(const ConvexQuadCrop &crop, const BenchmarkCloud &cloud, FrameBuffers &frame)
+{
+    const data_types_lib::PointCloudView input_cloud = cloud.view();
+    crop.run(input_cloud, frame.crop_indices);
+    lidar_processing_lib::filtering::ingestPointCloud(
+        data_types_lib::PointCloudView{input_cloud, frame.crop_indices.data(), frame.crop_indices.size()},
+        frame.cropped_cloud);
+}
+
+// RANSAC on the threads followed by Euclidean clustering of the obstacle points
+void registerRansacEuclideanFrameBenchmark(const BenchmarkCloud &cloud, const std::uint32_t thread_count)
+{
+    const std::string name = "Frame/ransac_euclidean/threads:" + std::to_string(thread_count) + "/" + cloud.name;
+    benchmark::RegisterBenchmark(name.c_str(), [&cloud, thread_count](benchmark::State &state) {
+        const ConvexQuadCrop crop{CROP_CORNERS, MAX_DISTANCE};
+        RansacSegmenter segmenter{SENSOR_HEIGHT_M, ORTHOGONAL_DISTANCE_THRESHOLD, NUMBER_OF_ITERATIONS, thread_count};
+        CartesianEuclideanClusterer clusterer{CLUSTER_TOLERANCE, MIN_CLUSTER_SIZE, MAX_CLUSTER_SIZE};
+
+        FrameBuffers frame;
+        for (auto _ : state)
+        {
+            cropFrame(crop, cloud, frame);
+            segmenter.run(frame.cropped_cloud, frame.segmentation_labels);
+            collectObstacleIndices(frame.segmentation_labels, frame.obstacle_indices);
+            lidar_processing_lib::filtering::selectPoints(frame.cropped_cloud, frame.obstacle_indices.data(),
+                                                          frame.obstacle_indices.size(), frame.obstacle_cloud);
+            clusterer.run(frame.obstacle_cloud, frame.clustering_labels);
+            benchmark::DoNotOptimize(frame.clustering_labels.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(cloud.points.size()));
+    })
+        ->Unit(benchmark::kMillisecond)
+        ->UseRealTime();
+}
+
+// Depth image segmentation and range image clustering sharing the depth image of the cropped cloud
+void registerDepthImageFrameBenchmark(const BenchmarkCloud &cloud)
+{
+    const std::string name = "Frame/depth_image_range_image/threads:1/" + cloud.name;
+    benchmark::RegisterBenchmark(name.c_str(), [&cloud](benchmark::State &state) {
+        const ConvexQuadCrop crop{CROP_CORNERS, MAX_DISTANCE};
+        auto depth_image = std::make_shared<DepthImage>();
+        DepthImageSegmenter segmenter{depth_image};
+        RangeImageClusterer clusterer{depth_image, ANGLE_THRESHOLD_DEG, MIN_CLUSTER_SIZE, MAX_CLUSTER_SIZE};
+
+        FrameBuffers frame;
+        for (auto _ : state)
+        {
+            cropFrame(crop, cloud, frame);
+            segmenter.run(frame.cropped_cloud, frame.segmentation_labels);
+            clusterer.clusterObstacles(frame.segmentation_labels, frame.clustering_labels);
+            benchmark::DoNotOptimize(frame.clustering_labels.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(cloud.points.size()));
+    })
+        ->Unit(benchmark::kMillisecond);
+}
+} // namespace
+
+void registerFrameBenchmarks(const BenchmarkClouds &clouds)
+{
+    for (const auto &cloud : clouds)
+    {
+        for (const std::uint32_t thread_count : benchmarkThreadCounts())
+        {
+            registerRansacEuclideanFrameBenchmark(*cloud, thread_count);
+        }
+        registerDepthImageFrameBenchmark(*cloud);
+    }
+}
+} // namespace benchmarks
@@ -0,0 +1,114 @@
+#include "benchmark_suites.hpp"
+
+// Processing
+#include <lidar_processing_lib/fusion/camera_calibration.hpp>    // CameraCalibration
+#include <lidar_processing_lib/fusion/point_cloud_colorizer.hpp> // PointCloudColorizer, CameraImageView
+
+// Benchmark
+#include <benchmark/benchmark.h>
+
+// STL
+#include <array>   // std::array
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint8_t, std::uint32_t
+#include <string>  // std::string
+#include <vector>  // std::vector
+
+namespace benchmarks
+{
+namespace
+{
+using lidar_processing_lib::fusion::CameraCalibration;
+using lidar_processing_lib::fusion::CameraImageView;
+using lidar_processing_lib::fusion::ImageEncoding;
+using lidar_processing_lib::fusion::PointCloudColorizer;
+
+// Rectified image size and horizontal baseline terms of the Kitti cameras 2, 3, 0 and 1 (2011_09_26), in priority
+// order of the node config
+constexpr std::uint32_t IMAGE_WIDTH = 1242U;
+constexpr std::uint32_t IMAGE_HEIGHT = 375U;
+constexpr std::array<double, 4U> BASELINE_TERMS{44.85728, -339.5242, 0.0, -387.5744};
+
+// Calibration of the drive, the cameras differ by the horizontal offset of their projection (their sub-pixel vertical
+// and depth offsets are left out)
+std::vector<CameraCalibration> makeCalibrations()
+{
+    Eigen::Matrix<double, 3, 4> projection;
+    projection << 721.5377, 0.0, 609.5593, 0.0, 0.0, 721.5377, 172.854, 0.0, 0.0, 0.0, 1.0, 0.0;
+
+    Eigen::Matrix4d rectification = Eigen::Matrix4d::Identity();
+    rectification.topLeftCorner<3, 3>() << 0.9999239, 0.00983776, -0.007445048, -0.009869795, 0.9999421,
+        -0.004278459, 0.007402527, 0.004351614, 0.9999631;
+
+    Eigen::Matrix4d lidar_to_camera = Eigen::Matrix4d::Identity();
+    lidar_to_camera.topLeftCorner<3, 3>() << 0.007533745, -0.9999714, -0.000616602, 0.01480249, 0.0007280733,
+        -0.9998902, 0.9998621, 0.00752379, 0.01480755;
+    lidar_to_camera.topRightCorner<3, 1>() << -0.004069766, -0.07631618, -0.2717806;
+
+    std::vector<CameraCalibration> calibrations;
+    for (const double baseline_term : BASELINE_TERMS)
+    {
+        projection(0, 3) = baseline_term;
+
+        CameraCalibration calibration;
+        calibration.lidar_to_image = (projection * rectification * lidar_to_camera).cast<float>();
+        calibration.width = IMAGE_WIDTH;
+        calibration.height = IMAGE_HEIGHT;
+        calibrations.push_back(calibration);
+    }
+    return calibrations;
+}
+
+// bgr8 image shared by the cameras, the pattern keeps the colour lookups from being uniform
+const std::vector<std::uint8_t> &benchmarkImage()
+{
+    static const std::vector<std::uint8_t> image = []() {
+        std::vector<std::uint8_t> pixels(static_cast<std::size_t>(IMAGE_WIDTH) * IMAGE_HEIGHT * 3U);
+        for (std::size_t i = 0U; i < pixels.size(); ++i)
+        {
+            pixels[i] = static_cast<std::uint8_t>(i * 7U);
+        }
+        return pixels;
+    }();
+    return image;
+}
+
+void registerColorizerBenchmark(const BenchmarkCloud &cloud, const std::uint32_t thread_count)
+{
+    const std::string name = "Colorizer/cameras:4/threads:" + std::to_string(thread_count) + "/" + cloud.name;
+    benchmark::RegisterBenchmark(name.c_str(), [&cloud, thread_count](benchmark::State &state) {
+        PointCloudColorizer colorizer{makeCalibrations(), thread_count};
+        const std::vector<CameraImageView> images(
+            colorizer.numberOfCameras(),
+            CameraImageView{benchmarkImage().data(), IMAGE_WIDTH, IMAGE_HEIGHT, IMAGE_WIDTH * 3U, ImageEncoding::BGR8});
+
+        std::vector<std::uint32_t> rgb;
+        std::vector<std::uint8_t> cameras;
+        for (auto _ : state)
+        {
+            colorizer.run(cloud.cloud, images, rgb, cameras);
+            benchmark::DoNotOptimize(rgb.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(cloud.cloud.size()));
+    })
+        ->Unit(benchmark::kMillisecond)
+        ->UseRealTime();
+}
+} // namespace
+
+void registerFusionBenchmarks(const BenchmarkClouds &clouds)
+{
+    for (const auto &cloud : clouds)
+    {
+        // More threads than cameras are idle
+        for (const std::uint32_t thread_count : benchmarkThreadCounts())
+        {
+            if (thread_count <= BASELINE_TERMS.size())
+            {
+                registerColorizerBenchmark(*cloud, thread_count);
+            }
+        }
+    }
+}
+} // namespace benchmarks
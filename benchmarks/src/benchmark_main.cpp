@@ -0,0 +1,48 @@
+#include "benchmark_suites.hpp"
+
+// Benchmark
+#include <benchmark/benchmark.h>
+
+// STL
+#include <cstdlib>   // std::getenv
+#include <exception> // std::exception
+#include <iostream>  // std::cerr
+#include <string>    // std::to_string
+
+// Runs the benchmarks of the processing stages and of utilities_lib. Results are written as JSON for a diff across
+// commits with --benchmark_out=<file> --benchmark_out_format=json, a recorded KITTI scan is added to the synthetic
+// clouds through LIDAR_BENCHMARK_KITTI_SCAN=<.../velodyne_points/data/0000000000.bin>.
+int main(int argc, char **argv)
+{
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    {
+        return 1;
+    }
+
+    try
+    {
+        // Clouds are generated before any benchmark runs and outlive them
+        const benchmarks::BenchmarkClouds clouds = benchmarks::makeBenchmarkClouds();
+        benchmarks::registerSegmentationBenchmarks(clouds);
+        benchmarks::registerClusteringBenchmarks(clouds);
+        benchmarks::registerFrameBenchmarks(clouds);
+        benchmarks::registerFusionBenchmarks(clouds);
+        benchmarks::registerThreadPoolBenchmarks();
+
+        // Inputs of the run, so that results of different machines or scans are not compared by accident
+        const char *kitti_scan_path = std::getenv(benchmarks::KITTI_SCAN_ENVIRONMENT_VARIABLE);
+        benchmark::AddCustomContext("kitti_scan", (kitti_scan_path == nullptr) ? "" : kitti_scan_path);
+        benchmark::AddCustomContext("synthetic_seed", std::to_string(benchmarks::SYNTHETIC_SEED));
+
+        benchmark::RunSpecifiedBenchmarks();
+        benchmark::Shutdown();
+    }
+    catch (const std::exception &ex)
+    {
+        std::cerr << "Exception: " << ex.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,183 @@
+#include "benchmark_suites.hpp"
+
+// Processing
+#include <lidar_processing_lib/filtering/point_cloud_ingest.hpp>       // ingestPointCloud
+#include <lidar_processing_lib/segmentation/depth_image.hpp>           // DepthImage
+#include <lidar_processing_lib/segmentation/depth_image_segmenter.hpp> // DepthImageSegmenter
+#include <lidar_processing_lib/segmentation/ransac_segmenter.hpp>      // RansacSegmenter
+
+// Eigen
+#include <eigen3/Eigen/Geometry> // Eigen::Isometry3f, Eigen::Translation3f
+
+// Benchmark
+#include <benchmark/benchmark.h>
+
+// STL
+#include <cstddef> // std::size_t
+#include <memory>  // std::make_shared, std::make_unique
+#include <string>  // std::string
+#include <vector>  // std::vector
+
+namespace benchmarks
+{
+namespace
+{
+using lidar_processing_lib::segmentation::DepthImage;
+using lidar_processing_lib::segmentation::DepthImageSegmenter;
+using lidar_processing_lib::segmentation::ISegmenter;
+using lidar_processing_lib::segmentation::RansacAdaptiveConfiguration;
+using lidar_processing_lib::segmentation::RansacSegmenter;
+using lidar_processing_lib::segmentation::TemporalGroundConfiguration;
+
+using SegmentationLabel = data_types_lib::SegmentationLabel;
+
+// Moving sequence, the sensor drives forward through the scene of the cloud by one step per frame (10 m/s at 10 Hz)
+constexpr std::size_t SEQUENCE_LENGTH = 10U;
+constexpr float SEQUENCE_STEP_M = 1.0F;
+
+// Consecutive frames of the moving sequence and the ego-motion into each of them, the first frame follows the last
+struct MovingSequence final
+{
+    std::vector<data_types_lib::PointCloudSoA> frames;
+    std::vector<Eigen::Isometry3f> ego_motions;
+};
+
+MovingSequence makeMovingSequence(const BenchmarkCloud &cloud)
+{
+    MovingSequence sequence;
+    sequence.frames.resize(SEQUENCE_LENGTH);
+    BenchmarkCloud frame_cloud;
+    for (std::size_t frame_index = 0U; frame_index < SEQUENCE_LENGTH; ++frame_index)
+    {
+        // The scene moves backwards in the frame of the sensor
+        const float offset = static_cast<float>(frame_index) * SEQUENCE_STEP_M;
+        frame_cloud.points = cloud.points;
+        for (auto &point : frame_cloud.points)
+        {
+            point.x -= offset;
+        }
+        lidar_processing_lib::filtering::ingestPointCloud(frame_cloud.view(), sequence.frames[frame_index]);
+
+        const float step = (frame_index == 0U) ? (static_cast<float>(SEQUENCE_LENGTH - 1U) * SEQUENCE_STEP_M)
+                                               : -SEQUENCE_STEP_M;
+        sequence.ego_motions.emplace_back(Eigen::Translation3f{step, 0.0F, 0.0F});
+    }
+    return sequence;
+}
+
+void runSegmenter(benchmark::State &state, ISegmenter &segmenter, const BenchmarkCloud &cloud)
+{
+    std::vector<SegmentationLabel> labels;
+    for (auto _ : state)
+    {
+        segmenter.run(cloud.cloud, labels);
+        benchmark::DoNotOptimize(labels.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(cloud.cloud.size()));
+}
+
+// Frames of the sequence are segmented in order, each with the ego-motion since the previous frame
+void runSegmenterOnSequence(benchmark::State &state, ISegmenter &segmenter, const BenchmarkCloud &cloud)
+{
+    const MovingSequence sequence = makeMovingSequence(cloud);
+    std::vector<SegmentationLabel> labels;
+    std::size_t frame_index = 0U;
+    for (auto _ : state)
+    {
+        segmenter.setEgoMotion(sequence.ego_motions[frame_index]);
+        segmenter.run(sequence.frames[frame_index], labels);
+        benchmark::DoNotOptimize(labels.data());
+        benchmark::ClobberMemory();
+        frame_index = (frame_index + 1U) % SEQUENCE_LENGTH;
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(cloud.cloud.size()));
+}
+
+// Fixed: exactly NUMBER_OF_ITERATIONS hypotheses, adaptive: early termination warm started from the previous frame,
+// banded: adaptive with the horizontal traversal split into one band per thread, incremental: fixed with the plane of
+// the previous frame reused while it is validated (the repeated scan is a static scene). Moving benchmarks segment the
+// consecutive frames of a moving sequence instead of the repeated scan
+void registerRansacBenchmark(const BenchmarkCloud &cloud, const std::string &mode, const std::uint32_t thread_count,
+                             const bool moving = false)
+{
+    const std::string name = "RansacSegmenter/" + mode + (moving ? "_moving" : "") +
+                             "/threads:" + std::to_string(thread_count) + "/" + cloud.name;
+    benchmark::RegisterBenchmark(name.c_str(), [&cloud, mode, thread_count, moving](benchmark::State &state) {
+        RansacAdaptiveConfiguration adaptive_configuration;
+        adaptive_configuration.enabled = (mode == "adaptive") || (mode == "banded");
+        const std::uint32_t horizontal_traversal_bands = (mode == "banded") ? thread_count : 1U;
+        TemporalGroundConfiguration temporal_configuration;
+        temporal_configuration.enabled = (mode == "incremental");
+
+        RansacSegmenter segmenter{SENSOR_HEIGHT_M,        ORTHOGONAL_DISTANCE_THRESHOLD, NUMBER_OF_ITERATIONS,
+                                  thread_count,           adaptive_configuration,        horizontal_traversal_bands,
+                                  temporal_configuration};
+        if (moving)
+        {
+            runSegmenterOnSequence(state, segmenter, cloud);
+        }
+        else
+        {
+            runSegmenter(state, segmenter, cloud);
+        }
+    })
+        ->Unit(benchmark::kMillisecond)
+        ->UseRealTime();
+}
+
+// Incremental: the ground elevation of every cell is kept across the frames, moving: consecutive frames of a moving
+// sequence instead of the repeated scan
+void registerDepthImageBenchmark(const BenchmarkCloud &cloud, const DepthImage::ProjectionMode projection_mode,
+                                 const bool incremental = false, const bool moving = false)
+{
+    const bool exact = (projection_mode == DepthImage::ProjectionMode::EXACT);
+    const std::string name = std::string{"DepthImageSegmenter/"} + (exact ? "exact" : "lookup_table") +
+                             (incremental ? "_incremental" : "") + (moving ? "_moving" : "") + "/threads:1/" +
+                             cloud.name;
+    benchmark::RegisterBenchmark(name.c_str(), [&cloud, projection_mode, incremental,
+                                                moving](benchmark::State &state) {
+        auto depth_image = std::make_shared<DepthImage>(lidar_processing_lib::segmentation::VelodyneHdl64e::PROFILE,
+                                                        DepthImage::DEFAULT_MIN_RANGE_M,
+                                                        DepthImage::DEFAULT_MAX_RANGE_M, projection_mode);
+        TemporalGroundConfiguration temporal_configuration;
+        temporal_configuration.enabled = incremental;
+        DepthImageSegmenter segmenter{depth_image, temporal_configuration};
+        if (moving)
+        {
+            runSegmenterOnSequence(state, segmenter, cloud);
+        }
+        else
+        {
+            runSegmenter(state, segmenter, cloud);
+        }
+    })
+        ->Unit(benchmark::kMillisecond);
+}
+} // namespace
+
+void registerSegmentationBenchmarks(const BenchmarkClouds &clouds)
+{
+    for (const auto &cloud : clouds)
+    {
+        for (const std::uint32_t thread_count : benchmarkThreadCounts())
+        {
+            registerRansacBenchmark(*cloud, "fixed", thread_count);
+            registerRansacBenchmark(*cloud, "adaptive", thread_count);
+            registerRansacBenchmark(*cloud, "incremental", thread_count);
+            registerRansacBenchmark(*cloud, "fixed", thread_count, true);
+            registerRansacBenchmark(*cloud, "incremental", thread_count, true);
+            if (thread_count > 1U)
+            {
+                registerRansacBenchmark(*cloud, "banded", thread_count);
+            }
+        }
+
+        registerDepthImageBenchmark(*cloud, DepthImage::ProjectionMode::EXACT);
+        registerDepthImageBenchmark(*cloud, DepthImage::ProjectionMode::LOOKUP_TABLE);
+        registerDepthImageBenchmark(*cloud, DepthImage::ProjectionMode::LOOKUP_TABLE, true);
+        registerDepthImageBenchmark(*cloud, DepthImage::ProjectionMode::LOOKUP_TABLE, false, true);
+        registerDepthImageBenchmark(*cloud, DepthImage::ProjectionMode::LOOKUP_TABLE, true, true);
+    }
+}
+} // namespace benchmarks
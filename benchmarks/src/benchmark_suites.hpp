@@ -0,0 +1,40 @@
+#ifndef BENCHMARK_SUITES_HPP
+#define BENCHMARK_SUITES_HPP
+
+#include "benchmark_clouds.hpp" // BenchmarkCloud
+
+// STL
+#include <cstdint> // std::uint32_t
+#include <memory>  // std::unique_ptr
+#include <vector>  // std::vector
+
+namespace benchmarks
+{
+using BenchmarkClouds = std::vector<std::unique_ptr<BenchmarkCloud>>;
+
+// Parameters of the node config
+constexpr float ORTHOGONAL_DISTANCE_THRESHOLD = 0.2F;
+constexpr std::uint32_t NUMBER_OF_ITERATIONS = 150U;
+constexpr float CLUSTER_TOLERANCE = 0.5F;
+constexpr std::uint32_t MIN_CLUSTER_SIZE = 5U;
+constexpr std::uint32_t MAX_CLUSTER_SIZE = 25000U;
+constexpr float ANGLE_THRESHOLD_DEG = 10.0F;
+
+/// @brief Registers the segmenters in each of their modes on every cloud.
+void registerSegmentationBenchmarks(const BenchmarkClouds &clouds);
+
+/// @brief Registers the clusterers on the obstacle points of every cloud.
+void registerClusteringBenchmarks(const BenchmarkClouds &clouds);
+
+/// @brief Registers the whole processing of a frame as the serial mode of the node runs it, from the crop to the
+/// clustering.
+void registerFrameBenchmarks(const BenchmarkClouds &clouds);
+
+/// @brief Registers the colorizer with the four Kitti cameras on every cloud, for one to four threads.
+void registerFusionBenchmarks(const BenchmarkClouds &clouds);
+
+/// @brief Registers the thread pool benchmarks for one to all hardware threads.
+void registerThreadPoolBenchmarks();
+} // namespace benchmarks
+
+#endif // BENCHMARK_SUITES_HPP
@@ -0,0 +1,73 @@
+#include "benchmark_suites.hpp"
+
+// Utilities
+#include <utilities_lib/thread_pool.hpp> // ThreadPool
+
+// Benchmark
+#include <benchmark/benchmark.h>
+
+// STL
+#include <atomic>  // std::atomic
+#include <cstddef> // std::size_t
+#include <numeric> // std::iota
+#include <string>  // std::string
+#include <vector>  // std::vector
+
+namespace benchmarks
+{
+namespace
+{
+// Round trip of a task without work, the scheduling overhead of the pool
+void BM_ThreadPoolEnqueue(benchmark::State &state, const std::uint32_t thread_count)
+{
+    utilities_lib::ThreadPool thread_pool{thread_count};
+    for (auto _ : state)
+    {
+        auto result = thread_pool.enqueue([]() { return 1; });
+        benchmark::DoNotOptimize(result.get());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Chunked reduction over a cloud sized buffer, the pattern of the RANSAC scoring and the DBSCAN neighbour searches
+void BM_ThreadPoolParallelFor(benchmark::State &state, const std::uint32_t thread_count)
+{
+    constexpr std::size_t NUMBER_OF_POINTS = 120'000U;
+    const auto grain = static_cast<std::size_t>(state.range(0));
+
+    std::vector<float> values(NUMBER_OF_POINTS);
+    std::iota(values.begin(), values.end(), 0.0F);
+
+    utilities_lib::ThreadPool thread_pool{thread_count};
+    for (auto _ : state)
+    {
+        std::atomic<std::size_t> count{0U};
+        thread_pool.parallelFor(0U, NUMBER_OF_POINTS, grain, [&values, &count](std::size_t first, std::size_t last) {
+            std::size_t local_count = 0U;
+            for (std::size_t i = first; i < last; ++i)
+            {
+                local_count += (values[i] * values[i] > 1e6F) ? 1U : 0U;
+            }
+            count.fetch_add(local_count, std::memory_order_relaxed);
+        });
+        benchmark::DoNotOptimize(count.load());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(NUMBER_OF_POINTS));
+}
+} // namespace
+
+void registerThreadPoolBenchmarks()
+{
+    for (const std::uint32_t thread_count : benchmarkThreadCounts())
+    {
+        const std::string threads = "/threads:" + std::to_string(thread_count);
+        benchmark::RegisterBenchmark(("ThreadPool/enqueue" + threads).c_str(), BM_ThreadPoolEnqueue, thread_count)
+            ->UseRealTime();
+        benchmark::RegisterBenchmark(("ThreadPool/parallel_for" + threads).c_str(), BM_ThreadPoolParallelFor,
+                                     thread_count)
+            ->Arg(1024)
+            ->Arg(16384)
+            ->UseRealTime();
+    }
+}
+} // namespace benchmarks
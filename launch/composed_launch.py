@@ -0,0 +1,57 @@
+import os
+from ament_index_python.packages import get_package_share_directory
+from launch import LaunchDescription
+from launch.actions import ExecuteProcess
+from launch_ros.actions import ComposableNodeContainer
+from launch_ros.descriptions import ComposableNode
+
+
+def generate_launch_description():
+    # RViz
+    package_directory = os.path.join(
+        get_package_share_directory("lidar_camera_fusion"), "visualization"
+    )
+    config_file = os.path.join(package_directory, "rviz2_config.rviz")
+    rviz = ExecuteProcess(cmd=["rviz2", "-d", config_file], output="screen")
+
+    # Sensor Data Publisher Node
+    package_directory = get_package_share_directory("sensor_data_publisher_node")
+    config_file = os.path.join(
+        package_directory, "config", "sensor_data_publisher_node.param.yaml"
+    )
+    sensor_data_publisher_node = ComposableNode(
+        package="sensor_data_publisher_node",
+        plugin="SensorDataPublisherNode",
+        name="sensor_data_publisher_node",
+        parameters=[config_file],
+        extra_arguments=[{"use_intra_process_comms": True}],
+    )
+
+    # Lidar Data Processor Node
+    package_directory = get_package_share_directory("lidar_data_processor_node")
+    config_file = os.path.join(
+        package_directory, "config", "lidar_data_processor_node.param.yaml"
+    )
+    lidar_data_processor_node = ComposableNode(
+        package="lidar_data_processor_node",
+        plugin="LidarDataProcessorNode",
+        name="lidar_data_processor_node",
+        parameters=[config_file],
+        extra_arguments=[{"use_intra_process_comms": True}],
+    )
+
+    # Both nodes share one process, point clouds are passed between them without serialization
+    container = ComposableNodeContainer(
+        name="lidar_camera_fusion_container",
+        namespace="",
+        package="rclcpp_components",
+        executable="component_container_mt",
+        composable_node_descriptions=[
+            sensor_data_publisher_node,
+            lidar_data_processor_node,
+        ],
+        output="screen",
+    )
+
+    # Create and return the launch description
+    return LaunchDescription([rviz, container])
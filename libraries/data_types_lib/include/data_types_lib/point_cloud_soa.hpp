@@ -0,0 +1,330 @@
+#ifndef DATA_TYPES_LIB__POINT_CLOUD_SOA_HPP
+#define DATA_TYPES_LIB__POINT_CLOUD_SOA_HPP
+
+#include <data_types_lib/point_cloud_view.hpp> // PointCloudView::Point
+
+#include <algorithm> // std::copy_n
+#include <cstddef>   // std::size_t, std::ptrdiff_t
+#include <iterator>  // std::input_iterator_tag
+#include <new>       // operator new, std::align_val_t
+#include <utility>   // std::swap
+
+namespace data_types_lib
+{
+/// @brief Owning point cloud in structure-of-arrays layout. Every channel is a contiguous float array starting on a
+/// cache line, so the processing stages stream through the channels they need. Range, horizontal range and azimuth
+/// are derived once at ingest and shared by the stages instead of being recomputed by each of them.
+/// The channels keep their capacity across frames, they are reallocated only to hold a larger cloud.
+class PointCloudSoA final
+{
+  public:
+    // Alignment of every channel in bytes
+    static constexpr std::size_t ALIGNMENT = 64U;
+
+    using Point = PointCloudView::Point;
+
+    /// @brief Random access range over the points, mirrors PointCloudView::Points.
+    class Points final
+    {
+      public:
+        class ConstIterator final
+        {
+          public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = Point;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const Point *;
+            using reference = Point;
+
+            ConstIterator(const Points *points, std::size_t index) noexcept : points_{points}, index_{index}
+            {
+            }
+
+            inline Point operator*() const noexcept
+            {
+                return (*points_)[index_];
+            }
+
+            inline ConstIterator &operator++() noexcept
+            {
+                ++index_;
+                return *this;
+            }
+
+            inline bool operator==(const ConstIterator &other) const noexcept
+            {
+                return (index_ == other.index_);
+            }
+
+            inline bool operator!=(const ConstIterator &other) const noexcept
+            {
+                return (index_ != other.index_);
+            }
+
+          private:
+            const Points *points_;
+            std::size_t index_;
+        };
+
+        inline std::size_t size() const noexcept
+        {
+            return size_;
+        }
+
+        inline bool empty() const noexcept
+        {
+            return (size_ == 0U);
+        }
+
+        inline Point operator[](const std::size_t index) const noexcept
+        {
+            return Point{x_[index], y_[index], z_[index], intensity_[index]};
+        }
+
+        inline ConstIterator begin() const noexcept
+        {
+            return ConstIterator{this, 0U};
+        }
+
+        inline ConstIterator end() const noexcept
+        {
+            return ConstIterator{this, size_};
+        }
+
+      private:
+        friend class PointCloudSoA;
+
+        const float *x_ = nullptr;
+        const float *y_ = nullptr;
+        const float *z_ = nullptr;
+        const float *intensity_ = nullptr;
+        std::size_t size_ = 0U;
+    };
+
+    /// @brief Default constructor, empty cloud without capacity.
+    PointCloudSoA() = default;
+
+    /// @brief Constructor, preallocates the channels for capacity points.
+    explicit PointCloudSoA(const std::size_t capacity)
+    {
+        reserve(capacity);
+    }
+
+    /// @brief Destructor.
+    ~PointCloudSoA()
+    {
+        release();
+    }
+
+    // Copy operations are not allowed, clouds are moved or refilled.
+    PointCloudSoA(const PointCloudSoA &) = delete;
+    PointCloudSoA &operator=(const PointCloudSoA &) = delete;
+
+    /// @brief Move constructor.
+    PointCloudSoA(PointCloudSoA &&other) noexcept
+    {
+        swap(other);
+    }
+
+    /// @brief Move assignment operator.
+    PointCloudSoA &operator=(PointCloudSoA &&other) noexcept
+    {
+        swap(other);
+        return *this;
+    }
+
+    inline std::size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    inline bool empty() const noexcept
+    {
+        return (size_ == 0U);
+    }
+
+    inline std::size_t capacity() const noexcept
+    {
+        return capacity_;
+    }
+
+    /// @brief Preallocates the channels, the points are kept.
+    void reserve(const std::size_t capacity)
+    {
+        if (capacity <= capacity_)
+        {
+            return;
+        }
+
+        // Channel length is rounded up to whole cache lines, so every channel starts aligned
+        constexpr std::size_t FLOATS_PER_LINE = ALIGNMENT / sizeof(float);
+        const std::size_t stride = ((capacity + FLOATS_PER_LINE - 1U) / FLOATS_PER_LINE) * FLOATS_PER_LINE;
+        auto *data = static_cast<float *>(
+            ::operator new(stride * NUMBER_OF_CHANNELS * sizeof(float), std::align_val_t{ALIGNMENT}));
+
+        for (std::size_t channel = 0U; channel < NUMBER_OF_CHANNELS; ++channel)
+        {
+            std::copy_n(data_ + (channel * stride_), size_, data + (channel * stride));
+        }
+
+        const std::size_t size = size_;
+        release();
+        data_ = data;
+        stride_ = stride;
+        capacity_ = capacity;
+        size_ = size;
+        updatePoints();
+    }
+
+    /// @brief Resizes the cloud, the values of the added points are unspecified until they are written.
+    void resize(const std::size_t size)
+    {
+        reserve(size);
+        size_ = size;
+        updatePoints();
+    }
+
+    /// @brief Removes the points, the capacity is kept.
+    inline void clear() noexcept
+    {
+        size_ = 0U;
+        updatePoints();
+    }
+
+    // Forward positive, in meters
+    inline float *x() noexcept
+    {
+        return channel(X);
+    }
+
+    inline const float *x() const noexcept
+    {
+        return channel(X);
+    }
+
+    // Leftward positive, in meters
+    inline float *y() noexcept
+    {
+        return channel(Y);
+    }
+
+    inline const float *y() const noexcept
+    {
+        return channel(Y);
+    }
+
+    // Upward positive, in meters
+    inline float *z() noexcept
+    {
+        return channel(Z);
+    }
+
+    inline const float *z() const noexcept
+    {
+        return channel(Z);
+    }
+
+    // Point intensity or reflectance
+    inline float *intensity() noexcept
+    {
+        return channel(INTENSITY);
+    }
+
+    inline const float *intensity() const noexcept
+    {
+        return channel(INTENSITY);
+    }
+
+    // Offset from the sensor origin to the point, in meters
+    inline float *range() noexcept
+    {
+        return channel(RANGE);
+    }
+
+    inline const float *range() const noexcept
+    {
+        return channel(RANGE);
+    }
+
+    // Distance from the sensor origin in the XY plane, in meters
+    inline float *horizontalRange() noexcept
+    {
+        return channel(HORIZONTAL_RANGE);
+    }
+
+    inline const float *horizontalRange() const noexcept
+    {
+        return channel(HORIZONTAL_RANGE);
+    }
+
+    // Azimuth in radians [-pi, pi], zero straight ahead, counterclockwise
+    inline float *azimuth() noexcept
+    {
+        return channel(AZIMUTH);
+    }
+
+    inline const float *azimuth() const noexcept
+    {
+        return channel(AZIMUTH);
+    }
+
+    // Points decoded from the channels, used by the algorithms templated on the cloud type
+    Points points;
+
+  private:
+    enum Channel : std::size_t
+    {
+        X,
+        Y,
+        Z,
+        INTENSITY,
+        RANGE,
+        HORIZONTAL_RANGE,
+        AZIMUTH,
+        NUMBER_OF_CHANNELS
+    };
+
+    float *data_ = nullptr;
+    std::size_t stride_ = 0U;
+    std::size_t capacity_ = 0U;
+    std::size_t size_ = 0U;
+
+    inline float *channel(const Channel channel) const noexcept
+    {
+        return data_ + (static_cast<std::size_t>(channel) * stride_);
+    }
+
+    inline void updatePoints() noexcept
+    {
+        points.x_ = channel(X);
+        points.y_ = channel(Y);
+        points.z_ = channel(Z);
+        points.intensity_ = channel(INTENSITY);
+        points.size_ = size_;
+    }
+
+    inline void release() noexcept
+    {
+        if (data_ != nullptr)
+        {
+            ::operator delete(data_, std::align_val_t{ALIGNMENT});
+        }
+        data_ = nullptr;
+        stride_ = 0U;
+        capacity_ = 0U;
+        size_ = 0U;
+    }
+
+    inline void swap(PointCloudSoA &other) noexcept
+    {
+        std::swap(data_, other.data_);
+        std::swap(stride_, other.stride_);
+        std::swap(capacity_, other.capacity_);
+        std::swap(size_, other.size_);
+        updatePoints();
+        other.updatePoints();
+    }
+};
+} // namespace data_types_lib
+
+#endif // DATA_TYPES_LIB__POINT_CLOUD_SOA_HPP
@@ -0,0 +1,199 @@
+#ifndef DATA_TYPES_LIB__POINT_CLOUD_VIEW_HPP
+#define DATA_TYPES_LIB__POINT_CLOUD_VIEW_HPP
+
+#include <cstddef>  // std::size_t, std::ptrdiff_t
+#include <cstdint>  // std::uint8_t, std::uint32_t
+#include <cstring>  // std::memcpy
+#include <iterator> // std::input_iterator_tag
+#include <limits>   // std::numeric_limits
+
+namespace data_types_lib
+{
+// Byte offsets of FLOAT32 fields within a point of point_step bytes
+struct PointCloudLayout final
+{
+    // Field is not present in the cloud
+    static constexpr auto INVALID_OFFSET = std::numeric_limits<std::uint32_t>::max();
+
+    std::uint32_t x_offset = INVALID_OFFSET;
+    std::uint32_t y_offset = INVALID_OFFSET;
+    std::uint32_t z_offset = INVALID_OFFSET;
+
+    // Optional, intensity of the viewed points is 0 when not present
+    std::uint32_t intensity_offset = INVALID_OFFSET;
+
+    std::uint32_t point_step = 0U;
+
+    inline bool isValid() const noexcept
+    {
+        const auto fits = [this](std::uint32_t offset) noexcept {
+            return (offset != INVALID_OFFSET) && ((offset + sizeof(float)) <= point_step);
+        };
+        return fits(x_offset) && fits(y_offset) && fits(z_offset) &&
+               ((intensity_offset == INVALID_OFFSET) || fits(intensity_offset));
+    }
+};
+
+/// @brief Non-owning view of a strided, row-major point buffer (e.g. the payload of a PointCloud2 message).
+/// Mirrors the part of pcl::PointCloud used by the processing algorithms, points are decoded on access.
+/// An indexed view selects points of another view through an index map (e.g. the points kept by a crop), so the
+/// selected points are not copied and point i of the indexed view is point indices[i] of the viewed buffer.
+class PointCloudView final
+{
+  public:
+    // Decoded point
+    struct Point final
+    {
+        float x;
+        float y;
+        float z;
+        float intensity;
+    };
+
+    /// @brief Random access range over the viewed points.
+    class Points final
+    {
+      public:
+        class ConstIterator final
+        {
+          public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = Point;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const Point *;
+            using reference = Point;
+
+            ConstIterator(const Points *points, std::size_t index) noexcept : points_{points}, index_{index}
+            {
+            }
+
+            inline Point operator*() const noexcept
+            {
+                return (*points_)[index_];
+            }
+
+            inline ConstIterator &operator++() noexcept
+            {
+                ++index_;
+                return *this;
+            }
+
+            inline bool operator==(const ConstIterator &other) const noexcept
+            {
+                return (index_ == other.index_);
+            }
+
+            inline bool operator!=(const ConstIterator &other) const noexcept
+            {
+                return (index_ != other.index_);
+            }
+
+          private:
+            const Points *points_;
+            std::size_t index_;
+        };
+
+        Points() = default;
+
+        Points(const std::uint8_t *data, std::uint32_t width, std::uint32_t height, std::uint32_t row_step,
+               const PointCloudLayout &layout) noexcept
+            : data_{data}, width_{width}, row_step_{row_step}, size_{static_cast<std::size_t>(width) * height},
+              contiguous_{row_step == (width * layout.point_step)}, layout_{layout}
+        {
+        }
+
+        /// @brief Selection of the points through the index map, the indices must outlive the points.
+        Points(const Points &points, const std::uint32_t *indices, std::size_t number_of_indices) noexcept
+            : Points{points}
+        {
+            indices_ = indices;
+            size_ = number_of_indices;
+        }
+
+        inline std::size_t size() const noexcept
+        {
+            return size_;
+        }
+
+        inline bool empty() const noexcept
+        {
+            return (size_ == 0U);
+        }
+
+        inline Point operator[](const std::size_t index) const noexcept
+        {
+            const std::uint8_t *point_data =
+                data_ + byteOffset((indices_ != nullptr) ? static_cast<std::size_t>(indices_[index]) : index);
+
+            Point point{0.0F, 0.0F, 0.0F, 0.0F};
+            std::memcpy(&point.x, point_data + layout_.x_offset, sizeof(float));
+            std::memcpy(&point.y, point_data + layout_.y_offset, sizeof(float));
+            std::memcpy(&point.z, point_data + layout_.z_offset, sizeof(float));
+            if (layout_.intensity_offset != PointCloudLayout::INVALID_OFFSET)
+            {
+                std::memcpy(&point.intensity, point_data + layout_.intensity_offset, sizeof(float));
+            }
+            return point;
+        }
+
+        inline ConstIterator begin() const noexcept
+        {
+            return ConstIterator{this, 0U};
+        }
+
+        inline ConstIterator end() const noexcept
+        {
+            return ConstIterator{this, size_};
+        }
+
+      private:
+        const std::uint8_t *data_ = nullptr;
+        std::uint32_t width_ = 0U;
+        std::uint32_t row_step_ = 0U;
+        std::size_t size_ = 0U;
+
+        // Rows are not padded, points are evenly spaced by point_step
+        bool contiguous_ = true;
+
+        PointCloudLayout layout_{};
+
+        // Index map of an indexed view, null when all points of the buffer are viewed
+        const std::uint32_t *indices_ = nullptr;
+
+        inline std::size_t byteOffset(const std::size_t index) const noexcept
+        {
+            if (contiguous_)
+            {
+                return index * layout_.point_step;
+            }
+            return ((index / width_) * row_step_) + ((index % width_) * layout_.point_step);
+        }
+    };
+
+    /// @brief Default constructor, empty view.
+    PointCloudView() = default;
+
+    /// @brief Constructor, the buffer must outlive the view.
+    /// @param row_step - Bytes between the starts of consecutive rows.
+    PointCloudView(const std::uint8_t *data, std::uint32_t width, std::uint32_t height, std::uint32_t row_step,
+                   const PointCloudLayout &layout) noexcept
+        : points{data, width, height, row_step, layout}, width{width}, height{height}
+    {
+    }
+
+    /// @brief Constructor of an indexed view, unorganized (height 1). The view and the indices must outlive it.
+    /// @param view - View of the buffer, must not be indexed itself.
+    /// @param indices - Indices of the selected points in the buffer, in the order of the indexed view.
+    PointCloudView(const PointCloudView &view, const std::uint32_t *indices, std::size_t number_of_indices) noexcept
+        : points{view.points, indices, number_of_indices}, width{static_cast<std::uint32_t>(number_of_indices)},
+          height{1U}
+    {
+    }
+
+    Points points;
+    std::uint32_t width = 0U;
+    std::uint32_t height = 0U;
+};
+} // namespace data_types_lib
+
+#endif // DATA_TYPES_LIB__POINT_CLOUD_VIEW_HPP
@@ -0,0 +1,136 @@
+#ifndef LIDAR_PROCESSING_LIB__BATCH__BATCH_SEGMENTER_HPP
+#define LIDAR_PROCESSING_LIB__BATCH__BATCH_SEGMENTER_HPP
+
+#include <cstddef>                                             // std::size_t
+#include <cstdint>                                             // std::uint32_t
+#include <data_types_lib/point_cloud_soa.hpp>                  // PointCloudSoA
+#include <data_types_lib/segmentation_label.hpp>               // SegmentationLabel
+#include <filesystem>                                          // std::filesystem
+#include <functional>                                          // std::function
+#include <lidar_processing_lib/filtering/convex_quad_crop.hpp> // ConvexQuadCrop
+#include <lidar_processing_lib/segmentation/i_segmenter.hpp>   // ISegmenter
+#include <memory>                                              // std::shared_ptr
+#include <mutex>                                               // std::mutex
+#include <utilities_lib/thread_pool.hpp>                       // ThreadPool
+#include <vector>                                              // std::vector
+
+namespace lidar_processing_lib::batch
+{
+struct BatchSegmentationConfiguration final
+{
+    // Workers segmenting frames in parallel, each with its own segmenter (0 uses every hardware thread)
+    std::size_t number_of_workers = 0U;
+
+    // Pins worker i to CPU core i modulo the number of cores (Linux only)
+    bool pin_threads = false;
+
+    // Segmenters keep a ground model across frames, every worker then segments a contiguous run of the frames in
+    // recording order. Otherwise the frames are scheduled in small chunks to keep the workers balanced
+    bool incremental = false;
+
+    // Frames preceding its run a worker segments without writing their labels in the incremental mode, so that the
+    // first frame of the run is segmented with a ground model. The default covers the max_cell_age and max_plane_age
+    // of the default TemporalGroundConfiguration
+    std::size_t warm_up_frames = 10U;
+};
+
+// Throughput of a segmented sequence, loading and writing of the frames included
+struct BatchSegmentationStatistics final
+{
+    std::size_t number_of_frames = 0U;
+    std::size_t number_of_points = 0U;
+    std::size_t number_of_workers = 0U;
+
+    double wall_time_s = 0.0;
+
+    // Time span of the recording from its timestamps, 0 when the sequence has no timestamps
+    double sequence_duration_s = 0.0;
+
+    double frames_per_second = 0.0;
+    double points_per_second = 0.0;
+
+    // Seconds of recording segmented per second of wall time, 0 when the sequence has no timestamps
+    double realtime_factor = 0.0;
+};
+
+/// @brief Offline segmentation of recorded sequences, without replaying them through the node. Every worker segments
+/// with its own segmenter, independent frames are scheduled in small chunks. In the incremental mode the frames are
+/// split into contiguous runs, one per worker, and every worker segments its run in recording order after warming up
+/// on the frames preceding it. The labels then depend on the number of workers only through the ground model older
+/// than the warm-up: cells carried for at most max_cell_age frames are rebuilt exactly, while the frames at which
+/// RANSAC refits its plane depend on the whole history and the labels around them may differ slightly. Clouds are
+/// mapped from their files instead of being read.
+///
+/// A sequence is a Kitti sensor folder: the .bin clouds in data/ (or in the folder itself) and an optional
+/// timestamps.txt. Every cloud gets a .label file of the same name in the output folder, holding one
+/// SegmentationLabel byte per point of the cloud, cropped points are UNKNOWN.
+class BatchSegmenter final
+{
+  public:
+    using SegmenterFactory = std::function<segmentation::ISegmenter::UniquePtr()>;
+
+    static constexpr const char *LABEL_FILE_EXTENSION = ".label";
+
+    /// @brief Deleted default constructor.
+    BatchSegmenter() = delete;
+
+    /// @brief Non-default constructor, creates the workers and their segmenters. The calling thread of run is one of
+    /// the workers.
+    /// @param segmenter_factory - Called once per worker, the segmenters must not share state (e.g. a depth image).
+    /// @param crop - Applied to every cloud before the segmentation, nullptr segments all points.
+    /// @throws std::runtime_error if the factory returns no segmenter.
+    BatchSegmenter(const SegmenterFactory &segmenter_factory, const BatchSegmentationConfiguration &configuration,
+                   std::shared_ptr<const filtering::ConvexQuadCrop> crop = nullptr);
+
+    ~BatchSegmenter();
+
+    // Copy and move operations are not allowed.
+    BatchSegmenter(const BatchSegmenter &) = delete;
+    BatchSegmenter(BatchSegmenter &&) = delete;
+    BatchSegmenter &operator=(const BatchSegmenter &) = delete;
+    BatchSegmenter &operator=(BatchSegmenter &&) = delete;
+
+    /// @brief Segments every cloud of the sequence and writes its labels, the output folder is created if needed.
+    /// @throws std::runtime_error if the sequence has no clouds or a cloud or label file can not be accessed.
+    BatchSegmentationStatistics run(const std::filesystem::path &sequence_path,
+                                    const std::filesystem::path &output_path);
+
+    /// @brief Get the number of workers.
+    inline std::size_t numberOfWorkers() const noexcept
+    {
+        return workers_.size();
+    }
+
+  private:
+    // Buffers of a worker keep their capacity across the frames of its run
+    struct Worker final
+    {
+        segmentation::ISegmenter::UniquePtr segmenter;
+        filtering::CropIndices crop_indices;
+        data_types_lib::PointCloudSoA cloud;
+        std::vector<data_types_lib::SegmentationLabel> labels;
+        std::vector<data_types_lib::SegmentationLabel> cloud_labels;
+        std::size_t number_of_points = 0U;
+    };
+
+    BatchSegmentationConfiguration configuration_;
+    std::shared_ptr<const filtering::ConvexQuadCrop> crop_;
+    std::vector<Worker> workers_;
+    utilities_lib::ThreadPool thread_pool_;
+
+    // Workers not segmenting a chunk, chunks run on any thread of the pool
+    std::mutex idle_workers_mutex_;
+    std::vector<Worker *> idle_workers_;
+
+    /// @brief Segments the clouds in [warm_up_first, last) in order and writes the labels of the clouds in
+    /// [first, last), the clouds before first only update the ground model of the segmenter.
+    void segmentRun(Worker &worker, const std::vector<std::filesystem::path> &cloud_paths, std::size_t warm_up_first,
+                    std::size_t first, std::size_t last, const std::filesystem::path &output_path);
+
+    /// @brief Segments the clouds of a chunk with an idle worker.
+    void segmentChunk(const std::vector<std::filesystem::path> &cloud_paths, std::size_t first, std::size_t last,
+                      const std::filesystem::path &output_path);
+};
+} // namespace lidar_processing_lib::batch
+
+#endif // LIDAR_PROCESSING_LIB__BATCH__BATCH_SEGMENTER_HPP
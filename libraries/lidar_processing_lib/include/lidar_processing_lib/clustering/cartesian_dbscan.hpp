@@ -1,30 +1,144 @@
 #ifndef LIDAR_PROCESSING_LIB__CLUSTERING__CARTESIAN_DBSCAN_HPP
 #define LIDAR_PROCESSING_LIB__CLUSTERING__CARTESIAN_DBSCAN_HPP
 
-#include "i_clusterer.hpp" // IClusterer
+#include "concurrent_disjoint_set.hpp"   // ConcurrentDisjointSet
+#include "i_clusterer.hpp"               // IClusterer
+#include "voxel_hash_grid.hpp"           // VoxelHashGrid
+#include <cmath>                         // std::isfinite
+#include <cstdint>                       // std::uint32_t
+#include <memory>                        // std::unique_ptr
+#include <stdexcept>                     // std::runtime_error
+#include <utilities_lib/thread_pool.hpp> // ThreadPool
+#include <vector>                        // std::vector
 
 namespace lidar_processing_lib::clustering
 {
+/// @brief Density-based clustering (DBSCAN), points with at least min_points points within epsilon (themselves
+/// included) are core points, core points within epsilon of each other belong to the same cluster and the remaining
+/// points within epsilon of a core point join one of its clusters as border points. Other points are outliers.
+/// Neighbours are searched in a voxel hash grid with voxels of the epsilon size, so the neighbours of a point lie
+/// within the 27 voxels around it. Core points are found and merged in parallel over ranges of voxels, clusters are
+/// merged in a lock-free union-find.
 class CartesianDBSCAN : public IClusterer
 {
   public:
-    CartesianDBSCAN();
+    // Number of points the grid and the search buffers are preallocated for
+    static constexpr std::uint32_t MAX_CLOUD_POINTS = 350000U;
+
+    /// @brief Constructor.
+    /// @param epsilon - Radius of the neighbourhood of a point.
+    /// @param min_points - Number of points within the neighbourhood of a core point, including the point itself.
+    /// @param thread_count - Number of workers sharing the voxels, 0 and 1 cluster on the calling thread.
+    explicit CartesianDBSCAN(float epsilon = 0.5F, std::uint32_t min_points = 5U, std::uint32_t thread_count = 1U);
+
     ~CartesianDBSCAN();
 
     void run(const pcl::PointCloud<pcl::PointXYZ> &cloud, std::vector<ClusteringLabel> &labels) override;
     void run(const pcl::PointCloud<pcl::PointXYZI> &cloud, std::vector<ClusteringLabel> &labels) override;
+    void run(const data_types_lib::PointCloudView &cloud, std::vector<ClusteringLabel> &labels) override;
+    void run(const data_types_lib::PointCloudSoA &cloud, std::vector<ClusteringLabel> &labels) override;
 
   private:
-    template <typename PointT> void cluster(const pcl::PointCloud<PointT> &cloud, std::vector<ClusteringLabel> &labels);
+    // Point is not within epsilon of a core point
+    static constexpr std::uint32_t NO_CORE_POINT = VoxelHashGrid::INVALID_VOXEL;
+
+    // Voxel ranges queued per worker, smaller ranges balance voxels of uneven density
+    static constexpr std::uint32_t RANGES_PER_WORKER = 4U;
+
+    float epsilon_;
+    std::uint32_t min_points_;
+    std::uint32_t thread_count_;
+
+    VoxelHashGrid voxel_grid_;
+
+    // Occupied neighbours of each voxel, NEIGHBOURHOOD_SIZE entries are kept per voxel
+    std::vector<std::uint8_t> neighbour_counts_;
+    std::vector<std::uint32_t> neighbour_voxels_;
+
+    // Per embedded point (in the order of the grid): core flag, and for the other points the position of a core point
+    // within epsilon
+    std::vector<std::uint8_t> core_flags_;
+    std::vector<std::uint32_t> border_cores_;
+
+    // Sets of core points, indexed by the position of the points in the grid
+    ConcurrentDisjointSet core_sets_;
+
+    // Label of each set, indexed by its root
+    std::vector<ClusteringLabel> set_labels_;
+
+    std::unique_ptr<utilities_lib::ThreadPool> thread_pool_;
+
+    template <typename CloudT> void cluster(const CloudT &cloud, std::vector<ClusteringLabel> &labels);
+
+    /// @brief Runs the DBSCAN stages over the embedded points, labels of the embedded points are set to the clusters.
+    void clusterEmbeddedPoints(std::vector<ClusteringLabel> &labels);
+
+    /// @brief Resolves the neighbours of the voxels and flags their core points.
+    void findCorePoints(std::uint32_t first_voxel, std::uint32_t last_voxel);
+
+    /// @brief Unites the core points of the voxels with the core points within epsilon in voxels of equal or larger
+    /// indices, so every pair of voxels is processed once.
+    void uniteCorePoints(std::uint32_t first_voxel, std::uint32_t last_voxel);
+
+    /// @brief Finds a core point within epsilon of every non-core point of the voxels.
+    void findBorderCores(std::uint32_t first_voxel, std::uint32_t last_voxel);
+
+    /// @brief Splits the occupied voxels into ranges processed on the thread pool and the calling thread, or on the
+    /// calling thread alone without the pool. Returns once all ranges are processed.
+    template <typename ProcessRange> void forEachVoxelRange(const ProcessRange &process_range);
 };
 
-template <typename PointT>
-void CartesianDBSCAN::cluster(const pcl::PointCloud<PointT> &cloud, std::vector<ClusteringLabel> &labels)
+template <typename ProcessRange> void CartesianDBSCAN::forEachVoxelRange(const ProcessRange &process_range)
+{
+    const std::uint32_t number_of_voxels = voxel_grid_.numberOfVoxels();
+    if (thread_pool_ == nullptr)
+    {
+        process_range(0U, number_of_voxels);
+        return;
+    }
+
+    // Idle workers steal the remaining ranges, so uneven voxel densities are balanced
+    const std::uint32_t number_of_ranges = thread_count_ * RANGES_PER_WORKER;
+    const std::uint32_t grain = (number_of_voxels + number_of_ranges - 1U) / number_of_ranges;
+    thread_pool_->parallelFor(0U, number_of_voxels, grain, [&process_range](std::size_t first, std::size_t last) {
+        process_range(static_cast<std::uint32_t>(first), static_cast<std::uint32_t>(last));
+    });
+}
+
+template <typename CloudT>
+void CartesianDBSCAN::cluster(const CloudT &cloud, std::vector<ClusteringLabel> &labels)
 {
     // Reset labels
     labels.assign(cloud.points.size(), static_cast<ClusteringLabel>(ReservedClusteringLabel::UNKNOWN));
 
-    // TODO: Perform clustering
+    if (cloud.points.size() > MAX_CLOUD_POINTS)
+    {
+        throw std::runtime_error("Number of points exceeds the capacity of CartesianDBSCAN!");
+    }
+
+    // Embed points into the voxel grid, points that cannot be embedded do not belong to any cluster
+    voxel_grid_.clear(cloud.points.size());
+    for (std::uint32_t i = 0U; i < static_cast<std::uint32_t>(cloud.points.size()); ++i)
+    {
+        const auto &point = cloud.points[i];
+        if (!std::isfinite(point.x) || !std::isfinite(point.y) || !std::isfinite(point.z))
+        {
+            labels[i] = static_cast<ClusteringLabel>(ReservedClusteringLabel::OUTLIER);
+            continue;
+        }
+
+        const auto coordinates = voxel_grid_.voxelCoordinates(point.x, point.y, point.z);
+        if (!VoxelHashGrid::isRepresentable(coordinates))
+        {
+            labels[i] = static_cast<ClusteringLabel>(ReservedClusteringLabel::OUTLIER);
+            continue;
+        }
+
+        voxel_grid_.stage(coordinates, VoxelGridPoint{point.x, point.y, point.z, i});
+    }
+    voxel_grid_.build();
+
+    clusterEmbeddedPoints(labels);
 }
 
 } // namespace lidar_processing_lib::clustering
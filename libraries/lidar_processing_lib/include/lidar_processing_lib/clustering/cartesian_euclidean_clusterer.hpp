@@ -1,30 +1,162 @@
 #ifndef LIDAR_PROCESSING_LIB__CLUSTERING__CARTESIAN_EUCLIDEAN_CLUSTERER_HPP
 #define LIDAR_PROCESSING_LIB__CLUSTERING__CARTESIAN_EUCLIDEAN_CLUSTERER_HPP
 
-#include "i_clusterer.hpp" // IClusterer
+#include "i_clusterer.hpp"              // IClusterer
+#include "voxel_hash_grid.hpp"          // VoxelHashGrid
+#include <algorithm>                    // std::max
+#include <cmath>                        // std::isfinite
+#include <cstddef>                      // std::size_t
+#include <cstdint>                      // std::uint32_t
+#include <stdexcept>                    // std::runtime_error
+#include <utilities_lib/fifo_queue.hpp> // FIFOQueue
+#include <vector>                       // std::vector
 
 namespace lidar_processing_lib::clustering
 {
+/// @brief Euclidean clustering, points closer than the cluster tolerance belong to the same cluster.
+/// Neighbours are searched in a voxel hash grid with voxels of the cluster tolerance size, so the neighbours of a point
+/// lie within the 27 voxels around it. Clusters are grown by breadth-first search from every unlabelled point.
 class CartesianEuclideanClusterer : public IClusterer
 {
   public:
-    CartesianEuclideanClusterer();
+    // Number of points the grid and the search buffers are preallocated for
+    static constexpr std::uint32_t MAX_CLOUD_POINTS = 350000U;
+
+    /// @brief Constructor.
+    /// @param cluster_tolerance - Maximum distance between neighbouring points of a cluster.
+    /// @param min_cluster_size - Points of smaller clusters are labelled as outliers.
+    /// @param max_cluster_size - Points of larger clusters are labelled as outliers.
+    explicit CartesianEuclideanClusterer(float cluster_tolerance = 0.5F, std::uint32_t min_cluster_size = 5U,
+                                         std::uint32_t max_cluster_size = MAX_CLOUD_POINTS);
+
     ~CartesianEuclideanClusterer();
 
     void run(const pcl::PointCloud<pcl::PointXYZ> &cloud, std::vector<ClusteringLabel> &labels) override;
     void run(const pcl::PointCloud<pcl::PointXYZI> &cloud, std::vector<ClusteringLabel> &labels) override;
+    void run(const data_types_lib::PointCloudView &cloud, std::vector<ClusteringLabel> &labels) override;
+    void run(const data_types_lib::PointCloudSoA &cloud, std::vector<ClusteringLabel> &labels) override;
 
   private:
-    template <typename PointT> void cluster(const pcl::PointCloud<PointT> &cloud, std::vector<ClusteringLabel> &labels);
+    // Flag of a neighbour count whose list still holds exhausted neighbours, the low bits hold the count
+    static constexpr std::uint8_t NEIGHBOURS_NOT_COMPACTED = 0x80U;
+    static constexpr std::uint8_t NEIGHBOUR_COUNT_MASK = 0x7FU;
+
+    // Largest batch tested against all its points, larger batches reject candidates by their bounding box first
+    static constexpr std::size_t SMALL_BATCH_SIZE = 8U;
+
+    // Axis-aligned bounding box of a batch of points
+    struct BoundingBox final
+    {
+        float min_x;
+        float min_y;
+        float min_z;
+        float max_x;
+        float max_y;
+        float max_z;
+
+        inline float squaredDistance(const float x, const float y, const float z) const noexcept
+        {
+            const float dx = std::max(std::max(min_x - x, x - max_x), 0.0F);
+            const float dy = std::max(std::max(min_y - y, y - max_y), 0.0F);
+            const float dz = std::max(std::max(min_z - z, z - max_z), 0.0F);
+            return (dx * dx) + (dy * dy) + (dz * dz);
+        }
+    };
+
+    float cluster_tolerance_;
+    std::uint32_t min_cluster_size_;
+    std::uint32_t max_cluster_size_;
+
+    VoxelHashGrid voxel_grid_;
+
+    // Breadth-first search frontier, holds voxels with points added to the cluster whose neighbours are yet to be
+    // searched, a voxel is queued at most once at a time
+    utilities_lib::FIFOQueue<std::uint32_t> frontier_;
+
+    // Points of each voxel v are kept partitioned in three ranges relative to its offset:
+    // [0, unlabelled_counts_[v]) do not belong to a cluster yet,
+    // [unlabelled_counts_[v], pending_ends_[v]) were added to the cluster but their neighbours are not searched yet,
+    // [pending_ends_[v], size) are fully processed.
+    // Searches never revisit clustered points, and points pending in the same voxel are expanded as one batch
+    std::vector<std::uint32_t> unlabelled_counts_;
+    std::vector<std::uint32_t> pending_ends_;
+
+    // Occupied neighbours of each voxel, built before growing, NEIGHBOURHOOD_SIZE entries are kept per voxel.
+    // Neighbours without unlabelled points are dropped from the lists as they are encountered
+    std::vector<std::uint8_t> neighbour_counts_;
+    std::vector<std::uint32_t> neighbour_voxels_;
+
+    // Number of points of each grown cluster, and the label it is published with
+    std::vector<std::uint32_t> cluster_sizes_;
+    std::vector<ClusteringLabel> cluster_labels_;
+
+    template <typename CloudT> void cluster(const CloudT &cloud, std::vector<ClusteringLabel> &labels);
+
+    /// @brief Grows clusters over the embedded points, labels of the embedded points are set to the cluster indices.
+    void growClusters(std::vector<ClusteringLabel> &labels);
+
+    /// @brief Returns the occupied voxels within the 3x3x3 neighbourhood of a voxel that have unlabelled points, their
+    /// number is stored in neighbour_counts_.
+    std::uint32_t *resolveNeighbourVoxels(std::uint32_t voxel_index);
 };
 
-template <typename PointT>
-void CartesianEuclideanClusterer::cluster(const pcl::PointCloud<PointT> &cloud, std::vector<ClusteringLabel> &labels)
+template <typename CloudT>
+void CartesianEuclideanClusterer::cluster(const CloudT &cloud, std::vector<ClusteringLabel> &labels)
 {
     // Reset labels
     labels.assign(cloud.points.size(), static_cast<ClusteringLabel>(ReservedClusteringLabel::UNKNOWN));
 
-    // TODO: Perform clustering
+    if (cloud.points.size() > MAX_CLOUD_POINTS)
+    {
+        throw std::runtime_error("Number of points exceeds the capacity of CartesianEuclideanClusterer!");
+    }
+
+    // Embed points into the voxel grid, points that cannot be embedded do not belong to any cluster
+    voxel_grid_.clear(cloud.points.size());
+    for (std::uint32_t i = 0U; i < static_cast<std::uint32_t>(cloud.points.size()); ++i)
+    {
+        const auto &point = cloud.points[i];
+        if (!std::isfinite(point.x) || !std::isfinite(point.y) || !std::isfinite(point.z))
+        {
+            labels[i] = static_cast<ClusteringLabel>(ReservedClusteringLabel::OUTLIER);
+            continue;
+        }
+
+        const auto coordinates = voxel_grid_.voxelCoordinates(point.x, point.y, point.z);
+        if (!VoxelHashGrid::isRepresentable(coordinates))
+        {
+            labels[i] = static_cast<ClusteringLabel>(ReservedClusteringLabel::OUTLIER);
+            continue;
+        }
+
+        voxel_grid_.stage(coordinates, VoxelGridPoint{point.x, point.y, point.z, i});
+    }
+    voxel_grid_.build();
+
+    growClusters(labels);
+
+    // Clusters outside of the size limits are outliers, the remaining ones are numbered consecutively
+    ClusteringLabel next_label = 0;
+    cluster_labels_.clear();
+    for (const auto cluster_size : cluster_sizes_)
+    {
+        if ((cluster_size >= min_cluster_size_) && (cluster_size <= max_cluster_size_))
+        {
+            cluster_labels_.push_back(next_label++);
+        }
+        else
+        {
+            cluster_labels_.push_back(static_cast<ClusteringLabel>(ReservedClusteringLabel::OUTLIER));
+        }
+    }
+
+    for (auto &label : labels)
+    {
+        if (label >= 0)
+        {
+            label = cluster_labels_[static_cast<std::size_t>(label)];
+        }
+    }
 }
 
 } // namespace lidar_processing_lib::clustering
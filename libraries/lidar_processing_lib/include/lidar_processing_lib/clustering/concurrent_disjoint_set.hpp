@@ -0,0 +1,103 @@
+#ifndef LIDAR_PROCESSING_LIB__CLUSTERING__CONCURRENT_DISJOINT_SET_HPP
+#define LIDAR_PROCESSING_LIB__CLUSTERING__CONCURRENT_DISJOINT_SET_HPP
+
+#include <atomic>    // std::atomic
+#include <cstddef>   // std::size_t
+#include <cstdint>   // std::uint32_t
+#include <memory>    // std::unique_ptr
+#include <stdexcept> // std::runtime_error
+#include <utility>   // std::swap
+
+namespace lidar_processing_lib::clustering
+{
+/// @brief Lock-free union-find over the elements [0, size), unite() and find() can be called from several threads.
+/// Roots are always linked below roots with smaller indices by compare-and-swap, so parents precede their children,
+/// the forest stays acyclic under concurrent updates and every set ends up rooted at its smallest element.
+class ConcurrentDisjointSet final
+{
+  public:
+    /// @brief Constructor.
+    /// @param capacity - Maximum number of elements.
+    explicit ConcurrentDisjointSet(const std::size_t capacity)
+        : capacity_{capacity}, parents_{std::make_unique<std::atomic<std::uint32_t>[]>(capacity)}
+    {
+    }
+
+    /// @brief Makes every element of [0, size) a singleton set, must not overlap with unite() or find().
+    inline void reset(const std::uint32_t size)
+    {
+        if (size > capacity_)
+        {
+            throw std::runtime_error("Number of elements exceeds the capacity of ConcurrentDisjointSet!");
+        }
+
+        for (std::uint32_t element = 0U; element < size; ++element)
+        {
+            parents_[element].store(element, std::memory_order_relaxed);
+        }
+        size_ = size;
+    }
+
+    inline std::uint32_t size() const noexcept
+    {
+        return size_;
+    }
+
+    /// @brief Root of the set containing the element, paths are halved along the way.
+    inline std::uint32_t find(std::uint32_t element) noexcept
+    {
+        while (true)
+        {
+            std::uint32_t parent = parents_[element].load(std::memory_order_relaxed);
+            if (parent == element)
+            {
+                return element;
+            }
+
+            const std::uint32_t grandparent = parents_[parent].load(std::memory_order_relaxed);
+            if (grandparent != parent)
+            {
+                // Failure means another thread has moved the element closer to the root already
+                parents_[element].compare_exchange_weak(parent, grandparent, std::memory_order_relaxed);
+            }
+            element = grandparent;
+        }
+    }
+
+    /// @brief Merges the sets containing both elements.
+    inline void unite(std::uint32_t element_a, std::uint32_t element_b) noexcept
+    {
+        while (true)
+        {
+            std::uint32_t root_a = find(element_a);
+            std::uint32_t root_b = find(element_b);
+            if (root_a == root_b)
+            {
+                return;
+            }
+
+            // Link the larger root below the smaller one, retry if it stopped being a root meanwhile
+            if (root_a < root_b)
+            {
+                std::swap(root_a, root_b);
+            }
+
+            std::uint32_t expected = root_a;
+            if (parents_[root_a].compare_exchange_strong(expected, root_b, std::memory_order_acq_rel))
+            {
+                return;
+            }
+
+            element_a = root_a;
+            element_b = root_b;
+        }
+    }
+
+  private:
+    std::size_t capacity_;
+    std::uint32_t size_ = 0U;
+    std::unique_ptr<std::atomic<std::uint32_t>[]> parents_;
+};
+} // namespace lidar_processing_lib::clustering
+
+#endif // LIDAR_PROCESSING_LIB__CLUSTERING__CONCURRENT_DISJOINT_SET_HPP
@@ -1,6 +1,8 @@
 #ifndef LIDAR_PROCESSING_LIB__CLUSTERING__I_CLUSTER_HPP
 #define LIDAR_PROCESSING_LIB__CLUSTERING__I_CLUSTER_HPP
 
+#include <data_types_lib/point_cloud_soa.hpp>           // PointCloudSoA
+#include <data_types_lib/point_cloud_view.hpp>          // PointCloudView
 #include <data_types_lib/reserved_clustering_label.hpp> // ReservedClusteringLabel
 
 #include <pcl/point_cloud.h> // pcl::PointCloud
@@ -55,6 +57,16 @@ class IClusterer
     /// @param cloud - Input variant of the point cloud.
     /// @param labels - Output clustering labels (equal to the number of elements in the input cloud).
     virtual void run(const pcl::PointCloud<pcl::PointXYZI> &cloud, std::vector<ClusteringLabel> &labels) = 0;
+
+    /// @brief Pure virtual run method to be implemented by the derived class.
+    /// @param cloud - Input view of an externally owned point buffer.
+    /// @param labels - Output clustering labels (equal to the number of elements in the input cloud).
+    virtual void run(const data_types_lib::PointCloudView &cloud, std::vector<ClusteringLabel> &labels) = 0;
+
+    /// @brief Pure virtual run method to be implemented by the derived class.
+    /// @param cloud - Input structure-of-arrays cloud with the channels derived at ingest.
+    /// @param labels - Output clustering labels (equal to the number of elements in the input cloud).
+    virtual void run(const data_types_lib::PointCloudSoA &cloud, std::vector<ClusteringLabel> &labels) = 0;
 };
 } // namespace lidar_processing_lib::clustering
 
@@ -0,0 +1,171 @@
+#ifndef LIDAR_PROCESSING_LIB__CLUSTERING__RANGE_IMAGE_CLUSTERER_HPP
+#define LIDAR_PROCESSING_LIB__CLUSTERING__RANGE_IMAGE_CLUSTERER_HPP
+
+#include "i_clusterer.hpp"                                   // IClusterer
+#include <array>                                             // std::array
+#include <cstdint>                                           // std::uint32_t
+#include <data_types_lib/segmentation_label.hpp>             // SegmentationLabel
+#include <lidar_processing_lib/segmentation/depth_image.hpp> // DepthImage
+#include <memory>                                            // std::shared_ptr
+#include <vector>                                            // std::vector
+
+namespace lidar_processing_lib::clustering
+{
+/// @brief Connected component clustering of the depth image (Bogoslavskyi and Stachniss, 2016).
+/// Neighbouring pixels belong to the same cluster when the angle between the beam of the farther point and the line
+/// joining both points exceeds the angle threshold, depth jumps between objects give small angles. Components are
+/// labelled in two raster passes over the image, the first unites neighbouring pixels in a union-find forest and the
+/// second resolves the provisional labels. The depth image can be shared with DepthImageSegmenter, so obstacles are
+/// clustered without projecting the cloud again.
+class RangeImageClusterer : public IClusterer
+{
+  public:
+    using DepthImage = segmentation::DepthImage;
+    using SegmentationLabel = data_types_lib::SegmentationLabel;
+
+    // Default upper limit of the cluster size, the buffers are sized by the sensor profile of the depth image
+    static constexpr std::uint32_t MAX_CLOUD_POINTS = 350000U;
+
+    // Empty pixels skipped along a row or a column when looking for the neighbour of a pixel, bridges missing returns
+    static constexpr std::uint32_t MAX_PIXEL_GAP = 2U;
+
+    /// @brief Constructor.
+    /// @param depth_image - Depth image shared with the segmenter, an own image is created when null.
+    /// @param angle_threshold_deg - Minimum angle in degrees (0, 90) between the beam and the line joining neighbouring
+    /// points of a cluster.
+    /// @param min_cluster_size - Points of smaller clusters are labelled as outliers.
+    /// @param max_cluster_size - Points of larger clusters are labelled as outliers.
+    explicit RangeImageClusterer(std::shared_ptr<DepthImage> depth_image = nullptr, float angle_threshold_deg = 10.0F,
+                                 std::uint32_t min_cluster_size = 5U,
+                                 std::uint32_t max_cluster_size = MAX_CLOUD_POINTS);
+
+    ~RangeImageClusterer();
+
+    /// @brief Projects the cloud into the depth image and clusters all projected points.
+    void run(const pcl::PointCloud<pcl::PointXYZ> &cloud, std::vector<ClusteringLabel> &labels) override;
+    void run(const pcl::PointCloud<pcl::PointXYZI> &cloud, std::vector<ClusteringLabel> &labels) override;
+    void run(const data_types_lib::PointCloudView &cloud, std::vector<ClusteringLabel> &labels) override;
+    void run(const data_types_lib::PointCloudSoA &cloud, std::vector<ClusteringLabel> &labels) override;
+
+    /// @brief Clusters the obstacle points of the cloud the depth image was last built from, without projecting it.
+    /// @param segmentation_labels - Segmentation labels of the cloud the depth image was built from.
+    /// @param labels - Output clustering labels of the OBSTACLE and TRANSITIONAL_OBSTACLE points, in the order of the
+    /// cloud (matching a cloud of the extracted obstacle points).
+    void clusterObstacles(const std::vector<SegmentationLabel> &segmentation_labels,
+                          std::vector<ClusteringLabel> &labels);
+
+    inline const std::shared_ptr<DepthImage> &depthImage() const noexcept
+    {
+        return depth_image_;
+    }
+
+  private:
+    // Pixel does not take part in clustering
+    static constexpr auto INACTIVE_PIXEL = DepthImage::INVALID_PIXEL;
+
+    // Sines and cosines of the angles between beams 1 to MAX_PIXEL_GAP + 1 pixels apart
+    using BeamAngleTable = std::array<float, MAX_PIXEL_GAP + 1U>;
+
+    std::shared_ptr<DepthImage> depth_image_;
+
+    float sin_angle_threshold_;
+    float cos_angle_threshold_;
+    std::uint32_t min_cluster_size_;
+    std::uint32_t max_cluster_size_;
+
+    BeamAngleTable horizontal_sines_;
+    BeamAngleTable horizontal_cosines_;
+    BeamAngleTable vertical_sines_;
+    BeamAngleTable vertical_cosines_;
+
+    // Union-find forest over the pixels, roots are the first pixels of the components in raster order.
+    // Pixels excluded from clustering hold INACTIVE_PIXEL
+    std::vector<std::uint32_t> parents_;
+
+    // Provisional label of the component of each active pixel
+    std::vector<ClusteringLabel> pixel_labels_;
+
+    // Number of points of each component, and the label it is published with
+    std::vector<std::uint32_t> cluster_sizes_;
+    std::vector<ClusteringLabel> cluster_labels_;
+
+    template <typename CloudT> void cluster(const CloudT &cloud, std::vector<ClusteringLabel> &labels);
+
+    /// @brief Labels the connected components of the active pixels, parents_ of active pixels point to themselves.
+    void labelComponents();
+
+    /// @brief Maps provisional labels to consecutive cluster labels, clusters outside of the size limits are outliers.
+    void filterClusters(std::vector<ClusteringLabel> &labels);
+
+    inline bool areConnected(const float range_a, const float range_b, const float sin_beam_angle,
+                             const float cos_beam_angle) const noexcept
+    {
+        const float far_range = (range_a > range_b) ? range_a : range_b;
+        const float near_range = (range_a > range_b) ? range_b : range_a;
+
+        // beta = atan2(near * sin(alpha), far - near * cos(alpha)) > threshold, compared without the arctangent
+        return ((near_range * sin_beam_angle * cos_angle_threshold_) >
+                ((far_range - near_range * cos_beam_angle) * sin_angle_threshold_));
+    }
+
+    inline std::uint32_t findRoot(std::uint32_t pixel) noexcept
+    {
+        // Path halving
+        while (parents_[pixel] != pixel)
+        {
+            parents_[pixel] = parents_[parents_[pixel]];
+            pixel = parents_[pixel];
+        }
+        return pixel;
+    }
+
+    inline void unite(const std::uint32_t pixel_a, const std::uint32_t pixel_b) noexcept
+    {
+        const std::uint32_t root_a = findRoot(pixel_a);
+        const std::uint32_t root_b = findRoot(pixel_b);
+
+        // The root with the smallest index is kept, so it is reached first by the raster scan
+        if (root_a < root_b)
+        {
+            parents_[root_b] = root_a;
+        }
+        else if (root_b < root_a)
+        {
+            parents_[root_a] = root_b;
+        }
+    }
+};
+
+template <typename CloudT>
+void RangeImageClusterer::cluster(const CloudT &cloud, std::vector<ClusteringLabel> &labels)
+{
+    depth_image_->build(cloud);
+
+    // Every projected point takes part in clustering
+    const auto &pixels = depth_image_->pixels();
+    for (std::uint32_t pixel_index = 0U; pixel_index < static_cast<std::uint32_t>(pixels.size()); ++pixel_index)
+    {
+        parents_[pixel_index] =
+            (pixels[pixel_index].index != DepthImage::Pixel::INVALID_INDEX) ? pixel_index : INACTIVE_PIXEL;
+    }
+
+    labelComponents();
+
+    // Points sharing a pixel with a closer point take the label of the pixel, points out of the image are outliers
+    const auto &point_pixels = depth_image_->pointPixels();
+    labels.assign(cloud.points.size(), static_cast<ClusteringLabel>(ReservedClusteringLabel::OUTLIER));
+    for (std::size_t i = 0U; i < point_pixels.size(); ++i)
+    {
+        if (point_pixels[i] != DepthImage::INVALID_PIXEL)
+        {
+            const ClusteringLabel label = pixel_labels_[point_pixels[i]];
+            labels[i] = label;
+            ++cluster_sizes_[static_cast<std::size_t>(label)];
+        }
+    }
+
+    filterClusters(labels);
+}
+} // namespace lidar_processing_lib::clustering
+
+#endif // LIDAR_PROCESSING_LIB__CLUSTERING__RANGE_IMAGE_CLUSTERER_HPP
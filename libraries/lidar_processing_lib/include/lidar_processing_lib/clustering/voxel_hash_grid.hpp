@@ -0,0 +1,238 @@
+#ifndef LIDAR_PROCESSING_LIB__CLUSTERING__VOXEL_HASH_GRID_HPP
+#define LIDAR_PROCESSING_LIB__CLUSTERING__VOXEL_HASH_GRID_HPP
+
+#include <algorithm> // std::min, std::max
+#include <cstddef>   // std::size_t
+#include <cstdint>   // std::int32_t, std::uint32_t, std::uint64_t
+#include <limits>    // std::numeric_limits
+#include <vector>    // std::vector
+
+namespace lidar_processing_lib::clustering
+{
+// Point embedded into a voxel hash grid
+struct VoxelGridPoint final
+{
+    float x;
+    float y;
+    float z;
+
+    // Index of the point cloud
+    std::uint32_t index;
+};
+
+/// @brief Sparse grid of cubic voxels, only occupied voxels are stored.
+/// Voxels are found through an open-addressing hash table keyed by the packed integer voxel coordinates. Points of
+/// each voxel are adjacent in memory, construction follows the two passes of PolarGrid: points are staged together
+/// with their voxel, then build() computes voxel offsets through a prefix sum and scatters the staged points.
+class VoxelHashGrid final
+{
+  public:
+    // Voxel is not occupied
+    static constexpr std::uint32_t INVALID_VOXEL = std::numeric_limits<std::uint32_t>::max();
+
+    // Number of bits of each packed voxel coordinate, packed voxel coordinates are within [-2^20, 2^20)
+    static constexpr std::uint32_t COORDINATE_BITS = 21U;
+    static constexpr std::int32_t COORDINATE_BIAS = 1 << (COORDINATE_BITS - 1U);
+
+    // The voxel itself and its 26 adjacent voxels
+    static constexpr std::uint32_t NEIGHBOURHOOD_SIZE = 27U;
+
+    // Adjacent voxels with a larger key, one of each pair of opposite adjacent voxels
+    static constexpr std::uint32_t FORWARD_NEIGHBOURHOOD_SIZE = 13U;
+
+    // Integer coordinates of a voxel
+    struct VoxelCoordinates final
+    {
+        std::int32_t x;
+        std::int32_t y;
+        std::int32_t z;
+    };
+
+    /// @brief Contiguous range of points of a single voxel.
+    class ConstVoxel final
+    {
+      public:
+        ConstVoxel(const VoxelGridPoint *begin, const VoxelGridPoint *end) noexcept : begin_{begin}, end_{end}
+        {
+        }
+
+        inline const VoxelGridPoint *begin() const noexcept
+        {
+            return begin_;
+        }
+
+        inline const VoxelGridPoint *end() const noexcept
+        {
+            return end_;
+        }
+
+        inline std::size_t size() const noexcept
+        {
+            return static_cast<std::size_t>(end_ - begin_);
+        }
+
+      private:
+        const VoxelGridPoint *begin_;
+        const VoxelGridPoint *end_;
+    };
+
+    /// @brief Constructor.
+    /// @param voxel_size - Edge length of the voxels.
+    /// @param max_points - Number of points the grid buffers and the hash table are preallocated for.
+    VoxelHashGrid(float voxel_size, std::size_t max_points);
+
+    /// @brief Removes all points from the grid, does not release memory.
+    /// @param number_of_points - Number of points to be staged next, at most max_points. The hash table probes only the
+    /// part sized for them, which stays in cache for the small clouds.
+    void clear(std::size_t number_of_points) noexcept;
+
+    /// @brief Integer coordinates of the voxel containing the point, coordinates of distant points are saturated to
+    /// values that are not representable.
+    inline VoxelCoordinates voxelCoordinates(const float x, const float y, const float z) const noexcept
+    {
+        const auto toCoordinate = [this](const float value) noexcept {
+            constexpr auto LIMIT = static_cast<float>(COORDINATE_BIAS);
+            // Rounds down by truncating the clamped value, std::floor is a library call without SSE4.1
+            const float scaled = std::min(std::max(value * inverse_voxel_size_, -LIMIT - 1.0F), LIMIT);
+            const auto truncated = static_cast<std::int32_t>(scaled);
+            return truncated - ((scaled < static_cast<float>(truncated)) ? 1 : 0);
+        };
+        return VoxelCoordinates{toCoordinate(x), toCoordinate(y), toCoordinate(z)};
+    }
+
+    /// @brief Checks that the voxel coordinates, and the coordinates of the adjacent voxels, can be packed into a key.
+    static inline bool isRepresentable(const VoxelCoordinates &coordinates) noexcept
+    {
+        const auto fits = [](const std::int32_t coordinate) noexcept {
+            return (coordinate > -COORDINATE_BIAS) && (coordinate < (COORDINATE_BIAS - 1));
+        };
+        return fits(coordinates.x) && fits(coordinates.y) && fits(coordinates.z);
+    }
+
+    /// @brief First pass, records a point to be embedded into the voxel containing it.
+    /// The voxel coordinates must be representable, and at most max_points points can be staged.
+    void stage(const VoxelCoordinates &coordinates, const VoxelGridPoint &point);
+
+    /// @brief Second pass, scatters staged points into voxels.
+    void build();
+
+    /// @brief Index of the voxel with the given coordinates, or INVALID_VOXEL if it is not occupied.
+    inline std::uint32_t findVoxel(const VoxelCoordinates &coordinates) const noexcept
+    {
+        if (!isRepresentable(coordinates))
+        {
+            return INVALID_VOXEL;
+        }
+
+        return findKey(packKey(coordinates));
+    }
+
+    /// @brief Finds the occupied voxels in the 3x3x3 neighbourhood of an occupied voxel, including the voxel itself.
+    /// @param neighbours - Output indices of the occupied voxels, must hold NEIGHBOURHOOD_SIZE entries.
+    /// @return Number of occupied voxels written to neighbours.
+    std::uint32_t findNeighbourVoxels(std::uint32_t voxel_index, std::uint32_t *neighbours) const noexcept;
+
+    /// @brief Finds the occupied voxels among the 13 adjacent voxels with a larger key. Every adjacent pair of voxels
+    /// is found once when all voxels are visited, which halves the lookups of building all neighbourhoods.
+    /// @param neighbours - Output indices of the occupied voxels, must hold FORWARD_NEIGHBOURHOOD_SIZE entries.
+    /// @return Number of occupied voxels written to neighbours.
+    std::uint32_t findForwardNeighbourVoxels(std::uint32_t voxel_index, std::uint32_t *neighbours) const noexcept;
+
+    /// @brief Returns points of a voxel, valid until the next call to clear.
+    inline ConstVoxel voxel(const std::uint32_t voxel_index) const noexcept
+    {
+        return ConstVoxel{points_.data() + voxel_offsets_[voxel_index],
+                          points_.data() + voxel_offsets_[voxel_index + 1U]};
+    }
+
+    /// @brief Offset of the first point of a voxel within the embedded points, the offset past the last voxel is
+    /// size().
+    inline std::uint32_t voxelOffset(const std::uint32_t voxel_index) const noexcept
+    {
+        return voxel_offsets_[voxel_index];
+    }
+
+    /// @brief Embedded points, grouped by voxel.
+    inline const std::vector<VoxelGridPoint> &points() const noexcept
+    {
+        return points_;
+    }
+
+    /// @brief Embedded points, grouped by voxel, points may be reordered within their voxel.
+    inline std::vector<VoxelGridPoint> &points() noexcept
+    {
+        return points_;
+    }
+
+    /// @brief Number of occupied voxels.
+    inline std::uint32_t numberOfVoxels() const noexcept
+    {
+        return static_cast<std::uint32_t>(voxel_keys_.size());
+    }
+
+    /// @brief Number of embedded points.
+    inline std::size_t size() const noexcept
+    {
+        return points_.size();
+    }
+
+  private:
+    static constexpr std::uint64_t COORDINATE_MASK = (std::uint64_t{1} << COORDINATE_BITS) - 1U;
+
+    float inverse_voxel_size_;
+
+    // Open-addressing hash table with linear probing, slots hold voxel indices
+    std::size_t slot_mask_;
+    std::uint32_t slot_shift_;
+    std::vector<std::uint32_t> slot_voxels_;
+
+    // Packed coordinates and hash table slot of each occupied voxel, in the order of occupation
+    std::vector<std::uint64_t> voxel_keys_;
+    std::vector<std::uint32_t> voxel_slots_;
+
+    // Points in the order of staging, and their voxel indices
+    std::vector<VoxelGridPoint> staged_points_;
+    std::vector<std::uint32_t> staged_voxel_indices_;
+
+    // Voxel v occupies range [voxel_offsets_[v], voxel_offsets_[v + 1]) of the points, holds counts before build()
+    std::vector<std::uint32_t> voxel_offsets_;
+
+    // Next write position of each voxel during scatter
+    std::vector<std::uint32_t> voxel_cursors_;
+
+    // Embedded points, grouped by voxel
+    std::vector<VoxelGridPoint> points_;
+
+    /// @brief Uses the smallest part of the hash table with a load factor below one half for the number of points.
+    void resizeSlots(std::size_t number_of_points) noexcept;
+
+    static inline std::uint64_t packKey(const VoxelCoordinates &coordinates) noexcept
+    {
+        const auto pack = [](const std::int32_t coordinate) noexcept {
+            return static_cast<std::uint64_t>(coordinate + COORDINATE_BIAS) & COORDINATE_MASK;
+        };
+        return (pack(coordinates.x) << (2U * COORDINATE_BITS)) | (pack(coordinates.y) << COORDINATE_BITS) |
+               pack(coordinates.z);
+    }
+
+    inline std::uint32_t findKey(const std::uint64_t key) const noexcept
+    {
+        for (std::size_t slot = slotOf(key);; slot = (slot + 1U) & slot_mask_)
+        {
+            const std::uint32_t voxel_index = slot_voxels_[slot];
+            if ((voxel_index == INVALID_VOXEL) || (voxel_keys_[voxel_index] == key))
+            {
+                return voxel_index;
+            }
+        }
+    }
+
+    // Fibonacci hashing, the high bits of the product are well mixed
+    inline std::size_t slotOf(const std::uint64_t key) const noexcept
+    {
+        return static_cast<std::size_t>((key * 0x9E3779B97F4A7C15ULL) >> slot_shift_);
+    }
+};
+} // namespace lidar_processing_lib::clustering
+
+#endif // LIDAR_PROCESSING_LIB__CLUSTERING__VOXEL_HASH_GRID_HPP
@@ -0,0 +1,106 @@
+#ifndef LIDAR_PROCESSING_LIB__FILTERING__CONVEX_QUAD_CROP_HPP
+#define LIDAR_PROCESSING_LIB__FILTERING__CONVEX_QUAD_CROP_HPP
+
+#include <array>                               // std::array
+#include <cstddef>                             // std::size_t
+#include <cstdint>                             // std::uint32_t
+#include <data_types_lib/point_cloud_view.hpp> // PointCloudView
+#include <limits>                              // std::numeric_limits
+#include <memory>                              // std::unique_ptr
+
+namespace lidar_processing_lib::filtering
+{
+// Corner of the cropped quadrilateral in the XY plane of the sensor
+struct QuadCorner final
+{
+    float x;
+    float y;
+};
+
+/// @brief Indices of the points kept by a crop. The storage is not initialized and only grows, the crop writes its
+/// indices through it and tracks their number separately, so no part of it is written again when a frame has fewer
+/// kept points than the storage holds.
+class CropIndices final
+{
+  public:
+    /// @brief Makes room for capacity indices, current indices are discarded when the storage grows.
+    inline void reserve(const std::size_t capacity)
+    {
+        if (capacity > capacity_)
+        {
+            // Default initialization leaves the indices uninitialized
+            storage_.reset(new std::uint32_t[capacity]);
+            capacity_ = capacity;
+            size_ = 0U;
+        }
+    }
+
+    inline const std::uint32_t *data() const noexcept
+    {
+        return storage_.get();
+    }
+
+    inline std::size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    inline std::size_t capacity() const noexcept
+    {
+        return capacity_;
+    }
+
+    inline std::uint32_t operator[](const std::size_t i) const noexcept
+    {
+        return storage_[i];
+    }
+
+  private:
+    friend class ConvexQuadCrop;
+
+    std::unique_ptr<std::uint32_t[]> storage_;
+    std::size_t capacity_ = 0U;
+    std::size_t size_ = 0U;
+};
+
+/// @brief Returns the name of the instruction set selected at compile time ("avx2", "sse2", "neon" or "scalar").
+const char *convexQuadCropInstructionSet() noexcept;
+
+/// @brief Crops the points inside a convex quadrilateral (e.g. the returns of the ego vehicle) and the points beyond a
+/// horizontal distance (the far field) off a cloud. The cloud is decoded in blocks of vector width straight from its
+/// buffer and the blocks are tested in SIMD, so the points are read once and never copied. The result is the index
+/// map of the kept points, viewed by an indexed PointCloudView for the later stages.
+class ConvexQuadCrop final
+{
+  public:
+    static constexpr std::size_t NUMBER_OF_CORNERS = 4U;
+
+    static constexpr float DEFAULT_MAX_DISTANCE_M = std::numeric_limits<float>::infinity();
+
+    /// @brief Constructor.
+    /// @param corners - Corners of a convex quadrilateral in either winding order, points inside or on its edges are
+    /// removed.
+    /// @param max_distance - Points with a larger horizontal distance from the sensor are removed.
+    explicit ConvexQuadCrop(const std::array<QuadCorner, NUMBER_OF_CORNERS> &corners,
+                            float max_distance = DEFAULT_MAX_DISTANCE_M);
+
+    /// @brief Finds the kept points of the cloud, points with non-finite x or y are removed as well.
+    /// @param kept_indices - Output indices of the kept points in increasing order, the map back to the cloud. Grows
+    /// only for a cloud larger than its capacity.
+    void run(const data_types_lib::PointCloudView &cloud, CropIndices &kept_indices) const;
+
+  private:
+    // Edge line a * x + b * y + c, non-negative on the inner side of the edge
+    struct EdgeLine final
+    {
+        float a;
+        float b;
+        float c;
+    };
+
+    std::array<EdgeLine, NUMBER_OF_CORNERS> edges_;
+    float squared_max_distance_;
+};
+} // namespace lidar_processing_lib::filtering
+
+#endif // LIDAR_PROCESSING_LIB__FILTERING__CONVEX_QUAD_CROP_HPP
@@ -0,0 +1,22 @@
+#ifndef LIDAR_PROCESSING_LIB__FILTERING__POINT_CLOUD_INGEST_HPP
+#define LIDAR_PROCESSING_LIB__FILTERING__POINT_CLOUD_INGEST_HPP
+
+#include <cstddef>                             // std::size_t
+#include <cstdint>                             // std::uint32_t
+#include <data_types_lib/point_cloud_soa.hpp>  // PointCloudSoA
+#include <data_types_lib/point_cloud_view.hpp> // PointCloudView
+
+namespace lidar_processing_lib::filtering
+{
+/// @brief Decodes the points of a view into a structure-of-arrays cloud and derives range, horizontal range and
+/// azimuth (by atan2Approx) once for all the later stages. Replaces the previous contents of the cloud.
+void ingestPointCloud(const data_types_lib::PointCloudView &cloud, data_types_lib::PointCloudSoA &soa_cloud);
+
+/// @brief Copies the selected points of a structure-of-arrays cloud together with their derived channels, nothing is
+/// recomputed. Replaces the previous contents of the selected cloud.
+/// @param indices - Indices of the selected points in the cloud, in the order of the selected cloud.
+void selectPoints(const data_types_lib::PointCloudSoA &cloud, const std::uint32_t *indices,
+                  std::size_t number_of_indices, data_types_lib::PointCloudSoA &selected_cloud);
+} // namespace lidar_processing_lib::filtering
+
+#endif // LIDAR_PROCESSING_LIB__FILTERING__POINT_CLOUD_INGEST_HPP
@@ -0,0 +1,32 @@
+#ifndef LIDAR_PROCESSING_LIB__FUSION__CAMERA_CALIBRATION_HPP
+#define LIDAR_PROCESSING_LIB__FUSION__CAMERA_CALIBRATION_HPP
+
+#include <cstdint>            // std::uint32_t
+#include <eigen3/Eigen/Dense> // Eigen::Matrix
+#include <filesystem>         // std::filesystem
+
+namespace lidar_processing_lib::fusion
+{
+/// @brief Projection of lidar points into the image of a camera. The extrinsics and intrinsics are composed once into
+/// a single matrix, so a point is projected into homogeneous pixel coordinates by one 3x4 product.
+struct CameraCalibration final
+{
+    // Lidar point (x, y, z, 1) to homogeneous pixel (u * w, v * w, w), w is the depth along the optical axis
+    Eigen::Matrix<float, 3, 4, Eigen::RowMajor> lidar_to_image;
+
+    // Size of the rectified image in pixels
+    std::uint32_t width;
+    std::uint32_t height;
+};
+
+/// @brief Loads the calibration of a camera of a Kitti raw drive, the lidar to image projection is
+/// P_rect_0i * R_rect_00 * [R | T]_velo_to_cam.
+/// @param calibration_path - Folder of calib_cam_to_cam.txt and calib_velo_to_cam.txt (e.g. 2011_09_26).
+/// @param camera_index - Kitti camera i of the image_0i folder, 0 and 1 are the grayscale and 2 and 3 the colour
+/// cameras.
+/// @throws std::runtime_error if a file can not be read or lacks a matrix of the camera.
+CameraCalibration loadKittiCameraCalibration(const std::filesystem::path &calibration_path,
+                                             std::uint32_t camera_index);
+} // namespace lidar_processing_lib::fusion
+
+#endif // LIDAR_PROCESSING_LIB__FUSION__CAMERA_CALIBRATION_HPP
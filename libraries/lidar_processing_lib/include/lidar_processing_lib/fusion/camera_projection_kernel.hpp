@@ -0,0 +1,31 @@
+#ifndef LIDAR_PROCESSING_LIB__FUSION__CAMERA_PROJECTION_KERNEL_HPP
+#define LIDAR_PROCESSING_LIB__FUSION__CAMERA_PROJECTION_KERNEL_HPP
+
+#include "camera_calibration.hpp" // CameraCalibration
+#include <cstddef>                // std::size_t
+#include <cstdint>                // std::uint32_t
+
+namespace lidar_processing_lib::fusion
+{
+// Pixel of a point that is not seen by the camera, never a packed pixel as rows and columns are below 0xFFFF
+static constexpr std::uint32_t INVALID_PIXEL = 0xFFFFFFFFU;
+
+/// @brief Packs the pixel of a projected point as (row << 16) | column.
+constexpr inline std::uint32_t packPixel(const std::uint32_t row, const std::uint32_t column) noexcept
+{
+    return (row << 16U) | column;
+}
+
+/// @brief Returns the name of the instruction set selected at compile time ("avx2", "sse2", "neon" or "scalar").
+const char *cameraProjectionKernelInstructionSet() noexcept;
+
+/// @brief Projects points into the image of a camera, several points at a time straight from the structure-of-arrays
+/// channels. Points behind the camera, nearer than min_depth or projected outside of the image are not seen.
+/// @param x, y, z - Structure-of-arrays point coordinates in the lidar frame, each of number_of_points elements.
+/// @param min_depth - Points nearer to the camera along its optical axis are not seen, in meters.
+/// @param pixels - Output packed pixel of each point, INVALID_PIXEL for points not seen by the camera.
+void projectToPixels(const float *x, const float *y, const float *z, std::size_t number_of_points,
+                     const CameraCalibration &calibration, float min_depth, std::uint32_t *pixels) noexcept;
+} // namespace lidar_processing_lib::fusion
+
+#endif // LIDAR_PROCESSING_LIB__FUSION__CAMERA_PROJECTION_KERNEL_HPP
@@ -0,0 +1,102 @@
+#ifndef LIDAR_PROCESSING_LIB__FUSION__POINT_CLOUD_COLORIZER_HPP
+#define LIDAR_PROCESSING_LIB__FUSION__POINT_CLOUD_COLORIZER_HPP
+
+#include "camera_calibration.hpp"             // CameraCalibration
+#include <cstddef>                            // std::size_t
+#include <cstdint>                            // std::uint8_t, std::uint32_t
+#include <data_types_lib/point_cloud_soa.hpp> // PointCloudSoA
+#include <memory>                             // std::unique_ptr
+#include <utilities_lib/thread_pool.hpp>      // ThreadPool
+#include <vector>                             // std::vector
+
+namespace lidar_processing_lib::fusion
+{
+// Channel order of the 8-bit, 3-channel images
+enum class ImageEncoding : std::uint8_t
+{
+    BGR8,
+    RGB8
+};
+
+/// @brief Non-owning view of a camera image, e.g. of the data of a sensor_msgs::msg::Image.
+struct CameraImageView final
+{
+    // nullptr when no image of the camera is available for the cloud
+    const std::uint8_t *data = nullptr;
+
+    std::uint32_t width = 0U;
+    std::uint32_t height = 0U;
+
+    // Bytes per image row, at least 3 * width
+    std::uint32_t row_step = 0U;
+
+    ImageEncoding encoding = ImageEncoding::BGR8;
+};
+
+/// @brief Colours lidar points with the pixels of the cameras they are projected into. The cameras are processed in
+/// parallel, each projects the whole cloud with its precomputed lidar to image matrix and looks up the colours of the
+/// seen points into its own buffer. A point seen by several cameras is coloured by the first of them, the cameras
+/// are given in order of priority.
+class PointCloudColorizer final
+{
+  public:
+    // Camera of the points not seen by any camera
+    static constexpr std::uint8_t NO_CAMERA = 0xFFU;
+
+    // Colour of the points not seen by any camera
+    static constexpr std::uint32_t NO_COLOUR = 0U;
+
+    // Points nearer to the camera along its optical axis are not coloured, in meters
+    static constexpr float DEFAULT_MIN_DEPTH = 0.5F;
+
+    /// @brief Deleted default constructor.
+    PointCloudColorizer() = delete;
+
+    /// @brief Non-default constructor.
+    /// @param calibrations - Calibration of each camera, in order of priority.
+    /// @param thread_count - Number of cameras processed at the same time, 0 and 1 process them on the calling
+    /// thread.
+    /// @throws std::runtime_error if there are no cameras or more than NO_CAMERA of them.
+    explicit PointCloudColorizer(std::vector<CameraCalibration> calibrations, std::uint32_t thread_count = 1U,
+                                 float min_depth = DEFAULT_MIN_DEPTH);
+
+    ~PointCloudColorizer();
+
+    // Copy and move operations are not allowed.
+    PointCloudColorizer(const PointCloudColorizer &) = delete;
+    PointCloudColorizer(PointCloudColorizer &&) = delete;
+    PointCloudColorizer &operator=(const PointCloudColorizer &) = delete;
+    PointCloudColorizer &operator=(PointCloudColorizer &&) = delete;
+
+    /// @brief Colours the points of the cloud.
+    /// @param images - Image of each camera, cameras without an image or with an image of another size than their
+    /// calibration are skipped.
+    /// @param rgb - Output colour of each point as 0x00RRGGBB, NO_COLOUR for the points not seen by any camera.
+    /// @param cameras - Output index of the camera colouring each point, NO_CAMERA for the points not seen.
+    /// @throws std::runtime_error if the number of images differs from the number of cameras.
+    void run(const data_types_lib::PointCloudSoA &cloud, const std::vector<CameraImageView> &images,
+             std::vector<std::uint32_t> &rgb, std::vector<std::uint8_t> &cameras);
+
+    /// @brief Get the number of cameras.
+    inline std::size_t numberOfCameras() const noexcept
+    {
+        return calibrations_.size();
+    }
+
+  private:
+    std::vector<CameraCalibration> calibrations_;
+    float min_depth_;
+
+    // Packed pixels of the cloud in each camera, overwritten in place by their colours
+    std::vector<std::vector<std::uint32_t>> camera_colours_;
+
+    std::unique_ptr<utilities_lib::ThreadPool> thread_pool_;
+
+    /// @brief Projects the cloud into a camera and looks up the colours of the seen points, INVALID_PIXEL for the
+    /// others.
+    void colourCamera(const data_types_lib::PointCloudSoA &cloud, std::size_t camera_index,
+                      const CameraImageView &image);
+};
+} // namespace lidar_processing_lib::fusion
+
+#endif // LIDAR_PROCESSING_LIB__FUSION__POINT_CLOUD_COLORIZER_HPP
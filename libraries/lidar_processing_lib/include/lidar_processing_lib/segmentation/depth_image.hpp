@@ -0,0 +1,340 @@
+#ifndef LIDAR_PROCESSING_LIB__SEGMENTATION__DEPTH_IMAGE_HPP
+#define LIDAR_PROCESSING_LIB__SEGMENTATION__DEPTH_IMAGE_HPP
+
+#include "point_channels.hpp"     // pointRange, pointHorizontalRange, pointAzimuth
+#include "sensor_profile.hpp"     // SensorProfile, StaticProjection, RuntimeProjection
+#include <cmath>                  // std::atan2
+#include <cstdint>                // std::uint32_t
+#include <limits>                 // std::numeric_limits
+#include <stdexcept>              // std::runtime_error
+#include <vector>                 // std::vector
+
+namespace lidar_processing_lib::segmentation
+{
+/// @brief Spherical projection of a point cloud, each pixel keeps the closest point projected into it.
+/// The image is built once per frame and can be shared by the processing stages working on the organized cloud.
+/// Only the pixels filled by the previous frame are reset, so building the image scales with the number of points.
+/// The image is sized once at construction by the sensor profile. Profiles of the sensors known at compile time
+/// (VelodyneHdl64e, VelodyneVlp32c, OusterOs1_128) are projected with compile-time dimensions and elevation tables,
+/// other profiles fall back to a runtime projection.
+class DepthImage final
+{
+  public:
+    /// @brief Projection of the points into pixels.
+    enum class ProjectionMode : std::uint8_t
+    {
+        // Exact azimuth and elevation by std::atan2
+        EXACT,
+
+        // Approximate azimuth by atan2Approx, row by the elevation table of the sensor, single square root
+        LOOKUP_TABLE
+    };
+
+    struct Pixel
+    {
+        // This pixel does not map to point cloud
+        static constexpr auto INVALID_INDEX = std::numeric_limits<std::uint32_t>::max();
+
+        float range = std::numeric_limits<float>::max();
+        std::uint32_t index = INVALID_INDEX; // index of the point cloud
+        std::uint8_t r = 0U;
+        std::uint8_t g = 0U;
+        std::uint8_t b = 0U;
+
+        inline void reset() noexcept
+        {
+            range = std::numeric_limits<float>::max();
+            index = INVALID_INDEX;
+            r = 0U;
+            g = 0U;
+            b = 0U;
+        }
+    };
+
+    // Point is not projected into the image
+    static constexpr auto INVALID_PIXEL = std::numeric_limits<std::uint32_t>::max();
+
+    // Range limits of the projected points
+    static constexpr float DEFAULT_MIN_RANGE_M = 0.0F;
+    static constexpr float DEFAULT_MAX_RANGE_M = 80.0F;
+
+    /// @brief Constructor.
+    /// @param profile - Geometry of the sensor, sizes the image.
+    /// @param min_range - Points closer to the sensor are not projected.
+    /// @param max_range - Points farther from the sensor are not projected.
+    /// @param projection_mode - Projection of the points into pixels.
+    explicit DepthImage(const SensorProfile &profile = VelodyneHdl64e::PROFILE, float min_range = DEFAULT_MIN_RANGE_M,
+                        float max_range = DEFAULT_MAX_RANGE_M,
+                        ProjectionMode projection_mode = ProjectionMode::LOOKUP_TABLE);
+
+    /// @brief Projects the point cloud, replaces the previous contents of the image.
+    template <typename CloudT> void build(const CloudT &cloud);
+
+    /// @brief Scatters the point cloud into the pixels supplied by the driver (ring and column of each point), no
+    /// trigonometry is evaluated. Points with a row or column out of the image are not projected.
+    /// @param rows - Row of each point of the cloud.
+    /// @param columns - Column of each point of the cloud.
+    template <typename CloudT, typename IndexT>
+    void build(const CloudT &cloud, const std::vector<IndexT> &rows, const std::vector<IndexT> &columns);
+
+    inline std::uint32_t rowMajorIndex(const std::uint32_t x, const std::uint32_t y) const noexcept
+    {
+        return (y * width_ + x);
+    }
+
+    inline const SensorProfile &profile() const noexcept
+    {
+        return profile_;
+    }
+
+    inline std::uint32_t width() const noexcept
+    {
+        return width_;
+    }
+
+    inline std::uint32_t height() const noexcept
+    {
+        return height_;
+    }
+
+    inline float minRange() const noexcept
+    {
+        return min_range_;
+    }
+
+    inline float maxRange() const noexcept
+    {
+        return max_range_;
+    }
+
+    inline ProjectionMode projectionMode() const noexcept
+    {
+        return projection_mode_;
+    }
+
+    inline const Pixel &pixel(const std::uint32_t x, const std::uint32_t y) const noexcept
+    {
+        return pixels_[rowMajorIndex(x, y)];
+    }
+
+    /// @brief Pixels in row major order [width x height].
+    inline const std::vector<Pixel> &pixels() const noexcept
+    {
+        return pixels_;
+    }
+
+    /// @brief Row major index of the pixel each point of the last built cloud is projected into, or INVALID_PIXEL.
+    /// Several points can share a pixel, the pixel keeps the index of the closest of them.
+    inline const std::vector<std::uint32_t> &pointPixels() const noexcept
+    {
+        return point_pixels_;
+    }
+
+    /// @brief Row major indices of the pixels holding a point, in the order they were filled.
+    inline const std::vector<std::uint32_t> &validPixels() const noexcept
+    {
+        return valid_pixels_;
+    }
+
+    /// @brief Number of pixels holding a point.
+    inline std::uint32_t numberOfValidPixels() const noexcept
+    {
+        return static_cast<std::uint32_t>(valid_pixels_.size());
+    }
+
+  private:
+    // Sensor profile projected with compile-time dimensions
+    enum class StaticProfile : std::uint8_t
+    {
+        VELODYNE_HDL_64E,
+        VELODYNE_VLP_32C,
+        OUSTER_OS1_128,
+        NONE
+    };
+
+    SensorProfile profile_;
+    std::uint32_t width_;
+    std::uint32_t height_;
+    StaticProfile static_profile_;
+    RuntimeProjection runtime_projection_;
+
+    float min_range_;
+    float max_range_;
+    ProjectionMode projection_mode_;
+
+    // Range image - contiguous in memory, index mapping [width x height] - row major order
+    std::vector<Pixel> pixels_;
+    std::vector<std::uint32_t> point_pixels_;
+    std::vector<std::uint32_t> valid_pixels_;
+
+    /// @brief Resets the pixels filled by the previous frame and prepares the point pixels of the next one.
+    void reset(std::size_t number_of_points);
+
+    template <typename CloudT> void projectExact(const CloudT &cloud);
+
+    /// @brief Single square root per point, azimuth by atan2Approx and row by the projection policy.
+    template <typename CloudT, typename ProjectionT>
+    void projectLookupTable(const CloudT &cloud, const ProjectionT &projection);
+
+    /// @brief Assigns the point to the pixel, the pixel keeps the closest of its points.
+    inline void scatter(const std::uint32_t point_index, const float range, const std::uint32_t pixel_index) noexcept
+    {
+        point_pixels_[point_index] = pixel_index;
+
+        auto &pixel = pixels_[pixel_index];
+        if (pixel.index == Pixel::INVALID_INDEX)
+        {
+            valid_pixels_.push_back(pixel_index);
+        }
+
+        if (range < pixel.range)
+        {
+            pixel.range = range;
+            pixel.index = point_index;
+            pixel.r = 0;
+            pixel.g = 255;
+            pixel.b = 0;
+        }
+    }
+
+    /// @brief Column of the azimuth, zero azimuth maps to the center of the image width. Width when out of the image.
+    static inline std::uint32_t column(const float azimuth_rad, const std::uint32_t width) noexcept
+    {
+        const auto x = static_cast<std::int32_t>(((azimuth_rad / M_PIf32) * 0.5F + 0.5F) * width);
+        return ((x < 0) || (x > static_cast<std::int32_t>(width - 1))) ? width : static_cast<std::uint32_t>(x);
+    }
+};
+
+template <typename CloudT> void DepthImage::build(const CloudT &cloud)
+{
+    reset(cloud.points.size());
+
+    if (projection_mode_ == ProjectionMode::EXACT)
+    {
+        projectExact(cloud);
+        return;
+    }
+
+    // Dispatched once per frame, the hot loop is instantiated per sensor known at compile time
+    switch (static_profile_)
+    {
+    case StaticProfile::VELODYNE_HDL_64E:
+        projectLookupTable(cloud, StaticProjection<VelodyneHdl64e>{});
+        break;
+    case StaticProfile::VELODYNE_VLP_32C:
+        projectLookupTable(cloud, StaticProjection<VelodyneVlp32c>{});
+        break;
+    case StaticProfile::OUSTER_OS1_128:
+        projectLookupTable(cloud, StaticProjection<OusterOs1_128>{});
+        break;
+    default:
+        projectLookupTable(cloud, runtime_projection_);
+        break;
+    }
+}
+
+template <typename CloudT, typename IndexT>
+void DepthImage::build(const CloudT &cloud, const std::vector<IndexT> &rows, const std::vector<IndexT> &columns)
+{
+    if ((rows.size() != cloud.points.size()) || (columns.size() != cloud.points.size()))
+    {
+        throw std::runtime_error("Rows and columns of DepthImage must be given for every point of the cloud!");
+    }
+
+    reset(cloud.points.size());
+
+    for (std::uint32_t i = 0U; i < cloud.points.size(); ++i)
+    {
+        const auto &point = cloud.points[i];
+        const float range = pointRange(cloud, i, point);
+
+        // Negated comparisons skip NaN ranges as well
+        if (!((range >= min_range_) && (range <= max_range_)))
+        {
+            continue;
+        }
+
+        const auto x = static_cast<std::uint32_t>(columns[i]);
+        const auto y = static_cast<std::uint32_t>(rows[i]);
+        if ((x < width_) && (y < height_))
+        {
+            scatter(i, range, rowMajorIndex(x, y));
+        }
+    }
+}
+
+template <typename CloudT> void DepthImage::projectExact(const CloudT &cloud)
+{
+    const float min_elevation_rad = profile_.minElevationRad();
+    const float max_elevation_rad = profile_.maxElevationRad();
+    const float elevation_mid_rad = (min_elevation_rad + max_elevation_rad) / 2.0F;
+
+    // Fill range image with point cloud points
+    for (std::uint32_t i = 0U; i < cloud.points.size(); ++i)
+    {
+        const auto &point = cloud.points[i];
+
+        const float range = pointRange(cloud, i, point);
+
+        if (!((range >= min_range_) && (range <= max_range_)))
+        {
+            continue; // Skip points out of range
+        }
+
+        const float azimuth_rad = std::atan2(point.y, point.x);
+        const float elevation_rad = std::atan2(point.z, pointHorizontalRange(cloud, i, point));
+
+        // Convention: (0, 0) coordinate of the image located at the top left corner
+        const std::uint32_t x = column(azimuth_rad, width_);
+        if (x == width_)
+        {
+            continue;
+        }
+
+        // Adjust elevation to map zero elevation to the center of the image height
+        const auto y = static_cast<std::int32_t>(
+            ((elevation_rad - elevation_mid_rad) / (max_elevation_rad - min_elevation_rad) + 0.5F) * height_);
+
+        // Ensure y is within the valid range
+        if ((y < 0) || (y > static_cast<std::int32_t>(height_ - 1)))
+        {
+            continue;
+        }
+
+        scatter(i, range, rowMajorIndex(x, static_cast<std::uint32_t>(y)));
+    }
+}
+
+template <typename CloudT, typename ProjectionT>
+void DepthImage::projectLookupTable(const CloudT &cloud, const ProjectionT &projection)
+{
+    for (std::uint32_t i = 0U; i < cloud.points.size(); ++i)
+    {
+        const auto &point = cloud.points[i];
+        const float range = pointRange(cloud, i, point);
+
+        // Points at the origin have no direction
+        if (!((range >= min_range_) && (range <= max_range_) && (range > 0.0F)))
+        {
+            continue;
+        }
+
+        const std::uint32_t y = projection.row(point.z, range);
+        if (y == ProjectionT::INVALID_ROW)
+        {
+            continue;
+        }
+
+        const std::uint32_t width = projection.width();
+        const std::uint32_t x = column(pointAzimuth(cloud, i, point), width);
+        if (x == width)
+        {
+            continue;
+        }
+
+        scatter(i, range, (y * width) + x);
+    }
+}
+} // namespace lidar_processing_lib::segmentation
+
+#endif // LIDAR_PROCESSING_LIB__SEGMENTATION__DEPTH_IMAGE_HPP
@@ -1,14 +1,20 @@
 #ifndef LIDAR_PROCESSING_LIB__SEGMENTATION__DEPTH_IMAGE_SEGMENTER_HPP
 #define LIDAR_PROCESSING_LIB__SEGMENTATION__DEPTH_IMAGE_SEGMENTER_HPP
 
-#include "i_segmenter.hpp"        // ISegmenter
-#include <array>                  // std::array
-#include <chrono>                 // std::chrono
-#include <cstdint>                // std::uint32_t
-#include <eigen3/Eigen/Dense>     // Eigen::
-#include <limits>                 // std::numeric_limits
-#include <utilities_lib/math.hpp> // constexprRound
-#include <vector>                 // std::vector
+#include "depth_image.hpp"            // DepthImage
+#include "i_segmenter.hpp"            // ISegmenter
+#include "point_channels.hpp"         // pointHorizontalRange, pointAzimuth
+#include "temporal_ground_model.hpp"  // TemporalGroundConfiguration, TemporalGroundStatistics
+#include <algorithm>                  // std::min
+#include <array>                      // std::array
+#include <cmath>                      // std::sqrt, std::isfinite
+#include <cstdint>                    // std::uint32_t
+#include <eigen3/Eigen/Dense>         // Eigen::
+#include <eigen3/Eigen/Geometry>      // Eigen::Isometry3f
+#include <limits>                     // std::numeric_limits
+#include <memory>                     // std::shared_ptr
+#include <utilities_lib/profiler.hpp> // UTILITIES_PROFILE_ZONE
+#include <vector>                     // std::vector
 
 namespace lidar_processing_lib::segmentation
 {
@@ -24,52 +30,7 @@ class DepthImageSegmenter : public ISegmenter
   public:
     using SegmentationLabel = data_types_lib::SegmentationLabel;
 
-    struct RangeImagePixel
-    {
-        // This pixel does not map to point cloud
-        static constexpr auto INVALID_INDEX = std::numeric_limits<std::uint32_t>::max();
-
-        float range = std::numeric_limits<float>::max();
-        std::uint32_t index = INVALID_INDEX; // index of the point cloud
-        std::uint8_t r = 0U;
-        std::uint8_t g = 0U;
-        std::uint8_t b = 0U;
-
-        inline void reset() noexcept
-        {
-            range = std::numeric_limits<float>::max();
-            index = INVALID_INDEX;
-            r = 0U;
-            g = 0U;
-            b = 0U;
-        }
-    };
-
-    // Values acceptable for Velodyne HDL-64E (tightest values)
-    static constexpr float DEG_TO_RAD = static_cast<float>(M_PI / 180.0F);
-
-    static constexpr float VERTICAL_RESOLUTION_DEG = 0.33F;
-    static constexpr float VERTICAL_RESOLUTION_RAD = VERTICAL_RESOLUTION_DEG * DEG_TO_RAD;
-    static constexpr float VERTICAL_FIELD_OF_VIEW_DEG = 26.9F;
-    static constexpr float VERTICAL_FIELD_OF_VIEW_RAD = VERTICAL_FIELD_OF_VIEW_DEG * DEG_TO_RAD;
-
-    static constexpr float MIN_ELEVATION_DEG = -24.8;
-    static constexpr float MIN_ELEVATION_RAD = MIN_ELEVATION_DEG * DEG_TO_RAD;
-    static constexpr float MAX_ELEVATION_DEG = MIN_ELEVATION_DEG + VERTICAL_FIELD_OF_VIEW_DEG;
-    static constexpr float MAX_ELEVATION_RAD = MAX_ELEVATION_DEG * DEG_TO_RAD;
-
-    static constexpr float HORIZONTAL_RESOLUTION_DEG = 0.1F;
-    static constexpr float HORIZONTAL_RESOLUTION_RAD = HORIZONTAL_RESOLUTION_DEG * DEG_TO_RAD;
-    static constexpr float HORIZONTAL_FIELD_OF_VIEW_DEG = 360.0F;
-    static constexpr float HORIZONTAL_FIELD_OF_VIEW_RAD = HORIZONTAL_FIELD_OF_VIEW_DEG * DEG_TO_RAD;
-
-    // width ~= 3600
-    static constexpr auto DEPTH_IMAGE_WIDTH =
-        static_cast<std::uint32_t>(std::ceil(HORIZONTAL_FIELD_OF_VIEW_DEG / HORIZONTAL_RESOLUTION_DEG));
-
-    // height ~= 82
-    static constexpr auto DEPTH_IMAGE_HEIGHT =
-        static_cast<std::uint32_t>(std::ceil(VERTICAL_FIELD_OF_VIEW_DEG / VERTICAL_RESOLUTION_DEG));
+    using RangeImagePixel = DepthImage::Pixel;
 
     // Elevation map parameters
     static constexpr float MIN_DISTANCE_M = 0.0F;
@@ -81,64 +42,87 @@ class DepthImageSegmenter : public ISegmenter
 
     static constexpr std::uint32_t NUMBER_OF_CHANNELS_IN_RING_ELEVATION_CONJUNCTION_MAP = 24U;
 
-    static constexpr std::uint32_t MAX_CLOUD_POINTS = 350000U;
+    static constexpr std::uint32_t NUMBER_OF_CELLS_IN_RING_ELEVATION_CONJUNCTION_MAP =
+        NUMBER_OF_RINGS_IN_RING_ELEVATION_CONJUNCTION_MAP * NUMBER_OF_CHANNELS_IN_RING_ELEVATION_CONJUNCTION_MAP;
+
+    // Point is out of the ring elevation map
+    static constexpr std::uint32_t INVALID_CELL = std::numeric_limits<std::uint32_t>::max();
+
+    // Cell has no ground elevation in the temporal ground model
+    static constexpr std::uint32_t INVALID_AGE = std::numeric_limits<std::uint32_t>::max();
 
-    static constexpr auto MAX_POINTS_PER_CELL_RING_ELEVATION_CONJUNCTION_MAP = static_cast<std::uint32_t>(
-        std::ceil(static_cast<float>(MAX_CLOUD_POINTS) / (NUMBER_OF_RINGS_IN_RING_ELEVATION_CONJUNCTION_MAP *
-                                                          NUMBER_OF_CHANNELS_IN_RING_ELEVATION_CONJUNCTION_MAP)));
+    /// @brief Constructor.
+    /// @param min_range - Points closer to the sensor are not projected into the depth image.
+    /// @param max_range - Points farther from the sensor are not projected into the depth image.
+    /// @param profile - Geometry of the sensor, sizes the depth image and the point buffers.
+    /// @param temporal_configuration - Incremental mode, the ground elevation of every cell is kept across frames.
+    DepthImageSegmenter(float min_range = MIN_DISTANCE_M, float max_range = MAX_DISTANCE_M,
+                        const SensorProfile &profile = VelodyneHdl64e::PROFILE,
+                        const TemporalGroundConfiguration &temporal_configuration = TemporalGroundConfiguration{});
+
+    /// @brief Constructor, the depth image is shared with other stages consuming it (e.g. RangeImageClusterer).
+    /// @param depth_image - Rebuilt from every segmented cloud, its range limits are used for the projection.
+    /// @param temporal_configuration - Incremental mode, the ground elevation of every cell is kept across frames.
+    explicit DepthImageSegmenter(
+        std::shared_ptr<DepthImage> depth_image,
+        const TemporalGroundConfiguration &temporal_configuration = TemporalGroundConfiguration{});
 
-    DepthImageSegmenter(float min_range = MIN_DISTANCE_M, float max_range = MAX_DISTANCE_M);
     ~DepthImageSegmenter();
 
+    /// @brief Depth image of the last segmented cloud.
+    inline const std::shared_ptr<DepthImage> &depthImage() const noexcept
+    {
+        return depth_image_;
+    }
+
     void run(const pcl::PointCloud<pcl::PointXYZ> &cloud, std::vector<SegmentationLabel> &labels) override;
     void run(const pcl::PointCloud<pcl::PointXYZI> &cloud, std::vector<SegmentationLabel> &labels) override;
+    void run(const data_types_lib::PointCloudView &cloud, std::vector<SegmentationLabel> &labels) override;
+    void run(const data_types_lib::PointCloudSoA &cloud, std::vector<SegmentationLabel> &labels) override;
 
-  private:
-    float min_range_;
-    float max_range_;
+    void setEgoMotion(const Eigen::Isometry3f &previous_to_current) override;
+
+    /// @brief Reuse of the cell ground elevations in the last segmented frame.
+    inline const TemporalGroundStatistics &temporalStatistics() const noexcept
+    {
+        return temporal_statistics_;
+    }
 
+  private:
     float dH_ = 0.20F;
     float dR_ = 1.50F;
     float dM_ = 0.15F;
 
-    // For embedding into polar grid (Ring Elevation Conjunction Map)
-    struct PointXYZIL final
-    {
-        float x;
-        float y;
-        float z;
-        std::uint32_t index;
-        SegmentationLabel label;
+    // Range image, may be shared with the stages consuming the organized cloud
+    std::shared_ptr<DepthImage> depth_image_;
 
-        PointXYZIL() = default;
+    // Stores min elevation values in the ring elevation map
+    std::array<float, NUMBER_OF_CELLS_IN_RING_ELEVATION_CONJUNCTION_MAP> ring_elevation_conjunction_map_;
 
-        PointXYZIL(float x, float y, float z, std::uint32_t index, SegmentationLabel label)
-            : x(x), y(y), z(z), index(index), label(label)
-        {
-        }
-    };
+    // Temporal ground model, slope limited ground elevation of every cell and the number of frames since the ground
+    // of the cell was last observed, INVALID_AGE if the cell has no ground elevation
+    TemporalGroundConfiguration temporal_configuration_;
+    std::array<float, NUMBER_OF_CELLS_IN_RING_ELEVATION_CONJUNCTION_MAP> ground_elevations_;
+    std::array<std::uint32_t, NUMBER_OF_CELLS_IN_RING_ELEVATION_CONJUNCTION_MAP> ground_ages_;
 
-    // Range image - contiguous in memory, index mapping [width x height] - row major order
-    std::vector<RangeImagePixel> depth_image_;
+    // Ground model moved by the ego-motion, several cells may move into one
+    std::array<float, NUMBER_OF_CELLS_IN_RING_ELEVATION_CONJUNCTION_MAP> warped_ground_elevations_;
+    std::array<std::uint32_t, NUMBER_OF_CELLS_IN_RING_ELEVATION_CONJUNCTION_MAP> warped_ground_ages_;
 
-    // Stores min elevation values in the ring elevation map
-    std::array<float,
-               NUMBER_OF_RINGS_IN_RING_ELEVATION_CONJUNCTION_MAP * NUMBER_OF_CHANNELS_IN_RING_ELEVATION_CONJUNCTION_MAP>
-        ring_elevation_conjunction_map_;
+    Eigen::Isometry3f ego_motion_ = Eigen::Isometry3f::Identity();
+    bool ego_motion_pending_ = false;
 
-    std::array<std::vector<PointXYZIL>,
-               NUMBER_OF_RINGS_IN_RING_ELEVATION_CONJUNCTION_MAP * NUMBER_OF_CHANNELS_IN_RING_ELEVATION_CONJUNCTION_MAP>
-        polar_grid_;
+    TemporalGroundStatistics temporal_statistics_{};
 
-    constexpr static inline std::uint32_t rowMajorIndexDepthImage(const std::uint32_t x, const std::uint32_t y) noexcept
-    {
-        return (y * DEPTH_IMAGE_WIDTH + x);
-    }
+    // Cell of the ring elevation map and elevation of each point, points out of the map are not labelled
+    std::vector<std::uint32_t> point_cells_;
+    std::vector<float> point_elevations_;
 
+    // Rows are the rings, the channels of a ring are contiguous so the slope limit runs across them in SIMD
     constexpr static inline std::uint32_t rowMajorIndexRingElevationConjunctionMap(
         const std::uint32_t channel_index, const std::uint32_t ring_index) noexcept
     {
-        return (channel_index * NUMBER_OF_RINGS_IN_RING_ELEVATION_CONJUNCTION_MAP + ring_index);
+        return (ring_index * NUMBER_OF_CHANNELS_IN_RING_ELEVATION_CONJUNCTION_MAP + channel_index);
     }
 
     inline void resetRingElevationConjunctionMap() noexcept
@@ -149,10 +133,11 @@ class DepthImageSegmenter : public ISegmenter
         }
     }
 
-    template <typename PointT> void embedCloudIntoPolarGrid(const pcl::PointCloud<PointT> &cloud);
+    /// @brief Finds the cell of every point and the minimum elevation of every cell.
+    template <typename CloudT> void embedCloudIntoRingElevationConjunctionMap(const CloudT &cloud);
 
-    template <typename PointT>
-    void segment(const pcl::PointCloud<PointT> &cloud, std::vector<SegmentationLabel> &labels);
+    template <typename CloudT>
+    void segment(const CloudT &cloud, std::vector<SegmentationLabel> &labels);
 
     template <typename PointT> static inline float rangeSquared(const PointT &point) noexcept
     {
@@ -164,193 +149,95 @@ class DepthImageSegmenter : public ISegmenter
         return std::sqrt(rangeSquared(point));
     }
 
-    template <typename PointT> void constructDepthImage(const pcl::PointCloud<PointT> &cloud);
+    /// @brief Moves the ground model into the frame of the next cloud by the pending ego-motion.
+    void compensateEgoMotion();
+
+    /// @brief Validates the ground model against the lowest points of the cells. Confirmed cells and cells the model
+    /// does not cover take the elevation of the frame, cells without ground returns keep the elevation of the model.
+    void mergeTemporalGroundModel() noexcept;
 
-    void segmentRingElevationConjunctionMap();
+    /// @brief Limits the cell elevations by the maximum road slope and labels the embedded points.
+    void segmentRingElevationConjunctionMap(std::vector<SegmentationLabel> &labels);
 };
 
-template <typename PointT> void DepthImageSegmenter::embedCloudIntoPolarGrid(const pcl::PointCloud<PointT> &cloud)
+template <typename CloudT> void DepthImageSegmenter::embedCloudIntoRingElevationConjunctionMap(const CloudT &cloud)
 {
-    static constexpr auto CHANNEL_RESOLUTION_RAD =
-        static_cast<float>(2.0 * M_PI / NUMBER_OF_CHANNELS_IN_RING_ELEVATION_CONJUNCTION_MAP);
+    // Cell indices are found by multiplication with the inverse resolutions
+    static constexpr auto INVERSE_CHANNEL_RESOLUTION_RAD =
+        static_cast<float>(NUMBER_OF_CHANNELS_IN_RING_ELEVATION_CONJUNCTION_MAP / (2.0 * M_PI));
+    static constexpr auto INVERSE_RING_SPACING_M = 1.0F / RING_SPACING_M;
 
-    // Clear old slices
-    for (auto &slice : polar_grid_)
-    {
-        slice.clear();
-    }
+    resetRingElevationConjunctionMap();
+    point_cells_.resize(cloud.points.size());
+    point_elevations_.resize(cloud.points.size());
 
-    // Embed points into each channel
+    // Record the cell of each point and the lowest elevation of each cell
     for (std::uint32_t i = 0U; i < cloud.points.size(); ++i)
     {
         const auto &point = cloud.points[i];
 
         // Calculate distance from sensor
-        const float distance = std::sqrt((point.x * point.x) + (point.y * point.y));
-
-        if ((distance > MIN_DISTANCE_M) && (distance <= MAX_DISTANCE_M))
-        {
-            // Convert azimuth angle to degrees and shift range to [0, 360) OR [0, 2 * PI]
-            float azimuth_rad = utilities_lib::atan2Approx(point.y, point.x);
-
-            // Adjust to range [0, 2 * pi]
-            if (azimuth_rad < 0)
-            {
-                azimuth_rad += static_cast<float>(2.0 * M_PI);
-            }
-
-            // Determine channel index using floor division
-            const std::uint32_t channel_index =
-                std::min(static_cast<std::uint32_t>(azimuth_rad / CHANNEL_RESOLUTION_RAD),
-                         (NUMBER_OF_CHANNELS_IN_RING_ELEVATION_CONJUNCTION_MAP - 1U));
-
-            // Determine ring index
-            const std::uint32_t ring_index =
-                std::min(static_cast<std::uint32_t>((distance - MIN_DISTANCE_M) / RING_SPACING_M),
-                         (NUMBER_OF_RINGS_IN_RING_ELEVATION_CONJUNCTION_MAP - 1U));
-
-            // Embed point into polar grid channel and bin (ring)
-            polar_grid_[rowMajorIndexRingElevationConjunctionMap(channel_index, ring_index)].emplace_back(
-                point.x, point.y, point.z, i, SegmentationLabel::UNKNOWN);
-        }
-    }
+        const float distance = pointHorizontalRange(cloud, i, point);
 
-    // Sort points in increasing radial order, in each channel in each ring
-    for (std::uint32_t channel_index = 0U; channel_index < NUMBER_OF_CHANNELS_IN_RING_ELEVATION_CONJUNCTION_MAP;
-         ++channel_index)
-    {
-        for (std::uint32_t ring_index = 0U; ring_index < NUMBER_OF_RINGS_IN_RING_ELEVATION_CONJUNCTION_MAP;
-             ++ring_index)
-        {
-            const std::uint32_t cell_index = rowMajorIndexRingElevationConjunctionMap(channel_index, ring_index);
-            auto &cell = polar_grid_[cell_index];
-
-            if (!cell.empty())
-            {
-                std::sort(cell.begin(), cell.end(), [](const auto &p1, const auto &p2) noexcept {
-                    const float dr1 = (p1.x * p1.x) + (p1.y * p1.y);
-                    const float dr2 = (p2.x * p2.x) + (p2.y * p2.y);
-                    return dr1 < dr2;
-                });
-            }
-        }
-    }
-}
-
-template <typename PointT> void DepthImageSegmenter::constructDepthImage(const pcl::PointCloud<PointT> &cloud)
-{
-    static constexpr float ELEVATION_MID_RAD = (MIN_ELEVATION_RAD + MAX_ELEVATION_RAD) / 2.0F;
-
-    // Ensure the range image is properly sized and reset
-    if (depth_image_.size() != (DEPTH_IMAGE_WIDTH * DEPTH_IMAGE_HEIGHT))
-    {
-        depth_image_.resize(DEPTH_IMAGE_WIDTH * DEPTH_IMAGE_HEIGHT);
-    }
-
-    // Reset all pixels of the range image
-    std::fill(depth_image_.begin(), depth_image_.end(), RangeImagePixel());
-
-    // Fill range image with point cloud points
-    for (std::uint32_t i = 0U; i < cloud.points.size(); ++i)
-    {
-        const auto &point = cloud.points[i];
-
-        const float dd_sqr = point.x * point.x + point.y * point.y;
-        const float range = std::sqrt(dd_sqr + point.z * point.z);
-
-        if ((range < min_range_) || (range > max_range_))
-        {
-            continue; // Skip points out of range
-        }
-
-        const float azimuth_rad = std::atan2(point.y, point.x);
-        const float elevation_rad = std::atan2(point.z, std::sqrt(dd_sqr));
-
-        // Convention: (0, 0) coordinate of the image located at the top left corner
-
-        // Adjust azimuth to map zero azimuth to the center of the image width
-        const auto x = static_cast<std::int32_t>(((azimuth_rad / M_PIf32) * 0.5F + 0.5F) * DEPTH_IMAGE_WIDTH);
-
-        // Ensure x is within the valid range
-        if ((x < 0) || (x > static_cast<std::int32_t>(DEPTH_IMAGE_WIDTH - 1)))
+        if (!((distance > MIN_DISTANCE_M) && (distance <= MAX_DISTANCE_M)) || !std::isfinite(point.z))
         {
+            point_cells_[i] = INVALID_CELL;
             continue;
         }
 
-        // Adjust elevation to map zero elevation to the center of the image height
-        const auto y = static_cast<std::int32_t>(
-            ((elevation_rad - ELEVATION_MID_RAD) / (MAX_ELEVATION_RAD - MIN_ELEVATION_RAD) + 0.5F) *
-            DEPTH_IMAGE_HEIGHT);
+        // Convert azimuth angle to degrees and shift range to [0, 360) OR [0, 2 * PI]
+        float azimuth_rad = pointAzimuth(cloud, i, point);
 
-        // Ensure y is within the valid range
-        if ((y < 0) || (y > static_cast<std::int32_t>(DEPTH_IMAGE_HEIGHT - 1)))
+        // Adjust to range [0, 2 * pi]
+        if (azimuth_rad < 0)
         {
-            continue;
+            azimuth_rad += static_cast<float>(2.0 * M_PI);
         }
 
-        const auto row_major_index = rowMajorIndexDepthImage(x, y);
+        // Determine channel index using floor division
+        const std::uint32_t channel_index =
+            std::min(static_cast<std::uint32_t>(azimuth_rad * INVERSE_CHANNEL_RESOLUTION_RAD),
+                     (NUMBER_OF_CHANNELS_IN_RING_ELEVATION_CONJUNCTION_MAP - 1U));
 
-        auto &pixel = depth_image_[row_major_index];
-        if (range < pixel.range)
-        {
-            pixel.range = range;
-            pixel.index = i;
-            pixel.r = 0;
-            pixel.g = 255;
-            pixel.b = 0;
-        }
-    }
-
-    std::uint32_t number_of_depth_image_points = 0U;
-    for (const auto &point : depth_image_)
-    {
-        if (point.index != RangeImagePixel::INVALID_INDEX)
-        {
-            ++number_of_depth_image_points;
-        }
-    }
+        // Determine ring index
+        const std::uint32_t ring_index =
+            std::min(static_cast<std::uint32_t>((distance - MIN_DISTANCE_M) * INVERSE_RING_SPACING_M),
+                     (NUMBER_OF_RINGS_IN_RING_ELEVATION_CONJUNCTION_MAP - 1U));
 
-    std::cerr << "Number of depth image pixels: " << number_of_depth_image_points << " out of a total of "
-              << cloud.points.size() << " points" << std::endl;
-}
+        const std::uint32_t cell_index = rowMajorIndexRingElevationConjunctionMap(channel_index, ring_index);
+        point_cells_[i] = cell_index;
+        point_elevations_[i] = point.z;
 
-void DepthImageSegmenter::segmentRingElevationConjunctionMap()
-{
-    // Course segmentation algorithm
-    // Input: Raw Point Cloud
-    // Output: First Labelled Point Cloud
-    // 1. Choose ground height threshold, dH
-    // 2. Choose grid ring spacing, dR
-    // 3. Choose road maximum slope, dM
-    //
-    // For each Point(t,c) in Cloud:
-    //      Label(t,c) = GROUND
-    //      Point(t,c) in GRID(m,n)
-    //      Elevation(m,n) = min(Elevation(m,n), z(t,c))
-    //
-    // For each Elevation(m,n) in ElevationMap:
-    //      Elevation(m,n) = min(Elevation(m,n), Elevation(m-1,n) + dR * tan(dM))
-    //
-    // For each Point(t,c) in Cloud:
-    //      Point(t,c) in GRID(m,n)
-    //      if z(t,c) >= Elevation(m,n) + dH:
-    //          Label(t,c) = OBSTACLE
+        float &cell_elevation = ring_elevation_conjunction_map_[cell_index];
+        cell_elevation = std::min(cell_elevation, point.z);
+    }
 }
 
-template <typename PointT>
-void DepthImageSegmenter::segment(const pcl::PointCloud<PointT> &cloud, std::vector<SegmentationLabel> &labels)
+template <typename CloudT>
+void DepthImageSegmenter::segment(const CloudT &cloud, std::vector<SegmentationLabel> &labels)
 {
     // Set all labels to unknown
     labels.assign(cloud.points.size(), SegmentationLabel::UNKNOWN);
 
-    // Construct depth image
-    const auto t1 = std::chrono::steady_clock::now();
+    UTILITIES_PROFILE_ZONE("depth_image_segmenter");
 
-    constructDepthImage(cloud);
+    // Construct depth image
+    {
+        UTILITIES_PROFILE_ZONE("depth_image_segmenter.depth_image");
+        depth_image_->build(cloud);
+    }
 
-    const auto t2 = std::chrono::steady_clock::now();
-    std::cerr << "Construction of depth image time [ms]: "
-              << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << std::endl;
+    // Coarse ground segmentation
+    {
+        UTILITIES_PROFILE_ZONE("depth_image_segmenter.ring_elevation_conjunction_map");
+        embedCloudIntoRingElevationConjunctionMap(cloud);
+        if (temporal_configuration_.enabled)
+        {
+            compensateEgoMotion();
+            mergeTemporalGroundModel();
+        }
+        segmentRingElevationConjunctionMap(labels);
+    }
 }
 
 } // namespace lidar_processing_lib::segmentation
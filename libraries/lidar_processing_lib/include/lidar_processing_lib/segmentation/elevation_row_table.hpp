@@ -0,0 +1,93 @@
+#ifndef LIDAR_PROCESSING_LIB__SEGMENTATION__ELEVATION_ROW_TABLE_HPP
+#define LIDAR_PROCESSING_LIB__SEGMENTATION__ELEVATION_ROW_TABLE_HPP
+
+#include <array>                  // std::array
+#include <cstdint>                // std::uint32_t
+#include <limits>                 // std::numeric_limits
+#include <utilities_lib/math.hpp> // constexprSin
+
+namespace lidar_processing_lib::segmentation
+{
+/// @brief Compile-time lookup of the depth image row of a point from the sine of its elevation (z / range), rows
+/// split the vertical field of view of the sensor evenly. The sine range of the field of view is divided into
+/// NUMBER_OF_BINS even bins holding the row of their lower edge, bins are finer than the rows so a single comparison
+/// against the row boundaries corrects the bins a boundary falls into. No trigonometry is evaluated per point.
+template <std::uint32_t HEIGHT, std::uint32_t NUMBER_OF_BINS = 1024U> class ElevationRowTable final
+{
+  public:
+    static_assert(HEIGHT > 0U, "Depth image must have at least one row!");
+    static_assert(NUMBER_OF_BINS >= 2U * HEIGHT, "Bins of ElevationRowTable must be finer than the rows!");
+
+    // Elevation is out of the vertical field of view
+    static constexpr auto INVALID_ROW = std::numeric_limits<std::uint32_t>::max();
+
+    /// @brief Constructor, meant to be evaluated at compile time.
+    /// @param min_elevation_rad - Lower edge of the first row.
+    /// @param max_elevation_rad - Upper edge of the last row.
+    constexpr ElevationRowTable(const float min_elevation_rad, const float max_elevation_rad)
+    {
+        const double row_height_rad = (static_cast<double>(max_elevation_rad) - min_elevation_rad) / HEIGHT;
+        for (std::uint32_t row = 0U; row <= HEIGHT; ++row)
+        {
+            row_sines_[row] = static_cast<float>(utilities_lib::constexprSin(min_elevation_rad + row * row_height_rad));
+        }
+
+        min_sine_ = row_sines_[0U];
+        max_sine_ = row_sines_[HEIGHT];
+        const double bin_width = (static_cast<double>(max_sine_) - min_sine_) / NUMBER_OF_BINS;
+        inverse_bin_width_ = static_cast<float>(1.0 / bin_width);
+
+        // Boundaries increase monotonically, so the rows of the bins are found in a single sweep
+        std::uint32_t row = 0U;
+        for (std::uint32_t bin = 0U; bin < NUMBER_OF_BINS; ++bin)
+        {
+            const double bin_sine = min_sine_ + bin * bin_width;
+            while ((row + 1U < HEIGHT) && (row_sines_[row + 1U] <= bin_sine))
+            {
+                ++row;
+            }
+            bin_rows_[bin] = row;
+        }
+    }
+
+    /// @brief Row of the elevation with the given sine, or INVALID_ROW outside of the vertical field of view.
+    constexpr inline std::uint32_t row(const float elevation_sine) const noexcept
+    {
+        // Negated comparisons reject NaN as well
+        if (!((elevation_sine >= min_sine_) && (elevation_sine < max_sine_)))
+        {
+            return INVALID_ROW;
+        }
+
+        auto bin = static_cast<std::uint32_t>((elevation_sine - min_sine_) * inverse_bin_width_);
+        bin = (bin < NUMBER_OF_BINS) ? bin : (NUMBER_OF_BINS - 1U);
+
+        // A row boundary within the bin, or rounding of the bin index, moves the elevation by one row
+        std::uint32_t row = bin_rows_[bin];
+        if ((row + 1U < HEIGHT) && (elevation_sine >= row_sines_[row + 1U]))
+        {
+            ++row;
+        }
+        else if ((row > 0U) && (elevation_sine < row_sines_[row]))
+        {
+            --row;
+        }
+        return row;
+    }
+
+    /// @brief Sine of the lower edge of each row, followed by the sine of the upper edge of the last row.
+    constexpr inline const std::array<float, HEIGHT + 1U> &rowSines() const noexcept
+    {
+        return row_sines_;
+    }
+
+  private:
+    std::array<float, HEIGHT + 1U> row_sines_{};
+    std::array<std::uint32_t, NUMBER_OF_BINS> bin_rows_{};
+    float min_sine_ = 0.0F;
+    float max_sine_ = 0.0F;
+    float inverse_bin_width_ = 0.0F;
+};
+} // namespace lidar_processing_lib::segmentation
+
+#endif // LIDAR_PROCESSING_LIB__SEGMENTATION__ELEVATION_ROW_TABLE_HPP
@@ -1,10 +1,13 @@
 #ifndef LIDAR_PROCESSING_LIB__SEGMENTATION__I_SEGMENTER_HPP
 #define LIDAR_PROCESSING_LIB__SEGMENTATION__I_SEGMENTER_HPP
 
+#include <data_types_lib/point_cloud_soa.hpp>    // PointCloudSoA
+#include <data_types_lib/point_cloud_view.hpp>   // PointCloudView
 #include <data_types_lib/segmentation_label.hpp> // SegmentationLabel
 
-#include <pcl/point_cloud.h> // pcl::PointCloud
-#include <pcl/point_types.h> // pcl::PointXYZ
+#include <eigen3/Eigen/Geometry> // Eigen::Isometry3f
+#include <pcl/point_cloud.h>       // pcl::PointCloud
+#include <pcl/point_types.h>       // pcl::PointXYZ
 
 #include <memory>      // std::unique_ptr, std::make_unique
 #include <type_traits> // std::is_base_of_v
@@ -54,6 +57,24 @@ class ISegmenter
     /// @param cloud - Input variant of the point cloud.
     /// @param labels - Output segmentation labels (equal to the number of elements in the input cloud).
     virtual void run(const pcl::PointCloud<pcl::PointXYZI> &cloud, std::vector<SegmentationLabel> &labels) = 0;
+
+    /// @brief Pure virtual run method to be implemented by the derived class.
+    /// @param cloud - Input view of an externally owned point buffer.
+    /// @param labels - Output segmentation labels (equal to the number of elements in the input cloud).
+    virtual void run(const data_types_lib::PointCloudView &cloud, std::vector<SegmentationLabel> &labels) = 0;
+
+    /// @brief Pure virtual run method to be implemented by the derived class.
+    /// @param cloud - Input structure-of-arrays cloud with the channels derived at ingest.
+    /// @param labels - Output segmentation labels (equal to the number of elements in the input cloud).
+    virtual void run(const data_types_lib::PointCloudSoA &cloud, std::vector<SegmentationLabel> &labels) = 0;
+
+    /// @brief Motion of the sensor since the previous frame, compensated in the ground model kept by the incremental
+    /// mode. Applies to the next run only, segmenters without a temporal ground model ignore it.
+    /// @param previous_to_current - Transforms points of the previous frame into the frame of the next cloud.
+    virtual void setEgoMotion(const Eigen::Isometry3f &previous_to_current)
+    {
+        static_cast<void>(previous_to_current);
+    }
 };
 } // namespace lidar_processing_lib::segmentation
 
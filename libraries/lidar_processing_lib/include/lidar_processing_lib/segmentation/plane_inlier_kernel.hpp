@@ -0,0 +1,33 @@
+#ifndef LIDAR_PROCESSING_LIB__SEGMENTATION__PLANE_INLIER_KERNEL_HPP
+#define LIDAR_PROCESSING_LIB__SEGMENTATION__PLANE_INLIER_KERNEL_HPP
+
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint32_t
+
+namespace lidar_processing_lib::segmentation
+{
+// Plane a * x + b * y + c * z = d with unit normal (a, b, c)
+struct PlaneCoefficients final
+{
+    float a;
+    float b;
+    float c;
+    float d;
+};
+
+// Number of planes evaluated against each loaded block of points
+static constexpr std::size_t PLANES_PER_KERNEL_PASS = 4U;
+
+/// @brief Returns the name of the instruction set selected at compile time ("avx2", "sse2", "neon" or "scalar").
+const char *planeInlierKernelInstructionSet() noexcept;
+
+/// @brief Counts points with orthogonal distance |n.p - d| < threshold for several planes in one pass over the points.
+/// @param x, y, z - Structure-of-arrays point coordinates, each of number_of_points elements.
+/// @param planes - Plane hypotheses to be scored.
+/// @param inlier_counts - Output number of inliers of each plane hypothesis.
+void countPlaneInliers(const float *x, const float *y, const float *z, std::size_t number_of_points,
+                       const PlaneCoefficients *planes, std::size_t number_of_planes, float threshold,
+                       std::uint32_t *inlier_counts) noexcept;
+} // namespace lidar_processing_lib::segmentation
+
+#endif // LIDAR_PROCESSING_LIB__SEGMENTATION__PLANE_INLIER_KERNEL_HPP
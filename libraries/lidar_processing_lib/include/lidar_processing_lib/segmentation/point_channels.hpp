@@ -0,0 +1,52 @@
+#ifndef LIDAR_PROCESSING_LIB__SEGMENTATION__POINT_CHANNELS_HPP
+#define LIDAR_PROCESSING_LIB__SEGMENTATION__POINT_CHANNELS_HPP
+
+#include <cmath>                              // std::sqrt
+#include <cstddef>                            // std::size_t
+#include <data_types_lib/point_cloud_soa.hpp> // PointCloudSoA
+#include <utilities_lib/math.hpp>             // atan2Approx
+
+namespace lidar_processing_lib::segmentation
+{
+// Derived channels of the point at index of a cloud. Clouds of any point type compute them from the point, a
+// structure-of-arrays cloud reads the channels derived at ingest.
+
+template <typename CloudT, typename PointT>
+inline float pointRange(const CloudT &, std::size_t, const PointT &point) noexcept
+{
+    return std::sqrt(point.x * point.x + point.y * point.y + point.z * point.z);
+}
+
+inline float pointRange(const data_types_lib::PointCloudSoA &cloud, const std::size_t index,
+                        const data_types_lib::PointCloudSoA::Point &) noexcept
+{
+    return cloud.range()[index];
+}
+
+template <typename CloudT, typename PointT>
+inline float pointHorizontalRange(const CloudT &, std::size_t, const PointT &point) noexcept
+{
+    return std::sqrt((point.x * point.x) + (point.y * point.y));
+}
+
+inline float pointHorizontalRange(const data_types_lib::PointCloudSoA &cloud, const std::size_t index,
+                                  const data_types_lib::PointCloudSoA::Point &) noexcept
+{
+    return cloud.horizontalRange()[index];
+}
+
+/// @brief Azimuth in radians [-pi, pi] approximated by atan2Approx.
+template <typename CloudT, typename PointT>
+inline float pointAzimuth(const CloudT &, std::size_t, const PointT &point) noexcept
+{
+    return utilities_lib::atan2Approx(point.y, point.x);
+}
+
+inline float pointAzimuth(const data_types_lib::PointCloudSoA &cloud, const std::size_t index,
+                          const data_types_lib::PointCloudSoA::Point &) noexcept
+{
+    return cloud.azimuth()[index];
+}
+} // namespace lidar_processing_lib::segmentation
+
+#endif // LIDAR_PROCESSING_LIB__SEGMENTATION__POINT_CHANNELS_HPP
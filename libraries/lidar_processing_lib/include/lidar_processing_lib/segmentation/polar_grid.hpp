@@ -0,0 +1,146 @@
+#ifndef LIDAR_PROCESSING_LIB__SEGMENTATION__POLAR_GRID_HPP
+#define LIDAR_PROCESSING_LIB__SEGMENTATION__POLAR_GRID_HPP
+
+#include <data_types_lib/segmentation_label.hpp> // SegmentationLabel
+
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint32_t
+#include <vector>  // std::vector
+
+namespace lidar_processing_lib::segmentation
+{
+// Point embedded into a polar grid
+struct PolarGridPoint final
+{
+    float x;
+    float y;
+    float z;
+
+    // Horizontal distance from the sensor, ordering key of the points within a cell
+    float radius;
+
+    // Index of the point cloud
+    std::uint32_t index;
+
+    data_types_lib::SegmentationLabel label;
+};
+
+/// @brief Polar grid of channels (azimuth partition) and cells (radial partition) stored in one contiguous buffer.
+/// Points of each cell are adjacent in memory and sorted in increasing radial order, cells are stored channel-major.
+/// Construction is done in two passes: points are staged together with their cell, then build() counts points per
+/// cell, computes cell offsets through a prefix sum and scatters the staged points into their cells.
+class PolarGrid final
+{
+  public:
+    /// @brief Contiguous range of points of a single cell.
+    template <typename PointT> class CellRange final
+    {
+      public:
+        CellRange(PointT *begin, PointT *end) noexcept : begin_{begin}, end_{end}
+        {
+        }
+
+        inline PointT *begin() const noexcept
+        {
+            return begin_;
+        }
+
+        inline PointT *end() const noexcept
+        {
+            return end_;
+        }
+
+        inline std::size_t size() const noexcept
+        {
+            return static_cast<std::size_t>(end_ - begin_);
+        }
+
+        inline bool empty() const noexcept
+        {
+            return (begin_ == end_);
+        }
+
+      private:
+        PointT *begin_;
+        PointT *end_;
+    };
+
+    using Cell = CellRange<PolarGridPoint>;
+    using ConstCell = CellRange<const PolarGridPoint>;
+
+    /// @brief Constructor.
+    /// @param max_points - Number of points the grid buffers are preallocated for.
+    PolarGrid(std::uint32_t number_of_channels, std::uint32_t number_of_cells, std::size_t max_points);
+
+    /// @brief Removes all points from the grid, does not release memory.
+    void clear() noexcept;
+
+    /// @brief First pass, records a point to be embedded into the specified cell.
+    inline void stage(const std::uint32_t channel_index, const std::uint32_t cell_index, const PolarGridPoint &point)
+    {
+        const std::uint32_t flat_cell_index = flatIndex(channel_index, cell_index);
+        staged_points_.push_back(point);
+        staged_cell_indices_.push_back(flat_cell_index);
+        ++cell_offsets_[flat_cell_index + 1U];
+    }
+
+    /// @brief Second pass, scatters staged points into cells and sorts each cell by radius.
+    void build();
+
+    /// @brief Returns points of a cell, valid until the next call to clear().
+    inline Cell cell(const std::uint32_t channel_index, const std::uint32_t cell_index) noexcept
+    {
+        const std::uint32_t flat_cell_index = flatIndex(channel_index, cell_index);
+        return Cell{points_.data() + cell_offsets_[flat_cell_index],
+                    points_.data() + cell_offsets_[flat_cell_index + 1U]};
+    }
+
+    /// @brief Returns points of a cell, valid until the next call to clear().
+    inline ConstCell cell(const std::uint32_t channel_index, const std::uint32_t cell_index) const noexcept
+    {
+        const std::uint32_t flat_cell_index = flatIndex(channel_index, cell_index);
+        return ConstCell{points_.data() + cell_offsets_[flat_cell_index],
+                         points_.data() + cell_offsets_[flat_cell_index + 1U]};
+    }
+
+    inline std::uint32_t numberOfChannels() const noexcept
+    {
+        return number_of_channels_;
+    }
+
+    inline std::uint32_t numberOfCells() const noexcept
+    {
+        return number_of_cells_;
+    }
+
+    /// @brief Number of embedded points.
+    inline std::size_t size() const noexcept
+    {
+        return points_.size();
+    }
+
+  private:
+    std::uint32_t number_of_channels_;
+    std::uint32_t number_of_cells_;
+
+    // Points in the order of staging, and their flattened cell indices
+    std::vector<PolarGridPoint> staged_points_;
+    std::vector<std::uint32_t> staged_cell_indices_;
+
+    // Cell c occupies range [cell_offsets_[c], cell_offsets_[c + 1]) of the points, holds counts before build()
+    std::vector<std::uint32_t> cell_offsets_;
+
+    // Next write position of each cell during scatter
+    std::vector<std::uint32_t> cell_cursors_;
+
+    // Embedded points, grouped by cell
+    std::vector<PolarGridPoint> points_;
+
+    inline std::uint32_t flatIndex(const std::uint32_t channel_index, const std::uint32_t cell_index) const noexcept
+    {
+        return (channel_index * number_of_cells_ + cell_index);
+    }
+};
+} // namespace lidar_processing_lib::segmentation
+
+#endif // LIDAR_PROCESSING_LIB__SEGMENTATION__POLAR_GRID_HPP
@@ -2,17 +2,47 @@
 #define LIDAR_PROCESSING_LIB__SEGMENTATION__RANSAC_SEGMENTER_HPP
 
 #include "i_segmenter.hpp"               // ISegmenter
-#include <algorithm>                     // std::sort
+#include "plane_inlier_kernel.hpp"       // countPlaneInliers
+#include "point_channels.hpp"            // pointHorizontalRange, pointAzimuth
+#include "polar_grid.hpp"                // PolarGrid
+#include "temporal_ground_model.hpp"     // TemporalGroundConfiguration, TemporalGroundStatistics
+#include <algorithm>                     // std::min
 #include <array>                         // std::array
-#include <chrono>                        // std::chrono
 #include <cmath>                         // M_PI
+#include <eigen3/Eigen/Geometry>         // Eigen::Isometry3f
+#include <memory>                        // std::unique_ptr
+#include <memory_resource>               // std::pmr::vector
 #include <random>                        // std::random_device, std::mt19937, std::uniform_int_distribution
+#include <utilities_lib/frame_arena.hpp> // FrameArena
 #include <utilities_lib/math.hpp>        // constexprRound
-#include <utilities_lib/thread_pool.hpp> // ThreadPool
+#include <utilities_lib/profiler.hpp>    // UTILITIES_PROFILE_ZONE
+#include <utilities_lib/thread_pool.hpp> // ThreadPool, TaskGroup
 #include <vector>                        // std::vector
 
 namespace lidar_processing_lib::segmentation
 {
+// Adaptive termination of RANSAC, disabled mode evaluates exactly number_of_iterations hypotheses
+struct RansacAdaptiveConfiguration final
+{
+    bool enabled = false;
+
+    // Probability that at least one outlier-free sample has been drawn once the iterations stop
+    float confidence = 0.99F;
+
+    // Lower bound of evaluated hypotheses, the upper bound is number_of_iterations
+    std::uint32_t min_iterations = 16U;
+
+    // Number of evenly spread points used to pre-screen each hypothesis, 0 disables preemptive scoring
+    std::uint32_t preemptive_sample_size = 128U;
+
+    // Hypothesis is rejected without full scoring when its inlier ratio on the sample is below this fraction of the
+    // best inlier ratio found so far
+    float preemptive_rejection_ratio = 0.5F;
+
+    // Score the plane found in the previous frame before drawing random hypotheses
+    bool warm_start = true;
+};
+
 class RansacSegmenter : public ISegmenter
 {
   public:
@@ -35,70 +65,181 @@ class RansacSegmenter : public ISegmenter
     static constexpr auto NUMBER_OF_CELLS =
         static_cast<std::uint32_t>(utilities_lib::constexprRound(MAX_CELL_RADIUS / CELL_RESOLUTION_M));
 
+    // Seed of the first worker, each next worker is seeded with an incremented value
+    static constexpr std::uint32_t RANDOM_SEED = 42U;
+
+    // Number of points the processing buffers and the polar grid are preallocated for
+    static constexpr std::uint32_t MAX_CLOUD_POINTS = 350000U;
+
+    // Number of hypotheses generated before scoring them in a single pass over the processing points
+    static constexpr std::uint32_t HYPOTHESES_PER_BATCH = 2U * PLANES_PER_KERNEL_PASS;
+
+    /// @brief Constructor.
+    /// @param number_of_iterations - Number of hypotheses, upper bound on hypotheses in the adaptive mode.
+    /// @param thread_count - Number of workers sharing the hypotheses, 0 and 1 run RANSAC on the calling thread.
+    /// @param adaptive_configuration - Early termination settings.
+    /// @param horizontal_traversal_bands - Number of ring bands traversed in parallel during the horizontal refinement,
+    /// 1 keeps a single traversal over all rings.
+    /// @param temporal_configuration - Incremental mode, the plane of the previous frame is reused while the next
+    /// frames validate it.
     explicit RansacSegmenter(float height_offset, float orthogonal_distance_threshold = 0.1F,
-                             std::uint32_t number_of_iterations = 100U, float max_plane_inclination_deg = 25.0F,
-                             float consideration_radius = 20.0F, float consideration_height = 0.8F,
-                             float classification_radius = 60.0F);
+                             std::uint32_t number_of_iterations = 100U, std::uint32_t thread_count = 1U,
+                             const RansacAdaptiveConfiguration &adaptive_configuration = RansacAdaptiveConfiguration{},
+                             std::uint32_t horizontal_traversal_bands = 1U,
+                             const TemporalGroundConfiguration &temporal_configuration = TemporalGroundConfiguration{},
+                             float max_plane_inclination_deg = 25.0F, float consideration_radius = 20.0F,
+                             float consideration_height = 0.8F, float classification_radius = 60.0F);
 
     ~RansacSegmenter();
 
     void run(const pcl::PointCloud<pcl::PointXYZ> &cloud, std::vector<SegmentationLabel> &labels) override;
     void run(const pcl::PointCloud<pcl::PointXYZI> &cloud, std::vector<SegmentationLabel> &labels) override;
+    void run(const data_types_lib::PointCloudView &cloud, std::vector<SegmentationLabel> &labels) override;
+    void run(const data_types_lib::PointCloudSoA &cloud, std::vector<SegmentationLabel> &labels) override;
+
+    void setEgoMotion(const Eigen::Isometry3f &previous_to_current) override;
+
+    /// @brief Reuse of the previous plane in the last segmented frame.
+    inline const TemporalGroundStatistics &temporalStatistics() const noexcept
+    {
+        return temporal_statistics_;
+    }
+
+    /// @brief Number of points reclassified by the horizontal traversal in the last segmented frame.
+    inline std::uint32_t reclassifiedPoints() const noexcept
+    {
+        return reclassified_points_;
+    }
 
   private:
+    // Plane n.p = d with unit normal n = (a, b, c)
+    struct PlaneHypothesis final
+    {
+        float a = 0.0F;
+        float b = 0.0F;
+        float c = 1.0F;
+        float d = 0.0F;
+        std::uint32_t inlier_count = 0U;
+    };
+
     float height_offset_;
     float orthogonal_distance_threshold_;
     std::uint32_t number_of_iterations_;
+    std::uint32_t thread_count_;
+    RansacAdaptiveConfiguration adaptive_configuration_;
+    std::uint32_t horizontal_traversal_bands_;
+    TemporalGroundConfiguration temporal_configuration_;
     float max_plane_inclination_deg_;
     float consideration_radius_;
     float consideration_height_;
     float classification_radius_;
 
-    std::vector<pcl::PointXYZ> processing_points_;
+    // Scratch buffers of the frame, released at once at the start of the next frame
+    utilities_lib::FrameArena frame_arena_;
 
-    struct PointXYZIL final
-    {
-        float x;
-        float y;
-        float z;
-        std::uint32_t index;
-        SegmentationLabel label;
+    // Consideration region points in structure-of-arrays layout for vectorized plane scoring
+    std::pmr::vector<float> processing_x_;
+    std::pmr::vector<float> processing_y_;
+    std::pmr::vector<float> processing_z_;
 
-        PointXYZIL() = default;
+    // Subset of the processing points used for preemptive scoring in the adaptive mode
+    std::pmr::vector<float> preemptive_x_;
+    std::pmr::vector<float> preemptive_y_;
+    std::pmr::vector<float> preemptive_z_;
 
-        PointXYZIL(float x, float y, float z, std::uint32_t index, SegmentationLabel label)
-            : x(x), y(y), z(z), index(index), label(label)
-        {
-        }
-    };
+    // Best plane of the previous frame, used for warm start and reused by the incremental mode
+    PlaneHypothesis previous_plane_{};
+    bool previous_plane_valid_ = false;
+
+    // Inlier ratio of the last fitted plane and number of frames it has been reused for since
+    float fitted_inlier_ratio_ = 0.0F;
+    std::uint32_t plane_age_ = 0U;
+
+    // Motion applied to the previous plane before the next frame
+    Eigen::Isometry3f ego_motion_ = Eigen::Isometry3f::Identity();
+    bool ego_motion_pending_ = false;
+
+    TemporalGroundStatistics temporal_statistics_{};
+    std::uint32_t reclassified_points_ = 0U;
+
+    // Multithreaded hypothesis scoring, one generator per worker to keep results deterministic
+    std::unique_ptr<utilities_lib::ThreadPool> thread_pool_;
+    std::vector<std::mt19937> generators_;
+    std::vector<PlaneHypothesis> worker_planes_;
+
+    // Per-task reclassification counters of the parallel refinement, and the last ground point of each ring band
+    std::vector<std::uint32_t> range_reclassified_points_;
+    std::vector<const PolarGridPoint *> band_last_ground_points_;
+
+    PolarGrid polar_grid_;
+
+    template <typename CloudT>
+    void embedPointCloudIntoPolarGrid(const CloudT &cloud, const std::vector<SegmentationLabel> &labels);
 
-    std::array<std::array<std::vector<PointXYZIL>, NUMBER_OF_CELLS>, NUMBER_OF_CHANNELS> polar_grid_;
+    template <typename CloudT>
+    void segmentRansac(const CloudT &cloud, std::vector<SegmentationLabel> &labels);
 
-    template <typename PointT>
-    void embedPointCloudIntoPolarGrid(const pcl::PointCloud<PointT> &cloud,
-                                      const std::vector<SegmentationLabel> &labels);
+    template <typename CloudT>
+    void segment(const CloudT &cloud, std::vector<SegmentationLabel> &labels);
 
-    template <typename PointT>
-    void segmentRansac(const pcl::PointCloud<PointT> &cloud, std::vector<SegmentationLabel> &labels);
+    /// @brief Releases the scratch buffers of the previous frame and takes them from the frame arena again.
+    void resetFrameScratch(std::size_t number_of_points);
 
-    template <typename PointT>
-    void segment(const pcl::PointCloud<PointT> &cloud, std::vector<SegmentationLabel> &labels);
+    /// @brief Estimates the ground plane from the processing points.
+    PlaneHypothesis fitPlane();
 
-    void refineClassificationThroughPolarGridTraversal(std::vector<SegmentationLabel> &labels);
+    /// @brief Moves the previous plane into the frame of the next cloud by the pending ego-motion.
+    void compensateEgoMotion() noexcept;
+
+    /// @brief Scores the previous plane against the processing points, the plane is reused while it keeps enough of
+    /// the inliers of its fit.
+    /// @param plane - Previous plane with its inliers in this frame, if it is valid.
+    /// @return True if the plane is valid for this frame.
+    bool validatePreviousPlane(PlaneHypothesis &plane) const;
+
+    /// @brief Distributes hypotheses between the workers and reduces their results.
+    /// @param reference_plane - Best plane so far, returned if no better hypothesis is found.
+    PlaneHypothesis evaluateHypothesesOnWorkers(std::uint32_t number_of_hypotheses,
+                                                const PlaneHypothesis &reference_plane);
+
+    /// @brief Generates and scores plane hypotheses against the processing points.
+    /// @param reference_inlier_count - Inlier count of the best plane so far, used for preemptive rejection.
+    /// @return Hypothesis with the largest number of inliers.
+    PlaneHypothesis evaluateHypotheses(std::mt19937 &generator, std::uint32_t number_of_hypotheses,
+                                       std::uint32_t reference_inlier_count) const;
+
+    /// @brief Number of hypotheses needed to draw an outlier-free sample with the configured confidence.
+    std::uint32_t requiredNumberOfHypotheses(std::uint32_t best_inlier_count) const noexcept;
+
+    /// @brief Reclassifies the points of the polar grid, traverses the channels, the rings and finally the cells.
+    /// @return Number of reclassified points.
+    std::uint32_t refineClassificationThroughPolarGridTraversal(std::vector<SegmentationLabel> &labels);
+
+    /// @brief Splits [0, number_of_items) into contiguous ranges processed by the workers.
+    /// @param process_range - Called as process_range(range_index, first, last), returns its reclassified points.
+    /// @return Total number of reclassified points.
+    template <typename ProcessRange>
+    std::uint32_t reduceOverRanges(std::uint32_t number_of_items, std::uint32_t number_of_ranges,
+                                   const ProcessRange &process_range);
+
+    /// @brief Forward traversal of channels [first_channel, last_channel) from the sensor outwards.
+    std::uint32_t traverseChannels(std::uint32_t first_channel, std::uint32_t last_channel,
+                                   std::vector<SegmentationLabel> &labels);
+
+    /// @brief Horizontal traversal of rings [first_cell, last_cell) across all channels.
+    /// @param last_known_ground_point - Ground point carried into the first ring, updated to the last ground point.
+    std::uint32_t traverseRings(std::uint32_t first_cell, std::uint32_t last_cell,
+                                const PolarGridPoint *&last_known_ground_point, std::vector<SegmentationLabel> &labels);
+
+    /// @brief Per cell smoothing of channels [first_channel, last_channel).
+    std::uint32_t smoothChannelCells(std::uint32_t first_channel, std::uint32_t last_channel);
 };
 
-template <typename PointT>
-void RansacSegmenter::embedPointCloudIntoPolarGrid(const pcl::PointCloud<PointT> &cloud,
-                                                   const std::vector<SegmentationLabel> &labels)
+template <typename CloudT>
+void RansacSegmenter::embedPointCloudIntoPolarGrid(const CloudT &cloud, const std::vector<SegmentationLabel> &labels)
 {
     // Clear old points
-    for (auto &channel : polar_grid_)
-    {
-        for (auto &cell : channel)
-        {
-            cell.clear();
-        }
-    }
+    polar_grid_.clear();
 
     // Embed points into each channel
     for (std::uint32_t i = 0U; i < cloud.points.size(); ++i)
@@ -108,12 +249,12 @@ void RansacSegmenter::embedPointCloudIntoPolarGrid(const pcl::PointCloud<PointT>
             const auto &point = cloud.points[i];
 
             // Calculate distance
-            const float distance = std::sqrt((point.x * point.x) + (point.y * point.y));
+            const float distance = pointHorizontalRange(cloud, i, point);
 
             if (distance < MAX_CELL_RADIUS)
             {
                 // Convert azimuth angle to degrees and shift range to [0, 360) OR [0, 2 * PI]
-                float azimuth_rad = utilities_lib::atan2Approx(point.y, point.x);
+                float azimuth_rad = pointAzimuth(cloud, i, point);
 
                 // Adjust to range [0, 2 * pi]
                 if (azimuth_rad < 0)
@@ -130,156 +271,60 @@ void RansacSegmenter::embedPointCloudIntoPolarGrid(const pcl::PointCloud<PointT>
                     std::min(static_cast<std::uint32_t>(distance / CELL_RESOLUTION_M), (NUMBER_OF_CELLS - 1U));
 
                 // Embed point into polar grid channel and cell
-                polar_grid_[channel_index][cell_index].emplace_back(point.x, point.y, point.z, i, labels[i]);
+                polar_grid_.stage(channel_index, cell_index,
+                                  PolarGridPoint{point.x, point.y, point.z, distance, i, labels[i]});
             }
         }
     }
 
-    // Sort points in increasing radial order, in each channel in each cell
-    for (auto &channel : polar_grid_)
-    {
-        for (auto &cell : channel)
-        {
-            if (!cell.empty())
-            {
-                std::sort(cell.begin(), cell.end(), [](const auto &p1, const auto &p2) noexcept {
-                    const float dr1 = (p1.x * p1.x) + (p1.y * p1.y);
-                    const float dr2 = (p2.x * p2.x) + (p2.y * p2.y);
-                    return dr1 < dr2;
-                });
-            }
-        }
-    }
+    // Scatter points into cells, sorted in increasing radial order
+    polar_grid_.build();
 }
 
-void RansacSegmenter::refineClassificationThroughPolarGridTraversal(std::vector<SegmentationLabel> &labels)
+template <typename ProcessRange>
+std::uint32_t RansacSegmenter::reduceOverRanges(std::uint32_t number_of_items, std::uint32_t number_of_ranges,
+                                                const ProcessRange &process_range)
 {
-    const PointXYZIL pivot_point{0.0F, 0.0F, -height_offset_, 0, SegmentationLabel::GROUND};
-    std::uint32_t points_reclassified = 0U;
+    const auto rangeBegin = [number_of_items, number_of_ranges](std::uint32_t range_index) noexcept {
+        return static_cast<std::uint32_t>((static_cast<std::uint64_t>(range_index) * number_of_items) /
+                                          number_of_ranges);
+    };
 
-    // Traverse grid in the forward direction
-    std::uint32_t reclassified_points_forward_traversal = 0U;
-    for (auto &channel : polar_grid_)
+    std::uint32_t reclassified_points = 0U;
+    if (thread_pool_ == nullptr)
     {
-        const auto *last_known_ground_point = &pivot_point;
-
-        // Traverse each cell and refine
-        for (auto &cell : channel)
+        for (std::uint32_t range_index = 0U; range_index < number_of_ranges; ++range_index)
         {
-            // Traverse each point within cell
-            for (auto &point : cell)
-            {
-                if (point.label == SegmentationLabel::GROUND)
-                {
-                    last_known_ground_point = &point;
-                }
-                // Check if can be re-classified as ground
-                else
-                {
-                    const float dx = point.x - last_known_ground_point->x;
-                    const float dy = point.y - last_known_ground_point->y;
-                    const float dz = point.z - last_known_ground_point->z;
-                    const float dr = std::sqrt((dx * dx) + (dy * dy));
-                    const float gradient = dz / dr;
-
-                    if ((std::fabs(gradient) < 0.2F) && (dr < 8.0F))
-                    {
-                        point.label = SegmentationLabel::GROUND;
-                        last_known_ground_point = &point;
-                        labels[point.index] = SegmentationLabel::GROUND;
-                        ++reclassified_points_forward_traversal;
-                    }
-                }
-            }
+            reclassified_points += process_range(range_index, rangeBegin(range_index), rangeBegin(range_index + 1U));
         }
+        return reclassified_points;
     }
 
-    // Traverse grid in the horizontal direction
-    const auto *last_known_ground_point = &pivot_point;
-    std::uint32_t reclassified_points_horizontal_traversal = 0U;
-    for (std::uint32_t cell_index = 0U; cell_index < NUMBER_OF_CELLS; ++cell_index)
+    // Every range writes its own counter, the group is joined without allocating futures
+    utilities_lib::TaskGroup task_group(*thread_pool_);
+    for (std::uint32_t range_index = 0U; range_index < number_of_ranges; ++range_index)
     {
-        for (std::uint32_t channel_index = 0U; channel_index < NUMBER_OF_CHANNELS; ++channel_index)
-        {
-            // For each point
-            for (auto &point : polar_grid_[channel_index][cell_index])
-            {
-                if (point.label == SegmentationLabel::GROUND)
-                {
-                    last_known_ground_point = &point;
-                }
-                // Check if can be re-classified as ground
-                else
-                {
-                    const float dx = point.x - last_known_ground_point->x;
-                    const float dy = point.y - last_known_ground_point->y;
-                    const float dz = point.z - last_known_ground_point->z;
-                    const float dr = std::sqrt((dx * dx) + (dy * dy));
-                    const float gradient = dz / dr;
-
-                    if ((std::fabs(gradient) < 0.10F) && (dr < 1.0F))
-                    {
-                        point.label = SegmentationLabel::GROUND;
-                        last_known_ground_point = &point;
-                        labels[point.index] = SegmentationLabel::GROUND;
-                        ++reclassified_points_horizontal_traversal;
-                    }
-                }
-            }
-        }
+        const std::uint32_t first = rangeBegin(range_index);
+        const std::uint32_t last = rangeBegin(range_index + 1U);
+        std::uint32_t &range_reclassified_points = range_reclassified_points_[range_index];
+        task_group.run([&process_range, &range_reclassified_points, range_index, first, last]() {
+            range_reclassified_points = process_range(range_index, first, last);
+        });
     }
+    task_group.wait();
 
-    // Last stage - per cell reclassification
-    std::uint32_t reclassified_points_cell_smoothing = 0U;
-    for (auto &channel : polar_grid_)
+    for (std::uint32_t range_index = 0U; range_index < number_of_ranges; ++range_index)
     {
-        for (auto &cell : channel)
-        {
-            // Find mean ground point within current cells
-            float z_mean = 0.0;
-            std::uint32_t number_of_ground_points_within_cell = 0U;
-            for (const auto &point : cell)
-            {
-                if (point.label == SegmentationLabel::GROUND)
-                {
-                    z_mean += point.z;
-                    ++number_of_ground_points_within_cell;
-                }
-            }
-            if (number_of_ground_points_within_cell > 0U)
-            {
-                z_mean /= number_of_ground_points_within_cell;
-
-                // Attempt to smooth out non-ground classifications
-                for (auto &point : cell)
-                {
-                    if (point.label == SegmentationLabel::OBSTACLE)
-                    {
-                        if (std::fabs(point.z - z_mean) < 0.15F)
-                        {
-                            point.label = SegmentationLabel::GROUND;
-                            ++reclassified_points_cell_smoothing;
-                        }
-                    }
-                }
-            }
-        }
+        reclassified_points += range_reclassified_points_[range_index];
     }
-
-    points_reclassified = reclassified_points_forward_traversal + reclassified_points_horizontal_traversal +
-                          reclassified_points_cell_smoothing;
-
-    std::cerr << "Reclassified points forward traversal: " << reclassified_points_forward_traversal << std::endl;
-    std::cerr << "Reclassified points horizontal traversal: " << reclassified_points_horizontal_traversal << std::endl;
-    std::cerr << "Reclassified points cell smoothing: " << reclassified_points_cell_smoothing << std::endl;
-    std::cerr << "Reclassified points: " << points_reclassified << std::endl;
+    return reclassified_points;
 }
 
-template <typename PointT>
-void RansacSegmenter::segmentRansac(const pcl::PointCloud<PointT> &cloud, std::vector<SegmentationLabel> &labels)
+template <typename CloudT>
+void RansacSegmenter::segmentRansac(const CloudT &cloud, std::vector<SegmentationLabel> &labels)
 {
     // Copy points from the cloud to the processing points
-    processing_points_.clear();
+    resetFrameScratch(cloud.points.size());
     const float consideration_radius_squared = consideration_radius_ * consideration_radius_;
     for (const auto &point : cloud.points)
     {
@@ -287,96 +332,44 @@ void RansacSegmenter::segmentRansac(const pcl::PointCloud<PointT> &cloud, std::v
         if ((std::fabs(point.z + height_offset_) <= consideration_height_) &&
             ((point.x * point.x + point.y * point.y) < consideration_radius_squared))
         {
-            processing_points_.emplace_back(point.x, point.y, point.z);
+            processing_x_.push_back(point.x);
+            processing_y_.push_back(point.y);
+            processing_z_.push_back(point.z);
         }
     }
 
-    // Set pivot constraints
-    const PointT point_1{0.0F, 0.0F, -height_offset_};
-    const float max_plane_inclination_rad = max_plane_inclination_deg_ * M_PIf32 / 180.0F;
-    const float max_plane_cosine_angle = std::cos(max_plane_inclination_rad);
-
-    // Plane coefficients
-    float a = 0.0F;
-    float b = 0.0F;
-    float c = 1.0F;
-    float d = 0.0F;
-
-    // For index generation
-    std::mt19937 generator(42);
-    std::uniform_int_distribution<std::uint32_t> distribution(0, processing_points_.size() - 1U);
-
-    // RANSAC
-    std::uint32_t best_inlier_count = 0U;
-    for (std::uint32_t iteration = 0U; iteration < number_of_iterations_; ++iteration)
+    // At least two points are required to form a plane through the pivot
+    if (processing_x_.size() < 2U)
     {
-        // Choose 2 random points
-        const std::uint32_t point_2_index = distribution(generator);
-        const auto &point_2 = processing_points_[point_2_index];
-
-        std::uint32_t point_3_index = distribution(generator);
-        while (point_2_index == point_3_index)
-        {
-            point_3_index = distribution(generator);
-        }
-        const auto &point_3 = processing_points_[point_3_index];
-
-        // Calculate a plane defined by three points
-        float normal_x =
-            ((point_2.y - point_1.y) * (point_3.z - point_1.z)) - ((point_2.z - point_1.z) * (point_3.y - point_1.y));
-        float normal_y =
-            ((point_2.z - point_1.z) * (point_3.x - point_1.x)) - ((point_2.x - point_1.x) * (point_3.z - point_1.z));
-        float normal_z =
-            ((point_2.x - point_1.x) * (point_3.y - point_1.y)) - ((point_2.y - point_1.y) * (point_3.x - point_1.x));
-
-        // Calculate normalization
-        const float denominator = std::sqrt((normal_x * normal_x) + (normal_y * normal_y) + (normal_z * normal_z));
-
-        // Check that denominator is not too small
-        if (denominator < 1.0e-4F)
-        {
-            continue;
-        }
-        const float normalization = 1.0F / denominator;
-
-        // Normalize plane coefficients
-        normal_z *= normalization;
-
-        // Constrain plane
-        if (std::fabs(normal_z) < max_plane_cosine_angle)
-        {
-            continue;
-        }
-
-        normal_x *= normalization;
-        normal_y *= normalization;
-
-        const float plane_d = (normal_x * point_1.x) + (normal_y * point_1.y) + (normal_z * point_1.z);
-
-        // Count inlier points
-        std::uint32_t inlier_count = 0U;
-        for (const auto &point : processing_points_)
-        {
-            const float orthogonal_distance =
-                std::fabs((normal_x * point.x) + (normal_y * point.y) + (normal_z * point.z) - plane_d);
+        return;
+    }
 
-            if (orthogonal_distance < orthogonal_distance_threshold_)
-            {
-                ++inlier_count;
-            }
-        }
+    // Incremental mode falls back to a full fit once the previous plane loses its inliers or exceeds its age
+    PlaneHypothesis best_plane{};
+    temporal_statistics_.plane_reused = validatePreviousPlane(best_plane);
+    if (temporal_statistics_.plane_reused)
+    {
+        ++plane_age_;
+    }
+    else
+    {
+        best_plane = fitPlane();
+        fitted_inlier_ratio_ =
+            static_cast<float>(best_plane.inlier_count) / static_cast<float>(processing_x_.size());
+        plane_age_ = 0U;
+    }
 
-        // If the plane is best so far, update the plane coefficients
-        if (inlier_count > best_inlier_count)
-        {
-            best_inlier_count = inlier_count;
-            a = normal_x;
-            b = normal_y;
-            c = normal_z;
-            d = plane_d;
-        }
+    if ((adaptive_configuration_.enabled && adaptive_configuration_.warm_start) || temporal_configuration_.enabled)
+    {
+        previous_plane_ = best_plane;
+        previous_plane_valid_ = (best_plane.inlier_count > 0U);
     }
 
+    const float a = best_plane.a;
+    const float b = best_plane.b;
+    const float c = best_plane.c;
+    const float d = best_plane.d;
+
     // Decide which points are GROUND and which points are NON-GROUND
     const float classification_radius_squared = classification_radius_ * classification_radius_;
     for (std::size_t i = 0U; i < cloud.points.size(); ++i)
@@ -399,46 +392,41 @@ void RansacSegmenter::segmentRansac(const pcl::PointCloud<PointT> &cloud, std::v
     }
 }
 
-template <typename PointT>
-void RansacSegmenter::segment(const pcl::PointCloud<PointT> &cloud, std::vector<SegmentationLabel> &labels)
+template <typename CloudT>
+void RansacSegmenter::segment(const CloudT &cloud, std::vector<SegmentationLabel> &labels)
 {
     // Set all labels to unknown
     labels.assign(cloud.points.size(), SegmentationLabel::UNKNOWN);
 
+    // Previous plane follows the sensor into every frame, frames without a fit included
+    compensateEgoMotion();
+    temporal_statistics_ = TemporalGroundStatistics{};
+
     // If cloud contains less than 3 points
     if (cloud.points.size() < 3U)
     {
         return;
     }
 
-    const auto t0 = std::chrono::steady_clock::now();
+    UTILITIES_PROFILE_ZONE("ransac_segmenter");
 
     // Form initial segmentation (consensus)
-    segmentRansac(cloud, labels);
-
-    const auto t1 = std::chrono::steady_clock::now();
+    {
+        UTILITIES_PROFILE_ZONE("ransac_segmenter.consensus");
+        segmentRansac(cloud, labels);
+    }
 
     // Form polar grid
-    embedPointCloudIntoPolarGrid(cloud, labels);
-
-    const auto t2 = std::chrono::steady_clock::now();
+    {
+        UTILITIES_PROFILE_ZONE("ransac_segmenter.polar_grid_embedding");
+        embedPointCloudIntoPolarGrid(cloud, labels);
+    }
 
     // Refine classification (reduce number of false positives)
-    refineClassificationThroughPolarGridTraversal(labels);
-
-    const auto t3 = std::chrono::steady_clock::now();
-
-    std::cerr << "Elapsed time RANSAC [ms]: " << std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count()
-              << std::endl;
-
-    std::cerr << "Elapsed time polar grid embedding [ms]: "
-              << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() << std::endl;
-
-    std::cerr << "Elapsed time polar grid classification refinement [ms]: "
-              << std::chrono::duration_cast<std::chrono::milliseconds>(t3 - t2).count() << std::endl;
-
-    std::cerr << "Total segmentation time [ms]: "
-              << std::chrono::duration_cast<std::chrono::milliseconds>(t3 - t0).count() << std::endl;
+    {
+        UTILITIES_PROFILE_ZONE("ransac_segmenter.refinement");
+        reclassified_points_ = refineClassificationThroughPolarGridTraversal(labels);
+    }
 }
 } // namespace lidar_processing_lib::segmentation
 
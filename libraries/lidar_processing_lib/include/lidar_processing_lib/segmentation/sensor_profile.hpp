@@ -0,0 +1,157 @@
+#ifndef LIDAR_PROCESSING_LIB__SEGMENTATION__SENSOR_PROFILE_HPP
+#define LIDAR_PROCESSING_LIB__SEGMENTATION__SENSOR_PROFILE_HPP
+
+#include "elevation_row_table.hpp" // ElevationRowTable
+#include <algorithm>                 // std::max
+#include <cmath>                     // std::ceil, std::sqrt
+#include <cstdint>                   // std::uint32_t
+#include <limits>                    // std::numeric_limits
+#include <stdexcept>                 // std::runtime_error
+#include <string>                    // std::string
+#include <utilities_lib/math.hpp>    // atan2Approx
+
+namespace lidar_processing_lib::segmentation
+{
+inline constexpr float DEG_TO_RAD = static_cast<float>(M_PI / 180.0F);
+
+/// @brief Geometry of a spinning lidar, the depth image has a row per vertical resolution step over the vertical
+/// field of view and a column per horizontal resolution step over the full turn.
+struct SensorProfile final
+{
+    float min_elevation_deg;
+    float vertical_field_of_view_deg;
+    float vertical_resolution_deg;
+    float horizontal_resolution_deg;
+
+    // Number of points of a cloud the buffers are preallocated for
+    std::uint32_t max_cloud_points;
+
+    constexpr inline std::uint32_t width() const noexcept
+    {
+        return static_cast<std::uint32_t>(std::ceil(360.0F / horizontal_resolution_deg));
+    }
+
+    constexpr inline std::uint32_t height() const noexcept
+    {
+        return static_cast<std::uint32_t>(std::ceil(vertical_field_of_view_deg / vertical_resolution_deg));
+    }
+
+    constexpr inline float minElevationRad() const noexcept
+    {
+        return min_elevation_deg * DEG_TO_RAD;
+    }
+
+    constexpr inline float maxElevationRad() const noexcept
+    {
+        return (min_elevation_deg + vertical_field_of_view_deg) * DEG_TO_RAD;
+    }
+
+    constexpr inline bool operator==(const SensorProfile &other) const noexcept
+    {
+        return (min_elevation_deg == other.min_elevation_deg) &&
+               (vertical_field_of_view_deg == other.vertical_field_of_view_deg) &&
+               (vertical_resolution_deg == other.vertical_resolution_deg) &&
+               (horizontal_resolution_deg == other.horizontal_resolution_deg) &&
+               (max_cloud_points == other.max_cloud_points);
+    }
+};
+
+// Values acceptable for Velodyne HDL-64E (tightest values)
+struct VelodyneHdl64e final
+{
+    static constexpr SensorProfile PROFILE{-24.8F, 26.9F, 0.33F, 0.1F, 350000U};
+};
+
+// Velodyne VLP-32C, finest vertical resolution of its non-uniform beams
+struct VelodyneVlp32c final
+{
+    static constexpr SensorProfile PROFILE{-25.0F, 40.0F, 0.33F, 0.2F, 120000U};
+};
+
+// Ouster OS1-128 in 2048 x 10 mode, beams evenly spread over the vertical field of view
+struct OusterOs1_128 final
+{
+    static constexpr SensorProfile PROFILE{-22.5F, 45.0F, 0.3515625F, 0.17578125F, 262144U};
+};
+
+/// @brief Profile of a sensor model supported at compile time ("hdl64e", "vlp32c" or "os1_128").
+inline SensorProfile sensorProfile(const std::string &model)
+{
+    if (model == "hdl64e")
+    {
+        return VelodyneHdl64e::PROFILE;
+    }
+    if (model == "vlp32c")
+    {
+        return VelodyneVlp32c::PROFILE;
+    }
+    if (model == "os1_128")
+    {
+        return OusterOs1_128::PROFILE;
+    }
+    throw std::runtime_error("Unknown sensor model!");
+}
+
+/// @brief Projection policy of a sensor known at compile time, the image dimensions and the elevation row table are
+/// constants of the hot projection loop.
+template <typename SensorT> struct StaticProjection final
+{
+    static constexpr SensorProfile PROFILE = SensorT::PROFILE;
+    static constexpr std::uint32_t WIDTH = PROFILE.width();
+    static constexpr std::uint32_t HEIGHT = PROFILE.height();
+    static constexpr ElevationRowTable<HEIGHT> ELEVATION_ROW_TABLE{PROFILE.minElevationRad(),
+                                                                   PROFILE.maxElevationRad()};
+
+    static constexpr auto INVALID_ROW = ElevationRowTable<HEIGHT>::INVALID_ROW;
+
+    constexpr inline std::uint32_t width() const noexcept
+    {
+        return WIDTH;
+    }
+
+    /// @brief Row of the point, or INVALID_ROW out of the vertical field of view. The sine of the elevation selects
+    /// the row, no arctangent and no horizontal distance are needed.
+    constexpr inline std::uint32_t row(const float z, const float range) const noexcept
+    {
+        return ELEVATION_ROW_TABLE.row(z / range);
+    }
+};
+
+/// @brief Projection policy of a sensor profile given at runtime, the elevation is approximated by atan2Approx.
+class RuntimeProjection final
+{
+  public:
+    static constexpr auto INVALID_ROW = std::numeric_limits<std::uint32_t>::max();
+
+    explicit RuntimeProjection(const SensorProfile &profile)
+        : width_(profile.width()), height_(profile.height()), min_elevation_rad_(profile.minElevationRad()),
+          inverse_row_height_rad_(static_cast<float>(profile.height()) /
+                                  (profile.maxElevationRad() - profile.minElevationRad()))
+    {
+    }
+
+    inline std::uint32_t width() const noexcept
+    {
+        return width_;
+    }
+
+    /// @brief Row of the point, or INVALID_ROW out of the vertical field of view.
+    inline std::uint32_t row(const float z, const float range) const noexcept
+    {
+        const float horizontal_distance = std::sqrt(std::max((range * range) - (z * z), 0.0F));
+        const float row = (utilities_lib::atan2Approx(z, horizontal_distance) - min_elevation_rad_) *
+                          inverse_row_height_rad_;
+
+        // Comparisons fail for NaN as well
+        return ((row >= 0.0F) && (row < static_cast<float>(height_))) ? static_cast<std::uint32_t>(row) : INVALID_ROW;
+    }
+
+  private:
+    std::uint32_t width_;
+    std::uint32_t height_;
+    float min_elevation_rad_;
+    float inverse_row_height_rad_;
+};
+} // namespace lidar_processing_lib::segmentation
+
+#endif // LIDAR_PROCESSING_LIB__SEGMENTATION__SENSOR_PROFILE_HPP
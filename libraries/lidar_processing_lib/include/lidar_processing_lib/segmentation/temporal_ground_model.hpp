@@ -0,0 +1,44 @@
+#ifndef LIDAR_PROCESSING_LIB__SEGMENTATION__TEMPORAL_GROUND_MODEL_HPP
+#define LIDAR_PROCESSING_LIB__SEGMENTATION__TEMPORAL_GROUND_MODEL_HPP
+
+#include <cstdint> // std::uint32_t
+
+namespace lidar_processing_lib::segmentation
+{
+// Incremental segmentation, the ground model of the previous frame is validated against the next frame and only the
+// parts of the model contradicted by the frame are recomputed. Disabled mode estimates the ground of every frame anew
+struct TemporalGroundConfiguration final
+{
+    bool enabled = false;
+
+    // Frames a cell keeps its ground elevation while the frames do not observe its ground (empty or occluded cell)
+    std::uint32_t max_cell_age = 5U;
+
+    // Lowest point of a cell within this distance of the previous ground elevation validates it, in meters
+    float cell_tolerance = 0.15F;
+
+    // Previous plane is reused while it keeps this fraction of the inlier ratio of the last full fit
+    float plane_inlier_retention = 0.9F;
+
+    // Frames a plane is reused before it is refitted regardless of its inliers
+    std::uint32_t max_plane_age = 10U;
+};
+
+// Reuse of the ground model in the last segmented frame
+struct TemporalGroundStatistics final
+{
+    // Plane of the previous frame was validated and no hypotheses were evaluated
+    bool plane_reused = false;
+
+    // Cells whose lowest point confirmed the previous ground elevation
+    std::uint32_t validated_cells = 0U;
+
+    // Cells without a valid previous elevation or contradicted by the frame, estimated from the frame alone
+    std::uint32_t recomputed_cells = 0U;
+
+    // Cells with the ground unobserved by the frame, kept at the previous ground elevation
+    std::uint32_t carried_cells = 0U;
+};
+} // namespace lidar_processing_lib::segmentation
+
+#endif // LIDAR_PROCESSING_LIB__SEGMENTATION__TEMPORAL_GROUND_MODEL_HPP
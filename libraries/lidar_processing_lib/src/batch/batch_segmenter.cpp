@@ -0,0 +1,242 @@
+#include <lidar_processing_lib/batch/batch_segmenter.hpp>
+
+#include <lidar_processing_lib/filtering/point_cloud_ingest.hpp> // ingestPointCloud
+
+#include <data_types_lib/cartesian_return.hpp> // CartesianReturn
+#include <data_types_lib/point_cloud_view.hpp> // PointCloudView, PointCloudLayout
+#include <utilities_lib/file_operations.hpp>   // readFileNamesWithExtensionFromDirectory, mapPointCloudDataFromBinFile
+
+#include <algorithm> // std::max, std::min, std::fill
+#include <chrono>    // std::chrono
+#include <cstddef>   // offsetof
+#include <fstream>   // std::ofstream
+#include <mutex>     // std::mutex, std::lock_guard
+#include <stdexcept> // std::runtime_error
+#include <string>    // std::string
+#include <thread>    // std::thread
+#include <utility>   // std::move
+
+namespace lidar_processing_lib::batch
+{
+namespace
+{
+constexpr double NANOSECONDS_TO_SECONDS = 1e-9;
+
+// Frames per chunk without the incremental mode, small so that the workers stay balanced when frames differ in cost
+constexpr std::size_t FRAME_GRAIN = 2U;
+
+std::size_t resolveNumberOfWorkers(const BatchSegmentationConfiguration &configuration) noexcept
+{
+    if (configuration.number_of_workers > 0U)
+    {
+        return configuration.number_of_workers;
+    }
+    return std::max<std::size_t>(std::thread::hardware_concurrency(), 1U);
+}
+
+// Kitti clouds are rows of x, y, z and reflectance
+data_types_lib::PointCloudLayout cartesianReturnLayout() noexcept
+{
+    data_types_lib::PointCloudLayout layout;
+    layout.x_offset = offsetof(data_types_lib::CartesianReturn, x);
+    layout.y_offset = offsetof(data_types_lib::CartesianReturn, y);
+    layout.z_offset = offsetof(data_types_lib::CartesianReturn, z);
+    layout.intensity_offset = offsetof(data_types_lib::CartesianReturn, intensity);
+    layout.point_step = sizeof(data_types_lib::CartesianReturn);
+    return layout;
+}
+} // namespace
+
+BatchSegmenter::BatchSegmenter(const SegmenterFactory &segmenter_factory,
+                               const BatchSegmentationConfiguration &configuration,
+                               std::shared_ptr<const filtering::ConvexQuadCrop> crop)
+    : configuration_{configuration}, crop_{std::move(crop)},
+      thread_pool_{resolveNumberOfWorkers(configuration) - 1U, configuration.pin_threads}
+{
+    workers_.resize(resolveNumberOfWorkers(configuration));
+    for (auto &worker : workers_)
+    {
+        worker.segmenter = segmenter_factory();
+        if (worker.segmenter == nullptr)
+        {
+            throw std::runtime_error("Segmenter factory did not create a segmenter");
+        }
+        idle_workers_.push_back(&worker);
+    }
+}
+
+BatchSegmenter::~BatchSegmenter() = default;
+
+BatchSegmentationStatistics BatchSegmenter::run(const std::filesystem::path &sequence_path,
+                                                const std::filesystem::path &output_path)
+{
+    // Clouds of a Kitti sensor folder are in data/, a folder of clouds is accepted as well
+    const std::filesystem::path data_path =
+        std::filesystem::is_directory(sequence_path / "data") ? (sequence_path / "data") : sequence_path;
+    std::vector<std::filesystem::path> cloud_paths;
+    utilities_lib::readFileNamesWithExtensionFromDirectory(data_path, ".bin", cloud_paths);
+    if (cloud_paths.empty())
+    {
+        throw std::runtime_error("No .bin clouds in " + data_path.string());
+    }
+
+    std::filesystem::create_directories(output_path);
+
+    BatchSegmentationStatistics statistics;
+    statistics.number_of_frames = cloud_paths.size();
+
+    const std::filesystem::path timestamps_path = sequence_path / "timestamps.txt";
+    if (std::filesystem::is_regular_file(timestamps_path))
+    {
+        std::vector<std::int64_t> timestamps;
+        utilities_lib::readTimestampsFromTxtFile(timestamps_path, timestamps);
+        if (timestamps.size() >= 2U)
+        {
+            statistics.sequence_duration_s =
+                static_cast<double>(timestamps.back() - timestamps.front()) * NANOSECONDS_TO_SECONDS;
+        }
+    }
+
+    for (auto &worker : workers_)
+    {
+        worker.number_of_points = 0U;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    if (configuration_.incremental)
+    {
+        // Runs are balanced to within one frame, a worker without frames is not started
+        const std::size_t number_of_runs = std::min(workers_.size(), cloud_paths.size());
+        statistics.number_of_workers = number_of_runs;
+        thread_pool_.parallelFor(0U, number_of_runs, 1U, [&](const std::size_t first_run, const std::size_t last_run) {
+            for (std::size_t run = first_run; run < last_run; ++run)
+            {
+                const std::size_t first = (run * cloud_paths.size()) / number_of_runs;
+                const std::size_t warm_up_first = first - std::min(first, configuration_.warm_up_frames);
+                segmentRun(workers_[run], cloud_paths, warm_up_first, first,
+                           ((run + 1U) * cloud_paths.size()) / number_of_runs, output_path);
+            }
+        });
+    }
+    else
+    {
+        const std::size_t number_of_chunks = (cloud_paths.size() + FRAME_GRAIN - 1U) / FRAME_GRAIN;
+        statistics.number_of_workers = std::min(workers_.size(), number_of_chunks);
+        thread_pool_.parallelFor(0U, cloud_paths.size(), FRAME_GRAIN,
+                                 [&](const std::size_t first, const std::size_t last) {
+                                     segmentChunk(cloud_paths, first, last, output_path);
+                                 });
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    for (const auto &worker : workers_)
+    {
+        statistics.number_of_points += worker.number_of_points;
+    }
+
+    statistics.wall_time_s = std::chrono::duration<double>(end - start).count();
+    if (statistics.wall_time_s > 0.0)
+    {
+        statistics.frames_per_second = static_cast<double>(statistics.number_of_frames) / statistics.wall_time_s;
+        statistics.points_per_second = static_cast<double>(statistics.number_of_points) / statistics.wall_time_s;
+        statistics.realtime_factor = statistics.sequence_duration_s / statistics.wall_time_s;
+    }
+
+    return statistics;
+}
+
+void BatchSegmenter::segmentChunk(const std::vector<std::filesystem::path> &cloud_paths, const std::size_t first,
+                                  const std::size_t last, const std::filesystem::path &output_path)
+{
+    // At most one chunk runs per thread of the pool, which has a worker per thread
+    Worker *worker = nullptr;
+    {
+        std::lock_guard<std::mutex> lock{idle_workers_mutex_};
+        worker = idle_workers_.back();
+        idle_workers_.pop_back();
+    }
+
+    const auto release_worker = [this, worker]() {
+        std::lock_guard<std::mutex> lock{idle_workers_mutex_};
+        idle_workers_.push_back(worker);
+    };
+
+    try
+    {
+        segmentRun(*worker, cloud_paths, first, first, last, output_path);
+    }
+    catch (...)
+    {
+        release_worker();
+        throw;
+    }
+    release_worker();
+}
+
+void BatchSegmenter::segmentRun(Worker &worker, const std::vector<std::filesystem::path> &cloud_paths,
+                                const std::size_t warm_up_first, const std::size_t first, const std::size_t last,
+                                const std::filesystem::path &output_path)
+{
+    const data_types_lib::PointCloudLayout layout = cartesianReturnLayout();
+
+    utilities_lib::MappedFile cloud_file;
+    for (std::size_t frame = warm_up_first; frame < last; ++frame)
+    {
+        utilities_lib::mapPointCloudDataFromBinFile(cloud_paths[frame], cloud_file);
+        if (cloud_file.empty())
+        {
+            throw std::runtime_error("Could not map the cloud " + cloud_paths[frame].string());
+        }
+
+        const auto number_of_points =
+            static_cast<std::uint32_t>(cloud_file.size() / sizeof(data_types_lib::CartesianReturn));
+        const data_types_lib::PointCloudView cloud{reinterpret_cast<const std::uint8_t *>(cloud_file.data()),
+                                                   number_of_points, 1U, number_of_points * layout.point_step,
+                                                   layout};
+
+        // Labels are written per point of the file, the points cropped off remain UNKNOWN
+        const std::vector<data_types_lib::SegmentationLabel> *cloud_labels = &worker.labels;
+        if (crop_ != nullptr)
+        {
+            crop_->run(cloud, worker.crop_indices);
+            filtering::ingestPointCloud(
+                data_types_lib::PointCloudView{cloud, worker.crop_indices.data(), worker.crop_indices.size()},
+                worker.cloud);
+            worker.segmenter->run(worker.cloud, worker.labels);
+
+            worker.cloud_labels.resize(number_of_points);
+            std::fill(worker.cloud_labels.begin(), worker.cloud_labels.end(),
+                      data_types_lib::SegmentationLabel::UNKNOWN);
+            for (std::size_t i = 0U; i < worker.crop_indices.size(); ++i)
+            {
+                worker.cloud_labels[worker.crop_indices[i]] = worker.labels[i];
+            }
+            cloud_labels = &worker.cloud_labels;
+        }
+        else
+        {
+            filtering::ingestPointCloud(cloud, worker.cloud);
+            worker.segmenter->run(worker.cloud, worker.labels);
+        }
+
+        // Warm-up frames only update the ground model
+        if (frame < first)
+        {
+            continue;
+        }
+
+        std::filesystem::path label_path = output_path / cloud_paths[frame].filename();
+        label_path.replace_extension(LABEL_FILE_EXTENSION);
+        std::ofstream label_file{label_path, std::ios::binary | std::ios::trunc};
+        const std::size_t label_bytes = cloud_labels->size() * sizeof(data_types_lib::SegmentationLabel);
+        label_file.write(reinterpret_cast<const char *>(cloud_labels->data()),
+                         static_cast<std::streamsize>(label_bytes));
+        if (!label_file.good())
+        {
+            throw std::runtime_error("Could not write the labels " + label_path.string());
+        }
+
+        worker.number_of_points += number_of_points;
+    }
+}
+} // namespace lidar_processing_lib::batch
@@ -0,0 +1,229 @@
+#include <lidar_processing_lib/clustering/cartesian_dbscan.hpp>
+
+#include <algorithm> // std::max
+
+namespace lidar_processing_lib::clustering
+{
+CartesianDBSCAN::CartesianDBSCAN(float epsilon, std::uint32_t min_points, std::uint32_t thread_count)
+    : epsilon_(epsilon), min_points_(std::max(min_points, 1U)), thread_count_(std::max(thread_count, 1U)),
+      voxel_grid_(epsilon, MAX_CLOUD_POINTS), core_sets_(MAX_CLOUD_POINTS)
+{
+    if (!(epsilon_ > 0.0F))
+    {
+        throw std::runtime_error("Epsilon of CartesianDBSCAN must be positive!");
+    }
+
+    neighbour_counts_.reserve(MAX_CLOUD_POINTS);
+    core_flags_.reserve(MAX_CLOUD_POINTS);
+    border_cores_.reserve(MAX_CLOUD_POINTS);
+    set_labels_.reserve(MAX_CLOUD_POINTS);
+
+    // Grows with the largest number of occupied voxels seen, capacity is kept across frames
+    neighbour_voxels_.reserve(VoxelHashGrid::NEIGHBOURHOOD_SIZE * (MAX_CLOUD_POINTS / 16U));
+
+    if (thread_count_ > 1U)
+    {
+        thread_pool_ = std::make_unique<utilities_lib::ThreadPool>(thread_count_);
+    }
+}
+
+CartesianDBSCAN::~CartesianDBSCAN()
+{
+}
+
+void CartesianDBSCAN::run(const pcl::PointCloud<pcl::PointXYZ> &cloud, std::vector<ClusteringLabel> &labels)
+{
+    cluster(cloud, labels);
+}
+
+void CartesianDBSCAN::run(const pcl::PointCloud<pcl::PointXYZI> &cloud, std::vector<ClusteringLabel> &labels)
+{
+    cluster(cloud, labels);
+}
+
+void CartesianDBSCAN::run(const data_types_lib::PointCloudView &cloud, std::vector<ClusteringLabel> &labels)
+{
+    cluster(cloud, labels);
+}
+
+void CartesianDBSCAN::run(const data_types_lib::PointCloudSoA &cloud, std::vector<ClusteringLabel> &labels)
+{
+    cluster(cloud, labels);
+}
+
+void CartesianDBSCAN::clusterEmbeddedPoints(std::vector<ClusteringLabel> &labels)
+{
+    const std::uint32_t number_of_voxels = voxel_grid_.numberOfVoxels();
+    const auto number_of_points = static_cast<std::uint32_t>(voxel_grid_.size());
+
+    neighbour_counts_.resize(number_of_voxels);
+    neighbour_voxels_.resize(static_cast<std::size_t>(number_of_voxels) * VoxelHashGrid::NEIGHBOURHOOD_SIZE);
+    core_flags_.assign(number_of_points, 0U);
+    border_cores_.assign(number_of_points, NO_CORE_POINT);
+    core_sets_.reset(number_of_points);
+
+    // Every stage only writes the entries of its own voxels, or merges sets through the lock-free union-find
+    forEachVoxelRange([this](std::uint32_t first, std::uint32_t last) { findCorePoints(first, last); });
+    forEachVoxelRange([this](std::uint32_t first, std::uint32_t last) { uniteCorePoints(first, last); });
+    forEachVoxelRange([this](std::uint32_t first, std::uint32_t last) { findBorderCores(first, last); });
+
+    // Clusters are numbered in the order of their roots, which does not depend on the number of workers
+    const auto &points = voxel_grid_.points();
+    set_labels_.assign(number_of_points, static_cast<ClusteringLabel>(ReservedClusteringLabel::UNKNOWN));
+    ClusteringLabel next_label = 0;
+    for (std::uint32_t position = 0U; position < number_of_points; ++position)
+    {
+        const std::uint32_t core_position = (core_flags_[position] != 0U) ? position : border_cores_[position];
+        if (core_position == NO_CORE_POINT)
+        {
+            labels[points[position].index] = static_cast<ClusteringLabel>(ReservedClusteringLabel::OUTLIER);
+            continue;
+        }
+
+        ClusteringLabel &set_label = set_labels_[core_sets_.find(core_position)];
+        if (set_label < 0)
+        {
+            set_label = next_label++;
+        }
+        labels[points[position].index] = set_label;
+    }
+}
+
+void CartesianDBSCAN::findCorePoints(const std::uint32_t first_voxel, const std::uint32_t last_voxel)
+{
+    const auto &points = voxel_grid_.points();
+    const float squared_epsilon = epsilon_ * epsilon_;
+
+    for (std::uint32_t voxel_index = first_voxel; voxel_index < last_voxel; ++voxel_index)
+    {
+        std::uint32_t *const neighbours =
+            neighbour_voxels_.data() + (static_cast<std::size_t>(voxel_index) * VoxelHashGrid::NEIGHBOURHOOD_SIZE);
+        const std::uint32_t number_of_neighbours = voxel_grid_.findNeighbourVoxels(voxel_index, neighbours);
+        neighbour_counts_[voxel_index] = static_cast<std::uint8_t>(number_of_neighbours);
+
+        for (std::uint32_t position = voxel_grid_.voxelOffset(voxel_index);
+             position < voxel_grid_.voxelOffset(voxel_index + 1U); ++position)
+        {
+            const VoxelGridPoint &point = points[position];
+
+            // Counting stops as soon as the point is known to be a core point
+            std::uint32_t number_of_neighbour_points = 0U;
+            for (std::uint32_t k = 0U; (k < number_of_neighbours) && (number_of_neighbour_points < min_points_); ++k)
+            {
+                for (const auto &neighbour_point : voxel_grid_.voxel(neighbours[k]))
+                {
+                    const float dx = neighbour_point.x - point.x;
+                    const float dy = neighbour_point.y - point.y;
+                    const float dz = neighbour_point.z - point.z;
+                    if (((dx * dx) + (dy * dy) + (dz * dz)) <= squared_epsilon)
+                    {
+                        ++number_of_neighbour_points;
+                    }
+                }
+            }
+
+            core_flags_[position] = (number_of_neighbour_points >= min_points_) ? 1U : 0U;
+        }
+    }
+}
+
+void CartesianDBSCAN::uniteCorePoints(const std::uint32_t first_voxel, const std::uint32_t last_voxel)
+{
+    const auto &points = voxel_grid_.points();
+    const float squared_epsilon = epsilon_ * epsilon_;
+
+    for (std::uint32_t voxel_index = first_voxel; voxel_index < last_voxel; ++voxel_index)
+    {
+        const std::uint32_t *const neighbours =
+            neighbour_voxels_.data() + (static_cast<std::size_t>(voxel_index) * VoxelHashGrid::NEIGHBOURHOOD_SIZE);
+        const std::uint32_t number_of_neighbours = neighbour_counts_[voxel_index];
+
+        for (std::uint32_t position = voxel_grid_.voxelOffset(voxel_index);
+             position < voxel_grid_.voxelOffset(voxel_index + 1U); ++position)
+        {
+            if (core_flags_[position] == 0U)
+            {
+                continue;
+            }
+
+            const VoxelGridPoint &point = points[position];
+            for (std::uint32_t k = 0U; k < number_of_neighbours; ++k)
+            {
+                const std::uint32_t neighbour_index = neighbours[k];
+                if (neighbour_index < voxel_index)
+                {
+                    continue;
+                }
+
+                // Pairs within the voxel itself are tested once
+                const std::uint32_t first_position =
+                    (neighbour_index == voxel_index) ? (position + 1U) : voxel_grid_.voxelOffset(neighbour_index);
+                for (std::uint32_t neighbour_position = first_position;
+                     neighbour_position < voxel_grid_.voxelOffset(neighbour_index + 1U); ++neighbour_position)
+                {
+                    if (core_flags_[neighbour_position] == 0U)
+                    {
+                        continue;
+                    }
+
+                    const VoxelGridPoint &neighbour_point = points[neighbour_position];
+                    const float dx = neighbour_point.x - point.x;
+                    const float dy = neighbour_point.y - point.y;
+                    const float dz = neighbour_point.z - point.z;
+                    if (((dx * dx) + (dy * dy) + (dz * dz)) <= squared_epsilon)
+                    {
+                        core_sets_.unite(position, neighbour_position);
+                    }
+                }
+            }
+        }
+    }
+}
+
+void CartesianDBSCAN::findBorderCores(const std::uint32_t first_voxel, const std::uint32_t last_voxel)
+{
+    const auto &points = voxel_grid_.points();
+    const float squared_epsilon = epsilon_ * epsilon_;
+
+    for (std::uint32_t voxel_index = first_voxel; voxel_index < last_voxel; ++voxel_index)
+    {
+        const std::uint32_t *const neighbours =
+            neighbour_voxels_.data() + (static_cast<std::size_t>(voxel_index) * VoxelHashGrid::NEIGHBOURHOOD_SIZE);
+        const std::uint32_t number_of_neighbours = neighbour_counts_[voxel_index];
+
+        for (std::uint32_t position = voxel_grid_.voxelOffset(voxel_index);
+             position < voxel_grid_.voxelOffset(voxel_index + 1U); ++position)
+        {
+            if (core_flags_[position] != 0U)
+            {
+                continue;
+            }
+
+            // The first core point found in the grid order is taken, so border points are assigned deterministically
+            const VoxelGridPoint &point = points[position];
+            for (std::uint32_t k = 0U; (k < number_of_neighbours) && (border_cores_[position] == NO_CORE_POINT); ++k)
+            {
+                const std::uint32_t neighbour_index = neighbours[k];
+                for (std::uint32_t neighbour_position = voxel_grid_.voxelOffset(neighbour_index);
+                     neighbour_position < voxel_grid_.voxelOffset(neighbour_index + 1U); ++neighbour_position)
+                {
+                    if (core_flags_[neighbour_position] == 0U)
+                    {
+                        continue;
+                    }
+
+                    const VoxelGridPoint &neighbour_point = points[neighbour_position];
+                    const float dx = neighbour_point.x - point.x;
+                    const float dy = neighbour_point.y - point.y;
+                    const float dz = neighbour_point.z - point.z;
+                    if (((dx * dx) + (dy * dy) + (dz * dz)) <= squared_epsilon)
+                    {
+                        border_cores_[position] = neighbour_position;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+}
+} // namespace lidar_processing_lib::clustering
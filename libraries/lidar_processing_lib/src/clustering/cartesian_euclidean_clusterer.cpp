@@ -1,9 +1,27 @@
 #include <lidar_processing_lib/clustering/cartesian_euclidean_clusterer.hpp>
 
+#include <algorithm> // std::min, std::max
+
 namespace lidar_processing_lib::clustering
 {
-CartesianEuclideanClusterer::CartesianEuclideanClusterer()
+CartesianEuclideanClusterer::CartesianEuclideanClusterer(float cluster_tolerance, std::uint32_t min_cluster_size,
+                                                         std::uint32_t max_cluster_size)
+    : cluster_tolerance_(cluster_tolerance), min_cluster_size_(min_cluster_size), max_cluster_size_(max_cluster_size),
+      voxel_grid_(cluster_tolerance, MAX_CLOUD_POINTS), frontier_(MAX_CLOUD_POINTS)
 {
+    if (!(cluster_tolerance_ > 0.0F))
+    {
+        throw std::runtime_error("Cluster tolerance of CartesianEuclideanClusterer must be positive!");
+    }
+
+    unlabelled_counts_.reserve(MAX_CLOUD_POINTS);
+    pending_ends_.reserve(MAX_CLOUD_POINTS);
+    neighbour_counts_.reserve(MAX_CLOUD_POINTS);
+    cluster_sizes_.reserve(MAX_CLOUD_POINTS);
+    cluster_labels_.reserve(MAX_CLOUD_POINTS);
+
+    // Grows with the largest number of occupied voxels seen, capacity is kept across frames
+    neighbour_voxels_.reserve(VoxelHashGrid::NEIGHBOURHOOD_SIZE * (MAX_CLOUD_POINTS / 16U));
 }
 
 CartesianEuclideanClusterer::~CartesianEuclideanClusterer()
@@ -20,4 +38,210 @@ void CartesianEuclideanClusterer::run(const pcl::PointCloud<pcl::PointXYZI> &clo
 {
     cluster(cloud, labels);
 }
+
+void CartesianEuclideanClusterer::run(const data_types_lib::PointCloudView &cloud, std::vector<ClusteringLabel> &labels)
+{
+    cluster(cloud, labels);
+}
+
+void CartesianEuclideanClusterer::run(const data_types_lib::PointCloudSoA &cloud, std::vector<ClusteringLabel> &labels)
+{
+    cluster(cloud, labels);
+}
+
+std::uint32_t *CartesianEuclideanClusterer::resolveNeighbourVoxels(const std::uint32_t voxel_index)
+{
+    std::uint32_t *const neighbours =
+        neighbour_voxels_.data() + (static_cast<std::size_t>(voxel_index) * VoxelHashGrid::NEIGHBOURHOOD_SIZE);
+
+    // Drops the neighbours without unlabelled points once, when the voxel is first reached, they stay exhausted
+    if ((neighbour_counts_[voxel_index] & NEIGHBOURS_NOT_COMPACTED) != 0U)
+    {
+        const std::uint32_t number_of_neighbours = neighbour_counts_[voxel_index] & NEIGHBOUR_COUNT_MASK;
+        std::uint32_t number_of_live_neighbours = 0U;
+        for (std::uint32_t k = 0U; k < number_of_neighbours; ++k)
+        {
+            neighbours[number_of_live_neighbours] = neighbours[k];
+            number_of_live_neighbours += (unlabelled_counts_[neighbours[k]] > 0U) ? 1U : 0U;
+        }
+        neighbour_counts_[voxel_index] = static_cast<std::uint8_t>(number_of_live_neighbours);
+    }
+
+    return neighbours;
+}
+
+void CartesianEuclideanClusterer::growClusters(std::vector<ClusteringLabel> &labels)
+{
+    auto &points = voxel_grid_.points();
+    const std::uint32_t number_of_voxels = voxel_grid_.numberOfVoxels();
+
+    unlabelled_counts_.resize(number_of_voxels);
+    pending_ends_.resize(number_of_voxels);
+    neighbour_counts_.assign(number_of_voxels, NEIGHBOURS_NOT_COMPACTED);
+    neighbour_voxels_.resize(static_cast<std::size_t>(number_of_voxels) * VoxelHashGrid::NEIGHBOURHOOD_SIZE);
+
+    // Every voxel is its own neighbour, each adjacent pair is looked up once and appended to the lists of both voxels
+    const auto appendNeighbour = [this](const std::uint32_t voxel_index, const std::uint32_t neighbour_index) {
+        const std::uint32_t position = neighbour_counts_[voxel_index]++ & NEIGHBOUR_COUNT_MASK;
+        neighbour_voxels_[(static_cast<std::size_t>(voxel_index) * VoxelHashGrid::NEIGHBOURHOOD_SIZE) + position] =
+            neighbour_index;
+    };
+    std::uint32_t forward_neighbours[VoxelHashGrid::FORWARD_NEIGHBOURHOOD_SIZE];
+    for (std::uint32_t voxel_index = 0U; voxel_index < number_of_voxels; ++voxel_index)
+    {
+        appendNeighbour(voxel_index, voxel_index);
+        const std::uint32_t number_of_forward_neighbours =
+            voxel_grid_.findForwardNeighbourVoxels(voxel_index, forward_neighbours);
+        for (std::uint32_t k = 0U; k < number_of_forward_neighbours; ++k)
+        {
+            appendNeighbour(voxel_index, forward_neighbours[k]);
+            appendNeighbour(forward_neighbours[k], voxel_index);
+        }
+    }
+    cluster_sizes_.clear();
+
+    for (std::uint32_t voxel_index = 0U; voxel_index < number_of_voxels; ++voxel_index)
+    {
+        unlabelled_counts_[voxel_index] =
+            voxel_grid_.voxelOffset(voxel_index + 1U) - voxel_grid_.voxelOffset(voxel_index);
+        pending_ends_[voxel_index] = unlabelled_counts_[voxel_index];
+    }
+
+    const float squared_tolerance = cluster_tolerance_ * cluster_tolerance_;
+
+    for (std::uint32_t seed_voxel_index = 0U; seed_voxel_index < number_of_voxels; ++seed_voxel_index)
+    {
+        while (unlabelled_counts_[seed_voxel_index] > 0U)
+        {
+            const auto cluster_index = static_cast<ClusteringLabel>(cluster_sizes_.size());
+            std::uint32_t cluster_size = 1U;
+
+            // Seed with the last unlabelled point of the voxel, which becomes its only pending point
+            const std::uint32_t seed_position =
+                voxel_grid_.voxelOffset(seed_voxel_index) + (--unlabelled_counts_[seed_voxel_index]);
+            labels[points[seed_position].index] = cluster_index;
+            frontier_.push(seed_voxel_index);
+
+            while (!frontier_.empty())
+            {
+                const std::uint32_t voxel_index = frontier_.front();
+                frontier_.pop();
+
+                // Take the pending points of the voxel as the batch, points of the voxel clustered from here on
+                // become pending again and queue the voxel
+                const VoxelGridPoint *const voxel_points = points.data() + voxel_grid_.voxelOffset(voxel_index);
+                const VoxelGridPoint *const batch_begin = voxel_points + unlabelled_counts_[voxel_index];
+                const VoxelGridPoint *const batch_end = voxel_points + pending_ends_[voxel_index];
+                pending_ends_[voxel_index] = unlabelled_counts_[voxel_index];
+
+                // Candidates farther than the tolerance from the bounding box of the batch are rejected without
+                // testing the batch points
+                BoundingBox batch_box{batch_begin->x, batch_begin->y, batch_begin->z,
+                                      batch_begin->x, batch_begin->y, batch_begin->z};
+                for (const VoxelGridPoint *point = batch_begin + 1; point != batch_end; ++point)
+                {
+                    batch_box.min_x = std::min(batch_box.min_x, point->x);
+                    batch_box.min_y = std::min(batch_box.min_y, point->y);
+                    batch_box.min_z = std::min(batch_box.min_z, point->z);
+                    batch_box.max_x = std::max(batch_box.max_x, point->x);
+                    batch_box.max_y = std::max(batch_box.max_y, point->y);
+                    batch_box.max_z = std::max(batch_box.max_z, point->z);
+                }
+
+                std::uint32_t *const neighbours = resolveNeighbourVoxels(voxel_index);
+                std::uint8_t &number_of_neighbours = neighbour_counts_[voxel_index];
+                const std::size_t batch_size = static_cast<std::size_t>(batch_end - batch_begin);
+
+                for (std::uint32_t k = 0U; k < number_of_neighbours;)
+                {
+                    const std::uint32_t neighbour_index = neighbours[k];
+                    std::uint32_t &unlabelled_count = unlabelled_counts_[neighbour_index];
+
+                    // Exhausted voxels stay exhausted
+                    if (unlabelled_count == 0U)
+                    {
+                        neighbours[k] = neighbours[--number_of_neighbours];
+                        continue;
+                    }
+                    ++k;
+
+                    // Partitions the unlabelled points of the neighbour, the connected ones are moved behind the
+                    // remaining ones without branching on the unpredictable outcome
+                    VoxelGridPoint *const neighbour_points = points.data() + voxel_grid_.voxelOffset(neighbour_index);
+                    const std::uint32_t candidate_count = unlabelled_count;
+                    std::uint32_t remaining_count = 0U;
+                    const auto partition = [neighbour_points, &remaining_count](const std::uint32_t i,
+                                                                                const bool connected) noexcept {
+                        const VoxelGridPoint candidate = neighbour_points[i];
+                        neighbour_points[i] = neighbour_points[remaining_count];
+                        neighbour_points[remaining_count] = candidate;
+                        remaining_count += connected ? 0U : 1U;
+                    };
+
+                    if (batch_size <= SMALL_BATCH_SIZE)
+                    {
+                        // Small batches are tested completely, which is cheaper than the bounding box and the early
+                        // exit
+                        for (std::uint32_t i = 0U; i < candidate_count; ++i)
+                        {
+                            const VoxelGridPoint &candidate = neighbour_points[i];
+                            bool connected = false;
+                            for (const VoxelGridPoint *point = batch_begin; point != batch_end; ++point)
+                            {
+                                const float dx = candidate.x - point->x;
+                                const float dy = candidate.y - point->y;
+                                const float dz = candidate.z - point->z;
+                                connected |= (((dx * dx) + (dy * dy) + (dz * dz)) <= squared_tolerance);
+                            }
+                            partition(i, connected);
+                        }
+                    }
+                    else
+                    {
+                        for (std::uint32_t i = 0U; i < candidate_count; ++i)
+                        {
+                            const VoxelGridPoint &candidate = neighbour_points[i];
+                            bool connected = false;
+                            if (batch_box.squaredDistance(candidate.x, candidate.y, candidate.z) <= squared_tolerance)
+                            {
+                                for (const VoxelGridPoint *point = batch_begin; point != batch_end; ++point)
+                                {
+                                    const float dx = candidate.x - point->x;
+                                    const float dy = candidate.y - point->y;
+                                    const float dz = candidate.z - point->z;
+                                    if (((dx * dx) + (dy * dy) + (dz * dz)) <= squared_tolerance)
+                                    {
+                                        connected = true;
+                                        break;
+                                    }
+                                }
+                            }
+                            partition(i, connected);
+                        }
+                    }
+
+                    if (remaining_count == candidate_count)
+                    {
+                        continue;
+                    }
+
+                    // The connected points become pending points of the neighbour
+                    for (std::uint32_t i = remaining_count; i < candidate_count; ++i)
+                    {
+                        labels[neighbour_points[i].index] = cluster_index;
+                    }
+                    cluster_size += candidate_count - remaining_count;
+
+                    if (candidate_count == pending_ends_[neighbour_index])
+                    {
+                        frontier_.push(neighbour_index);
+                    }
+                    unlabelled_count = remaining_count;
+                }
+            }
+
+            cluster_sizes_.push_back(cluster_size);
+        }
+    }
+}
 } // namespace lidar_processing_lib::clustering
@@ -0,0 +1,215 @@
+#include <lidar_processing_lib/clustering/range_image_clusterer.hpp>
+
+#include <cmath>     // std::sin, std::cos
+#include <stdexcept> // std::runtime_error
+#include <utility>   // std::move
+
+namespace lidar_processing_lib::clustering
+{
+RangeImageClusterer::RangeImageClusterer(std::shared_ptr<DepthImage> depth_image, float angle_threshold_deg,
+                                         std::uint32_t min_cluster_size, std::uint32_t max_cluster_size)
+    : depth_image_(std::move(depth_image)), min_cluster_size_(min_cluster_size), max_cluster_size_(max_cluster_size)
+{
+    if (!(angle_threshold_deg > 0.0F) || !(angle_threshold_deg < 90.0F))
+    {
+        throw std::runtime_error("Angle threshold of RangeImageClusterer must be within (0, 90) degrees!");
+    }
+
+    if (depth_image_ == nullptr)
+    {
+        depth_image_ = std::make_shared<DepthImage>();
+    }
+
+    const float angle_threshold_rad = angle_threshold_deg * segmentation::DEG_TO_RAD;
+    sin_angle_threshold_ = std::sin(angle_threshold_rad);
+    cos_angle_threshold_ = std::cos(angle_threshold_rad);
+
+    // Angular steps between the columns and between the rows of the image
+    const auto &profile = depth_image_->profile();
+    const float horizontal_step_rad = static_cast<float>(2.0 * M_PI) / static_cast<float>(depth_image_->width());
+    const float vertical_step_rad = (profile.maxElevationRad() - profile.minElevationRad()) /
+                                    static_cast<float>(depth_image_->height());
+
+    for (std::uint32_t step = 0U; step <= MAX_PIXEL_GAP; ++step)
+    {
+        const auto number_of_steps = static_cast<float>(step + 1U);
+        horizontal_sines_[step] = std::sin(number_of_steps * horizontal_step_rad);
+        horizontal_cosines_[step] = std::cos(number_of_steps * horizontal_step_rad);
+        vertical_sines_[step] = std::sin(number_of_steps * vertical_step_rad);
+        vertical_cosines_[step] = std::cos(number_of_steps * vertical_step_rad);
+    }
+
+    // Sized once for the sensor of the depth image
+    parents_.assign(depth_image_->pixels().size(), INACTIVE_PIXEL);
+    pixel_labels_.assign(depth_image_->pixels().size(), static_cast<ClusteringLabel>(ReservedClusteringLabel::UNKNOWN));
+    cluster_sizes_.reserve(profile.max_cloud_points);
+    cluster_labels_.reserve(profile.max_cloud_points);
+}
+
+RangeImageClusterer::~RangeImageClusterer()
+{
+}
+
+void RangeImageClusterer::run(const pcl::PointCloud<pcl::PointXYZ> &cloud, std::vector<ClusteringLabel> &labels)
+{
+    cluster(cloud, labels);
+}
+
+void RangeImageClusterer::run(const pcl::PointCloud<pcl::PointXYZI> &cloud, std::vector<ClusteringLabel> &labels)
+{
+    cluster(cloud, labels);
+}
+
+void RangeImageClusterer::run(const data_types_lib::PointCloudView &cloud, std::vector<ClusteringLabel> &labels)
+{
+    cluster(cloud, labels);
+}
+
+void RangeImageClusterer::run(const data_types_lib::PointCloudSoA &cloud, std::vector<ClusteringLabel> &labels)
+{
+    cluster(cloud, labels);
+}
+
+void RangeImageClusterer::clusterObstacles(const std::vector<SegmentationLabel> &segmentation_labels,
+                                           std::vector<ClusteringLabel> &labels)
+{
+    const auto &point_pixels = depth_image_->pointPixels();
+    if (point_pixels.size() != segmentation_labels.size())
+    {
+        throw std::runtime_error("Depth image of RangeImageClusterer was not built from the segmented cloud!");
+    }
+
+    const auto isObstacle = [](const SegmentationLabel label) noexcept {
+        return (label == SegmentationLabel::OBSTACLE) || (label == SegmentationLabel::TRANSITIONAL_OBSTACLE);
+    };
+
+    // Only pixels holding an obstacle point take part in clustering
+    const auto &pixels = depth_image_->pixels();
+    for (std::uint32_t pixel_index = 0U; pixel_index < static_cast<std::uint32_t>(pixels.size()); ++pixel_index)
+    {
+        const std::uint32_t point_index = pixels[pixel_index].index;
+        parents_[pixel_index] =
+            ((point_index != DepthImage::Pixel::INVALID_INDEX) && isObstacle(segmentation_labels[point_index]))
+                ? pixel_index
+                : INACTIVE_PIXEL;
+    }
+
+    labelComponents();
+
+    // Obstacle points occluded by a closer point of another class in their pixel are outliers
+    labels.clear();
+    for (std::size_t i = 0U; i < segmentation_labels.size(); ++i)
+    {
+        if (!isObstacle(segmentation_labels[i]))
+        {
+            continue;
+        }
+
+        const std::uint32_t pixel_index = point_pixels[i];
+        if ((pixel_index == DepthImage::INVALID_PIXEL) || (parents_[pixel_index] == INACTIVE_PIXEL))
+        {
+            labels.push_back(static_cast<ClusteringLabel>(ReservedClusteringLabel::OUTLIER));
+            continue;
+        }
+
+        const ClusteringLabel label = pixel_labels_[pixel_index];
+        labels.push_back(label);
+        ++cluster_sizes_[static_cast<std::size_t>(label)];
+    }
+
+    filterClusters(labels);
+}
+
+void RangeImageClusterer::labelComponents()
+{
+    const auto &pixels = depth_image_->pixels();
+    const std::uint32_t width = depth_image_->width();
+    const std::uint32_t height = depth_image_->height();
+
+    // First pass, unite every pixel with its nearest active neighbours to the left (wrapping around the full turn) and
+    // above, together they cover all neighbouring pairs of the image
+    for (std::uint32_t y = 0U; y < height; ++y)
+    {
+        for (std::uint32_t x = 0U; x < width; ++x)
+        {
+            const std::uint32_t pixel_index = (y * width) + x;
+            if (parents_[pixel_index] == INACTIVE_PIXEL)
+            {
+                continue;
+            }
+
+            const float range = pixels[pixel_index].range;
+
+            for (std::uint32_t step = 0U; step <= MAX_PIXEL_GAP; ++step)
+            {
+                const std::uint32_t neighbour_x = (x > step) ? (x - step - 1U) : (x + width - step - 1U);
+                const std::uint32_t neighbour_index = (y * width) + neighbour_x;
+                if (parents_[neighbour_index] != INACTIVE_PIXEL)
+                {
+                    if (areConnected(range, pixels[neighbour_index].range, horizontal_sines_[step],
+                                     horizontal_cosines_[step]))
+                    {
+                        unite(pixel_index, neighbour_index);
+                    }
+                    break;
+                }
+            }
+
+            for (std::uint32_t step = 0U; (step <= MAX_PIXEL_GAP) && (step < y); ++step)
+            {
+                const std::uint32_t neighbour_index = ((y - step - 1U) * width) + x;
+                if (parents_[neighbour_index] != INACTIVE_PIXEL)
+                {
+                    if (areConnected(range, pixels[neighbour_index].range, vertical_sines_[step],
+                                     vertical_cosines_[step]))
+                    {
+                        unite(pixel_index, neighbour_index);
+                    }
+                    break;
+                }
+            }
+        }
+    }
+
+    // Second pass, roots precede the other pixels of their components, so they are labelled first
+    ClusteringLabel next_label = 0;
+    for (std::uint32_t pixel_index = 0U; pixel_index < static_cast<std::uint32_t>(pixels.size()); ++pixel_index)
+    {
+        if (parents_[pixel_index] == INACTIVE_PIXEL)
+        {
+            continue;
+        }
+
+        const std::uint32_t root_index = findRoot(pixel_index);
+        pixel_labels_[pixel_index] = (root_index == pixel_index) ? next_label++ : pixel_labels_[root_index];
+    }
+
+    cluster_sizes_.assign(static_cast<std::size_t>(next_label), 0U);
+}
+
+void RangeImageClusterer::filterClusters(std::vector<ClusteringLabel> &labels)
+{
+    // Clusters outside of the size limits are outliers, the remaining ones are numbered consecutively
+    ClusteringLabel next_label = 0;
+    cluster_labels_.clear();
+    for (const auto cluster_size : cluster_sizes_)
+    {
+        if ((cluster_size >= min_cluster_size_) && (cluster_size <= max_cluster_size_))
+        {
+            cluster_labels_.push_back(next_label++);
+        }
+        else
+        {
+            cluster_labels_.push_back(static_cast<ClusteringLabel>(ReservedClusteringLabel::OUTLIER));
+        }
+    }
+
+    for (auto &label : labels)
+    {
+        if (label >= 0)
+        {
+            label = cluster_labels_[static_cast<std::size_t>(label)];
+        }
+    }
+}
+} // namespace lidar_processing_lib::clustering
@@ -0,0 +1,181 @@
+#include <lidar_processing_lib/clustering/voxel_hash_grid.hpp>
+
+#include <algorithm> // std::fill, std::copy, std::min, std::max
+#include <array>     // std::array
+
+namespace lidar_processing_lib::clustering
+{
+namespace
+{
+constexpr std::int64_t keyOffset(const std::int64_t dx, const std::int64_t dy, const std::int64_t dz) noexcept
+{
+    return (dx * (std::int64_t{1} << (2U * VoxelHashGrid::COORDINATE_BITS))) +
+           (dy * (std::int64_t{1} << VoxelHashGrid::COORDINATE_BITS)) + dz;
+}
+
+// Key differences of the adjacent voxels, adding them to a key wraps around without carrying across the packed
+// coordinates since the neighbours of representable voxels are representable
+constexpr auto NEIGHBOUR_KEY_OFFSETS = []() {
+    std::array<std::uint64_t, VoxelHashGrid::NEIGHBOURHOOD_SIZE> offsets{};
+    std::uint32_t offset_index = 0U;
+    for (std::int64_t dx = -1; dx <= 1; ++dx)
+    {
+        for (std::int64_t dy = -1; dy <= 1; ++dy)
+        {
+            for (std::int64_t dz = -1; dz <= 1; ++dz)
+            {
+                offsets[offset_index++] = static_cast<std::uint64_t>(keyOffset(dx, dy, dz));
+            }
+        }
+    }
+    return offsets;
+}();
+
+// Positive key differences, the opposite adjacent voxel of each has a smaller key
+constexpr auto FORWARD_NEIGHBOUR_KEY_OFFSETS = []() {
+    std::array<std::uint64_t, VoxelHashGrid::FORWARD_NEIGHBOURHOOD_SIZE> offsets{};
+    std::uint32_t offset_index = 0U;
+    for (std::int64_t dx = -1; dx <= 1; ++dx)
+    {
+        for (std::int64_t dy = -1; dy <= 1; ++dy)
+        {
+            for (std::int64_t dz = -1; dz <= 1; ++dz)
+            {
+                if (keyOffset(dx, dy, dz) > 0)
+                {
+                    offsets[offset_index++] = static_cast<std::uint64_t>(keyOffset(dx, dy, dz));
+                }
+            }
+        }
+    }
+    return offsets;
+}();
+} // namespace
+
+VoxelHashGrid::VoxelHashGrid(float voxel_size, std::size_t max_points)
+    : inverse_voxel_size_(1.0F / voxel_size), voxel_offsets_(max_points + 1U, 0U), voxel_cursors_(max_points, 0U)
+{
+    // The table is allocated for max_points, each frame uses the smallest power of two part of it fitting its points
+    resizeSlots(max_points);
+    slot_voxels_.assign(slot_mask_ + 1U, INVALID_VOXEL);
+
+    voxel_keys_.reserve(max_points);
+    voxel_slots_.reserve(max_points);
+    staged_points_.reserve(max_points);
+    staged_voxel_indices_.reserve(max_points);
+    points_.reserve(max_points);
+}
+
+void VoxelHashGrid::clear(const std::size_t number_of_points) noexcept
+{
+    // Only the occupied slots are reset, the cost does not depend on the size of the table
+    for (const auto slot : voxel_slots_)
+    {
+        slot_voxels_[slot] = INVALID_VOXEL;
+    }
+    std::fill(voxel_offsets_.begin(), voxel_offsets_.begin() + voxel_keys_.size() + 1U, 0U);
+
+    voxel_keys_.clear();
+    voxel_slots_.clear();
+    staged_points_.clear();
+    staged_voxel_indices_.clear();
+    points_.clear();
+
+    // The whole table is free, so the number of slots in use can change
+    resizeSlots(std::min(number_of_points, slot_voxels_.size() / 2U));
+}
+
+void VoxelHashGrid::resizeSlots(const std::size_t number_of_points) noexcept
+{
+    // Load factor of the hash table stays below one half
+    std::size_t number_of_slots = 2U;
+    std::uint32_t slot_bits = 1U;
+    while (number_of_slots < (2U * std::max<std::size_t>(number_of_points, 1U)))
+    {
+        number_of_slots <<= 1U;
+        ++slot_bits;
+    }
+
+    slot_mask_ = number_of_slots - 1U;
+    slot_shift_ = 64U - slot_bits;
+}
+
+void VoxelHashGrid::stage(const VoxelCoordinates &coordinates, const VoxelGridPoint &point)
+{
+    const std::uint64_t key = packKey(coordinates);
+
+    std::size_t slot = slotOf(key);
+    std::uint32_t voxel_index = slot_voxels_[slot];
+    while ((voxel_index != INVALID_VOXEL) && (voxel_keys_[voxel_index] != key))
+    {
+        slot = (slot + 1U) & slot_mask_;
+        voxel_index = slot_voxels_[slot];
+    }
+
+    // Occupy a new voxel
+    if (voxel_index == INVALID_VOXEL)
+    {
+        voxel_index = static_cast<std::uint32_t>(voxel_keys_.size());
+        slot_voxels_[slot] = voxel_index;
+        voxel_keys_.push_back(key);
+        voxel_slots_.push_back(static_cast<std::uint32_t>(slot));
+    }
+
+    staged_points_.push_back(point);
+    staged_voxel_indices_.push_back(voxel_index);
+    ++voxel_offsets_[voxel_index + 1U];
+}
+
+std::uint32_t VoxelHashGrid::findNeighbourVoxels(const std::uint32_t voxel_index,
+                                                 std::uint32_t *neighbours) const noexcept
+{
+    const std::uint64_t key = voxel_keys_[voxel_index];
+
+    std::uint32_t number_of_neighbours = 0U;
+    for (const auto key_offset : NEIGHBOUR_KEY_OFFSETS)
+    {
+        const std::uint32_t neighbour_index = findKey(key + key_offset);
+        if (neighbour_index != INVALID_VOXEL)
+        {
+            neighbours[number_of_neighbours++] = neighbour_index;
+        }
+    }
+    return number_of_neighbours;
+}
+
+std::uint32_t VoxelHashGrid::findForwardNeighbourVoxels(const std::uint32_t voxel_index,
+                                                        std::uint32_t *neighbours) const noexcept
+{
+    const std::uint64_t key = voxel_keys_[voxel_index];
+
+    // Whether a neighbour is occupied is not predictable, the lookup result is written either way and kept only when
+    // the voxel is occupied
+    std::uint32_t number_of_neighbours = 0U;
+    for (const auto key_offset : FORWARD_NEIGHBOUR_KEY_OFFSETS)
+    {
+        const std::uint32_t neighbour_index = findKey(key + key_offset);
+        neighbours[number_of_neighbours] = neighbour_index;
+        number_of_neighbours += (neighbour_index != INVALID_VOXEL) ? 1U : 0U;
+    }
+    return number_of_neighbours;
+}
+
+void VoxelHashGrid::build()
+{
+    const std::size_t number_of_voxels = voxel_keys_.size();
+
+    // Counts are stored one slot ahead, so the prefix sum turns them into voxel boundaries
+    for (std::size_t voxel_index = 1U; voxel_index <= number_of_voxels; ++voxel_index)
+    {
+        voxel_offsets_[voxel_index] += voxel_offsets_[voxel_index - 1U];
+    }
+    std::copy(voxel_offsets_.begin(), voxel_offsets_.begin() + number_of_voxels, voxel_cursors_.begin());
+
+    // Scatter, points of a voxel keep the staging order
+    points_.resize(staged_points_.size());
+    for (std::size_t i = 0U; i < staged_points_.size(); ++i)
+    {
+        points_[voxel_cursors_[staged_voxel_indices_[i]]++] = staged_points_[i];
+    }
+}
+} // namespace lidar_processing_lib::clustering
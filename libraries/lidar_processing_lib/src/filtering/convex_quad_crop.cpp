@@ -0,0 +1,233 @@
+#include <lidar_processing_lib/filtering/convex_quad_crop.hpp>
+
+#include <cmath>     // std::isfinite
+#include <limits>    // std::numeric_limits
+#include <stdexcept> // std::runtime_error
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace lidar_processing_lib::filtering
+{
+namespace
+{
+#if defined(__AVX2__)
+constexpr std::size_t LANES = 8U;
+#elif defined(__SSE2__) || defined(__ARM_NEON)
+constexpr std::size_t LANES = 4U;
+#else
+constexpr std::size_t LANES = 1U;
+#endif
+
+// Coordinates with a larger magnitude are infinite, comparisons with NaN fail. Non-finite points are removed
+// explicitly, the distance limit alone keeps infinite coordinates when the limit is infinite
+constexpr float MAX_FINITE = std::numeric_limits<float>::max();
+
+// Components of the edge lines broadcast to the vector lanes
+struct EdgeVectors final
+{
+    std::array<float, ConvexQuadCrop::NUMBER_OF_CORNERS> a;
+    std::array<float, ConvexQuadCrop::NUMBER_OF_CORNERS> b;
+    std::array<float, ConvexQuadCrop::NUMBER_OF_CORNERS> c;
+};
+
+// Scalar test of a single point, used for the tail of the vectorized loop
+inline bool isKeptScalar(const float x, const float y, const EdgeVectors &edges,
+                         const float squared_max_distance) noexcept
+{
+    bool is_outside = false;
+    for (std::size_t e = 0U; e < ConvexQuadCrop::NUMBER_OF_CORNERS; ++e)
+    {
+        is_outside = is_outside || (((edges.a[e] * x) + (edges.b[e] * y) + edges.c[e]) < 0.0F);
+    }
+
+    return is_outside && std::isfinite(x) && std::isfinite(y) && (((x * x) + (y * y)) <= squared_max_distance);
+}
+
+// Bit l of the mask is set when lane l of the block is kept
+inline std::uint32_t keptMask(const float *x, const float *y, const EdgeVectors &edges,
+                              const float squared_max_distance) noexcept
+{
+#if defined(__AVX2__)
+    const __m256 px = _mm256_load_ps(x);
+    const __m256 py = _mm256_load_ps(y);
+    const __m256 zero = _mm256_setzero_ps();
+
+    __m256 is_outside = _mm256_setzero_ps();
+    for (std::size_t e = 0U; e < ConvexQuadCrop::NUMBER_OF_CORNERS; ++e)
+    {
+        __m256 side = _mm256_mul_ps(_mm256_set1_ps(edges.a[e]), px);
+        side = _mm256_add_ps(side, _mm256_mul_ps(_mm256_set1_ps(edges.b[e]), py));
+        side = _mm256_add_ps(side, _mm256_set1_ps(edges.c[e]));
+        is_outside = _mm256_or_ps(is_outside, _mm256_cmp_ps(side, zero, _CMP_LT_OQ));
+    }
+
+    const __m256 squared_distance = _mm256_add_ps(_mm256_mul_ps(px, px), _mm256_mul_ps(py, py));
+    const __m256 is_near = _mm256_cmp_ps(squared_distance, _mm256_set1_ps(squared_max_distance), _CMP_LE_OQ);
+
+    // Comparisons of the magnitudes with NaN fail as well
+    const __m256 sign = _mm256_set1_ps(-0.0F);
+    const __m256 max_finite = _mm256_set1_ps(MAX_FINITE);
+    const __m256 is_finite = _mm256_and_ps(_mm256_cmp_ps(_mm256_andnot_ps(sign, px), max_finite, _CMP_LE_OQ),
+                                           _mm256_cmp_ps(_mm256_andnot_ps(sign, py), max_finite, _CMP_LE_OQ));
+    return static_cast<std::uint32_t>(_mm256_movemask_ps(_mm256_and_ps(_mm256_and_ps(is_outside, is_near), is_finite)));
+#elif defined(__SSE2__)
+    const __m128 px = _mm_load_ps(x);
+    const __m128 py = _mm_load_ps(y);
+    const __m128 zero = _mm_setzero_ps();
+
+    __m128 is_outside = _mm_setzero_ps();
+    for (std::size_t e = 0U; e < ConvexQuadCrop::NUMBER_OF_CORNERS; ++e)
+    {
+        __m128 side = _mm_mul_ps(_mm_set1_ps(edges.a[e]), px);
+        side = _mm_add_ps(side, _mm_mul_ps(_mm_set1_ps(edges.b[e]), py));
+        side = _mm_add_ps(side, _mm_set1_ps(edges.c[e]));
+        is_outside = _mm_or_ps(is_outside, _mm_cmplt_ps(side, zero));
+    }
+
+    const __m128 squared_distance = _mm_add_ps(_mm_mul_ps(px, px), _mm_mul_ps(py, py));
+    const __m128 is_near = _mm_cmple_ps(squared_distance, _mm_set1_ps(squared_max_distance));
+
+    // Comparisons of the magnitudes with NaN fail as well
+    const __m128 sign = _mm_set1_ps(-0.0F);
+    const __m128 max_finite = _mm_set1_ps(MAX_FINITE);
+    const __m128 is_finite = _mm_and_ps(_mm_cmple_ps(_mm_andnot_ps(sign, px), max_finite),
+                                        _mm_cmple_ps(_mm_andnot_ps(sign, py), max_finite));
+    return static_cast<std::uint32_t>(_mm_movemask_ps(_mm_and_ps(_mm_and_ps(is_outside, is_near), is_finite)));
+#elif defined(__ARM_NEON)
+    const float32x4_t px = vld1q_f32(x);
+    const float32x4_t py = vld1q_f32(y);
+    const float32x4_t zero = vdupq_n_f32(0.0F);
+
+    uint32x4_t is_outside = vdupq_n_u32(0U);
+    for (std::size_t e = 0U; e < ConvexQuadCrop::NUMBER_OF_CORNERS; ++e)
+    {
+        float32x4_t side = vmulq_f32(vdupq_n_f32(edges.a[e]), px);
+        side = vaddq_f32(side, vmulq_f32(vdupq_n_f32(edges.b[e]), py));
+        side = vaddq_f32(side, vdupq_n_f32(edges.c[e]));
+        is_outside = vorrq_u32(is_outside, vcltq_f32(side, zero));
+    }
+
+    const float32x4_t squared_distance = vaddq_f32(vmulq_f32(px, px), vmulq_f32(py, py));
+    const uint32x4_t is_near = vcleq_f32(squared_distance, vdupq_n_f32(squared_max_distance));
+
+    // Comparisons of the magnitudes with NaN fail as well
+    const float32x4_t max_finite = vdupq_n_f32(MAX_FINITE);
+    const uint32x4_t is_finite = vandq_u32(vcleq_f32(vabsq_f32(px), max_finite), vcleq_f32(vabsq_f32(py), max_finite));
+    const uint32x4_t is_kept = vandq_u32(vandq_u32(is_outside, is_near), is_finite);
+
+    // Lane l contributes bit l
+    static constexpr std::uint32_t LANE_BITS[LANES] = {1U, 2U, 4U, 8U};
+    return vaddvq_u32(vandq_u32(is_kept, vld1q_u32(LANE_BITS)));
+#else
+    return isKeptScalar(x[0], y[0], edges, squared_max_distance) ? 1U : 0U;
+#endif
+}
+} // namespace
+
+const char *convexQuadCropInstructionSet() noexcept
+{
+#if defined(__AVX2__)
+    return "avx2";
+#elif defined(__SSE2__)
+    return "sse2";
+#elif defined(__ARM_NEON)
+    return "neon";
+#else
+    return "scalar";
+#endif
+}
+
+ConvexQuadCrop::ConvexQuadCrop(const std::array<QuadCorner, NUMBER_OF_CORNERS> &corners, float max_distance)
+    : edges_{}, squared_max_distance_{max_distance * max_distance}
+{
+    if (!(max_distance > 0.0F))
+    {
+        throw std::runtime_error("Maximum distance of ConvexQuadCrop must be positive!");
+    }
+
+    // Turns at the corners all have the sign of the winding order for a convex quadrilateral
+    float winding = 0.0F;
+    for (std::size_t i = 0U; i < NUMBER_OF_CORNERS; ++i)
+    {
+        const QuadCorner &previous = corners[(i + NUMBER_OF_CORNERS - 1U) % NUMBER_OF_CORNERS];
+        const QuadCorner &corner = corners[i];
+        const QuadCorner &next = corners[(i + 1U) % NUMBER_OF_CORNERS];
+
+        const float turn =
+            ((corner.x - previous.x) * (next.y - corner.y)) - ((corner.y - previous.y) * (next.x - corner.x));
+        if (!(turn != 0.0F) || ((winding != 0.0F) && ((turn > 0.0F) != (winding > 0.0F))))
+        {
+            throw std::runtime_error("Corners of ConvexQuadCrop must form a convex quadrilateral!");
+        }
+        winding = turn;
+    }
+
+    // Edge lines are oriented so the inner side is non-negative in both winding orders
+    const float orientation = (winding > 0.0F) ? 1.0F : -1.0F;
+    for (std::size_t i = 0U; i < NUMBER_OF_CORNERS; ++i)
+    {
+        const QuadCorner &start = corners[i];
+        const QuadCorner &end = corners[(i + 1U) % NUMBER_OF_CORNERS];
+
+        edges_[i].a = -orientation * (end.y - start.y);
+        edges_[i].b = orientation * (end.x - start.x);
+        edges_[i].c = -((edges_[i].a * start.x) + (edges_[i].b * start.y));
+    }
+}
+
+void ConvexQuadCrop::run(const data_types_lib::PointCloudView &cloud, CropIndices &kept_indices) const
+{
+    EdgeVectors edges;
+    for (std::size_t e = 0U; e < NUMBER_OF_CORNERS; ++e)
+    {
+        edges.a[e] = edges_[e].a;
+        edges.b[e] = edges_[e].b;
+        edges.c[e] = edges_[e].c;
+    }
+
+    // Written without bounds checks into storage holding every point, only the kept part is touched
+    const std::size_t number_of_points = cloud.points.size();
+    kept_indices.reserve(number_of_points);
+    std::uint32_t *const begin = kept_indices.storage_.get();
+    std::uint32_t *write_position = begin;
+
+    // Coordinates of a block are decoded straight from the buffer of the cloud
+    alignas(32) std::array<float, LANES> x;
+    alignas(32) std::array<float, LANES> y;
+
+    const std::size_t vectorized_end = number_of_points - (number_of_points % LANES);
+    for (std::size_t first = 0U; first < vectorized_end; first += LANES)
+    {
+        for (std::size_t l = 0U; l < LANES; ++l)
+        {
+            const auto point = cloud.points[first + l];
+            x[l] = point.x;
+            y[l] = point.y;
+        }
+
+        std::uint32_t mask = keptMask(x.data(), y.data(), edges, squared_max_distance_);
+        while (mask != 0U)
+        {
+            *write_position++ = static_cast<std::uint32_t>(first) + static_cast<std::uint32_t>(__builtin_ctz(mask));
+            mask &= (mask - 1U);
+        }
+    }
+
+    for (std::size_t i = vectorized_end; i < number_of_points; ++i)
+    {
+        const auto point = cloud.points[i];
+        if (isKeptScalar(point.x, point.y, edges, squared_max_distance_))
+        {
+            *write_position++ = static_cast<std::uint32_t>(i);
+        }
+    }
+
+    kept_indices.size_ = static_cast<std::size_t>(write_position - begin);
+}
+} // namespace lidar_processing_lib::filtering
@@ -0,0 +1,66 @@
+#include <lidar_processing_lib/filtering/point_cloud_ingest.hpp>
+
+#include <cmath>                  // std::sqrt
+#include <utilities_lib/math.hpp> // atan2Approx
+
+namespace lidar_processing_lib::filtering
+{
+void ingestPointCloud(const data_types_lib::PointCloudView &cloud, data_types_lib::PointCloudSoA &soa_cloud)
+{
+    const std::size_t number_of_points = cloud.points.size();
+    soa_cloud.resize(number_of_points);
+
+    float *const x = soa_cloud.x();
+    float *const y = soa_cloud.y();
+    float *const z = soa_cloud.z();
+    float *const intensity = soa_cloud.intensity();
+
+    // Strided or indexed points are decoded once, the derived channels are computed from the contiguous channels
+    for (std::size_t i = 0U; i < number_of_points; ++i)
+    {
+        const auto point = cloud.points[i];
+        x[i] = point.x;
+        y[i] = point.y;
+        z[i] = point.z;
+        intensity[i] = point.intensity;
+    }
+
+    // Same expressions as the stages evaluated per point, so labels do not depend on the cloud type
+    float *const range = soa_cloud.range();
+    float *const horizontal_range = soa_cloud.horizontalRange();
+    for (std::size_t i = 0U; i < number_of_points; ++i)
+    {
+        const float horizontal_range_squared = (x[i] * x[i]) + (y[i] * y[i]);
+        horizontal_range[i] = std::sqrt(horizontal_range_squared);
+        range[i] = std::sqrt(horizontal_range_squared + (z[i] * z[i]));
+    }
+
+    float *const azimuth = soa_cloud.azimuth();
+    for (std::size_t i = 0U; i < number_of_points; ++i)
+    {
+        azimuth[i] = utilities_lib::atan2Approx(y[i], x[i]);
+    }
+}
+
+void selectPoints(const data_types_lib::PointCloudSoA &cloud, const std::uint32_t *indices,
+                  std::size_t number_of_indices, data_types_lib::PointCloudSoA &selected_cloud)
+{
+    selected_cloud.resize(number_of_indices);
+
+    // Channel by channel, each pass gathers from a single source array
+    const auto gather = [indices, number_of_indices](const float *source, float *destination) noexcept {
+        for (std::size_t i = 0U; i < number_of_indices; ++i)
+        {
+            destination[i] = source[indices[i]];
+        }
+    };
+
+    gather(cloud.x(), selected_cloud.x());
+    gather(cloud.y(), selected_cloud.y());
+    gather(cloud.z(), selected_cloud.z());
+    gather(cloud.intensity(), selected_cloud.intensity());
+    gather(cloud.range(), selected_cloud.range());
+    gather(cloud.horizontalRange(), selected_cloud.horizontalRange());
+    gather(cloud.azimuth(), selected_cloud.azimuth());
+}
+} // namespace lidar_processing_lib::filtering
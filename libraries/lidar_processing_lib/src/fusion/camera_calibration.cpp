@@ -0,0 +1,120 @@
+#include <lidar_processing_lib/fusion/camera_calibration.hpp>
+
+#include <cmath>         // std::round
+#include <cstddef>       // std::size_t
+#include <cstdint>       // std::uint16_t
+#include <fstream>       // std::ifstream
+#include <limits>        // std::numeric_limits
+#include <sstream>       // std::istringstream
+#include <stdexcept>     // std::runtime_error
+#include <string>        // std::string, std::getline
+#include <unordered_map> // std::unordered_map
+#include <utility>       // std::move
+#include <vector>        // std::vector
+
+namespace lidar_processing_lib::fusion
+{
+namespace
+{
+using CalibrationEntries = std::unordered_map<std::string, std::vector<double>>;
+
+// Kitti calibration files hold one "<name>: <values>" entry per line, entries without numeric values are skipped
+CalibrationEntries readCalibrationFile(const std::filesystem::path &file_path)
+{
+    std::ifstream input_file{file_path};
+    if (!input_file.is_open())
+    {
+        throw std::runtime_error("Could not read the calibration " + file_path.string());
+    }
+
+    CalibrationEntries entries;
+    std::string line;
+    while (std::getline(input_file, line))
+    {
+        const std::size_t separator = line.find(':');
+        if (separator == std::string::npos)
+        {
+            continue;
+        }
+
+        std::vector<double> values;
+        std::istringstream value_stream{line.substr(separator + 1U)};
+        double value = 0.0;
+        while (value_stream >> value)
+        {
+            values.push_back(value);
+        }
+
+        if (!values.empty())
+        {
+            entries.emplace(line.substr(0U, separator), std::move(values));
+        }
+    }
+
+    return entries;
+}
+
+const std::vector<double> &calibrationEntry(const CalibrationEntries &entries, const std::string &name,
+                                            const std::size_t number_of_values, const std::filesystem::path &file_path)
+{
+    const auto entry = entries.find(name);
+    if ((entry == entries.end()) || (entry->second.size() != number_of_values))
+    {
+        throw std::runtime_error("Calibration " + file_path.string() + " has no " + std::to_string(number_of_values) +
+                                 " values of " + name);
+    }
+    return entry->second;
+}
+} // namespace
+
+CameraCalibration loadKittiCameraCalibration(const std::filesystem::path &calibration_path,
+                                             std::uint32_t camera_index)
+{
+    const std::filesystem::path cam_to_cam_path = calibration_path / "calib_cam_to_cam.txt";
+    const std::filesystem::path velo_to_cam_path = calibration_path / "calib_velo_to_cam.txt";
+    const CalibrationEntries cam_to_cam = readCalibrationFile(cam_to_cam_path);
+    const CalibrationEntries velo_to_cam = readCalibrationFile(velo_to_cam_path);
+
+    const std::string camera = "0" + std::to_string(camera_index);
+    const auto &image_size = calibrationEntry(cam_to_cam, "S_rect_" + camera, 2U, cam_to_cam_path);
+    const auto &rectified_projection = calibrationEntry(cam_to_cam, "P_rect_" + camera, 12U, cam_to_cam_path);
+
+    // Every camera projects the points rectified into the frame of the reference camera 0
+    const auto &rectification = calibrationEntry(cam_to_cam, "R_rect_00", 9U, cam_to_cam_path);
+    const auto &rotation = calibrationEntry(velo_to_cam, "R", 9U, velo_to_cam_path);
+    const auto &translation = calibrationEntry(velo_to_cam, "T", 3U, velo_to_cam_path);
+
+    // Composed in double precision, the product is rounded to float once
+    Eigen::Matrix<double, 3, 4> projection_matrix;
+    Eigen::Matrix4d rectification_matrix = Eigen::Matrix4d::Identity();
+    Eigen::Matrix4d lidar_to_camera = Eigen::Matrix4d::Identity();
+    for (Eigen::Index row = 0; row < 3; ++row)
+    {
+        for (Eigen::Index column = 0; column < 3; ++column)
+        {
+            rectification_matrix(row, column) = rectification[static_cast<std::size_t>((row * 3) + column)];
+            lidar_to_camera(row, column) = rotation[static_cast<std::size_t>((row * 3) + column)];
+        }
+        lidar_to_camera(row, 3) = translation[static_cast<std::size_t>(row)];
+
+        for (Eigen::Index column = 0; column < 4; ++column)
+        {
+            projection_matrix(row, column) = rectified_projection[static_cast<std::size_t>((row * 4) + column)];
+        }
+    }
+
+    // Packed pixel coordinates hold 16 bits per axis
+    constexpr double MAX_IMAGE_SIZE = static_cast<double>(std::numeric_limits<std::uint16_t>::max());
+    if ((image_size[0] < 1.0) || (image_size[1] < 1.0) || (image_size[0] > MAX_IMAGE_SIZE) ||
+        (image_size[1] > MAX_IMAGE_SIZE))
+    {
+        throw std::runtime_error("Image size of the calibration " + cam_to_cam_path.string() + " is out of range");
+    }
+
+    CameraCalibration calibration;
+    calibration.lidar_to_image = (projection_matrix * rectification_matrix * lidar_to_camera).cast<float>();
+    calibration.width = static_cast<std::uint32_t>(std::round(image_size[0]));
+    calibration.height = static_cast<std::uint32_t>(std::round(image_size[1]));
+    return calibration;
+}
+} // namespace lidar_processing_lib::fusion
@@ -0,0 +1,233 @@
+#include <lidar_processing_lib/fusion/camera_projection_kernel.hpp>
+
+#include <array> // std::array
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace lidar_processing_lib::fusion
+{
+namespace
+{
+// Rows of the lidar to image matrix, m[row * 4 + column]
+using ProjectionCoefficients = std::array<float, 12U>;
+
+// Scalar projection of the points in range [begin, end), used for the tail of the vectorized loops
+inline void projectScalar(const float *x, const float *y, const float *z, std::size_t begin, std::size_t end,
+                          const ProjectionCoefficients &m, float width, float height, float min_depth,
+                          std::uint32_t *pixels) noexcept
+{
+    for (std::size_t i = begin; i < end; ++i)
+    {
+        const float depth = (m[8] * x[i]) + (m[9] * y[i]) + (m[10] * z[i]) + m[11];
+        const float column = ((m[0] * x[i]) + (m[1] * y[i]) + (m[2] * z[i]) + m[3]) / depth;
+        const float row = ((m[4] * x[i]) + (m[5] * y[i]) + (m[6] * z[i]) + m[7]) / depth;
+
+        // Comparisons with NaN are false, non-finite points are not seen
+        const bool is_seen = (depth > min_depth) && (column >= 0.0F) && (column < width) && (row >= 0.0F) &&
+                             (row < height);
+        pixels[i] = is_seen ? packPixel(static_cast<std::uint32_t>(row), static_cast<std::uint32_t>(column))
+                            : INVALID_PIXEL;
+    }
+}
+
+#if defined(__AVX2__)
+constexpr std::size_t LANES = 8U;
+
+inline void projectPoints(const float *x, const float *y, const float *z, std::size_t number_of_points,
+                          const ProjectionCoefficients &m, float width, float height, float min_depth,
+                          std::uint32_t *pixels) noexcept
+{
+    __m256 coefficients[12U];
+    for (std::size_t k = 0U; k < m.size(); ++k)
+    {
+        coefficients[k] = _mm256_set1_ps(m[k]);
+    }
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 width_vector = _mm256_set1_ps(width);
+    const __m256 height_vector = _mm256_set1_ps(height);
+    const __m256 min_depth_vector = _mm256_set1_ps(min_depth);
+    const __m256i invalid_pixel = _mm256_set1_epi32(static_cast<int>(INVALID_PIXEL));
+
+    const auto row_product = [&coefficients](std::size_t row, __m256 px, __m256 py, __m256 pz) noexcept {
+        __m256 product = _mm256_mul_ps(coefficients[(row * 4U) + 0U], px);
+        product = _mm256_add_ps(product, _mm256_mul_ps(coefficients[(row * 4U) + 1U], py));
+        product = _mm256_add_ps(product, _mm256_mul_ps(coefficients[(row * 4U) + 2U], pz));
+        return _mm256_add_ps(product, coefficients[(row * 4U) + 3U]);
+    };
+
+    const std::size_t vectorized_end = number_of_points - (number_of_points % LANES);
+    for (std::size_t i = 0U; i < vectorized_end; i += LANES)
+    {
+        const __m256 px = _mm256_loadu_ps(x + i);
+        const __m256 py = _mm256_loadu_ps(y + i);
+        const __m256 pz = _mm256_loadu_ps(z + i);
+
+        const __m256 depth = row_product(2U, px, py, pz);
+        const __m256 column = _mm256_div_ps(row_product(0U, px, py, pz), depth);
+        const __m256 row = _mm256_div_ps(row_product(1U, px, py, pz), depth);
+
+        // Ordered comparisons are false for NaN, non-finite points are not seen
+        __m256 is_seen = _mm256_cmp_ps(depth, min_depth_vector, _CMP_GT_OQ);
+        is_seen = _mm256_and_ps(is_seen, _mm256_cmp_ps(column, zero, _CMP_GE_OQ));
+        is_seen = _mm256_and_ps(is_seen, _mm256_cmp_ps(column, width_vector, _CMP_LT_OQ));
+        is_seen = _mm256_and_ps(is_seen, _mm256_cmp_ps(row, zero, _CMP_GE_OQ));
+        is_seen = _mm256_and_ps(is_seen, _mm256_cmp_ps(row, height_vector, _CMP_LT_OQ));
+
+        // Coordinates are non-negative where seen, truncation rounds them down to the pixel
+        const __m256i packed = _mm256_or_si256(_mm256_slli_epi32(_mm256_cvttps_epi32(row), 16),
+                                               _mm256_cvttps_epi32(column));
+        const __m256i result = _mm256_or_si256(_mm256_and_si256(_mm256_castps_si256(is_seen), packed),
+                                               _mm256_andnot_si256(_mm256_castps_si256(is_seen), invalid_pixel));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(pixels + i), result);
+    }
+
+    projectScalar(x, y, z, vectorized_end, number_of_points, m, width, height, min_depth, pixels);
+}
+#elif defined(__SSE2__)
+constexpr std::size_t LANES = 4U;
+
+inline void projectPoints(const float *x, const float *y, const float *z, std::size_t number_of_points,
+                          const ProjectionCoefficients &m, float width, float height, float min_depth,
+                          std::uint32_t *pixels) noexcept
+{
+    __m128 coefficients[12U];
+    for (std::size_t k = 0U; k < m.size(); ++k)
+    {
+        coefficients[k] = _mm_set1_ps(m[k]);
+    }
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 width_vector = _mm_set1_ps(width);
+    const __m128 height_vector = _mm_set1_ps(height);
+    const __m128 min_depth_vector = _mm_set1_ps(min_depth);
+    const __m128i invalid_pixel = _mm_set1_epi32(static_cast<int>(INVALID_PIXEL));
+
+    const auto row_product = [&coefficients](std::size_t row, __m128 px, __m128 py, __m128 pz) noexcept {
+        __m128 product = _mm_mul_ps(coefficients[(row * 4U) + 0U], px);
+        product = _mm_add_ps(product, _mm_mul_ps(coefficients[(row * 4U) + 1U], py));
+        product = _mm_add_ps(product, _mm_mul_ps(coefficients[(row * 4U) + 2U], pz));
+        return _mm_add_ps(product, coefficients[(row * 4U) + 3U]);
+    };
+
+    const std::size_t vectorized_end = number_of_points - (number_of_points % LANES);
+    for (std::size_t i = 0U; i < vectorized_end; i += LANES)
+    {
+        const __m128 px = _mm_loadu_ps(x + i);
+        const __m128 py = _mm_loadu_ps(y + i);
+        const __m128 pz = _mm_loadu_ps(z + i);
+
+        const __m128 depth = row_product(2U, px, py, pz);
+        const __m128 column = _mm_div_ps(row_product(0U, px, py, pz), depth);
+        const __m128 row = _mm_div_ps(row_product(1U, px, py, pz), depth);
+
+        // Ordered comparisons are false for NaN, non-finite points are not seen
+        __m128 is_seen = _mm_cmpgt_ps(depth, min_depth_vector);
+        is_seen = _mm_and_ps(is_seen, _mm_cmpge_ps(column, zero));
+        is_seen = _mm_and_ps(is_seen, _mm_cmplt_ps(column, width_vector));
+        is_seen = _mm_and_ps(is_seen, _mm_cmpge_ps(row, zero));
+        is_seen = _mm_and_ps(is_seen, _mm_cmplt_ps(row, height_vector));
+
+        // Coordinates are non-negative where seen, truncation rounds them down to the pixel
+        const __m128i packed = _mm_or_si128(_mm_slli_epi32(_mm_cvttps_epi32(row), 16), _mm_cvttps_epi32(column));
+        const __m128i result = _mm_or_si128(_mm_and_si128(_mm_castps_si128(is_seen), packed),
+                                            _mm_andnot_si128(_mm_castps_si128(is_seen), invalid_pixel));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(pixels + i), result);
+    }
+
+    projectScalar(x, y, z, vectorized_end, number_of_points, m, width, height, min_depth, pixels);
+}
+#elif defined(__ARM_NEON)
+constexpr std::size_t LANES = 4U;
+
+inline void projectPoints(const float *x, const float *y, const float *z, std::size_t number_of_points,
+                          const ProjectionCoefficients &m, float width, float height, float min_depth,
+                          std::uint32_t *pixels) noexcept
+{
+    float32x4_t coefficients[12U];
+    for (std::size_t k = 0U; k < m.size(); ++k)
+    {
+        coefficients[k] = vdupq_n_f32(m[k]);
+    }
+    const float32x4_t zero = vdupq_n_f32(0.0F);
+    const float32x4_t width_vector = vdupq_n_f32(width);
+    const float32x4_t height_vector = vdupq_n_f32(height);
+    const float32x4_t min_depth_vector = vdupq_n_f32(min_depth);
+    const uint32x4_t invalid_pixel = vdupq_n_u32(INVALID_PIXEL);
+
+    const auto row_product = [&coefficients](std::size_t row, float32x4_t px, float32x4_t py,
+                                             float32x4_t pz) noexcept {
+        float32x4_t product = vmulq_f32(coefficients[(row * 4U) + 0U], px);
+        product = vaddq_f32(product, vmulq_f32(coefficients[(row * 4U) + 1U], py));
+        product = vaddq_f32(product, vmulq_f32(coefficients[(row * 4U) + 2U], pz));
+        return vaddq_f32(product, coefficients[(row * 4U) + 3U]);
+    };
+
+    const std::size_t vectorized_end = number_of_points - (number_of_points % LANES);
+    for (std::size_t i = 0U; i < vectorized_end; i += LANES)
+    {
+        const float32x4_t px = vld1q_f32(x + i);
+        const float32x4_t py = vld1q_f32(y + i);
+        const float32x4_t pz = vld1q_f32(z + i);
+
+        const float32x4_t depth = row_product(2U, px, py, pz);
+        const float32x4_t column = vdivq_f32(row_product(0U, px, py, pz), depth);
+        const float32x4_t row = vdivq_f32(row_product(1U, px, py, pz), depth);
+
+        // Comparisons are false for NaN, non-finite points are not seen
+        uint32x4_t is_seen = vcgtq_f32(depth, min_depth_vector);
+        is_seen = vandq_u32(is_seen, vcgeq_f32(column, zero));
+        is_seen = vandq_u32(is_seen, vcltq_f32(column, width_vector));
+        is_seen = vandq_u32(is_seen, vcgeq_f32(row, zero));
+        is_seen = vandq_u32(is_seen, vcltq_f32(row, height_vector));
+
+        // Conversion saturates and rounds toward zero, coordinates are non-negative where seen
+        const uint32x4_t packed = vorrq_u32(vshlq_n_u32(vcvtq_u32_f32(row), 16), vcvtq_u32_f32(column));
+        vst1q_u32(pixels + i, vbslq_u32(is_seen, packed, invalid_pixel));
+    }
+
+    projectScalar(x, y, z, vectorized_end, number_of_points, m, width, height, min_depth, pixels);
+}
+#else
+inline void projectPoints(const float *x, const float *y, const float *z, std::size_t number_of_points,
+                          const ProjectionCoefficients &m, float width, float height, float min_depth,
+                          std::uint32_t *pixels) noexcept
+{
+    projectScalar(x, y, z, 0U, number_of_points, m, width, height, min_depth, pixels);
+}
+#endif
+} // namespace
+
+const char *cameraProjectionKernelInstructionSet() noexcept
+{
+#if defined(__AVX2__)
+    return "avx2";
+#elif defined(__SSE2__)
+    return "sse2";
+#elif defined(__ARM_NEON)
+    return "neon";
+#else
+    return "scalar";
+#endif
+}
+
+void projectToPixels(const float *x, const float *y, const float *z, std::size_t number_of_points,
+                     const CameraCalibration &calibration, float min_depth, std::uint32_t *pixels) noexcept
+{
+    ProjectionCoefficients m;
+    for (Eigen::Index row = 0; row < 3; ++row)
+    {
+        for (Eigen::Index column = 0; column < 4; ++column)
+        {
+            m[static_cast<std::size_t>((row * 4) + column)] = calibration.lidar_to_image(row, column);
+        }
+    }
+
+    projectPoints(x, y, z, number_of_points, m, static_cast<float>(calibration.width),
+                  static_cast<float>(calibration.height), min_depth, pixels);
+}
+} // namespace lidar_processing_lib::fusion
@@ -0,0 +1,121 @@
+#include <lidar_processing_lib/fusion/point_cloud_colorizer.hpp>
+
+#include <lidar_processing_lib/fusion/camera_projection_kernel.hpp> // projectToPixels, INVALID_PIXEL
+
+#include <algorithm> // std::max, std::fill
+#include <stdexcept> // std::runtime_error
+#include <string>    // std::to_string
+#include <utility>   // std::move
+
+namespace lidar_processing_lib::fusion
+{
+namespace
+{
+// Points merged per task, the merge streams through the colours of every camera
+constexpr std::size_t MERGE_GRAIN = 16'384U;
+} // namespace
+
+PointCloudColorizer::PointCloudColorizer(std::vector<CameraCalibration> calibrations, std::uint32_t thread_count,
+                                         float min_depth)
+    : calibrations_{std::move(calibrations)}, min_depth_{min_depth}, camera_colours_(calibrations_.size())
+{
+    if (calibrations_.empty() || (calibrations_.size() > NO_CAMERA))
+    {
+        throw std::runtime_error("Colorizer needs between 1 and " + std::to_string(NO_CAMERA) + " cameras!");
+    }
+
+    // The calling thread processes cameras as well
+    thread_count = std::max(thread_count, 1U);
+    if (thread_count > 1U)
+    {
+        thread_pool_ = std::make_unique<utilities_lib::ThreadPool>(thread_count - 1U);
+    }
+}
+
+PointCloudColorizer::~PointCloudColorizer() = default;
+
+void PointCloudColorizer::colourCamera(const data_types_lib::PointCloudSoA &cloud, const std::size_t camera_index,
+                                       const CameraImageView &image)
+{
+    const CameraCalibration &calibration = calibrations_[camera_index];
+    std::vector<std::uint32_t> &colours = camera_colours_[camera_index];
+    colours.resize(cloud.size());
+
+    const bool is_image_valid = (image.data != nullptr) && (image.width == calibration.width) &&
+                                (image.height == calibration.height) && (image.row_step >= (3U * image.width));
+    if (!is_image_valid)
+    {
+        std::fill(colours.begin(), colours.end(), INVALID_PIXEL);
+        return;
+    }
+
+    projectToPixels(cloud.x(), cloud.y(), cloud.z(), cloud.size(), calibration, min_depth_, colours.data());
+
+    // Channel offsets of red and blue in the pixel, green is always in the middle
+    const std::size_t red_offset = (image.encoding == ImageEncoding::RGB8) ? 0U : 2U;
+    const std::size_t blue_offset = 2U - red_offset;
+
+    for (auto &colour : colours)
+    {
+        if (colour == INVALID_PIXEL)
+        {
+            continue;
+        }
+
+        const std::uint32_t row = colour >> 16U;
+        const std::uint32_t column = colour & 0xFFFFU;
+        const std::uint8_t *pixel =
+            image.data + (static_cast<std::size_t>(row) * image.row_step) + (static_cast<std::size_t>(column) * 3U);
+        colour = (static_cast<std::uint32_t>(pixel[red_offset]) << 16U) |
+                 (static_cast<std::uint32_t>(pixel[1U]) << 8U) | static_cast<std::uint32_t>(pixel[blue_offset]);
+    }
+}
+
+void PointCloudColorizer::run(const data_types_lib::PointCloudSoA &cloud, const std::vector<CameraImageView> &images,
+                              std::vector<std::uint32_t> &rgb, std::vector<std::uint8_t> &cameras)
+{
+    if (images.size() != calibrations_.size())
+    {
+        throw std::runtime_error("Colorizer expects one image per camera!");
+    }
+
+    const std::size_t number_of_cameras = calibrations_.size();
+    const auto colour_cameras = [&](const std::size_t first, const std::size_t last) {
+        for (std::size_t camera_index = first; camera_index < last; ++camera_index)
+        {
+            colourCamera(cloud, camera_index, images[camera_index]);
+        }
+    };
+
+    const auto merge_points = [&](const std::size_t first, const std::size_t last) {
+        for (std::size_t i = first; i < last; ++i)
+        {
+            rgb[i] = NO_COLOUR;
+            cameras[i] = NO_CAMERA;
+            for (std::size_t camera_index = 0U; camera_index < number_of_cameras; ++camera_index)
+            {
+                const std::uint32_t colour = camera_colours_[camera_index][i];
+                if (colour != INVALID_PIXEL)
+                {
+                    rgb[i] = colour;
+                    cameras[i] = static_cast<std::uint8_t>(camera_index);
+                    break;
+                }
+            }
+        }
+    };
+
+    rgb.resize(cloud.size());
+    cameras.resize(cloud.size());
+
+    if (thread_pool_ == nullptr)
+    {
+        colour_cameras(0U, number_of_cameras);
+        merge_points(0U, cloud.size());
+        return;
+    }
+
+    thread_pool_->parallelFor(0U, number_of_cameras, 1U, colour_cameras);
+    thread_pool_->parallelFor(0U, cloud.size(), MERGE_GRAIN, merge_points);
+}
+} // namespace lidar_processing_lib::fusion
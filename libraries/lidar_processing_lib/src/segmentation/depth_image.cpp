@@ -0,0 +1,51 @@
+#include <lidar_processing_lib/segmentation/depth_image.hpp>
+
+namespace lidar_processing_lib::segmentation
+{
+DepthImage::DepthImage(const SensorProfile &profile, float min_range, float max_range, ProjectionMode projection_mode)
+    : profile_(profile), width_(profile.width()), height_(profile.height()), static_profile_(StaticProfile::NONE),
+      runtime_projection_(profile), min_range_(min_range), max_range_(max_range), projection_mode_(projection_mode)
+{
+    if (!(profile_.horizontal_resolution_deg > 0.0F) || !(profile_.vertical_resolution_deg > 0.0F) ||
+        !(profile_.vertical_field_of_view_deg > 0.0F) || !(profile_.min_elevation_deg >= -90.0F) ||
+        !((profile_.min_elevation_deg + profile_.vertical_field_of_view_deg) <= 90.0F))
+    {
+        throw std::runtime_error("Sensor profile of DepthImage is invalid!");
+    }
+
+    if (!(min_range_ < max_range_))
+    {
+        throw std::runtime_error("Minimum range of DepthImage must be smaller than its maximum range!");
+    }
+
+    if (profile_ == VelodyneHdl64e::PROFILE)
+    {
+        static_profile_ = StaticProfile::VELODYNE_HDL_64E;
+    }
+    else if (profile_ == VelodyneVlp32c::PROFILE)
+    {
+        static_profile_ = StaticProfile::VELODYNE_VLP_32C;
+    }
+    else if (profile_ == OusterOs1_128::PROFILE)
+    {
+        static_profile_ = StaticProfile::OUSTER_OS1_128;
+    }
+
+    // All buffers are sized once for the sensor
+    pixels_.resize(static_cast<std::size_t>(width_) * height_);
+    valid_pixels_.reserve(pixels_.size());
+    point_pixels_.reserve(profile_.max_cloud_points);
+}
+
+void DepthImage::reset(const std::size_t number_of_points)
+{
+    // Pixels untouched by the previous frame are still empty
+    for (const auto pixel_index : valid_pixels_)
+    {
+        pixels_[pixel_index].reset();
+    }
+    valid_pixels_.clear();
+
+    point_pixels_.assign(number_of_points, INVALID_PIXEL);
+}
+} // namespace lidar_processing_lib::segmentation
@@ -1,14 +1,71 @@
 #include <lidar_processing_lib/segmentation/depth_image_segmenter.hpp>
 
+#include <algorithm> // std::min
+#include <cmath>     // std::tan, std::cos, std::sin, std::atan2, std::hypot
+#include <stdexcept> // std::runtime_error
+#include <utility>   // std::move
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 namespace lidar_processing_lib::segmentation
 {
-DepthImageSegmenter::DepthImageSegmenter(float min_range, float max_range)
-    : min_range_(min_range), max_range_(max_range), depth_image_(DEPTH_IMAGE_HEIGHT * DEPTH_IMAGE_WIDTH)
+namespace
+{
+#if defined(__AVX2__)
+constexpr std::uint32_t LANES = 8U;
+#elif defined(__SSE2__) || defined(__ARM_NEON)
+constexpr std::uint32_t LANES = 4U;
+#else
+constexpr std::uint32_t LANES = 1U;
+#endif
+
+static_assert((DepthImageSegmenter::NUMBER_OF_CHANNELS_IN_RING_ELEVATION_CONJUNCTION_MAP % LANES) == 0U,
+              "Channels of a ring must fill whole vectors");
+
+// Limits the elevations of a ring by the elevations of the previous ring raised by the step, for a vector of channels
+inline void limitElevations(float *ring, const float *previous_ring, const float max_elevation_step) noexcept
+{
+#if defined(__AVX2__)
+    const __m256 limit = _mm256_add_ps(_mm256_loadu_ps(previous_ring), _mm256_set1_ps(max_elevation_step));
+    _mm256_storeu_ps(ring, _mm256_min_ps(_mm256_loadu_ps(ring), limit));
+#elif defined(__SSE2__)
+    const __m128 limit = _mm_add_ps(_mm_loadu_ps(previous_ring), _mm_set1_ps(max_elevation_step));
+    _mm_storeu_ps(ring, _mm_min_ps(_mm_loadu_ps(ring), limit));
+#elif defined(__ARM_NEON)
+    const float32x4_t limit = vaddq_f32(vld1q_f32(previous_ring), vdupq_n_f32(max_elevation_step));
+    vst1q_f32(ring, vminq_f32(vld1q_f32(ring), limit));
+#else
+    ring[0] = std::min(ring[0], previous_ring[0] + max_elevation_step);
+#endif
+}
+} // namespace
+
+DepthImageSegmenter::DepthImageSegmenter(float min_range, float max_range, const SensorProfile &profile,
+                                         const TemporalGroundConfiguration &temporal_configuration)
+    : DepthImageSegmenter(std::make_shared<DepthImage>(profile, min_range, max_range), temporal_configuration)
+{
+}
+
+DepthImageSegmenter::DepthImageSegmenter(std::shared_ptr<DepthImage> depth_image,
+                                         const TemporalGroundConfiguration &temporal_configuration)
+    : depth_image_(std::move(depth_image)), temporal_configuration_(temporal_configuration)
 {
-    for (auto &slice : polar_grid_)
+    if (depth_image_ == nullptr)
     {
-        slice.reserve(MAX_POINTS_PER_CELL_RING_ELEVATION_CONJUNCTION_MAP);
+        throw std::runtime_error("Depth image of DepthImageSegmenter must not be null!");
     }
+
+    point_cells_.reserve(depth_image_->profile().max_cloud_points);
+    point_elevations_.reserve(depth_image_->profile().max_cloud_points);
+
+    ground_elevations_.fill(std::numeric_limits<float>::max());
+    ground_ages_.fill(INVALID_AGE);
 }
 
 DepthImageSegmenter::~DepthImageSegmenter()
@@ -24,4 +81,200 @@ void DepthImageSegmenter::run(const pcl::PointCloud<pcl::PointXYZI> &cloud, std:
 {
     segment(cloud, labels);
 }
+
+void DepthImageSegmenter::run(const data_types_lib::PointCloudView &cloud, std::vector<SegmentationLabel> &labels)
+{
+    segment(cloud, labels);
+}
+
+void DepthImageSegmenter::run(const data_types_lib::PointCloudSoA &cloud, std::vector<SegmentationLabel> &labels)
+{
+    segment(cloud, labels);
+}
+
+void DepthImageSegmenter::setEgoMotion(const Eigen::Isometry3f &previous_to_current)
+{
+    ego_motion_ = previous_to_current;
+    ego_motion_pending_ = true;
+}
+
+void DepthImageSegmenter::compensateEgoMotion()
+{
+    if (!ego_motion_pending_)
+    {
+        return;
+    }
+    ego_motion_pending_ = false;
+
+    static constexpr auto CHANNEL_RESOLUTION_RAD =
+        static_cast<float>((2.0 * M_PI) / NUMBER_OF_CHANNELS_IN_RING_ELEVATION_CONJUNCTION_MAP);
+
+    warped_ground_elevations_.fill(std::numeric_limits<float>::max());
+    warped_ground_ages_.fill(INVALID_AGE);
+
+    // Ground at the center of every modelled cell is moved into the cell it falls into in the next frame, the most
+    // recently observed ground wins when cells merge
+    for (std::uint32_t channel_index = 0U; channel_index < NUMBER_OF_CHANNELS_IN_RING_ELEVATION_CONJUNCTION_MAP;
+         ++channel_index)
+    {
+        const float azimuth_rad = (static_cast<float>(channel_index) + 0.5F) * CHANNEL_RESOLUTION_RAD;
+        for (std::uint32_t ring_index = 0U; ring_index < NUMBER_OF_RINGS_IN_RING_ELEVATION_CONJUNCTION_MAP;
+             ++ring_index)
+        {
+            const std::uint32_t cell_index = rowMajorIndexRingElevationConjunctionMap(channel_index, ring_index);
+            if (ground_ages_[cell_index] == INVALID_AGE)
+            {
+                continue;
+            }
+
+            // Center of the part of the cell within the map, the last ring extends past the maximum distance
+            const float ring_begin = MIN_DISTANCE_M + (static_cast<float>(ring_index) * RING_SPACING_M);
+            const float ring_end = std::min(ring_begin + RING_SPACING_M, MAX_DISTANCE_M);
+            const float distance = 0.5F * (ring_begin + ring_end);
+            const Eigen::Vector3f ground =
+                ego_motion_ * Eigen::Vector3f{distance * std::cos(azimuth_rad), distance * std::sin(azimuth_rad),
+                                              ground_elevations_[cell_index]};
+
+            const float warped_distance = std::hypot(ground.x(), ground.y());
+            if (!((warped_distance > MIN_DISTANCE_M) && (warped_distance <= MAX_DISTANCE_M)))
+            {
+                continue;
+            }
+
+            float warped_azimuth_rad = std::atan2(ground.y(), ground.x());
+            if (warped_azimuth_rad < 0.0F)
+            {
+                warped_azimuth_rad += static_cast<float>(2.0 * M_PI);
+            }
+
+            const std::uint32_t warped_cell_index = rowMajorIndexRingElevationConjunctionMap(
+                std::min(static_cast<std::uint32_t>(warped_azimuth_rad / CHANNEL_RESOLUTION_RAD),
+                         (NUMBER_OF_CHANNELS_IN_RING_ELEVATION_CONJUNCTION_MAP - 1U)),
+                std::min(static_cast<std::uint32_t>((warped_distance - MIN_DISTANCE_M) / RING_SPACING_M),
+                         (NUMBER_OF_RINGS_IN_RING_ELEVATION_CONJUNCTION_MAP - 1U)));
+
+            const std::uint32_t age = ground_ages_[cell_index];
+            std::uint32_t &warped_age = warped_ground_ages_[warped_cell_index];
+            float &warped_elevation = warped_ground_elevations_[warped_cell_index];
+            if ((age < warped_age) || ((age == warped_age) && (ground.z() < warped_elevation)))
+            {
+                warped_age = age;
+                warped_elevation = ground.z();
+            }
+        }
+    }
+
+    ground_elevations_ = warped_ground_elevations_;
+    ground_ages_ = warped_ground_ages_;
+}
+
+void DepthImageSegmenter::mergeTemporalGroundModel() noexcept
+{
+    temporal_statistics_ = TemporalGroundStatistics{};
+    for (std::uint32_t cell_index = 0U; cell_index < NUMBER_OF_CELLS_IN_RING_ELEVATION_CONJUNCTION_MAP; ++cell_index)
+    {
+        float &cell_elevation = ring_elevation_conjunction_map_[cell_index];
+        std::uint32_t &ground_age = ground_ages_[cell_index];
+        const bool modelled = (ground_age < temporal_configuration_.max_cell_age);
+        const float ground_elevation = ground_elevations_[cell_index];
+        const bool observed = (cell_elevation != std::numeric_limits<float>::max());
+
+        if (modelled && (!observed || (cell_elevation > (ground_elevation + temporal_configuration_.cell_tolerance))))
+        {
+            // Empty cell or lowest point above the ground, e.g. an obstacle covering the cell
+            cell_elevation = ground_elevation;
+            ++ground_age;
+            ++temporal_statistics_.carried_cells;
+        }
+        else if (observed)
+        {
+            // Ground confirmed by the frame, or lower than the model which is then replaced by the frame
+            if (modelled && (cell_elevation >= (ground_elevation - temporal_configuration_.cell_tolerance)))
+            {
+                ++temporal_statistics_.validated_cells;
+            }
+            else
+            {
+                ++temporal_statistics_.recomputed_cells;
+            }
+            ground_age = 0U;
+        }
+        else
+        {
+            ground_age = INVALID_AGE;
+        }
+    }
+}
+
+void DepthImageSegmenter::segmentRingElevationConjunctionMap(std::vector<SegmentationLabel> &labels)
+{
+    // Course segmentation algorithm
+    // Input: Raw Point Cloud
+    // Output: First Labelled Point Cloud
+    // 1. Choose ground height threshold, dH
+    // 2. Choose grid ring spacing, dR
+    // 3. Choose road maximum slope, dM
+    //
+    // For each Point(t,c) in Cloud:
+    //      Label(t,c) = GROUND
+    //      Point(t,c) in GRID(m,n)
+    //      Elevation(m,n) = min(Elevation(m,n), z(t,c))
+    //
+    // For each Elevation(m,n) in ElevationMap:
+    //      Elevation(m,n) = min(Elevation(m,n), Elevation(m-1,n) + dR * tan(dM))
+    //
+    // For each Point(t,c) in Cloud:
+    //      Point(t,c) in GRID(m,n)
+    //      if z(t,c) >= Elevation(m,n) + dH:
+    //          Label(t,c) = OBSTACLE
+    //
+    // Minimum elevations are gathered by embedCloudIntoRingElevationConjunctionMap
+
+    // Ground rises by at most the maximum slope from one ring to the next. The rings depend on each other, the
+    // channels of a ring do not and are limited in SIMD. Empty cells inherit the limit of the previous ring
+    const float max_elevation_step = dR_ * std::tan(dM_);
+    for (std::uint32_t ring_index = 1U; ring_index < NUMBER_OF_RINGS_IN_RING_ELEVATION_CONJUNCTION_MAP; ++ring_index)
+    {
+        float *const ring = ring_elevation_conjunction_map_.data() +
+                            rowMajorIndexRingElevationConjunctionMap(0U, ring_index);
+        const float *const previous_ring = ring - NUMBER_OF_CHANNELS_IN_RING_ELEVATION_CONJUNCTION_MAP;
+        for (std::uint32_t channel_index = 0U; channel_index < NUMBER_OF_CHANNELS_IN_RING_ELEVATION_CONJUNCTION_MAP;
+             channel_index += LANES)
+        {
+            limitElevations(ring + channel_index, previous_ring + channel_index, max_elevation_step);
+        }
+    }
+
+    // Slope limited elevations of the cells with ground are the model of the next frame, cells filled by the limit
+    // alone stay out of the model
+    if (temporal_configuration_.enabled)
+    {
+        for (std::uint32_t cell_index = 0U; cell_index < NUMBER_OF_CELLS_IN_RING_ELEVATION_CONJUNCTION_MAP;
+             ++cell_index)
+        {
+            if (ground_ages_[cell_index] != INVALID_AGE)
+            {
+                ground_elevations_[cell_index] = ring_elevation_conjunction_map_[cell_index];
+            }
+        }
+    }
+
+    // Obstacle thresholds of the cells, empty cells keep values at the top of the float range
+    for (auto &cell_elevation : ring_elevation_conjunction_map_)
+    {
+        cell_elevation += dH_;
+    }
+
+    // Label the embedded points, points out of the map stay unknown
+    for (std::size_t i = 0U; i < point_cells_.size(); ++i)
+    {
+        const std::uint32_t cell_index = point_cells_[i];
+        if (cell_index != INVALID_CELL)
+        {
+            labels[i] = (point_elevations_[i] >= ring_elevation_conjunction_map_[cell_index])
+                            ? SegmentationLabel::OBSTACLE
+                            : SegmentationLabel::GROUND;
+        }
+    }
+}
 } // namespace lidar_processing_lib::segmentation
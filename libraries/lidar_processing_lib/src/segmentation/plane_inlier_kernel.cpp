@@ -0,0 +1,248 @@
+#include <lidar_processing_lib/segmentation/plane_inlier_kernel.hpp>
+
+#include <array>  // std::array
+#include <cmath>  // std::fabs
+#include <limits> // std::numeric_limits
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace lidar_processing_lib::segmentation
+{
+namespace
+{
+using PlaneGroup = std::array<PlaneCoefficients, PLANES_PER_KERNEL_PASS>;
+using CountGroup = std::array<std::uint32_t, PLANES_PER_KERNEL_PASS>;
+
+// Scalar evaluation of the points in range [begin, end), used for the tail of the vectorized loops
+inline void countGroupScalar(const float *x, const float *y, const float *z, std::size_t begin, std::size_t end,
+                             const PlaneGroup &planes, float threshold, CountGroup &counts) noexcept
+{
+    for (std::size_t i = begin; i < end; ++i)
+    {
+        for (std::size_t p = 0U; p < PLANES_PER_KERNEL_PASS; ++p)
+        {
+            const auto &plane = planes[p];
+            const float orthogonal_distance =
+                std::fabs((plane.a * x[i]) + (plane.b * y[i]) + (plane.c * z[i]) - plane.d);
+            counts[p] += (orthogonal_distance < threshold) ? 1U : 0U;
+        }
+    }
+}
+
+#if defined(__AVX2__)
+constexpr std::size_t LANES = 8U;
+
+inline void countGroup(const float *x, const float *y, const float *z, std::size_t number_of_points,
+                       const PlaneGroup &planes, float threshold, CountGroup &counts) noexcept
+{
+    const __m256 abs_mask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+    const __m256 threshold_vector = _mm256_set1_ps(threshold);
+
+    __m256 a[PLANES_PER_KERNEL_PASS];
+    __m256 b[PLANES_PER_KERNEL_PASS];
+    __m256 c[PLANES_PER_KERNEL_PASS];
+    __m256 d[PLANES_PER_KERNEL_PASS];
+    __m256i accumulators[PLANES_PER_KERNEL_PASS];
+    for (std::size_t p = 0U; p < PLANES_PER_KERNEL_PASS; ++p)
+    {
+        a[p] = _mm256_set1_ps(planes[p].a);
+        b[p] = _mm256_set1_ps(planes[p].b);
+        c[p] = _mm256_set1_ps(planes[p].c);
+        d[p] = _mm256_set1_ps(planes[p].d);
+        accumulators[p] = _mm256_setzero_si256();
+    }
+
+    const std::size_t vectorized_end = number_of_points - (number_of_points % LANES);
+    for (std::size_t i = 0U; i < vectorized_end; i += LANES)
+    {
+        const __m256 px = _mm256_loadu_ps(x + i);
+        const __m256 py = _mm256_loadu_ps(y + i);
+        const __m256 pz = _mm256_loadu_ps(z + i);
+
+        for (std::size_t p = 0U; p < PLANES_PER_KERNEL_PASS; ++p)
+        {
+            __m256 distance = _mm256_mul_ps(a[p], px);
+            distance = _mm256_add_ps(distance, _mm256_mul_ps(b[p], py));
+            distance = _mm256_add_ps(distance, _mm256_mul_ps(c[p], pz));
+            distance = _mm256_and_ps(_mm256_sub_ps(distance, d[p]), abs_mask);
+
+            // Comparison mask is all ones (-1) for inliers
+            const __m256i is_inlier = _mm256_castps_si256(_mm256_cmp_ps(distance, threshold_vector, _CMP_LT_OQ));
+            accumulators[p] = _mm256_sub_epi32(accumulators[p], is_inlier);
+        }
+    }
+
+    for (std::size_t p = 0U; p < PLANES_PER_KERNEL_PASS; ++p)
+    {
+        alignas(32) std::array<std::uint32_t, LANES> lanes;
+        _mm256_store_si256(reinterpret_cast<__m256i *>(lanes.data()), accumulators[p]);
+        for (const auto lane : lanes)
+        {
+            counts[p] += lane;
+        }
+    }
+
+    countGroupScalar(x, y, z, vectorized_end, number_of_points, planes, threshold, counts);
+}
+#elif defined(__SSE2__)
+constexpr std::size_t LANES = 4U;
+
+inline void countGroup(const float *x, const float *y, const float *z, std::size_t number_of_points,
+                       const PlaneGroup &planes, float threshold, CountGroup &counts) noexcept
+{
+    const __m128 abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    const __m128 threshold_vector = _mm_set1_ps(threshold);
+
+    __m128 a[PLANES_PER_KERNEL_PASS];
+    __m128 b[PLANES_PER_KERNEL_PASS];
+    __m128 c[PLANES_PER_KERNEL_PASS];
+    __m128 d[PLANES_PER_KERNEL_PASS];
+    __m128i accumulators[PLANES_PER_KERNEL_PASS];
+    for (std::size_t p = 0U; p < PLANES_PER_KERNEL_PASS; ++p)
+    {
+        a[p] = _mm_set1_ps(planes[p].a);
+        b[p] = _mm_set1_ps(planes[p].b);
+        c[p] = _mm_set1_ps(planes[p].c);
+        d[p] = _mm_set1_ps(planes[p].d);
+        accumulators[p] = _mm_setzero_si128();
+    }
+
+    const std::size_t vectorized_end = number_of_points - (number_of_points % LANES);
+    for (std::size_t i = 0U; i < vectorized_end; i += LANES)
+    {
+        const __m128 px = _mm_loadu_ps(x + i);
+        const __m128 py = _mm_loadu_ps(y + i);
+        const __m128 pz = _mm_loadu_ps(z + i);
+
+        for (std::size_t p = 0U; p < PLANES_PER_KERNEL_PASS; ++p)
+        {
+            __m128 distance = _mm_mul_ps(a[p], px);
+            distance = _mm_add_ps(distance, _mm_mul_ps(b[p], py));
+            distance = _mm_add_ps(distance, _mm_mul_ps(c[p], pz));
+            distance = _mm_and_ps(_mm_sub_ps(distance, d[p]), abs_mask);
+
+            // Comparison mask is all ones (-1) for inliers
+            const __m128i is_inlier = _mm_castps_si128(_mm_cmplt_ps(distance, threshold_vector));
+            accumulators[p] = _mm_sub_epi32(accumulators[p], is_inlier);
+        }
+    }
+
+    for (std::size_t p = 0U; p < PLANES_PER_KERNEL_PASS; ++p)
+    {
+        alignas(16) std::array<std::uint32_t, LANES> lanes;
+        _mm_store_si128(reinterpret_cast<__m128i *>(lanes.data()), accumulators[p]);
+        for (const auto lane : lanes)
+        {
+            counts[p] += lane;
+        }
+    }
+
+    countGroupScalar(x, y, z, vectorized_end, number_of_points, planes, threshold, counts);
+}
+#elif defined(__ARM_NEON)
+constexpr std::size_t LANES = 4U;
+
+inline void countGroup(const float *x, const float *y, const float *z, std::size_t number_of_points,
+                       const PlaneGroup &planes, float threshold, CountGroup &counts) noexcept
+{
+    const float32x4_t threshold_vector = vdupq_n_f32(threshold);
+
+    float32x4_t a[PLANES_PER_KERNEL_PASS];
+    float32x4_t b[PLANES_PER_KERNEL_PASS];
+    float32x4_t c[PLANES_PER_KERNEL_PASS];
+    float32x4_t d[PLANES_PER_KERNEL_PASS];
+    uint32x4_t accumulators[PLANES_PER_KERNEL_PASS];
+    for (std::size_t p = 0U; p < PLANES_PER_KERNEL_PASS; ++p)
+    {
+        a[p] = vdupq_n_f32(planes[p].a);
+        b[p] = vdupq_n_f32(planes[p].b);
+        c[p] = vdupq_n_f32(planes[p].c);
+        d[p] = vdupq_n_f32(planes[p].d);
+        accumulators[p] = vdupq_n_u32(0U);
+    }
+
+    const std::size_t vectorized_end = number_of_points - (number_of_points % LANES);
+    for (std::size_t i = 0U; i < vectorized_end; i += LANES)
+    {
+        const float32x4_t px = vld1q_f32(x + i);
+        const float32x4_t py = vld1q_f32(y + i);
+        const float32x4_t pz = vld1q_f32(z + i);
+
+        for (std::size_t p = 0U; p < PLANES_PER_KERNEL_PASS; ++p)
+        {
+            float32x4_t distance = vmulq_f32(a[p], px);
+            distance = vaddq_f32(distance, vmulq_f32(b[p], py));
+            distance = vaddq_f32(distance, vmulq_f32(c[p], pz));
+            distance = vabsq_f32(vsubq_f32(distance, d[p]));
+
+            // Comparison mask is all ones for inliers
+            const uint32x4_t is_inlier = vcltq_f32(distance, threshold_vector);
+            accumulators[p] = vsubq_u32(accumulators[p], is_inlier);
+        }
+    }
+
+    for (std::size_t p = 0U; p < PLANES_PER_KERNEL_PASS; ++p)
+    {
+        std::array<std::uint32_t, LANES> lanes;
+        vst1q_u32(lanes.data(), accumulators[p]);
+        for (const auto lane : lanes)
+        {
+            counts[p] += lane;
+        }
+    }
+
+    countGroupScalar(x, y, z, vectorized_end, number_of_points, planes, threshold, counts);
+}
+#else
+inline void countGroup(const float *x, const float *y, const float *z, std::size_t number_of_points,
+                       const PlaneGroup &planes, float threshold, CountGroup &counts) noexcept
+{
+    countGroupScalar(x, y, z, 0U, number_of_points, planes, threshold, counts);
+}
+#endif
+} // namespace
+
+const char *planeInlierKernelInstructionSet() noexcept
+{
+#if defined(__AVX2__)
+    return "avx2";
+#elif defined(__SSE2__)
+    return "sse2";
+#elif defined(__ARM_NEON)
+    return "neon";
+#else
+    return "scalar";
+#endif
+}
+
+void countPlaneInliers(const float *x, const float *y, const float *z, std::size_t number_of_points,
+                       const PlaneCoefficients *planes, std::size_t number_of_planes, float threshold,
+                       std::uint32_t *inlier_counts) noexcept
+{
+    // Unused slots of the last group never produce inliers
+    static constexpr PlaneCoefficients EMPTY_PLANE{0.0F, 0.0F, 0.0F, std::numeric_limits<float>::infinity()};
+
+    for (std::size_t first_plane = 0U; first_plane < number_of_planes; first_plane += PLANES_PER_KERNEL_PASS)
+    {
+        PlaneGroup group;
+        CountGroup counts{};
+        for (std::size_t p = 0U; p < PLANES_PER_KERNEL_PASS; ++p)
+        {
+            group[p] = ((first_plane + p) < number_of_planes) ? planes[first_plane + p] : EMPTY_PLANE;
+        }
+
+        countGroup(x, y, z, number_of_points, group, threshold, counts);
+
+        for (std::size_t p = 0U; (p < PLANES_PER_KERNEL_PASS) && ((first_plane + p) < number_of_planes); ++p)
+        {
+            inlier_counts[first_plane + p] = counts[p];
+        }
+    }
+}
+} // namespace lidar_processing_lib::segmentation
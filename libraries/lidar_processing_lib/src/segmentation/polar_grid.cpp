@@ -0,0 +1,55 @@
+#include <lidar_processing_lib/segmentation/polar_grid.hpp>
+
+#include <algorithm> // std::sort, std::fill, std::copy
+
+namespace lidar_processing_lib::segmentation
+{
+PolarGrid::PolarGrid(std::uint32_t number_of_channels, std::uint32_t number_of_cells, std::size_t max_points)
+    : number_of_channels_(number_of_channels), number_of_cells_(number_of_cells),
+      cell_offsets_((number_of_channels * number_of_cells) + 1U, 0U),
+      cell_cursors_(number_of_channels * number_of_cells, 0U)
+{
+    staged_points_.reserve(max_points);
+    staged_cell_indices_.reserve(max_points);
+    points_.reserve(max_points);
+}
+
+void PolarGrid::clear() noexcept
+{
+    staged_points_.clear();
+    staged_cell_indices_.clear();
+    points_.clear();
+    std::fill(cell_offsets_.begin(), cell_offsets_.end(), 0U);
+}
+
+void PolarGrid::build()
+{
+    // Counts are stored one slot ahead, so the prefix sum turns them into cell boundaries
+    for (std::size_t cell_index = 1U; cell_index < cell_offsets_.size(); ++cell_index)
+    {
+        cell_offsets_[cell_index] += cell_offsets_[cell_index - 1U];
+    }
+    std::copy(cell_offsets_.begin(), cell_offsets_.end() - 1, cell_cursors_.begin());
+
+    // Scatter, points of a cell keep the staging order
+    points_.resize(staged_points_.size());
+    for (std::size_t i = 0U; i < staged_points_.size(); ++i)
+    {
+        points_[cell_cursors_[staged_cell_indices_[i]]++] = staged_points_[i];
+    }
+
+    // Sort points in increasing radial order, cells hold few points so these are short sorts on a cached key
+    for (std::size_t cell_index = 0U; (cell_index + 1U) < cell_offsets_.size(); ++cell_index)
+    {
+        const auto begin = points_.begin() + cell_offsets_[cell_index];
+        const auto end = points_.begin() + cell_offsets_[cell_index + 1U];
+
+        if ((end - begin) > 1)
+        {
+            std::sort(begin, end, [](const PolarGridPoint &p1, const PolarGridPoint &p2) noexcept {
+                return p1.radius < p2.radius;
+            });
+        }
+    }
+}
+} // namespace lidar_processing_lib::segmentation
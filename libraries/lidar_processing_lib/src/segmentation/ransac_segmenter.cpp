@@ -2,28 +2,379 @@
 
 namespace lidar_processing_lib::segmentation
 {
+namespace
+{
+// Processing points of the largest cloud and the preemptive sample, with room for the alignment padding
+constexpr std::size_t frameArenaCapacity(std::size_t max_cloud_points, std::size_t preemptive_sample_size) noexcept
+{
+    constexpr std::size_t NUMBER_OF_BUFFERS = 6U;
+    return (3U * (max_cloud_points + preemptive_sample_size) * sizeof(float)) +
+           (NUMBER_OF_BUFFERS * alignof(std::max_align_t));
+}
+} // namespace
+
 RansacSegmenter::RansacSegmenter(float height_offset, float orthogonal_distance_threshold,
-                                 std::uint32_t number_of_iterations, float max_plane_inclination_deg,
-                                 float consideration_radius, float consideration_height, float classification_radius)
+                                 std::uint32_t number_of_iterations, std::uint32_t thread_count,
+                                 const RansacAdaptiveConfiguration &adaptive_configuration,
+                                 std::uint32_t horizontal_traversal_bands,
+                                 const TemporalGroundConfiguration &temporal_configuration,
+                                 float max_plane_inclination_deg, float consideration_radius,
+                                 float consideration_height, float classification_radius)
     : ISegmenter(), height_offset_(height_offset), orthogonal_distance_threshold_(orthogonal_distance_threshold),
-      number_of_iterations_(number_of_iterations), max_plane_inclination_deg_(max_plane_inclination_deg),
+      number_of_iterations_(number_of_iterations), thread_count_(std::max(thread_count, 1U)),
+      adaptive_configuration_(adaptive_configuration),
+      horizontal_traversal_bands_(std::max(horizontal_traversal_bands, 1U)),
+      temporal_configuration_(temporal_configuration), max_plane_inclination_deg_(max_plane_inclination_deg),
       consideration_radius_(consideration_radius), consideration_height_(consideration_height),
-      classification_radius_(classification_radius)
+      classification_radius_(classification_radius),
+      frame_arena_(frameArenaCapacity(MAX_CLOUD_POINTS, adaptive_configuration.preemptive_sample_size)),
+      processing_x_(&frame_arena_), processing_y_(&frame_arena_), processing_z_(&frame_arena_),
+      preemptive_x_(&frame_arena_), preemptive_y_(&frame_arena_), preemptive_z_(&frame_arena_),
+      polar_grid_(NUMBER_OF_CHANNELS, NUMBER_OF_CELLS, MAX_CLOUD_POINTS)
+{
+    generators_.resize(thread_count_);
+    worker_planes_.resize(thread_count_);
+    range_reclassified_points_.resize(std::max(thread_count_, horizontal_traversal_bands_));
+    band_last_ground_points_.resize(horizontal_traversal_bands_);
+    if (thread_count_ > 1U)
+    {
+        thread_pool_ = std::make_unique<utilities_lib::ThreadPool>(thread_count_);
+    }
+}
+
+RansacSegmenter::~RansacSegmenter()
+{
+}
+
+void RansacSegmenter::resetFrameScratch(std::size_t number_of_points)
 {
-    processing_points_.reserve(200'000U);
+    // Buffers of the previous frame are handed back before the arena reuses their memory
+    processing_x_ = std::pmr::vector<float>{&frame_arena_};
+    processing_y_ = std::pmr::vector<float>{&frame_arena_};
+    processing_z_ = std::pmr::vector<float>{&frame_arena_};
+    preemptive_x_ = std::pmr::vector<float>{&frame_arena_};
+    preemptive_y_ = std::pmr::vector<float>{&frame_arena_};
+    preemptive_z_ = std::pmr::vector<float>{&frame_arena_};
+    frame_arena_.reset();
+
+    // Reserved up front, so the buffers never grow within the frame
+    processing_x_.reserve(number_of_points);
+    processing_y_.reserve(number_of_points);
+    processing_z_.reserve(number_of_points);
+    preemptive_x_.reserve(adaptive_configuration_.preemptive_sample_size);
+    preemptive_y_.reserve(adaptive_configuration_.preemptive_sample_size);
+    preemptive_z_.reserve(adaptive_configuration_.preemptive_sample_size);
+}
 
-    for (auto &channel : polar_grid_)
+RansacSegmenter::PlaneHypothesis RansacSegmenter::fitPlane()
+{
+    // Restart random sequences so that every frame is processed the same way
+    for (std::uint32_t worker = 0U; worker < generators_.size(); ++worker)
     {
-        for (auto &cell : channel)
+        generators_[worker].seed(RANDOM_SEED + worker);
+    }
+
+    if (!adaptive_configuration_.enabled)
+    {
+        return evaluateHypothesesOnWorkers(number_of_iterations_, PlaneHypothesis{});
+    }
+
+    const auto number_of_points = static_cast<std::uint32_t>(processing_x_.size());
+
+    // Pick evenly spread points for preemptive scoring, small clouds are always scored in full
+    preemptive_x_.clear();
+    preemptive_y_.clear();
+    preemptive_z_.clear();
+    const std::uint32_t sample_size = adaptive_configuration_.preemptive_sample_size;
+    if ((sample_size > 0U) && (number_of_points > sample_size))
+    {
+        const std::uint32_t stride = number_of_points / sample_size;
+        for (std::uint32_t i = 0U; preemptive_x_.size() < sample_size; i += stride)
         {
-            // Approximate number of points in each cell
-            cell.reserve(100U);
+            preemptive_x_.push_back(processing_x_[i]);
+            preemptive_y_.push_back(processing_y_[i]);
+            preemptive_z_.push_back(processing_z_[i]);
         }
     }
+
+    // Ground rarely changes between frames, previous plane often terminates the search right away
+    PlaneHypothesis best_plane{};
+    if (adaptive_configuration_.warm_start && previous_plane_valid_)
+    {
+        const PlaneCoefficients previous_plane{previous_plane_.a, previous_plane_.b, previous_plane_.c,
+                                               previous_plane_.d};
+        best_plane = previous_plane_;
+        countPlaneInliers(processing_x_.data(), processing_y_.data(), processing_z_.data(), number_of_points,
+                          &previous_plane, 1U, orthogonal_distance_threshold_, &best_plane.inlier_count);
+    }
+
+    // Evaluate hypotheses in rounds, the number of required hypotheses is updated after each round
+    const std::uint32_t round_size = thread_count_ * HYPOTHESES_PER_BATCH;
+    std::uint32_t evaluated_hypotheses = 0U;
+    std::uint32_t required_hypotheses = requiredNumberOfHypotheses(best_plane.inlier_count);
+    while (evaluated_hypotheses < required_hypotheses)
+    {
+        const std::uint32_t number_of_hypotheses = std::min(round_size, required_hypotheses - evaluated_hypotheses);
+        best_plane = evaluateHypothesesOnWorkers(number_of_hypotheses, best_plane);
+        evaluated_hypotheses += number_of_hypotheses;
+        required_hypotheses = requiredNumberOfHypotheses(best_plane.inlier_count);
+    }
+
+    return best_plane;
 }
 
-RansacSegmenter::~RansacSegmenter()
+void RansacSegmenter::setEgoMotion(const Eigen::Isometry3f &previous_to_current)
+{
+    ego_motion_ = previous_to_current;
+    ego_motion_pending_ = true;
+}
+
+void RansacSegmenter::compensateEgoMotion() noexcept
+{
+    if (!ego_motion_pending_)
+    {
+        return;
+    }
+    ego_motion_pending_ = false;
+
+    // Points move as p' = R p + t, so the plane n.p = d becomes (R n).p' = d + (R n).t
+    const Eigen::Vector3f normal =
+        ego_motion_.linear() * Eigen::Vector3f{previous_plane_.a, previous_plane_.b, previous_plane_.c};
+    previous_plane_.a = normal.x();
+    previous_plane_.b = normal.y();
+    previous_plane_.c = normal.z();
+    previous_plane_.d += normal.dot(ego_motion_.translation());
+}
+
+bool RansacSegmenter::validatePreviousPlane(PlaneHypothesis &plane) const
+{
+    if (!temporal_configuration_.enabled || !previous_plane_valid_ ||
+        (plane_age_ >= temporal_configuration_.max_plane_age))
+    {
+        return false;
+    }
+
+    const auto number_of_points = static_cast<std::uint32_t>(processing_x_.size());
+    const PlaneCoefficients previous_plane{previous_plane_.a, previous_plane_.b, previous_plane_.c, previous_plane_.d};
+    plane = previous_plane_;
+    countPlaneInliers(processing_x_.data(), processing_y_.data(), processing_z_.data(), number_of_points,
+                      &previous_plane, 1U, orthogonal_distance_threshold_, &plane.inlier_count);
+
+    // Ratio of the last fit, not of the last reused frame, so that the plane can not drift by small losses
+    const float inlier_ratio = static_cast<float>(plane.inlier_count) / static_cast<float>(number_of_points);
+    return (inlier_ratio >= (temporal_configuration_.plane_inlier_retention * fitted_inlier_ratio_)) &&
+           (plane.inlier_count > 0U);
+}
+
+RansacSegmenter::PlaneHypothesis RansacSegmenter::evaluateHypothesesOnWorkers(std::uint32_t number_of_hypotheses,
+                                                                              const PlaneHypothesis &reference_plane)
 {
+    PlaneHypothesis best_plane = reference_plane;
+
+    if (thread_pool_ == nullptr)
+    {
+        const PlaneHypothesis plane =
+            evaluateHypotheses(generators_.front(), number_of_hypotheses, reference_plane.inlier_count);
+        if (plane.inlier_count > best_plane.inlier_count)
+        {
+            best_plane = plane;
+        }
+        return best_plane;
+    }
+
+    // Split hypotheses evenly between the workers, every worker writes its own best plane
+    utilities_lib::TaskGroup task_group(*thread_pool_);
+    const std::uint32_t hypotheses_per_worker = number_of_hypotheses / thread_count_;
+    const std::uint32_t remaining_hypotheses = number_of_hypotheses % thread_count_;
+    for (std::uint32_t worker = 0U; worker < thread_count_; ++worker)
+    {
+        const std::uint32_t worker_hypotheses = hypotheses_per_worker + ((worker < remaining_hypotheses) ? 1U : 0U);
+        worker_planes_[worker] = PlaneHypothesis{};
+        if (worker_hypotheses == 0U)
+        {
+            continue;
+        }
+
+        const std::uint32_t reference_inlier_count = reference_plane.inlier_count;
+        task_group.run([this, worker, worker_hypotheses, reference_inlier_count]() {
+            worker_planes_[worker] = evaluateHypotheses(generators_[worker], worker_hypotheses, reference_inlier_count);
+        });
+    }
+    task_group.wait();
+
+    // Reduce in the worker order, ties are resolved in favour of the reference plane and then the lower worker index
+    for (const auto &plane : worker_planes_)
+    {
+        if (plane.inlier_count > best_plane.inlier_count)
+        {
+            best_plane = plane;
+        }
+    }
+
+    return best_plane;
+}
+
+std::uint32_t RansacSegmenter::requiredNumberOfHypotheses(std::uint32_t best_inlier_count) const noexcept
+{
+    if (best_inlier_count == 0U)
+    {
+        return number_of_iterations_;
+    }
+
+    // Pivot point is fixed, so each sample consists of two random points
+    const double inlier_ratio = static_cast<double>(best_inlier_count) / static_cast<double>(processing_x_.size());
+    const double outlier_free_sample_probability = inlier_ratio * inlier_ratio;
+
+    const auto confidence = static_cast<double>(adaptive_configuration_.confidence);
+
+    double required_hypotheses = static_cast<double>(adaptive_configuration_.min_iterations);
+    if (outlier_free_sample_probability < 1.0)
+    {
+        required_hypotheses =
+            std::max(required_hypotheses,
+                     std::ceil(std::log(1.0 - confidence) / std::log(1.0 - outlier_free_sample_probability)));
+    }
+
+    // Also rejects NaN and infinity for confidence outside of (0, 1)
+    if (!(required_hypotheses < static_cast<double>(number_of_iterations_)))
+    {
+        return number_of_iterations_;
+    }
+
+    return static_cast<std::uint32_t>(required_hypotheses);
+}
+
+RansacSegmenter::PlaneHypothesis RansacSegmenter::evaluateHypotheses(std::mt19937 &generator,
+                                                                     std::uint32_t number_of_hypotheses,
+                                                                     std::uint32_t reference_inlier_count) const
+{
+    // Set pivot constraints
+    const pcl::PointXYZ point_1{0.0F, 0.0F, -height_offset_};
+    const float max_plane_inclination_rad = max_plane_inclination_deg_ * M_PIf32 / 180.0F;
+    const float max_plane_cosine_angle = std::cos(max_plane_inclination_rad);
+
+    // For index generation
+    const auto number_of_points = static_cast<std::uint32_t>(processing_x_.size());
+    std::uniform_int_distribution<std::uint32_t> distribution(0, number_of_points - 1U);
+
+    // Hypotheses are generated in batches and scored together
+    std::array<PlaneCoefficients, HYPOTHESES_PER_BATCH> batch_planes;
+    std::array<std::uint32_t, HYPOTHESES_PER_BATCH> batch_inlier_counts;
+    std::uint32_t batch_size = 0U;
+
+    // Preemptive scoring is only possible once a plane to compete against is known
+    const auto number_of_sample_points = static_cast<std::uint32_t>(preemptive_x_.size());
+    const bool preemptive_scoring = adaptive_configuration_.enabled && (number_of_sample_points > 0U);
+
+    PlaneHypothesis best_plane{};
+    const auto scoreBatch = [&]() -> void {
+        const std::uint32_t competing_inlier_count = std::max(reference_inlier_count, best_plane.inlier_count);
+        if (preemptive_scoring && (competing_inlier_count > 0U))
+        {
+            countPlaneInliers(preemptive_x_.data(), preemptive_y_.data(), preemptive_z_.data(),
+                              number_of_sample_points, batch_planes.data(), batch_size,
+                              orthogonal_distance_threshold_, batch_inlier_counts.data());
+
+            // Keep only the hypotheses that are competitive on the sample
+            const float min_sample_inliers = adaptive_configuration_.preemptive_rejection_ratio *
+                                             static_cast<float>(competing_inlier_count) *
+                                             static_cast<float>(number_of_sample_points) /
+                                             static_cast<float>(number_of_points);
+            std::uint32_t survivors = 0U;
+            for (std::uint32_t i = 0U; i < batch_size; ++i)
+            {
+                if (static_cast<float>(batch_inlier_counts[i]) >= min_sample_inliers)
+                {
+                    batch_planes[survivors] = batch_planes[i];
+                    ++survivors;
+                }
+            }
+            batch_size = survivors;
+        }
+
+        countPlaneInliers(processing_x_.data(), processing_y_.data(), processing_z_.data(), number_of_points,
+                          batch_planes.data(), batch_size, orthogonal_distance_threshold_, batch_inlier_counts.data());
+
+        // If the plane is best so far, update the plane coefficients
+        for (std::uint32_t i = 0U; i < batch_size; ++i)
+        {
+            if (batch_inlier_counts[i] > best_plane.inlier_count)
+            {
+                best_plane.inlier_count = batch_inlier_counts[i];
+                best_plane.a = batch_planes[i].a;
+                best_plane.b = batch_planes[i].b;
+                best_plane.c = batch_planes[i].c;
+                best_plane.d = batch_planes[i].d;
+            }
+        }
+
+        batch_size = 0U;
+    };
+
+    for (std::uint32_t iteration = 0U; iteration < number_of_hypotheses; ++iteration)
+    {
+        // Choose 2 random points
+        const std::uint32_t point_2_index = distribution(generator);
+        const pcl::PointXYZ point_2{processing_x_[point_2_index], processing_y_[point_2_index],
+                                    processing_z_[point_2_index]};
+
+        std::uint32_t point_3_index = distribution(generator);
+        while (point_2_index == point_3_index)
+        {
+            point_3_index = distribution(generator);
+        }
+        const pcl::PointXYZ point_3{processing_x_[point_3_index], processing_y_[point_3_index],
+                                    processing_z_[point_3_index]};
+
+        // Calculate a plane defined by three points
+        float normal_x =
+            ((point_2.y - point_1.y) * (point_3.z - point_1.z)) - ((point_2.z - point_1.z) * (point_3.y - point_1.y));
+        float normal_y =
+            ((point_2.z - point_1.z) * (point_3.x - point_1.x)) - ((point_2.x - point_1.x) * (point_3.z - point_1.z));
+        float normal_z =
+            ((point_2.x - point_1.x) * (point_3.y - point_1.y)) - ((point_2.y - point_1.y) * (point_3.x - point_1.x));
+
+        // Calculate normalization
+        const float denominator = std::sqrt((normal_x * normal_x) + (normal_y * normal_y) + (normal_z * normal_z));
+
+        // Check that denominator is not too small
+        if (denominator < 1.0e-4F)
+        {
+            continue;
+        }
+        const float normalization = 1.0F / denominator;
+
+        // Normalize plane coefficients
+        normal_z *= normalization;
+
+        // Constrain plane
+        if (std::fabs(normal_z) < max_plane_cosine_angle)
+        {
+            continue;
+        }
+
+        normal_x *= normalization;
+        normal_y *= normalization;
+
+        const float plane_d = (normal_x * point_1.x) + (normal_y * point_1.y) + (normal_z * point_1.z);
+
+        // Defer inlier counting until the batch is full
+        batch_planes[batch_size] = PlaneCoefficients{normal_x, normal_y, normal_z, plane_d};
+        ++batch_size;
+
+        if (batch_size == HYPOTHESES_PER_BATCH)
+        {
+            scoreBatch();
+        }
+    }
+
+    // Score remaining hypotheses
+    if (batch_size > 0U)
+    {
+        scoreBatch();
+    }
+
+    return best_plane;
 }
 
 void RansacSegmenter::run(const pcl::PointCloud<pcl::PointXYZ> &cloud, std::vector<SegmentationLabel> &labels)
@@ -35,4 +386,198 @@ void RansacSegmenter::run(const pcl::PointCloud<pcl::PointXYZI> &cloud, std::vec
 {
     segment(cloud, labels);
 }
+
+void RansacSegmenter::run(const data_types_lib::PointCloudView &cloud, std::vector<SegmentationLabel> &labels)
+{
+    segment(cloud, labels);
+}
+
+void RansacSegmenter::run(const data_types_lib::PointCloudSoA &cloud, std::vector<SegmentationLabel> &labels)
+{
+    segment(cloud, labels);
+}
+
+std::uint32_t RansacSegmenter::refineClassificationThroughPolarGridTraversal(std::vector<SegmentationLabel> &labels)
+{
+    const PolarGridPoint pivot_point{0.0F, 0.0F, -height_offset_, 0.0F, 0U, SegmentationLabel::GROUND};
+
+    // Channels are independent in the forward traversal and in the cell smoothing, each worker takes a range of them
+    const std::uint32_t number_of_channel_ranges = (thread_pool_ == nullptr) ? 1U : thread_count_;
+
+    // Traverse grid in the forward direction
+    const std::uint32_t reclassified_points_forward_traversal = reduceOverRanges(
+        NUMBER_OF_CHANNELS, number_of_channel_ranges,
+        [this, &labels](std::uint32_t, std::uint32_t first_channel, std::uint32_t last_channel) {
+            return traverseChannels(first_channel, last_channel, labels);
+        });
+
+    // Traverse grid in the horizontal direction
+    std::uint32_t reclassified_points_horizontal_traversal = 0U;
+    if ((horizontal_traversal_bands_ == 1U) || (thread_pool_ == nullptr))
+    {
+        const auto *last_known_ground_point = &pivot_point;
+        reclassified_points_horizontal_traversal =
+            traverseRings(0U, NUMBER_OF_CELLS, last_known_ground_point, labels);
+    }
+    else
+    {
+        // Each band of rings starts from the pivot point instead of the ground point carried from the previous band
+        reclassified_points_horizontal_traversal = reduceOverRanges(
+            NUMBER_OF_CELLS, horizontal_traversal_bands_,
+            [this, &labels, &pivot_point](std::uint32_t band_index, std::uint32_t first_cell, std::uint32_t last_cell) {
+                const auto *last_known_ground_point = &pivot_point;
+                const std::uint32_t reclassified_points =
+                    traverseRings(first_cell, last_cell, last_known_ground_point, labels);
+                band_last_ground_points_[band_index] = last_known_ground_point;
+                return reclassified_points;
+            });
+
+        // Seam fix-up, revisit the first ring of each band with the last ground point of the previous band
+        for (std::uint32_t band_index = 1U; band_index < horizontal_traversal_bands_; ++band_index)
+        {
+            const auto first_cell = static_cast<std::uint32_t>(
+                (static_cast<std::uint64_t>(band_index) * NUMBER_OF_CELLS) / horizontal_traversal_bands_);
+            const auto *last_known_ground_point = band_last_ground_points_[band_index - 1U];
+            reclassified_points_horizontal_traversal +=
+                traverseRings(first_cell, std::min(first_cell + 1U, NUMBER_OF_CELLS), last_known_ground_point, labels);
+        }
+    }
+
+    // Last stage - per cell reclassification
+    const std::uint32_t reclassified_points_cell_smoothing =
+        reduceOverRanges(NUMBER_OF_CHANNELS, number_of_channel_ranges,
+                         [this](std::uint32_t, std::uint32_t first_channel, std::uint32_t last_channel) {
+                             return smoothChannelCells(first_channel, last_channel);
+                         });
+
+    return reclassified_points_forward_traversal + reclassified_points_horizontal_traversal +
+           reclassified_points_cell_smoothing;
+}
+
+std::uint32_t RansacSegmenter::traverseChannels(std::uint32_t first_channel, std::uint32_t last_channel,
+                                                std::vector<SegmentationLabel> &labels)
+{
+    const PolarGridPoint pivot_point{0.0F, 0.0F, -height_offset_, 0.0F, 0U, SegmentationLabel::GROUND};
+
+    std::uint32_t reclassified_points = 0U;
+    for (std::uint32_t channel_index = first_channel; channel_index < last_channel; ++channel_index)
+    {
+        const auto *last_known_ground_point = &pivot_point;
+
+        // Traverse each cell and refine
+        for (std::uint32_t cell_index = 0U; cell_index < NUMBER_OF_CELLS; ++cell_index)
+        {
+            // Traverse each point within cell
+            for (auto &point : polar_grid_.cell(channel_index, cell_index))
+            {
+                if (point.label == SegmentationLabel::GROUND)
+                {
+                    last_known_ground_point = &point;
+                }
+                // Check if can be re-classified as ground
+                else
+                {
+                    const float dx = point.x - last_known_ground_point->x;
+                    const float dy = point.y - last_known_ground_point->y;
+                    const float dz = point.z - last_known_ground_point->z;
+                    const float dr = std::sqrt((dx * dx) + (dy * dy));
+                    const float gradient = dz / dr;
+
+                    if ((std::fabs(gradient) < 0.2F) && (dr < 8.0F))
+                    {
+                        point.label = SegmentationLabel::GROUND;
+                        last_known_ground_point = &point;
+                        labels[point.index] = SegmentationLabel::GROUND;
+                        ++reclassified_points;
+                    }
+                }
+            }
+        }
+    }
+
+    return reclassified_points;
+}
+
+std::uint32_t RansacSegmenter::traverseRings(std::uint32_t first_cell, std::uint32_t last_cell,
+                                             const PolarGridPoint *&last_known_ground_point,
+                                             std::vector<SegmentationLabel> &labels)
+{
+    std::uint32_t reclassified_points = 0U;
+    for (std::uint32_t cell_index = first_cell; cell_index < last_cell; ++cell_index)
+    {
+        for (std::uint32_t channel_index = 0U; channel_index < NUMBER_OF_CHANNELS; ++channel_index)
+        {
+            // For each point
+            for (auto &point : polar_grid_.cell(channel_index, cell_index))
+            {
+                if (point.label == SegmentationLabel::GROUND)
+                {
+                    last_known_ground_point = &point;
+                }
+                // Check if can be re-classified as ground
+                else
+                {
+                    const float dx = point.x - last_known_ground_point->x;
+                    const float dy = point.y - last_known_ground_point->y;
+                    const float dz = point.z - last_known_ground_point->z;
+                    const float dr = std::sqrt((dx * dx) + (dy * dy));
+                    const float gradient = dz / dr;
+
+                    if ((std::fabs(gradient) < 0.10F) && (dr < 1.0F))
+                    {
+                        point.label = SegmentationLabel::GROUND;
+                        last_known_ground_point = &point;
+                        labels[point.index] = SegmentationLabel::GROUND;
+                        ++reclassified_points;
+                    }
+                }
+            }
+        }
+    }
+
+    return reclassified_points;
+}
+
+std::uint32_t RansacSegmenter::smoothChannelCells(std::uint32_t first_channel, std::uint32_t last_channel)
+{
+    std::uint32_t reclassified_points = 0U;
+    for (std::uint32_t channel_index = first_channel; channel_index < last_channel; ++channel_index)
+    {
+        for (std::uint32_t cell_index = 0U; cell_index < NUMBER_OF_CELLS; ++cell_index)
+        {
+            const auto cell = polar_grid_.cell(channel_index, cell_index);
+
+            // Find mean ground point within current cells
+            float z_mean = 0.0;
+            std::uint32_t number_of_ground_points_within_cell = 0U;
+            for (const auto &point : cell)
+            {
+                if (point.label == SegmentationLabel::GROUND)
+                {
+                    z_mean += point.z;
+                    ++number_of_ground_points_within_cell;
+                }
+            }
+            if (number_of_ground_points_within_cell > 0U)
+            {
+                z_mean /= number_of_ground_points_within_cell;
+
+                // Attempt to smooth out non-ground classifications
+                for (auto &point : cell)
+                {
+                    if (point.label == SegmentationLabel::OBSTACLE)
+                    {
+                        if (std::fabs(point.z - z_mean) < 0.15F)
+                        {
+                            point.label = SegmentationLabel::GROUND;
+                            ++reclassified_points;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    return reclassified_points;
+}
 } // namespace lidar_processing_lib::segmentation
@@ -0,0 +1,86 @@
+#ifndef LIDAR_PROCESSING_LIB__TEST__SYNTHETIC_SCAN_HPP
+#define LIDAR_PROCESSING_LIB__TEST__SYNTHETIC_SCAN_HPP
+
+#include <algorithm>                           // std::min
+#include <cmath>                               // std::tan, std::cos, std::sin, M_PI
+#include <cstddef>                             // offsetof
+#include <cstdint>                             // std::uint32_t, std::uint8_t
+#include <data_types_lib/cartesian_return.hpp> // CartesianReturn
+#include <data_types_lib/point_cloud_view.hpp> // PointCloudView, PointCloudLayout
+#include <vector>                              // std::vector
+
+namespace lidar_processing_lib::test
+{
+// Scan of a 64 beam sensor mounted at the height of the Kitti car over flat ground
+constexpr std::uint32_t NUMBER_OF_RINGS = 64U;
+constexpr float MIN_ELEVATION_DEG = -24.8F;
+constexpr float MAX_ELEVATION_DEG = 2.0F;
+constexpr float SENSOR_HEIGHT_M = 1.73F;
+constexpr float WALL_RANGE_M = 80.0F;
+
+/// @brief Rings of returns off flat ground, with a box of obstacle_height standing at obstacle_range in every eighth
+/// azimuth sector of 10 degrees. Rays above the horizon, or reaching the ground past the wall range, hit a wall.
+/// @param forward_offset - Distance the sensor moved forward, the ground and the obstacles stay in place.
+inline std::vector<data_types_lib::CartesianReturn> makeSyntheticScan(const float azimuth_step_deg,
+                                                                     const float forward_offset = 0.0F,
+                                                                     const float obstacle_range = 12.0F,
+                                                                     const float obstacle_height = 1.5F)
+{
+    constexpr float DEG_TO_RAD = static_cast<float>(M_PI / 180.0);
+
+    std::vector<data_types_lib::CartesianReturn> points;
+    const auto number_of_azimuths = static_cast<std::uint32_t>(360.0F / azimuth_step_deg);
+    points.reserve(static_cast<std::size_t>(NUMBER_OF_RINGS) * number_of_azimuths);
+
+    for (std::uint32_t azimuth_index = 0U; azimuth_index < number_of_azimuths; ++azimuth_index)
+    {
+        const float azimuth_deg = static_cast<float>(azimuth_index) * azimuth_step_deg;
+        const float azimuth = azimuth_deg * DEG_TO_RAD;
+        const bool has_obstacle = (static_cast<std::uint32_t>(azimuth_deg / 10.0F) % 8U) == 0U;
+
+        for (std::uint32_t ring = 0U; ring < NUMBER_OF_RINGS; ++ring)
+        {
+            const float elevation_deg =
+                MIN_ELEVATION_DEG + ((MAX_ELEVATION_DEG - MIN_ELEVATION_DEG) * static_cast<float>(ring) /
+                                     static_cast<float>(NUMBER_OF_RINGS - 1U));
+            const float slope = std::tan(elevation_deg * DEG_TO_RAD);
+
+            float range = WALL_RANGE_M;
+            if (slope < 0.0F)
+            {
+                range = std::min(SENSOR_HEIGHT_M / -slope, WALL_RANGE_M);
+            }
+
+            // The box face is hit where the ray passes it below the top of the box
+            const float obstacle_range_from_sensor = obstacle_range - forward_offset;
+            const float height_at_obstacle = SENSOR_HEIGHT_M + (obstacle_range_from_sensor * slope);
+            if (has_obstacle && (obstacle_range_from_sensor > 0.0F) && (range > obstacle_range_from_sensor) &&
+                (height_at_obstacle >= 0.0F) && (height_at_obstacle <= obstacle_height))
+            {
+                range = obstacle_range_from_sensor;
+            }
+
+            points.push_back(data_types_lib::CartesianReturn{range * std::cos(azimuth), range * std::sin(azimuth),
+                                                             range * slope, 1.0F});
+        }
+    }
+    return points;
+}
+
+/// @brief Unorganized view of the points, the points must outlive it.
+inline data_types_lib::PointCloudView viewOf(const std::vector<data_types_lib::CartesianReturn> &points) noexcept
+{
+    data_types_lib::PointCloudLayout layout;
+    layout.x_offset = offsetof(data_types_lib::CartesianReturn, x);
+    layout.y_offset = offsetof(data_types_lib::CartesianReturn, y);
+    layout.z_offset = offsetof(data_types_lib::CartesianReturn, z);
+    layout.intensity_offset = offsetof(data_types_lib::CartesianReturn, intensity);
+    layout.point_step = sizeof(data_types_lib::CartesianReturn);
+
+    const auto number_of_points = static_cast<std::uint32_t>(points.size());
+    return data_types_lib::PointCloudView{reinterpret_cast<const std::uint8_t *>(points.data()), number_of_points, 1U,
+                                          number_of_points * layout.point_step, layout};
+}
+} // namespace lidar_processing_lib::test
+
+#endif // LIDAR_PROCESSING_LIB__TEST__SYNTHETIC_SCAN_HPP
@@ -0,0 +1,263 @@
+#include <lidar_processing_lib/fusion/camera_calibration.hpp>
+#include <lidar_processing_lib/fusion/camera_projection_kernel.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace lidar_processing_lib;
+
+namespace
+{
+// Calibration of the 2011_09_26 Kitti drive, camera 2
+constexpr const char *IMAGE_SIZE = "1.242000e+03 3.750000e+02";
+constexpr const char *RECTIFIED_PROJECTION =
+    "7.215377e+02 0.000000e+00 6.095593e+02 4.485728e+01 0.000000e+00 7.215377e+02 1.728540e+02 2.163791e-01 "
+    "0.000000e+00 0.000000e+00 1.000000e+00 2.745884e-03";
+constexpr const char *RECTIFICATION = "9.999239e-01 9.837760e-03 -7.445048e-03 -9.869795e-03 9.999421e-01 "
+                                      "-4.278459e-03 7.402527e-03 4.351614e-03 9.999631e-01";
+constexpr const char *ROTATION = "7.533745e-03 -9.999714e-01 -6.166020e-04 1.480249e-02 7.280733e-04 -9.998902e-01 "
+                                 "9.998621e-01 7.523790e-03 1.480755e-02";
+constexpr const char *TRANSLATION = "-4.069766e-03 -7.631618e-02 -2.717806e-01";
+
+constexpr std::uint32_t CAMERA_INDEX = 2U;
+constexpr float MIN_DEPTH_M = 0.5F;
+
+// Points projected within this fraction of a pixel of a pixel border may round to either pixel in float precision
+constexpr double PIXEL_BORDER_TOLERANCE = 1e-3;
+
+struct CalibrationEntries final
+{
+    std::string image_size = IMAGE_SIZE;
+    std::string rectified_projection = RECTIFIED_PROJECTION;
+    std::string rectification = RECTIFICATION;
+    std::string rotation = ROTATION;
+    std::string translation = TRANSLATION;
+};
+
+// Writes the calibration files of a drive, an empty entry is left out of its file
+std::filesystem::path writeCalibration(const std::string &folder_name, const CalibrationEntries &entries)
+{
+    const std::filesystem::path calibration_path = std::filesystem::temp_directory_path() / folder_name;
+    std::filesystem::create_directories(calibration_path);
+
+    std::ofstream cam_to_cam{calibration_path / "calib_cam_to_cam.txt", std::ios::trunc};
+    cam_to_cam << "calib_time: 09-Jan-2012 13:57:47\n";
+    if (!entries.rectification.empty())
+    {
+        cam_to_cam << "R_rect_00: " << entries.rectification << "\n";
+    }
+    if (!entries.image_size.empty())
+    {
+        cam_to_cam << "S_rect_02: " << entries.image_size << "\n";
+    }
+    if (!entries.rectified_projection.empty())
+    {
+        cam_to_cam << "P_rect_02: " << entries.rectified_projection << "\n";
+    }
+
+    std::ofstream velo_to_cam{calibration_path / "calib_velo_to_cam.txt", std::ios::trunc};
+    velo_to_cam << "calib_time: 15-Mar-2012 11:37:16\n";
+    if (!entries.rotation.empty())
+    {
+        velo_to_cam << "R: " << entries.rotation << "\n";
+    }
+    if (!entries.translation.empty())
+    {
+        velo_to_cam << "T: " << entries.translation << "\n";
+    }
+    velo_to_cam << "delta_f: 0.000000e+00 0.000000e+00\n";
+
+    return calibration_path;
+}
+
+fusion::CameraCalibration loadCalibration(const CalibrationEntries &entries)
+{
+    const std::filesystem::path calibration_path = writeCalibration("lidar_processing_lib_test_calibration", entries);
+    const auto remove_calibration = [&calibration_path]() { std::filesystem::remove_all(calibration_path); };
+    try
+    {
+        const fusion::CameraCalibration calibration = fusion::loadKittiCameraCalibration(calibration_path,
+                                                                                       CAMERA_INDEX);
+        remove_calibration();
+        return calibration;
+    }
+    catch (...)
+    {
+        remove_calibration();
+        throw;
+    }
+}
+
+// Pixel of the point projected in double precision, false if it is not clearly inside or outside of the image
+bool projectReference(const fusion::CameraCalibration &calibration, const float x, const float y, const float z,
+                      std::uint32_t &pixel)
+{
+    const Eigen::Matrix<double, 3, 4> m = calibration.lidar_to_image.cast<double>();
+    const Eigen::Vector3d projected = m * Eigen::Vector4d{x, y, z, 1.0};
+    const double depth = projected.z();
+    const double column = projected.x() / depth;
+    const double row = projected.y() / depth;
+
+    const auto is_near_border = [](const double coordinate) {
+        return std::fabs(coordinate - std::round(coordinate)) < PIXEL_BORDER_TOLERANCE;
+    };
+    if (is_near_border(column) || is_near_border(row) || (std::fabs(depth - MIN_DEPTH_M) < PIXEL_BORDER_TOLERANCE))
+    {
+        return false;
+    }
+
+    const bool is_seen = (depth > MIN_DEPTH_M) && (column >= 0.0) && (column < calibration.width) && (row >= 0.0) &&
+                         (row < calibration.height);
+    pixel = is_seen ? fusion::packPixel(static_cast<std::uint32_t>(row), static_cast<std::uint32_t>(column))
+                    : fusion::INVALID_PIXEL;
+    return true;
+}
+} // namespace
+
+// Test that the composed projection matches the calibration entries
+TEST(CameraCalibrationTest, LoadKittiCalibration)
+{
+    const fusion::CameraCalibration calibration = loadCalibration(CalibrationEntries{});
+    EXPECT_EQ(calibration.width, 1242U);
+    EXPECT_EQ(calibration.height, 375U);
+
+    // Point on the optical axis of the lidar, 10 m ahead, is projected near the principal point
+    const Eigen::Vector3f projected = calibration.lidar_to_image * Eigen::Vector4f{10.0F, 0.0F, 0.0F, 1.0F};
+    EXPECT_NEAR(projected.z(), 10.0F, 0.3F);
+    EXPECT_NEAR(projected.x() / projected.z(), 609.6F, 15.0F);
+    EXPECT_NEAR(projected.y() / projected.z(), 172.9F, 15.0F);
+}
+
+// Test that a calibration without one of its entries is rejected
+TEST(CameraCalibrationTest, MissingEntry)
+{
+    for (std::size_t entry_index = 0U; entry_index < 5U; ++entry_index)
+    {
+        CalibrationEntries entries;
+        std::string *const entry[] = {&entries.image_size, &entries.rectified_projection, &entries.rectification,
+                                      &entries.rotation, &entries.translation};
+        entry[entry_index]->clear();
+        EXPECT_THROW(loadCalibration(entries), std::runtime_error) << "Entry " << entry_index;
+    }
+
+    EXPECT_THROW(fusion::loadKittiCameraCalibration(std::filesystem::temp_directory_path() /
+                                                        "lidar_processing_lib_test_missing_calibration",
+                                                    CAMERA_INDEX),
+                 std::runtime_error);
+}
+
+// Test that entries with too few or too many values are rejected
+TEST(CameraCalibrationTest, WrongValueCount)
+{
+    CalibrationEntries missing_value;
+    missing_value.rectified_projection = missing_value.rectified_projection.substr(
+        0U, missing_value.rectified_projection.rfind(' '));
+    EXPECT_THROW(loadCalibration(missing_value), std::runtime_error);
+
+    CalibrationEntries extra_value;
+    extra_value.translation += " 1.0";
+    EXPECT_THROW(loadCalibration(extra_value), std::runtime_error);
+
+    CalibrationEntries single_size;
+    single_size.image_size = "1.242000e+03";
+    EXPECT_THROW(loadCalibration(single_size), std::runtime_error);
+}
+
+// Test that image sizes which can not be packed into a pixel are rejected
+TEST(CameraCalibrationTest, ImageSizeRange)
+{
+    CalibrationEntries empty_image;
+    empty_image.image_size = "0.000000e+00 3.750000e+02";
+    EXPECT_THROW(loadCalibration(empty_image), std::runtime_error);
+
+    CalibrationEntries negative_image;
+    negative_image.image_size = "1.242000e+03 -3.750000e+02";
+    EXPECT_THROW(loadCalibration(negative_image), std::runtime_error);
+
+    CalibrationEntries wide_image;
+    wide_image.image_size = "7.000000e+04 3.750000e+02";
+    EXPECT_THROW(loadCalibration(wide_image), std::runtime_error);
+
+    CalibrationEntries largest_image;
+    largest_image.image_size = "6.553500e+04 6.553500e+04";
+    EXPECT_EQ(loadCalibration(largest_image).width, 65535U);
+}
+
+// Test that the vectorized projection and its scalar tail match a double precision projection, for every point count
+// up to a few vector widths so that every tail length is covered
+TEST(CameraProjectionKernelTest, MatchesDoublePrecisionReference)
+{
+    const fusion::CameraCalibration calibration = loadCalibration(CalibrationEntries{});
+
+    // Points around the camera, in front of it, behind it and at the minimum depth
+    std::mt19937 generator{42U};
+    std::uniform_real_distribution<float> forward{-5.0F, 60.0F};
+    std::uniform_real_distribution<float> lateral{-30.0F, 30.0F};
+    std::uniform_real_distribution<float> vertical{-3.0F, 3.0F};
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> z;
+    for (std::size_t i = 0U; i < 10'000U; ++i)
+    {
+        x.push_back(forward(generator));
+        y.push_back(lateral(generator));
+        z.push_back(vertical(generator));
+    }
+
+    // Non-finite points are never seen
+    x[7U] = std::numeric_limits<float>::quiet_NaN();
+    y[11U] = std::numeric_limits<float>::infinity();
+
+    std::vector<std::uint32_t> expected_pixels(x.size());
+    std::vector<bool> has_reference(x.size());
+    std::size_t number_of_seen_points = 0U;
+    for (std::size_t i = 0U; i < x.size(); ++i)
+    {
+        if (!std::isfinite(x[i]) || !std::isfinite(y[i]))
+        {
+            expected_pixels[i] = fusion::INVALID_PIXEL;
+            has_reference[i] = true;
+            continue;
+        }
+
+        std::uint32_t pixel = fusion::INVALID_PIXEL;
+        has_reference[i] = projectReference(calibration, x[i], y[i], z[i], pixel);
+        expected_pixels[i] = pixel;
+        number_of_seen_points += (has_reference[i] && (pixel != fusion::INVALID_PIXEL)) ? 1U : 0U;
+    }
+    EXPECT_GT(number_of_seen_points, 1'000U);
+
+    // Runs starting at every offset of a vector and ending at every tail length
+    std::vector<std::uint32_t> pixels(x.size());
+    const std::size_t counts[] = {0U, 1U, 3U, 4U, 5U, 7U, 8U, 9U, 15U, 16U, 17U, 33U, x.size()};
+    for (const std::size_t offset : {std::size_t{0U}, std::size_t{1U}, std::size_t{3U}})
+    {
+        for (const std::size_t count : counts)
+        {
+            const std::size_t number_of_points = std::min(count, x.size() - offset);
+            std::fill(pixels.begin(), pixels.end(), 0U);
+            fusion::projectToPixels(x.data() + offset, y.data() + offset, z.data() + offset, number_of_points,
+                                    calibration, MIN_DEPTH_M, pixels.data());
+
+            for (std::size_t i = 0U; i < number_of_points; ++i)
+            {
+                if (has_reference[offset + i])
+                {
+                    ASSERT_EQ(pixels[i], expected_pixels[offset + i])
+                        << fusion::cameraProjectionKernelInstructionSet() << " point " << (offset + i);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,220 @@
+#include "synthetic_scan.hpp"
+
+#include <lidar_processing_lib/clustering/cartesian_dbscan.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <random>
+#include <vector>
+
+using namespace lidar_processing_lib;
+
+namespace
+{
+constexpr float EPSILON_M = 0.5F;
+constexpr std::uint32_t MIN_POINTS = 4U;
+constexpr auto OUTLIER = static_cast<data_types_lib::ClusteringLabel>(data_types_lib::ReservedClusteringLabel::OUTLIER);
+
+// Coordinates are multiples of this step, so that squared distances are exact in float precision and points exactly
+// at epsilon are neighbours
+constexpr float COORDINATE_STEP_M = 1.0F / 16.0F;
+
+// Sparse blobs with core, border and noise points, some of them touching each other, chains of points spaced exactly
+// at epsilon above them, and a non-finite point
+std::vector<data_types_lib::CartesianReturn> makeBlobs(const std::uint32_t seed)
+{
+    std::mt19937 generator{seed};
+    std::uniform_int_distribution<int> center{-160, 160};
+    std::uniform_int_distribution<int> spread{-10, 10};
+    std::uniform_int_distribution<std::size_t> blob_size{1U, 30U};
+
+    std::vector<data_types_lib::CartesianReturn> points;
+    for (std::size_t blob = 0U; blob < 80U; ++blob)
+    {
+        const int center_x = center(generator);
+        const int center_y = center(generator);
+        const int center_z = center(generator) / 16;
+        const std::size_t number_of_points = blob_size(generator);
+        for (std::size_t i = 0U; i < number_of_points; ++i)
+        {
+            points.push_back(data_types_lib::CartesianReturn{
+                COORDINATE_STEP_M * static_cast<float>(center_x + spread(generator)),
+                COORDINATE_STEP_M * static_cast<float>(center_y + spread(generator)),
+                COORDINATE_STEP_M * static_cast<float>(center_z + spread(generator)), 1.0F});
+        }
+    }
+
+    // One chain along each axis, a chain point with both of its neighbours and a point beside it is a core point
+    for (std::size_t axis = 0U; axis < 3U; ++axis)
+    {
+        for (std::size_t i = 0U; i < 6U; ++i)
+        {
+            float coordinates[3U] = {4.0F * static_cast<float>(axis), 0.0F, 5.0F};
+            coordinates[axis] += EPSILON_M * static_cast<float>(i);
+            points.push_back(data_types_lib::CartesianReturn{coordinates[0U], coordinates[1U], coordinates[2U], 1.0F});
+            coordinates[(axis + 1U) % 3U] += EPSILON_M;
+            points.push_back(data_types_lib::CartesianReturn{coordinates[0U], coordinates[1U], coordinates[2U], 1.0F});
+        }
+    }
+
+    points[3U].y = std::numeric_limits<float>::quiet_NaN();
+    return points;
+}
+
+bool isFinite(const data_types_lib::CartesianReturn &point)
+{
+    return std::isfinite(point.x) && std::isfinite(point.y) && std::isfinite(point.z);
+}
+
+bool areNeighbours(const data_types_lib::CartesianReturn &point_a, const data_types_lib::CartesianReturn &point_b)
+{
+    const float dx = point_a.x - point_b.x;
+    const float dy = point_a.y - point_b.y;
+    const float dz = point_a.z - point_b.z;
+    return isFinite(point_a) && isFinite(point_b) && (((dx * dx) + (dy * dy) + (dz * dz)) <= EPSILON_M * EPSILON_M);
+}
+
+// Neighbours of every point found by comparing every pair of points, each point is its own neighbour
+std::vector<std::vector<std::size_t>> findNeighbours(const std::vector<data_types_lib::CartesianReturn> &points)
+{
+    std::vector<std::vector<std::size_t>> neighbours(points.size());
+    for (std::size_t i = 0U; i < points.size(); ++i)
+    {
+        for (std::size_t j = 0U; j < points.size(); ++j)
+        {
+            if (areNeighbours(points[i], points[j]))
+            {
+                neighbours[i].push_back(j);
+            }
+        }
+    }
+    return neighbours;
+}
+
+// Connected components of the core points, the maximum index for the other points
+std::vector<std::size_t> findCoreComponents(const std::vector<std::vector<std::size_t>> &neighbours)
+{
+    std::vector<std::size_t> parents(neighbours.size());
+    std::iota(parents.begin(), parents.end(), std::size_t{0U});
+    const auto find = [&parents](std::size_t i) {
+        while (parents[i] != i)
+        {
+            i = parents[i] = parents[parents[i]];
+        }
+        return i;
+    };
+
+    const auto is_core = [&neighbours](const std::size_t i) { return neighbours[i].size() >= MIN_POINTS; };
+    for (std::size_t i = 0U; i < neighbours.size(); ++i)
+    {
+        for (const std::size_t j : neighbours[i])
+        {
+            if (is_core(i) && is_core(j))
+            {
+                parents[find(i)] = find(j);
+            }
+        }
+    }
+
+    std::vector<std::size_t> components(neighbours.size(), std::numeric_limits<std::size_t>::max());
+    for (std::size_t i = 0U; i < neighbours.size(); ++i)
+    {
+        if (is_core(i))
+        {
+            components[i] = find(i);
+        }
+    }
+    return components;
+}
+} // namespace
+
+// Test that the clusters of the core points match the components of the core points found by brute force neighbour
+// search, up to the numbering of the clusters, that border points join the cluster of one of their core neighbours and
+// that the remaining points are outliers, on the calling thread and on several workers
+TEST(CartesianDBSCANTest, MatchesBruteForceClusters)
+{
+    for (const std::uint32_t seed : {42U, 7U})
+    {
+        const std::vector<data_types_lib::CartesianReturn> points = makeBlobs(seed);
+        const std::vector<std::vector<std::size_t>> neighbours = findNeighbours(points);
+        const std::vector<std::size_t> components = findCoreComponents(neighbours);
+
+        std::vector<data_types_lib::ClusteringLabel> first_labels;
+        for (const std::uint32_t thread_count : {1U, 4U})
+        {
+            clustering::CartesianDBSCAN dbscan{EPSILON_M, MIN_POINTS, thread_count};
+            std::vector<data_types_lib::ClusteringLabel> labels;
+            dbscan.run(test::viewOf(points), labels);
+            ASSERT_EQ(labels.size(), points.size());
+
+            // Every component of core points maps to one label and every label to one component
+            std::map<std::size_t, data_types_lib::ClusteringLabel> component_labels;
+            std::map<data_types_lib::ClusteringLabel, std::size_t> label_components;
+            for (std::size_t i = 0U; i < points.size(); ++i)
+            {
+                if (components[i] == std::numeric_limits<std::size_t>::max())
+                {
+                    continue;
+                }
+
+                ASSERT_GE(labels[i], 0) << "Point " << i << ", " << thread_count << " threads";
+                const auto component_label = component_labels.emplace(components[i], labels[i]).first;
+                const auto label_component = label_components.emplace(labels[i], components[i]).first;
+                ASSERT_EQ(component_label->second, labels[i]) << "Point " << i << ", " << thread_count << " threads";
+                ASSERT_EQ(label_component->second, components[i])
+                    << "Point " << i << ", " << thread_count << " threads";
+            }
+
+            // Border points take the label of a core neighbour, the other points are noise
+            std::size_t number_of_border_points = 0U;
+            std::size_t number_of_noise_points = 0U;
+            for (std::size_t i = 0U; i < points.size(); ++i)
+            {
+                if (components[i] != std::numeric_limits<std::size_t>::max())
+                {
+                    continue;
+                }
+
+                bool has_core_neighbour = false;
+                bool has_core_neighbour_label = false;
+                for (const std::size_t j : neighbours[i])
+                {
+                    if (components[j] != std::numeric_limits<std::size_t>::max())
+                    {
+                        has_core_neighbour = true;
+                        has_core_neighbour_label = has_core_neighbour_label || (labels[j] == labels[i]);
+                    }
+                }
+                if (has_core_neighbour)
+                {
+                    EXPECT_TRUE(has_core_neighbour_label) << "Point " << i << ", " << thread_count << " threads";
+                    ++number_of_border_points;
+                }
+                else
+                {
+                    EXPECT_EQ(labels[i], OUTLIER) << "Point " << i << ", " << thread_count << " threads";
+                    ++number_of_noise_points;
+                }
+            }
+
+            // Clusters are numbered consecutively, independently of the number of workers
+            ASSERT_GT(label_components.size(), 10U);
+            EXPECT_EQ(label_components.begin()->first, 0);
+            EXPECT_EQ(static_cast<std::size_t>(label_components.rbegin()->first), label_components.size() - 1U);
+            EXPECT_GT(number_of_border_points, 10U);
+            EXPECT_GT(number_of_noise_points, 10U);
+
+            if (first_labels.empty())
+            {
+                first_labels = labels;
+            }
+            EXPECT_EQ(labels, first_labels) << thread_count << " threads";
+        }
+    }
+}
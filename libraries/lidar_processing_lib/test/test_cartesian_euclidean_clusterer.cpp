@@ -0,0 +1,170 @@
+#include "synthetic_scan.hpp"
+
+#include <lidar_processing_lib/clustering/cartesian_euclidean_clusterer.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <random>
+#include <vector>
+
+using namespace lidar_processing_lib;
+
+namespace
+{
+constexpr float CLUSTER_TOLERANCE_M = 0.5F;
+constexpr std::uint32_t MIN_CLUSTER_SIZE = 5U;
+constexpr std::uint32_t MAX_CLUSTER_SIZE = 30U;
+constexpr auto OUTLIER = static_cast<data_types_lib::ClusteringLabel>(data_types_lib::ReservedClusteringLabel::OUTLIER);
+
+// Coordinates are multiples of this step, so that squared distances are exact in float precision and points exactly
+// at the cluster tolerance are neighbours
+constexpr float COORDINATE_STEP_M = 1.0F / 16.0F;
+
+// Blobs of up to a few tens of points, some of them touching each other, chains of points spaced exactly at the
+// cluster tolerance above them, and a non-finite point
+std::vector<data_types_lib::CartesianReturn> makeBlobs(const std::uint32_t seed)
+{
+    std::mt19937 generator{seed};
+    std::uniform_int_distribution<int> center{-160, 160};
+    std::uniform_int_distribution<int> spread{-6, 6};
+    std::uniform_int_distribution<std::size_t> blob_size{1U, 40U};
+
+    std::vector<data_types_lib::CartesianReturn> points;
+    for (std::size_t blob = 0U; blob < 60U; ++blob)
+    {
+        const int center_x = center(generator);
+        const int center_y = center(generator);
+        const int center_z = center(generator) / 16;
+        const std::size_t number_of_points = blob_size(generator);
+        for (std::size_t i = 0U; i < number_of_points; ++i)
+        {
+            points.push_back(data_types_lib::CartesianReturn{
+                COORDINATE_STEP_M * static_cast<float>(center_x + spread(generator)),
+                COORDINATE_STEP_M * static_cast<float>(center_y + spread(generator)),
+                COORDINATE_STEP_M * static_cast<float>(center_z + spread(generator)), 1.0F});
+        }
+    }
+
+    // One chain along each axis, the shortest one is smaller than the minimum cluster size
+    for (std::size_t axis = 0U; axis < 3U; ++axis)
+    {
+        for (std::size_t i = 0U; i < 4U + (3U * axis); ++i)
+        {
+            float coordinates[3U] = {4.0F * static_cast<float>(axis), 0.0F, 5.0F};
+            coordinates[axis] += CLUSTER_TOLERANCE_M * static_cast<float>(i);
+            points.push_back(data_types_lib::CartesianReturn{coordinates[0U], coordinates[1U], coordinates[2U], 1.0F});
+        }
+    }
+
+    points[3U].y = std::numeric_limits<float>::quiet_NaN();
+    return points;
+}
+
+// Connected components of the points closer than the tolerance, found by comparing every pair of points, the
+// maximum index for non-finite points
+std::vector<std::size_t> findComponents(const std::vector<data_types_lib::CartesianReturn> &points,
+                                        std::vector<std::size_t> &component_sizes)
+{
+    std::vector<std::size_t> parents(points.size());
+    std::iota(parents.begin(), parents.end(), std::size_t{0U});
+    const auto find = [&parents](std::size_t i) {
+        while (parents[i] != i)
+        {
+            i = parents[i] = parents[parents[i]];
+        }
+        return i;
+    };
+
+    const auto is_finite = [](const data_types_lib::CartesianReturn &point) {
+        return std::isfinite(point.x) && std::isfinite(point.y) && std::isfinite(point.z);
+    };
+    for (std::size_t i = 0U; i < points.size(); ++i)
+    {
+        for (std::size_t j = i + 1U; j < points.size(); ++j)
+        {
+            const float dx = points[i].x - points[j].x;
+            const float dy = points[i].y - points[j].y;
+            const float dz = points[i].z - points[j].z;
+            if (is_finite(points[i]) && is_finite(points[j]) &&
+                (((dx * dx) + (dy * dy) + (dz * dz)) <= CLUSTER_TOLERANCE_M * CLUSTER_TOLERANCE_M))
+            {
+                parents[find(i)] = find(j);
+            }
+        }
+    }
+
+    std::vector<std::size_t> components(points.size(), std::numeric_limits<std::size_t>::max());
+    component_sizes.assign(points.size(), 0U);
+    for (std::size_t i = 0U; i < points.size(); ++i)
+    {
+        if (is_finite(points[i]))
+        {
+            components[i] = find(i);
+            ++component_sizes[components[i]];
+        }
+    }
+    return components;
+}
+} // namespace
+
+// Test that clusters match the connected components found by brute force neighbour search, up to the numbering of
+// the clusters, and that components outside of the size limits are outliers
+TEST(CartesianEuclideanClustererTest, MatchesBruteForceComponents)
+{
+    clustering::CartesianEuclideanClusterer clusterer{CLUSTER_TOLERANCE_M, MIN_CLUSTER_SIZE, MAX_CLUSTER_SIZE};
+    std::vector<data_types_lib::ClusteringLabel> labels;
+
+    // Clusterer is reused across frames
+    for (const std::uint32_t seed : {42U, 7U})
+    {
+        const std::vector<data_types_lib::CartesianReturn> points = makeBlobs(seed);
+        std::vector<std::size_t> component_sizes;
+        const std::vector<std::size_t> components = findComponents(points, component_sizes);
+
+        clusterer.run(test::viewOf(points), labels);
+        ASSERT_EQ(labels.size(), points.size());
+
+        // Every kept component maps to one label and every label to one component
+        std::map<std::size_t, data_types_lib::ClusteringLabel> component_labels;
+        std::map<data_types_lib::ClusteringLabel, std::size_t> label_components;
+        for (std::size_t i = 0U; i < points.size(); ++i)
+        {
+            const bool is_kept = (components[i] < points.size()) &&
+                                 (component_sizes[components[i]] >= MIN_CLUSTER_SIZE) &&
+                                 (component_sizes[components[i]] <= MAX_CLUSTER_SIZE);
+            if (!is_kept)
+            {
+                ASSERT_EQ(labels[i], OUTLIER) << "Point " << i;
+                continue;
+            }
+
+            ASSERT_GE(labels[i], 0) << "Point " << i;
+            const auto component_label = component_labels.emplace(components[i], labels[i]).first;
+            const auto label_component = label_components.emplace(labels[i], components[i]).first;
+            ASSERT_EQ(component_label->second, labels[i]) << "Point " << i;
+            ASSERT_EQ(label_component->second, components[i]) << "Point " << i;
+        }
+
+        // Kept clusters are numbered consecutively
+        ASSERT_GT(label_components.size(), 10U);
+        EXPECT_EQ(label_components.begin()->first, 0);
+        EXPECT_EQ(static_cast<std::size_t>(label_components.rbegin()->first), label_components.size() - 1U);
+
+        // The scene has components beyond both size limits
+        std::size_t number_of_small_components = 0U;
+        std::size_t number_of_large_components = 0U;
+        for (const std::size_t component_size : component_sizes)
+        {
+            number_of_small_components += ((component_size > 0U) && (component_size < MIN_CLUSTER_SIZE)) ? 1U : 0U;
+            number_of_large_components += (component_size > MAX_CLUSTER_SIZE) ? 1U : 0U;
+        }
+        EXPECT_GT(number_of_small_components, 0U);
+        EXPECT_GT(number_of_large_components, 0U);
+    }
+}
@@ -0,0 +1,175 @@
+#include "synthetic_scan.hpp"
+
+#include <lidar_processing_lib/filtering/convex_quad_crop.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace lidar_processing_lib;
+
+namespace
+{
+// Footprint of the ego vehicle around the sensor
+constexpr std::array<filtering::QuadCorner, filtering::ConvexQuadCrop::NUMBER_OF_CORNERS> EGO_CORNERS = {
+    filtering::QuadCorner{-1.5F, -1.0F}, filtering::QuadCorner{3.0F, -1.0F}, filtering::QuadCorner{3.0F, 1.0F},
+    filtering::QuadCorner{-1.5F, 1.0F}};
+
+// Skewed quadrilateral of the reference comparison, with the far field limit
+constexpr std::array<filtering::QuadCorner, filtering::ConvexQuadCrop::NUMBER_OF_CORNERS> SKEWED_CORNERS = {
+    filtering::QuadCorner{-4.0F, -2.5F}, filtering::QuadCorner{6.5F, -6.0F}, filtering::QuadCorner{9.0F, 3.5F},
+    filtering::QuadCorner{-2.0F, 5.0F}};
+constexpr float MAX_DISTANCE_M = 20.0F;
+
+// Points within this distance of an edge or of the far field limit may be kept or removed in float precision
+constexpr double BORDER_TOLERANCE_M = 1e-3;
+
+std::vector<std::uint32_t> cropIndices(const filtering::ConvexQuadCrop &crop,
+                                       const std::vector<data_types_lib::CartesianReturn> &points)
+{
+    filtering::CropIndices kept_indices;
+    crop.run(test::viewOf(points), kept_indices);
+    return std::vector<std::uint32_t>(kept_indices.data(), kept_indices.data() + kept_indices.size());
+}
+
+// Whether the point is kept, by the sides of the point relative to the edges in double precision, false if the point
+// is not clearly inside or outside of the quadrilateral and the far field
+bool isKeptReference(const std::array<filtering::QuadCorner, filtering::ConvexQuadCrop::NUMBER_OF_CORNERS> &corners,
+                     const float x, const float y, bool &is_kept)
+{
+    bool has_positive_side = false;
+    bool has_negative_side = false;
+    for (std::size_t e = 0U; e < corners.size(); ++e)
+    {
+        const filtering::QuadCorner &first = corners[e];
+        const filtering::QuadCorner &second = corners[(e + 1U) % corners.size()];
+        const double edge_x = static_cast<double>(second.x) - first.x;
+        const double edge_y = static_cast<double>(second.y) - first.y;
+        const double distance = ((edge_x * (static_cast<double>(y) - first.y)) -
+                                 (edge_y * (static_cast<double>(x) - first.x))) /
+                                std::hypot(edge_x, edge_y);
+        if (std::fabs(distance) < BORDER_TOLERANCE_M)
+        {
+            return false;
+        }
+        has_positive_side = has_positive_side || (distance > 0.0);
+        has_negative_side = has_negative_side || (distance < 0.0);
+    }
+
+    const double horizontal_distance = std::hypot(static_cast<double>(x), static_cast<double>(y));
+    if (std::fabs(horizontal_distance - MAX_DISTANCE_M) < BORDER_TOLERANCE_M)
+    {
+        return false;
+    }
+
+    // Inside points are on the same side of every edge, whichever the winding order
+    is_kept = has_positive_side && has_negative_side && (horizontal_distance <= MAX_DISTANCE_M);
+    return true;
+}
+} // namespace
+
+// Test that the vectorized crop and its scalar tail match a point-in-quadrilateral test in double precision, for both
+// winding orders and for every point count up to a few vector widths so that every tail length is covered
+TEST(ConvexQuadCropTest, MatchesPointInQuadReference)
+{
+    std::mt19937 generator{42U};
+    std::uniform_real_distribution<float> coordinate{-25.0F, 25.0F};
+    std::vector<data_types_lib::CartesianReturn> points;
+    for (std::size_t i = 0U; i < 10'000U; ++i)
+    {
+        points.push_back(data_types_lib::CartesianReturn{coordinate(generator), coordinate(generator), 0.0F, 1.0F});
+    }
+
+    auto reversed_corners = SKEWED_CORNERS;
+    std::reverse(reversed_corners.begin(), reversed_corners.end());
+    for (const auto &corners : {SKEWED_CORNERS, reversed_corners})
+    {
+        const filtering::ConvexQuadCrop crop{corners, MAX_DISTANCE_M};
+
+        std::vector<bool> expected_kept(points.size());
+        std::vector<bool> has_reference(points.size());
+        std::size_t number_of_inside_points = 0U;
+        for (std::size_t i = 0U; i < points.size(); ++i)
+        {
+            bool is_kept = false;
+            has_reference[i] = isKeptReference(corners, points[i].x, points[i].y, is_kept);
+            expected_kept[i] = is_kept;
+            number_of_inside_points +=
+                (has_reference[i] && !is_kept && (std::hypot(points[i].x, points[i].y) < MAX_DISTANCE_M)) ? 1U : 0U;
+        }
+        EXPECT_GT(number_of_inside_points, 100U);
+
+        // Runs starting at every offset of a vector and ending at every tail length
+        const std::size_t counts[] = {0U, 1U, 3U, 4U, 5U, 7U, 8U, 9U, 15U, 16U, 17U, 33U, points.size()};
+        for (const std::size_t offset : {std::size_t{0U}, std::size_t{1U}, std::size_t{3U}})
+        {
+            for (const std::size_t count : counts)
+            {
+                const std::size_t number_of_points = std::min(count, points.size() - offset);
+                const std::vector<data_types_lib::CartesianReturn> run_points(
+                    points.begin() + static_cast<std::ptrdiff_t>(offset),
+                    points.begin() + static_cast<std::ptrdiff_t>(offset + number_of_points));
+                const std::vector<std::uint32_t> kept_indices = cropIndices(crop, run_points);
+
+                std::vector<bool> is_kept(number_of_points, false);
+                for (std::size_t k = 0U; k < kept_indices.size(); ++k)
+                {
+                    ASSERT_LT(kept_indices[k], number_of_points);
+                    ASSERT_TRUE((k == 0U) || (kept_indices[k - 1U] < kept_indices[k]));
+                    is_kept[kept_indices[k]] = true;
+                }
+                for (std::size_t i = 0U; i < number_of_points; ++i)
+                {
+                    if (has_reference[offset + i])
+                    {
+                        ASSERT_EQ(is_kept[i], expected_kept[offset + i])
+                            << filtering::convexQuadCropInstructionSet() << " point " << (offset + i);
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Test that points with an infinite or NaN coordinate are removed without a distance limit, in the vectorized blocks
+// and in the scalar tail
+TEST(ConvexQuadCropTest, RemovesNonFinitePoints)
+{
+    const filtering::ConvexQuadCrop crop{EGO_CORNERS};
+    constexpr float INF = std::numeric_limits<float>::infinity();
+    constexpr float NAN_VALUE = std::numeric_limits<float>::quiet_NaN();
+    const std::array<std::array<float, 2U>, 6U> non_finite_coordinates = {
+        std::array<float, 2U>{INF, 0.0F}, {-INF, 5.0F},      {5.0F, INF},
+        {5.0F, -INF},                     {NAN_VALUE, 5.0F}, {5.0F, NAN_VALUE}};
+
+    // A non-finite point at every position of a cloud of kept points, with a tail for every vector width
+    for (const std::size_t number_of_points : {std::size_t{1U}, std::size_t{7U}, std::size_t{16U}, std::size_t{21U}})
+    {
+        for (const auto &coordinates : non_finite_coordinates)
+        {
+            for (std::size_t position = 0U; position < number_of_points; ++position)
+            {
+                std::vector<data_types_lib::CartesianReturn> points(number_of_points,
+                                                                    data_types_lib::CartesianReturn{10.0F, 2.0F, 0.0F,
+                                                                                                    1.0F});
+                points[position].x = coordinates[0U];
+                points[position].y = coordinates[1U];
+
+                const std::vector<std::uint32_t> kept_indices = cropIndices(crop, points);
+                ASSERT_EQ(kept_indices.size(), number_of_points - 1U) << "Point " << position << " of "
+                                                                      << number_of_points;
+                for (const std::uint32_t index : kept_indices)
+                {
+                    EXPECT_NE(index, position);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,116 @@
+#include "synthetic_scan.hpp"
+
+#include <lidar_processing_lib/segmentation/depth_image.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace lidar_processing_lib;
+
+namespace
+{
+using DepthImage = segmentation::DepthImage;
+
+// Sensor not known at compile time, projected by the runtime policy
+constexpr segmentation::SensorProfile RUNTIME_PROFILE{-15.0F, 30.0F, 0.5F, 0.25F, 50'000U};
+
+// Points projected within this fraction of a pixel of a pixel border may fall into either pixel, the approximated
+// arctangent and float precision move the projection by less
+constexpr double PIXEL_BORDER_TOLERANCE = 0.02;
+
+// Pixel of the point projected by the exact azimuth and elevation in double precision, false if the point is not
+// clearly inside of a pixel or outside of the image
+bool projectReference(const segmentation::SensorProfile &profile, const data_types_lib::CartesianReturn &point,
+                      std::uint32_t &pixel_index)
+{
+    const double min_elevation_rad = profile.minElevationRad();
+    const double max_elevation_rad = profile.maxElevationRad();
+    const double azimuth_rad = std::atan2(static_cast<double>(point.y), static_cast<double>(point.x));
+    const double elevation_rad = std::atan2(static_cast<double>(point.z), std::hypot(point.x, point.y));
+    const double column = ((azimuth_rad / M_PI) * 0.5 + 0.5) * profile.width();
+    const double row = ((elevation_rad - min_elevation_rad) / (max_elevation_rad - min_elevation_rad)) *
+                       profile.height();
+
+    const auto is_near_border = [](const double coordinate) {
+        return std::fabs(coordinate - std::round(coordinate)) < PIXEL_BORDER_TOLERANCE;
+    };
+    if (is_near_border(column) || is_near_border(row))
+    {
+        return false;
+    }
+
+    const bool is_seen = (column >= 0.0) && (column < profile.width()) && (row >= 0.0) && (row < profile.height());
+    pixel_index = is_seen ? ((static_cast<std::uint32_t>(row) * profile.width()) + static_cast<std::uint32_t>(column))
+                          : DepthImage::INVALID_PIXEL;
+    return true;
+}
+
+// Points in every direction, beyond the vertical field of view as well, and out of the range limits
+std::vector<data_types_lib::CartesianReturn> makeDirections(const segmentation::SensorProfile &profile)
+{
+    std::mt19937 generator{42U};
+    std::uniform_real_distribution<double> azimuth{-M_PI, M_PI};
+    std::uniform_real_distribution<double> elevation{profile.minElevationRad() - 0.05,
+                                                     profile.maxElevationRad() + 0.05};
+    std::uniform_real_distribution<double> range{1.0, 79.0};
+
+    std::vector<data_types_lib::CartesianReturn> points;
+    for (std::size_t i = 0U; i < 20'000U; ++i)
+    {
+        const double azimuth_rad = azimuth(generator);
+        const double elevation_rad = elevation(generator);
+        const double range_m = range(generator);
+        points.push_back(data_types_lib::CartesianReturn{
+            static_cast<float>(range_m * std::cos(elevation_rad) * std::cos(azimuth_rad)),
+            static_cast<float>(range_m * std::cos(elevation_rad) * std::sin(azimuth_rad)),
+            static_cast<float>(range_m * std::sin(elevation_rad)), 1.0F});
+    }
+    points.push_back(data_types_lib::CartesianReturn{90.0F, 0.0F, 0.0F, 1.0F});
+    points.push_back(data_types_lib::CartesianReturn{std::numeric_limits<float>::quiet_NaN(), 0.0F, 0.0F, 1.0F});
+    return points;
+}
+} // namespace
+
+// Test that the lookup table projection of the sensors known at compile time and the runtime projection put every
+// point into the pixel of a double precision projection by the arctangent
+TEST(DepthImageTest, ProjectionMatchesArctangentReference)
+{
+    for (const segmentation::SensorProfile &profile :
+         {segmentation::VelodyneHdl64e::PROFILE, segmentation::VelodyneVlp32c::PROFILE,
+          segmentation::OusterOs1_128::PROFILE, RUNTIME_PROFILE})
+    {
+        const std::vector<data_types_lib::CartesianReturn> points = makeDirections(profile);
+        std::vector<std::uint32_t> expected_pixels(points.size(), DepthImage::INVALID_PIXEL);
+        std::vector<bool> has_reference(points.size(), true);
+        std::size_t number_of_seen_points = 0U;
+
+        // Points out of the range limits, the last ones, are never projected
+        for (std::size_t i = 0U; i + 2U < points.size(); ++i)
+        {
+            has_reference[i] = projectReference(profile, points[i], expected_pixels[i]);
+            number_of_seen_points +=
+                (has_reference[i] && (expected_pixels[i] != DepthImage::INVALID_PIXEL)) ? 1U : 0U;
+        }
+        EXPECT_GT(number_of_seen_points, points.size() / 2U);
+
+        DepthImage depth_image{profile, DepthImage::DEFAULT_MIN_RANGE_M, DepthImage::DEFAULT_MAX_RANGE_M,
+                               DepthImage::ProjectionMode::LOOKUP_TABLE};
+        depth_image.build(test::viewOf(points));
+        ASSERT_EQ(depth_image.pointPixels().size(), points.size());
+
+        for (std::size_t i = 0U; i < points.size(); ++i)
+        {
+            if (has_reference[i])
+            {
+                ASSERT_EQ(depth_image.pointPixels()[i], expected_pixels[i])
+                    << "Point " << i << " of a " << profile.width() << " x " << profile.height() << " image";
+            }
+        }
+    }
+}
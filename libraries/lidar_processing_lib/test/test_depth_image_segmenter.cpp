@@ -0,0 +1,147 @@
+#include "synthetic_scan.hpp"
+
+#include <lidar_processing_lib/segmentation/depth_image_segmenter.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace lidar_processing_lib;
+
+namespace
+{
+using Segmenter = segmentation::DepthImageSegmenter;
+
+constexpr std::uint32_t NUMBER_OF_RINGS = Segmenter::NUMBER_OF_RINGS_IN_RING_ELEVATION_CONJUNCTION_MAP;
+constexpr std::uint32_t NUMBER_OF_CHANNELS = Segmenter::NUMBER_OF_CHANNELS_IN_RING_ELEVATION_CONJUNCTION_MAP;
+
+// Obstacle height, ring spacing and maximum road slope of the segmenter
+constexpr float GROUND_HEIGHT_THRESHOLD_M = 0.20F;
+constexpr float RING_SPACING_M = 1.50F;
+constexpr float MAX_ROAD_SLOPE_RAD = 0.15F;
+
+struct CellPoint final
+{
+    std::uint32_t ring_index;
+    std::uint32_t channel_index;
+    data_types_lib::CartesianReturn point;
+};
+
+// Points near the centers of the cells, so that every point clearly falls into its cell. Cells are left empty, ground
+// rises and falls steeper than the road slope, and obstacles stand on it
+std::vector<CellPoint> makeCellPoints(const std::uint32_t seed)
+{
+    std::mt19937 generator{seed};
+    std::uniform_int_distribution<std::uint32_t> points_per_cell{0U, 3U};
+    std::uniform_real_distribution<float> jitter{-0.3F, 0.3F};
+    std::uniform_real_distribution<float> ground_step{-0.4F, 0.5F};
+    std::uniform_real_distribution<float> obstacle_height{0.0F, 2.0F};
+
+    constexpr auto CHANNEL_RESOLUTION_RAD = static_cast<float>((2.0 * M_PI) / NUMBER_OF_CHANNELS);
+    std::vector<CellPoint> cell_points;
+    for (std::uint32_t channel_index = 0U; channel_index < NUMBER_OF_CHANNELS; ++channel_index)
+    {
+        float ground_elevation = -test::SENSOR_HEIGHT_M;
+
+        // The last ring reaches beyond the maximum distance
+        for (std::uint32_t ring_index = 0U; ring_index + 1U < NUMBER_OF_RINGS; ++ring_index)
+        {
+            ground_elevation += ground_step(generator);
+            const std::uint32_t number_of_points = points_per_cell(generator);
+            for (std::uint32_t i = 0U; i < number_of_points; ++i)
+            {
+                const float distance = RING_SPACING_M * (static_cast<float>(ring_index) + 0.5F + jitter(generator));
+                const float azimuth_rad = CHANNEL_RESOLUTION_RAD * (static_cast<float>(channel_index) + 0.5F +
+                                                                    jitter(generator));
+                const float z = ground_elevation + ((i == 0U) ? 0.0F : obstacle_height(generator));
+                cell_points.push_back(CellPoint{ring_index, channel_index,
+                                                data_types_lib::CartesianReturn{distance * std::cos(azimuth_rad),
+                                                                                distance * std::sin(azimuth_rad), z,
+                                                                                1.0F}});
+            }
+        }
+    }
+    return cell_points;
+}
+
+// Labels of the ring elevation conjunction map, evaluated ring by ring for every channel
+std::vector<data_types_lib::SegmentationLabel> segmentReference(const std::vector<CellPoint> &cell_points)
+{
+    std::vector<std::vector<float>> elevations(NUMBER_OF_CHANNELS,
+                                               std::vector<float>(NUMBER_OF_RINGS, std::numeric_limits<float>::max()));
+    for (const CellPoint &cell_point : cell_points)
+    {
+        float &elevation = elevations[cell_point.channel_index][cell_point.ring_index];
+        elevation = std::min(elevation, cell_point.point.z);
+    }
+
+    const float max_elevation_step = RING_SPACING_M * std::tan(MAX_ROAD_SLOPE_RAD);
+    for (std::uint32_t channel_index = 0U; channel_index < NUMBER_OF_CHANNELS; ++channel_index)
+    {
+        for (std::uint32_t ring_index = 1U; ring_index < NUMBER_OF_RINGS; ++ring_index)
+        {
+            elevations[channel_index][ring_index] = std::min(elevations[channel_index][ring_index],
+                                                             elevations[channel_index][ring_index - 1U] +
+                                                                 max_elevation_step);
+        }
+    }
+
+    std::vector<data_types_lib::SegmentationLabel> labels;
+    for (const CellPoint &cell_point : cell_points)
+    {
+        const float threshold = elevations[cell_point.channel_index][cell_point.ring_index] + GROUND_HEIGHT_THRESHOLD_M;
+        labels.push_back((cell_point.point.z >= threshold) ? data_types_lib::SegmentationLabel::OBSTACLE
+                                                           : data_types_lib::SegmentationLabel::GROUND);
+    }
+    return labels;
+}
+} // namespace
+
+// Test that the slope limited ring elevation map labels the points as a scalar evaluation of the map, ring by ring for
+// every channel, and that points out of the map stay unknown
+TEST(DepthImageSegmenterTest, MatchesRingElevationReference)
+{
+    Segmenter segmenter;
+    std::vector<data_types_lib::SegmentationLabel> labels;
+
+    // Segmenter is reused across frames
+    for (const std::uint32_t seed : {42U, 7U})
+    {
+        const std::vector<CellPoint> cell_points = makeCellPoints(seed);
+        const std::vector<data_types_lib::SegmentationLabel> expected_labels = segmentReference(cell_points);
+
+        std::vector<data_types_lib::CartesianReturn> points;
+        for (const CellPoint &cell_point : cell_points)
+        {
+            points.push_back(cell_point.point);
+        }
+        points.push_back(data_types_lib::CartesianReturn{85.0F, 0.0F, -1.0F, 1.0F});
+        points.push_back(data_types_lib::CartesianReturn{0.0F, 0.0F, -1.0F, 1.0F});
+        points.push_back(data_types_lib::CartesianReturn{10.0F, 0.0F, std::numeric_limits<float>::quiet_NaN(), 1.0F});
+
+        segmenter.run(test::viewOf(points), labels);
+        ASSERT_EQ(labels.size(), points.size());
+
+        std::size_t number_of_obstacles = 0U;
+        for (std::size_t i = 0U; i < cell_points.size(); ++i)
+        {
+            ASSERT_EQ(labels[i], expected_labels[i]) << "Ring " << cell_points[i].ring_index << " channel "
+                                                     << cell_points[i].channel_index;
+            number_of_obstacles += (labels[i] == data_types_lib::SegmentationLabel::OBSTACLE) ? 1U : 0U;
+        }
+        for (std::size_t i = cell_points.size(); i < points.size(); ++i)
+        {
+            EXPECT_EQ(labels[i], data_types_lib::SegmentationLabel::UNKNOWN) << "Point " << i;
+        }
+
+        // The scene has ground and obstacles
+        EXPECT_GT(number_of_obstacles, cell_points.size() / 4U);
+        EXPECT_LT(number_of_obstacles, (3U * cell_points.size()) / 4U);
+    }
+}
@@ -0,0 +1,104 @@
+#include <lidar_processing_lib/segmentation/plane_inlier_kernel.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace lidar_processing_lib;
+
+namespace
+{
+constexpr float INLIER_THRESHOLD_M = 0.2F;
+
+// Points within this distance of the threshold may be counted on either side in float precision
+constexpr double THRESHOLD_TOLERANCE_M = 1e-3;
+
+double planeDistance(const segmentation::PlaneCoefficients &plane, const float x, const float y, const float z)
+{
+    return std::fabs((static_cast<double>(plane.a) * x) + (static_cast<double>(plane.b) * y) +
+                     (static_cast<double>(plane.c) * z) - static_cast<double>(plane.d));
+}
+} // namespace
+
+// Test that the vectorized counts and their scalar tail match a double precision count, for every number of planes
+// around a kernel pass and for every tail length
+TEST(PlaneInlierKernelTest, MatchesDoublePrecisionReference)
+{
+    // Tilted ground planes around the sensor height
+    std::mt19937 generator{42U};
+    std::uniform_real_distribution<float> tilt{-0.1F, 0.1F};
+    std::uniform_real_distribution<float> height{-1.9F, -1.5F};
+    std::vector<segmentation::PlaneCoefficients> planes;
+    for (std::size_t i = 0U; i < (2U * segmentation::PLANES_PER_KERNEL_PASS) + 1U; ++i)
+    {
+        const float a = tilt(generator);
+        const float b = tilt(generator);
+        const float c = std::sqrt(1.0F - (a * a) - (b * b));
+        planes.push_back(segmentation::PlaneCoefficients{a, b, c, height(generator)});
+    }
+
+    // Points near the ground, those too close to the threshold of any plane are drawn again
+    std::uniform_real_distribution<float> horizontal{-40.0F, 40.0F};
+    std::uniform_real_distribution<float> vertical{-2.2F, -1.2F};
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> z;
+    while (x.size() < 1'100U)
+    {
+        const float point_x = horizontal(generator);
+        const float point_y = horizontal(generator);
+        const float point_z = vertical(generator);
+        const bool is_near_threshold = std::any_of(planes.begin(), planes.end(), [&](const auto &plane) {
+            return std::fabs(planeDistance(plane, point_x, point_y, point_z) - INLIER_THRESHOLD_M) <
+                   THRESHOLD_TOLERANCE_M;
+        });
+        if (!is_near_threshold)
+        {
+            x.push_back(point_x);
+            y.push_back(point_y);
+            z.push_back(point_z);
+        }
+    }
+
+    // A non-finite point is never an inlier
+    z[5U] = std::numeric_limits<float>::quiet_NaN();
+
+    // Runs starting at every offset of a vector and ending at every tail length
+    std::vector<std::uint32_t> counts(planes.size());
+    for (std::size_t offset = 0U; offset < 4U; ++offset)
+    {
+        for (const std::size_t base : {std::size_t{0U}, std::size_t{8U}, std::size_t{16U}, std::size_t{1'000U}})
+        {
+            for (std::size_t tail = 0U; tail < 8U; ++tail)
+            {
+                const std::size_t number_of_points = base + tail;
+                for (std::size_t number_of_planes = 1U; number_of_planes <= planes.size(); ++number_of_planes)
+                {
+                    std::fill(counts.begin(), counts.end(), std::numeric_limits<std::uint32_t>::max());
+                    segmentation::countPlaneInliers(x.data() + offset, y.data() + offset, z.data() + offset,
+                                                    number_of_points, planes.data(), number_of_planes,
+                                                    INLIER_THRESHOLD_M, counts.data());
+
+                    for (std::size_t plane_index = 0U; plane_index < number_of_planes; ++plane_index)
+                    {
+                        std::uint32_t expected_count = 0U;
+                        for (std::size_t i = offset; i < offset + number_of_points; ++i)
+                        {
+                            expected_count +=
+                                (planeDistance(planes[plane_index], x[i], y[i], z[i]) < INLIER_THRESHOLD_M) ? 1U : 0U;
+                        }
+                        ASSERT_EQ(counts[plane_index], expected_count)
+                            << segmentation::planeInlierKernelInstructionSet() << " plane " << plane_index << " of "
+                            << number_of_planes << ", " << number_of_points << " points at offset " << offset;
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,114 @@
+#include <lidar_processing_lib/segmentation/polar_grid.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace lidar_processing_lib;
+
+namespace
+{
+constexpr std::uint32_t NUMBER_OF_CHANNELS = 12U;
+constexpr std::uint32_t NUMBER_OF_CELLS = 7U;
+
+struct StagedPoint final
+{
+    std::uint32_t channel_index;
+    std::uint32_t cell_index;
+    segmentation::PolarGridPoint point;
+};
+
+// Points spread over a part of the cells, so that some cells stay empty, with repeated radii within a cell
+std::vector<StagedPoint> makeStagedPoints(const std::size_t number_of_points, const std::uint32_t number_of_channels,
+                                          const std::uint32_t seed)
+{
+    std::mt19937 generator{seed};
+    std::uniform_int_distribution<std::uint32_t> channel{0U, number_of_channels - 1U};
+    std::uniform_int_distribution<std::uint32_t> cell{0U, NUMBER_OF_CELLS - 1U};
+    std::uniform_int_distribution<int> radius_step{0, 15};
+
+    std::vector<StagedPoint> staged_points;
+    for (std::uint32_t i = 0U; i < number_of_points; ++i)
+    {
+        const float radius = 0.25F * static_cast<float>(radius_step(generator));
+        const auto label = static_cast<data_types_lib::SegmentationLabel>(i % 5U);
+        staged_points.push_back(StagedPoint{channel(generator), cell(generator),
+                                            segmentation::PolarGridPoint{radius, -radius, 0.5F * radius, radius, i,
+                                                                         label}});
+    }
+    return staged_points;
+}
+
+// Checks that every cell holds exactly the points staged into it, sorted by radius
+void expectCells(const segmentation::PolarGrid &grid, const std::vector<StagedPoint> &staged_points)
+{
+    ASSERT_EQ(grid.size(), staged_points.size());
+
+    std::size_t number_of_points = 0U;
+    for (std::uint32_t channel_index = 0U; channel_index < NUMBER_OF_CHANNELS; ++channel_index)
+    {
+        for (std::uint32_t cell_index = 0U; cell_index < NUMBER_OF_CELLS; ++cell_index)
+        {
+            std::vector<std::uint32_t> expected_indices;
+            for (const StagedPoint &staged_point : staged_points)
+            {
+                if ((staged_point.channel_index == channel_index) && (staged_point.cell_index == cell_index))
+                {
+                    expected_indices.push_back(staged_point.point.index);
+                }
+            }
+
+            const auto cell = grid.cell(channel_index, cell_index);
+            std::vector<std::uint32_t> indices;
+            float previous_radius = 0.0F;
+            for (const segmentation::PolarGridPoint &point : cell)
+            {
+                ASSERT_LT(point.index, staged_points.size());
+                const segmentation::PolarGridPoint &staged_point = staged_points[point.index].point;
+                EXPECT_EQ(point.x, staged_point.x);
+                EXPECT_EQ(point.y, staged_point.y);
+                EXPECT_EQ(point.z, staged_point.z);
+                EXPECT_EQ(point.radius, staged_point.radius);
+                EXPECT_EQ(point.label, staged_point.label);
+                EXPECT_GE(point.radius, previous_radius) << "Channel " << channel_index << " cell " << cell_index;
+                previous_radius = point.radius;
+                indices.push_back(point.index);
+            }
+
+            std::sort(expected_indices.begin(), expected_indices.end());
+            std::sort(indices.begin(), indices.end());
+            EXPECT_EQ(indices, expected_indices) << "Channel " << channel_index << " cell " << cell_index;
+            number_of_points += cell.size();
+        }
+    }
+    EXPECT_EQ(number_of_points, staged_points.size());
+}
+} // namespace
+
+// Test that every staged point is embedded once into its own cell, in increasing radial order, and that the grid is
+// rebuilt from scratch after it is cleared
+TEST(PolarGridTest, BuildsSortedCells)
+{
+    segmentation::PolarGrid grid{NUMBER_OF_CHANNELS, NUMBER_OF_CELLS, 1'000U};
+
+    // Second frame leaves the last channels empty
+    for (const auto &staged_points :
+         {makeStagedPoints(1'000U, NUMBER_OF_CHANNELS, 42U), makeStagedPoints(300U, NUMBER_OF_CHANNELS / 2U, 7U)})
+    {
+        grid.clear();
+        for (const StagedPoint &staged_point : staged_points)
+        {
+            grid.stage(staged_point.channel_index, staged_point.cell_index, staged_point.point);
+        }
+        grid.build();
+        expectCells(grid, staged_points);
+    }
+
+    grid.clear();
+    grid.build();
+    expectCells(grid, {});
+}
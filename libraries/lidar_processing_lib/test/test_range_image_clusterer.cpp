@@ -0,0 +1,269 @@
+#include "synthetic_scan.hpp"
+
+#include <lidar_processing_lib/clustering/range_image_clusterer.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <vector>
+
+using namespace lidar_processing_lib;
+
+namespace
+{
+// Coarse sensor of 360 x 20 pixels, projected at runtime
+constexpr segmentation::SensorProfile PROFILE{-10.0F, 10.0F, 0.5F, 1.0F, 10'000U};
+
+constexpr float ANGLE_THRESHOLD_DEG = 10.0F;
+constexpr std::uint32_t MIN_CLUSTER_SIZE = 5U;
+constexpr std::uint32_t MAX_CLUSTER_SIZE = 100U;
+constexpr auto OUTLIER = static_cast<data_types_lib::ClusteringLabel>(data_types_lib::ReservedClusteringLabel::OUTLIER);
+
+// Range of an empty pixel of the scene
+constexpr float NO_RANGE = 0.0F;
+
+// Beam angles of the scene are at least this far from the threshold, so float precision can not change a connection
+constexpr double ANGLE_MARGIN_DEG = 1.0;
+
+struct Scene final
+{
+    // Range of each pixel in row major order, NO_RANGE when empty
+    std::vector<float> ranges;
+
+    // Pixels holding a ground point do not take part in clustering
+    std::vector<bool> is_ground;
+
+    std::vector<data_types_lib::CartesianReturn> points;
+    std::vector<std::uint32_t> rows;
+    std::vector<std::uint32_t> columns;
+    std::vector<data_types_lib::SegmentationLabel> segmentation_labels;
+};
+
+// Rectangles at ranges a factor of two apart, wrapping around the full turn, with missing returns and ground pixels.
+// Ranges grow slowly over a rectangle, so that its neighbouring pixels are connected
+Scene makeScene(const std::uint32_t seed)
+{
+    const std::uint32_t width = PROFILE.width();
+    const std::uint32_t height = PROFILE.height();
+    std::mt19937 generator{seed};
+    std::uniform_int_distribution<std::uint32_t> column{0U, width - 1U};
+    std::uniform_int_distribution<std::uint32_t> row{0U, height - 1U};
+    std::uniform_int_distribution<std::uint32_t> rectangle_width{1U, 25U};
+    std::uniform_int_distribution<std::uint32_t> rectangle_height{1U, 8U};
+    std::uniform_int_distribution<int> range_exponent{2, 6};
+    std::uniform_real_distribution<float> probability{0.0F, 1.0F};
+
+    Scene scene;
+    scene.ranges.assign(static_cast<std::size_t>(width) * height, NO_RANGE);
+    scene.is_ground.assign(scene.ranges.size(), false);
+    for (std::size_t rectangle = 0U; rectangle < 60U; ++rectangle)
+    {
+        const std::uint32_t first_column = column(generator);
+        const std::uint32_t first_row = row(generator);
+        const std::uint32_t number_of_columns = rectangle_width(generator);
+        const std::uint32_t number_of_rows = rectangle_height(generator);
+        const float range = std::ldexp(1.0F, range_exponent(generator));
+        for (std::uint32_t y = first_row; y < std::min(first_row + number_of_rows, height); ++y)
+        {
+            for (std::uint32_t i = 0U; i < number_of_columns; ++i)
+            {
+                const std::uint32_t x = (first_column + i) % width;
+                scene.ranges[(y * width) + x] = range * (1.0F + (0.001F * static_cast<float>(i + y - first_row)));
+            }
+        }
+    }
+
+    for (std::size_t pixel_index = 0U; pixel_index < scene.ranges.size(); ++pixel_index)
+    {
+        const float draw = probability(generator);
+        if (draw < 0.15F)
+        {
+            scene.ranges[pixel_index] = NO_RANGE;
+        }
+        scene.is_ground[pixel_index] = (scene.ranges[pixel_index] != NO_RANGE) && (draw > 0.95F);
+    }
+
+    // One point per filled pixel, out of the pixel order, and points which are not projected
+    std::vector<std::uint32_t> pixel_indices(scene.ranges.size());
+    std::iota(pixel_indices.begin(), pixel_indices.end(), 0U);
+    std::shuffle(pixel_indices.begin(), pixel_indices.end(), generator);
+    for (const std::uint32_t pixel_index : pixel_indices)
+    {
+        if (scene.ranges[pixel_index] != NO_RANGE)
+        {
+            scene.points.push_back(data_types_lib::CartesianReturn{scene.ranges[pixel_index], 0.0F, 0.0F, 1.0F});
+            scene.rows.push_back(pixel_index / width);
+            scene.columns.push_back(pixel_index % width);
+            scene.segmentation_labels.push_back(scene.is_ground[pixel_index]
+                                                    ? data_types_lib::SegmentationLabel::GROUND
+                                                    : data_types_lib::SegmentationLabel::OBSTACLE);
+        }
+    }
+    scene.points.push_back(data_types_lib::CartesianReturn{10.0F, 0.0F, 0.0F, 1.0F});
+    scene.rows.push_back(height);
+    scene.columns.push_back(0U);
+    scene.points.push_back(data_types_lib::CartesianReturn{std::numeric_limits<float>::quiet_NaN(), 0.0F, 0.0F, 1.0F});
+    scene.rows.push_back(0U);
+    scene.columns.push_back(0U);
+    scene.segmentation_labels.resize(scene.points.size(), data_types_lib::SegmentationLabel::OBSTACLE);
+    return scene;
+}
+
+// Components of the obstacle pixels, each pixel is compared with its nearest obstacle pixels to the left and above
+// within the pixel gap, by the angle between the beam of the farther point and the line joining both points
+std::vector<std::size_t> findComponents(const Scene &scene, std::vector<std::size_t> &component_sizes)
+{
+    const std::uint32_t width = PROFILE.width();
+    const std::uint32_t height = PROFILE.height();
+    const double horizontal_step_rad = (2.0 * M_PI) / width;
+    const double vertical_step_rad = (static_cast<double>(PROFILE.maxElevationRad()) - PROFILE.minElevationRad()) /
+                                     height;
+
+    std::vector<std::size_t> parents(scene.ranges.size());
+    std::iota(parents.begin(), parents.end(), std::size_t{0U});
+    const auto find = [&parents](std::size_t i) {
+        while (parents[i] != i)
+        {
+            i = parents[i] = parents[parents[i]];
+        }
+        return i;
+    };
+
+    const auto is_obstacle = [&scene](const std::size_t pixel_index) {
+        return (scene.ranges[pixel_index] != NO_RANGE) && !scene.is_ground[pixel_index];
+    };
+    const auto connect = [&](const std::size_t pixel_index, const std::size_t neighbour_index, const double angle_rad) {
+        const double far_range = std::max(scene.ranges[pixel_index], scene.ranges[neighbour_index]);
+        const double near_range = std::min(scene.ranges[pixel_index], scene.ranges[neighbour_index]);
+        const double beta_rad =
+            std::atan2(near_range * std::sin(angle_rad), far_range - (near_range * std::cos(angle_rad)));
+        const double beta_deg = beta_rad * (180.0 / M_PI);
+        EXPECT_GT(std::fabs(beta_deg - ANGLE_THRESHOLD_DEG), ANGLE_MARGIN_DEG);
+        if (beta_deg > ANGLE_THRESHOLD_DEG)
+        {
+            parents[find(pixel_index)] = find(neighbour_index);
+        }
+    };
+
+    for (std::uint32_t y = 0U; y < height; ++y)
+    {
+        for (std::uint32_t x = 0U; x < width; ++x)
+        {
+            const std::size_t pixel_index = (y * width) + x;
+            if (!is_obstacle(pixel_index))
+            {
+                continue;
+            }
+
+            for (std::uint32_t step = 1U; step <= clustering::RangeImageClusterer::MAX_PIXEL_GAP + 1U; ++step)
+            {
+                const std::size_t neighbour_index = (y * width) + ((x + width - step) % width);
+                if (is_obstacle(neighbour_index))
+                {
+                    connect(pixel_index, neighbour_index, step * horizontal_step_rad);
+                    break;
+                }
+            }
+
+            for (std::uint32_t step = 1U; (step <= clustering::RangeImageClusterer::MAX_PIXEL_GAP + 1U) && (step <= y);
+                 ++step)
+            {
+                const std::size_t neighbour_index = ((y - step) * width) + x;
+                if (is_obstacle(neighbour_index))
+                {
+                    connect(pixel_index, neighbour_index, step * vertical_step_rad);
+                    break;
+                }
+            }
+        }
+    }
+
+    std::vector<std::size_t> components(scene.ranges.size(), std::numeric_limits<std::size_t>::max());
+    component_sizes.assign(scene.ranges.size(), 0U);
+    for (std::size_t pixel_index = 0U; pixel_index < scene.ranges.size(); ++pixel_index)
+    {
+        if (is_obstacle(pixel_index))
+        {
+            components[pixel_index] = find(pixel_index);
+            ++component_sizes[components[pixel_index]];
+        }
+    }
+    return components;
+}
+} // namespace
+
+// Test that the clusters of the obstacle pixels match the components of a reference labelling that compares the beam
+// angles in double precision, up to the numbering of the clusters, and that components outside of the size limits and
+// points out of the image are outliers
+TEST(RangeImageClustererTest, MatchesReferenceComponents)
+{
+    const auto depth_image = std::make_shared<segmentation::DepthImage>(PROFILE);
+    clustering::RangeImageClusterer clusterer{depth_image, ANGLE_THRESHOLD_DEG, MIN_CLUSTER_SIZE, MAX_CLUSTER_SIZE};
+    std::vector<data_types_lib::ClusteringLabel> labels;
+
+    // Clusterer and image are reused across frames
+    for (const std::uint32_t seed : {42U, 7U})
+    {
+        const Scene scene = makeScene(seed);
+        std::vector<std::size_t> component_sizes;
+        const std::vector<std::size_t> components = findComponents(scene, component_sizes);
+
+        depth_image->build(test::viewOf(scene.points), scene.rows, scene.columns);
+        clusterer.clusterObstacles(scene.segmentation_labels, labels);
+
+        // Labels of the obstacle points, in the order of the cloud
+        std::map<std::size_t, data_types_lib::ClusteringLabel> component_labels;
+        std::map<data_types_lib::ClusteringLabel, std::size_t> label_components;
+        std::size_t label_index = 0U;
+        for (std::size_t i = 0U; i < scene.points.size(); ++i)
+        {
+            if (scene.segmentation_labels[i] != data_types_lib::SegmentationLabel::OBSTACLE)
+            {
+                continue;
+            }
+            ASSERT_LT(label_index, labels.size());
+            const data_types_lib::ClusteringLabel label = labels[label_index++];
+
+            const bool is_projected = (scene.rows[i] < PROFILE.height()) && std::isfinite(scene.points[i].x);
+            const std::size_t pixel_index = is_projected ? ((scene.rows[i] * PROFILE.width()) + scene.columns[i]) : 0U;
+            const bool is_kept = is_projected && (component_sizes[components[pixel_index]] >= MIN_CLUSTER_SIZE) &&
+                                 (component_sizes[components[pixel_index]] <= MAX_CLUSTER_SIZE);
+            if (!is_kept)
+            {
+                ASSERT_EQ(label, OUTLIER) << "Point " << i;
+                continue;
+            }
+
+            ASSERT_GE(label, 0) << "Point " << i;
+            const auto component_label = component_labels.emplace(components[pixel_index], label).first;
+            const auto label_component = label_components.emplace(label, components[pixel_index]).first;
+            ASSERT_EQ(component_label->second, label) << "Point " << i;
+            ASSERT_EQ(label_component->second, components[pixel_index]) << "Point " << i;
+        }
+        EXPECT_EQ(label_index, labels.size());
+
+        // Kept clusters are numbered consecutively
+        ASSERT_GT(label_components.size(), 10U);
+        EXPECT_EQ(label_components.begin()->first, 0);
+        EXPECT_EQ(static_cast<std::size_t>(label_components.rbegin()->first), label_components.size() - 1U);
+
+        // The scene has components beyond both size limits
+        std::size_t number_of_small_components = 0U;
+        std::size_t number_of_large_components = 0U;
+        for (const std::size_t component_size : component_sizes)
+        {
+            number_of_small_components += ((component_size > 0U) && (component_size < MIN_CLUSTER_SIZE)) ? 1U : 0U;
+            number_of_large_components += (component_size > MAX_CLUSTER_SIZE) ? 1U : 0U;
+        }
+        EXPECT_GT(number_of_small_components, 0U);
+        EXPECT_GT(number_of_large_components, 0U);
+    }
+}
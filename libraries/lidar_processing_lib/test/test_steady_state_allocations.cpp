@@ -0,0 +1,158 @@
+#include "synthetic_scan.hpp"
+
+#include <lidar_processing_lib/clustering/cartesian_dbscan.hpp>
+#include <lidar_processing_lib/clustering/cartesian_euclidean_clusterer.hpp>
+#include <lidar_processing_lib/filtering/point_cloud_ingest.hpp>
+#include <lidar_processing_lib/segmentation/depth_image_segmenter.hpp>
+#include <lidar_processing_lib/segmentation/ransac_segmenter.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+using namespace lidar_processing_lib;
+
+// Allocation counter hook, every allocation of the test binary goes through the replaced operator new
+namespace
+{
+std::atomic<std::size_t> heap_allocations{0U};
+
+// Frames run before counting, the buffers reach the capacity of the scan during them
+constexpr int WARM_UP_FRAMES = 2;
+constexpr int COUNTED_FRAMES = 5;
+
+// Ingested scan and the obstacle points selected from its segmentation, as in the node
+struct ScanFrames final
+{
+    std::vector<data_types_lib::CartesianReturn> points = test::makeSyntheticScan(0.4F);
+    data_types_lib::PointCloudSoA cloud;
+    data_types_lib::PointCloudSoA obstacle_cloud;
+
+    ScanFrames()
+    {
+        filtering::ingestPointCloud(test::viewOf(points), cloud);
+
+        std::vector<data_types_lib::SegmentationLabel> labels;
+        segmentation::RansacSegmenter segmenter{test::SENSOR_HEIGHT_M, 0.2F, 150U};
+        segmenter.run(cloud, labels);
+
+        std::vector<std::uint32_t> obstacle_indices;
+        for (std::size_t i = 0U; i < labels.size(); ++i)
+        {
+            if ((labels[i] == data_types_lib::SegmentationLabel::OBSTACLE) ||
+                (labels[i] == data_types_lib::SegmentationLabel::TRANSITIONAL_OBSTACLE))
+            {
+                obstacle_indices.push_back(static_cast<std::uint32_t>(i));
+            }
+        }
+        filtering::selectPoints(cloud, obstacle_indices.data(), obstacle_indices.size(), obstacle_cloud);
+    }
+};
+
+const ScanFrames &scanFrames()
+{
+    static const ScanFrames frames;
+    return frames;
+}
+
+// Heap allocations of the counted frames, after the warm-up frames
+template <typename StageT, typename CloudT, typename LabelsT>
+std::size_t countSteadyStateAllocations(StageT &stage, const CloudT &cloud, LabelsT &labels)
+{
+    for (int frame = 0; frame < WARM_UP_FRAMES; ++frame)
+    {
+        stage.run(cloud, labels);
+    }
+
+    const std::size_t allocations_before = heap_allocations.load();
+    for (int frame = 0; frame < COUNTED_FRAMES; ++frame)
+    {
+        stage.run(cloud, labels);
+    }
+    return heap_allocations.load() - allocations_before;
+}
+} // namespace
+
+void *operator new(std::size_t size)
+{
+    ++heap_allocations;
+    if (void *memory = std::malloc((size > 0U) ? size : 1U))
+    {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void *memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+// Test the warm frames of RANSAC on the calling thread, on workers and in the adaptive mode
+TEST(SteadyStateAllocationsTest, RansacSegmenter)
+{
+    const auto &frames = scanFrames();
+    ASSERT_GT(frames.obstacle_cloud.size(), 0U);
+    std::vector<data_types_lib::SegmentationLabel> labels;
+
+    segmentation::RansacSegmenter single_thread{test::SENSOR_HEIGHT_M, 0.2F, 150U, 1U};
+    EXPECT_EQ(countSteadyStateAllocations(single_thread, frames.cloud, labels), 0U);
+
+    segmentation::RansacSegmenter workers{test::SENSOR_HEIGHT_M, 0.2F, 150U, 4U};
+    EXPECT_EQ(countSteadyStateAllocations(workers, frames.cloud, labels), 0U);
+
+    segmentation::RansacAdaptiveConfiguration adaptive_configuration;
+    adaptive_configuration.enabled = true;
+    segmentation::RansacSegmenter adaptive{test::SENSOR_HEIGHT_M, 0.2F, 150U, 4U, adaptive_configuration, 4U};
+    EXPECT_EQ(countSteadyStateAllocations(adaptive, frames.cloud, labels), 0U);
+}
+
+// Test the warm frames of the depth image segmentation, with and without the temporal ground model
+TEST(SteadyStateAllocationsTest, DepthImageSegmenter)
+{
+    const auto &frames = scanFrames();
+    std::vector<data_types_lib::SegmentationLabel> labels;
+
+    segmentation::DepthImageSegmenter segmenter;
+    EXPECT_EQ(countSteadyStateAllocations(segmenter, frames.cloud, labels), 0U);
+
+    segmentation::TemporalGroundConfiguration temporal_configuration;
+    temporal_configuration.enabled = true;
+    segmentation::DepthImageSegmenter temporal_segmenter{segmentation::DepthImageSegmenter::MIN_DISTANCE_M,
+                                                         segmentation::DepthImageSegmenter::MAX_DISTANCE_M,
+                                                         segmentation::VelodyneHdl64e::PROFILE,
+                                                         temporal_configuration};
+    EXPECT_EQ(countSteadyStateAllocations(temporal_segmenter, frames.cloud, labels), 0U);
+}
+
+// Test the warm frames of the Euclidean clustering of the obstacle points
+TEST(SteadyStateAllocationsTest, CartesianEuclideanClusterer)
+{
+    const auto &frames = scanFrames();
+    std::vector<data_types_lib::ClusteringLabel> labels;
+
+    clustering::CartesianEuclideanClusterer clusterer{0.5F, 5U, 25000U};
+    EXPECT_EQ(countSteadyStateAllocations(clusterer, frames.obstacle_cloud, labels), 0U);
+}
+
+// Test the warm frames of DBSCAN on the calling thread and on workers
+TEST(SteadyStateAllocationsTest, CartesianDBSCAN)
+{
+    const auto &frames = scanFrames();
+    std::vector<data_types_lib::ClusteringLabel> labels;
+
+    clustering::CartesianDBSCAN single_thread{0.5F, 5U, 1U};
+    EXPECT_EQ(countSteadyStateAllocations(single_thread, frames.obstacle_cloud, labels), 0U);
+
+    clustering::CartesianDBSCAN workers{0.5F, 5U, 4U};
+    EXPECT_EQ(countSteadyStateAllocations(workers, frames.obstacle_cloud, labels), 0U);
+}
@@ -0,0 +1,231 @@
+#include "synthetic_scan.hpp"
+
+#include <lidar_processing_lib/segmentation/depth_image_segmenter.hpp>
+#include <lidar_processing_lib/segmentation/ransac_segmenter.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <eigen3/Eigen/Geometry>
+#include <vector>
+
+using namespace lidar_processing_lib;
+
+namespace
+{
+using SegmentationLabel = data_types_lib::SegmentationLabel;
+
+constexpr float AZIMUTH_STEP_DEG = 0.4F;
+constexpr float DEG_TO_RAD = static_cast<float>(M_PI / 180.0);
+
+// Points of the previous frame seen from the sensor after it moved by the ego-motion
+std::vector<data_types_lib::CartesianReturn> movePoints(const std::vector<data_types_lib::CartesianReturn> &points,
+                                                        const Eigen::Isometry3f &previous_to_current)
+{
+    std::vector<data_types_lib::CartesianReturn> moved_points = points;
+    for (auto &point : moved_points)
+    {
+        const Eigen::Vector3f moved = previous_to_current * Eigen::Vector3f{point.x, point.y, point.z};
+        point.x = moved.x();
+        point.y = moved.y();
+        point.z = moved.z();
+    }
+    return moved_points;
+}
+
+std::size_t countLabels(const std::vector<SegmentationLabel> &labels, const SegmentationLabel label)
+{
+    return static_cast<std::size_t>(std::count(labels.begin(), labels.end(), label));
+}
+
+// Every cell of the scan is in the ground model after the first frame
+segmentation::TemporalGroundConfiguration temporalConfiguration()
+{
+    segmentation::TemporalGroundConfiguration configuration;
+    configuration.enabled = true;
+    return configuration;
+}
+
+segmentation::RansacSegmenter makeRansacSegmenter(
+    const segmentation::TemporalGroundConfiguration &configuration = temporalConfiguration())
+{
+    return segmentation::RansacSegmenter{
+        test::SENSOR_HEIGHT_M, 0.2F, 150U, 1U, segmentation::RansacAdaptiveConfiguration{}, 1U, configuration};
+}
+
+// Sensor 0.5 m lower and pitched by 2 degrees, the ground is neither at the previous height nor level
+Eigen::Isometry3f tiltedEgoMotion()
+{
+    Eigen::Isometry3f ego_motion = Eigen::Isometry3f::Identity();
+    ego_motion.rotate(Eigen::AngleAxisf{2.0F * DEG_TO_RAD, Eigen::Vector3f::UnitY()});
+    ego_motion.pretranslate(Eigen::Vector3f{0.0F, 0.0F, 0.5F});
+    return ego_motion;
+}
+} // namespace
+
+// Test that the first frame estimates every cell and the repeated frame validates all of them
+TEST(DepthImageSegmenterTemporalTest, RepeatedFrameValidatesCells)
+{
+    const auto points = test::makeSyntheticScan(AZIMUTH_STEP_DEG);
+    segmentation::DepthImageSegmenter segmenter{segmentation::DepthImageSegmenter::MIN_DISTANCE_M,
+                                                segmentation::DepthImageSegmenter::MAX_DISTANCE_M,
+                                                segmentation::VelodyneHdl64e::PROFILE, temporalConfiguration()};
+    std::vector<SegmentationLabel> labels;
+
+    segmenter.run(test::viewOf(points), labels);
+    const segmentation::TemporalGroundStatistics first_frame = segmenter.temporalStatistics();
+    EXPECT_GT(first_frame.recomputed_cells, 0U);
+    EXPECT_EQ(first_frame.validated_cells, 0U);
+    EXPECT_EQ(first_frame.carried_cells, 0U);
+    const std::vector<SegmentationLabel> first_labels = labels;
+
+    segmenter.run(test::viewOf(points), labels);
+    const segmentation::TemporalGroundStatistics second_frame = segmenter.temporalStatistics();
+    EXPECT_EQ(second_frame.validated_cells, first_frame.recomputed_cells);
+    EXPECT_EQ(second_frame.recomputed_cells, 0U);
+    EXPECT_EQ(second_frame.carried_cells, 0U);
+    EXPECT_EQ(labels, first_labels);
+}
+
+// Test that cells without returns keep their ground for max_cell_age frames and then leave the model
+TEST(DepthImageSegmenterTemporalTest, UnobservedCellsAreCarriedUntilTheirMaxAge)
+{
+    const auto points = test::makeSyntheticScan(AZIMUTH_STEP_DEG);
+    const std::vector<data_types_lib::CartesianReturn> no_points;
+    const segmentation::TemporalGroundConfiguration configuration = temporalConfiguration();
+    segmentation::DepthImageSegmenter segmenter{segmentation::DepthImageSegmenter::MIN_DISTANCE_M,
+                                                segmentation::DepthImageSegmenter::MAX_DISTANCE_M,
+                                                segmentation::VelodyneHdl64e::PROFILE, configuration};
+    std::vector<SegmentationLabel> labels;
+
+    segmenter.run(test::viewOf(points), labels);
+    const std::uint32_t modelled_cells = segmenter.temporalStatistics().recomputed_cells;
+
+    for (std::uint32_t frame = 0U; frame < configuration.max_cell_age; ++frame)
+    {
+        segmenter.run(test::viewOf(no_points), labels);
+        EXPECT_EQ(segmenter.temporalStatistics().carried_cells, modelled_cells);
+        EXPECT_EQ(segmenter.temporalStatistics().validated_cells, 0U);
+        EXPECT_EQ(segmenter.temporalStatistics().recomputed_cells, 0U);
+    }
+
+    segmenter.run(test::viewOf(no_points), labels);
+    EXPECT_EQ(segmenter.temporalStatistics().carried_cells, 0U);
+
+    // Cells that left the model are estimated from the frame alone
+    segmenter.run(test::viewOf(points), labels);
+    EXPECT_EQ(segmenter.temporalStatistics().recomputed_cells, modelled_cells);
+    EXPECT_EQ(segmenter.temporalStatistics().validated_cells, 0U);
+}
+
+// Test that ground above the model is carried (e.g. covered by an obstacle) and ground below it is recomputed
+TEST(DepthImageSegmenterTemporalTest, ContradictedCellsAreCarriedOrRecomputed)
+{
+    const auto points = test::makeSyntheticScan(AZIMUTH_STEP_DEG);
+    const auto raised_points = movePoints(points, Eigen::Isometry3f{Eigen::Translation3f{0.0F, 0.0F, 0.5F}});
+    const auto lowered_points = movePoints(points, Eigen::Isometry3f{Eigen::Translation3f{0.0F, 0.0F, -0.5F}});
+    segmentation::DepthImageSegmenter segmenter{segmentation::DepthImageSegmenter::MIN_DISTANCE_M,
+                                                segmentation::DepthImageSegmenter::MAX_DISTANCE_M,
+                                                segmentation::VelodyneHdl64e::PROFILE, temporalConfiguration()};
+    std::vector<SegmentationLabel> labels;
+
+    segmenter.run(test::viewOf(points), labels);
+    const std::uint32_t modelled_cells = segmenter.temporalStatistics().recomputed_cells;
+
+    // Raised ground is above the carried elevation by more than the obstacle threshold
+    segmenter.run(test::viewOf(raised_points), labels);
+    EXPECT_EQ(segmenter.temporalStatistics().carried_cells, modelled_cells);
+    EXPECT_EQ(segmenter.temporalStatistics().validated_cells, 0U);
+    EXPECT_EQ(segmenter.temporalStatistics().recomputed_cells, 0U);
+    EXPECT_EQ(countLabels(labels, SegmentationLabel::GROUND), 0U);
+
+    segmenter.run(test::viewOf(lowered_points), labels);
+    EXPECT_EQ(segmenter.temporalStatistics().recomputed_cells, modelled_cells);
+    EXPECT_EQ(segmenter.temporalStatistics().validated_cells, 0U);
+    EXPECT_EQ(segmenter.temporalStatistics().carried_cells, 0U);
+}
+
+// Test that the ground model moved by the ego-motion is validated by the frame seen from the moved sensor
+TEST(DepthImageSegmenterTemporalTest, EgoMotionMovesTheGroundModel)
+{
+    // Yaw of one channel of the elevation map moves every cell center onto the center of its neighbour
+    Eigen::Isometry3f ego_motion = Eigen::Isometry3f::Identity();
+    ego_motion.rotate(Eigen::AngleAxisf{15.0F * DEG_TO_RAD, Eigen::Vector3f::UnitZ()});
+    ego_motion.pretranslate(Eigen::Vector3f{0.0F, 0.0F, 0.5F});
+
+    const auto points = test::makeSyntheticScan(AZIMUTH_STEP_DEG);
+    const auto moved_points = movePoints(points, ego_motion);
+    segmentation::DepthImageSegmenter segmenter{segmentation::DepthImageSegmenter::MIN_DISTANCE_M,
+                                                segmentation::DepthImageSegmenter::MAX_DISTANCE_M,
+                                                segmentation::VelodyneHdl64e::PROFILE, temporalConfiguration()};
+    std::vector<SegmentationLabel> labels;
+
+    segmenter.run(test::viewOf(points), labels);
+    const std::uint32_t modelled_cells = segmenter.temporalStatistics().recomputed_cells;
+    const std::size_t ground_points = countLabels(labels, SegmentationLabel::GROUND);
+
+    segmenter.setEgoMotion(ego_motion);
+    segmenter.run(test::viewOf(moved_points), labels);
+    EXPECT_EQ(segmenter.temporalStatistics().validated_cells, modelled_cells);
+    EXPECT_EQ(segmenter.temporalStatistics().recomputed_cells, 0U);
+    EXPECT_EQ(segmenter.temporalStatistics().carried_cells, 0U);
+
+    // Rays every 30 degrees are rotated onto a channel boundary, rounding may move their points to the next cell
+    const auto boundary_points = static_cast<double>(12U * test::NUMBER_OF_RINGS);
+    EXPECT_NEAR(static_cast<double>(countLabels(labels, SegmentationLabel::GROUND)),
+                static_cast<double>(ground_points), boundary_points);
+}
+
+// Test that the plane of the previous frame is reused for a repeated frame and refitted after max_plane_age frames
+TEST(RansacSegmenterTemporalTest, PlaneIsReusedUntilItsMaxAge)
+{
+    const auto points = test::makeSyntheticScan(AZIMUTH_STEP_DEG);
+    const segmentation::TemporalGroundConfiguration configuration = temporalConfiguration();
+    segmentation::RansacSegmenter segmenter = makeRansacSegmenter(configuration);
+    std::vector<SegmentationLabel> labels;
+
+    segmenter.run(test::viewOf(points), labels);
+    EXPECT_FALSE(segmenter.temporalStatistics().plane_reused);
+    const std::vector<SegmentationLabel> first_labels = labels;
+
+    for (std::uint32_t frame = 0U; frame < configuration.max_plane_age; ++frame)
+    {
+        segmenter.run(test::viewOf(points), labels);
+        EXPECT_TRUE(segmenter.temporalStatistics().plane_reused);
+        EXPECT_EQ(labels, first_labels);
+    }
+
+    segmenter.run(test::viewOf(points), labels);
+    EXPECT_FALSE(segmenter.temporalStatistics().plane_reused);
+}
+
+// Test that the previous plane is rejected when the sensor moved and the motion is not compensated
+TEST(RansacSegmenterTemporalTest, UncompensatedEgoMotionRejectsThePlane)
+{
+    const auto points = test::makeSyntheticScan(AZIMUTH_STEP_DEG);
+    const auto moved_points = movePoints(points, tiltedEgoMotion());
+    segmentation::RansacSegmenter segmenter = makeRansacSegmenter();
+    std::vector<SegmentationLabel> labels;
+
+    segmenter.run(test::viewOf(points), labels);
+    segmenter.run(test::viewOf(moved_points), labels);
+    EXPECT_FALSE(segmenter.temporalStatistics().plane_reused);
+}
+
+// Test that the plane moved by the ego-motion is reused and finds the ground points of the previous frame
+TEST(RansacSegmenterTemporalTest, CompensatedEgoMotionReusesThePlane)
+{
+    const auto points = test::makeSyntheticScan(AZIMUTH_STEP_DEG);
+    const auto moved_points = movePoints(points, tiltedEgoMotion());
+    segmentation::RansacSegmenter segmenter = makeRansacSegmenter();
+    std::vector<SegmentationLabel> labels;
+
+    segmenter.run(test::viewOf(points), labels);
+    const std::size_t ground_points = countLabels(labels, SegmentationLabel::GROUND);
+    segmenter.setEgoMotion(tiltedEgoMotion());
+    segmenter.run(test::viewOf(moved_points), labels);
+    EXPECT_TRUE(segmenter.temporalStatistics().plane_reused);
+    EXPECT_EQ(countLabels(labels, SegmentationLabel::GROUND), ground_points);
+}
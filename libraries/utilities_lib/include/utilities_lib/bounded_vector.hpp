@@ -4,16 +4,19 @@
 #include <cstddef>     // std::ptrdiff_t
 #include <cstdint>     // std::size_t
 #include <iterator>    // std::random_access_iterator
-#include <memory>      // std::allocator
+#include <memory>      // std::allocator, std::allocator_traits
 #include <stdexcept>   // std::runtime_error, std::out_of_range
 #include <type_traits> // std::is_same_v
 #include <utility>     // std::forward, std::move, std::swap
 
 namespace utilities_lib
 {
-template <typename T, std::size_t MaxSize> class BoundedVector final
+/// @brief Vector of a fixed capacity, MAX_SIZE elements are allocated once at construction. The Allocator may be
+/// stateful (e.g. TLSFAllocator of a preallocated heap), it is copied along with the container.
+template <typename T, std::size_t MaxSize, typename Allocator = std::allocator<T>> class BoundedVector final
 {
     static_assert(MaxSize > 0U, "BoundedVector cannot have 0 max size.");
+    static_assert(std::is_same_v<typename Allocator::value_type, T>, "<Allocator> must allocate <T>.");
 
   public:
     static constexpr std::size_t MAX_SIZE = MaxSize;
@@ -22,6 +25,7 @@ template <typename T, std::size_t MaxSize> class BoundedVector final
     using value_type = T;
     using pointer = T *;
     using reference = T &;
+    using allocator_type = Allocator;
 
     /// @brief Swap function.
     friend void swap(BoundedVector &first, BoundedVector &second) noexcept
@@ -29,16 +33,24 @@ template <typename T, std::size_t MaxSize> class BoundedVector final
         using std::swap;
         swap(first.size_, second.size_);
         swap(first.data_, second.data_);
+        swap(first.allocator_, second.allocator_);
     }
 
     /// @brief Default constructor.
     /// Preallocates MAX_SIZE memory for the container.
-    BoundedVector() : size_{0U}, data_{allocator_.allocate(MAX_SIZE)}
+    BoundedVector() : size_{0U}, allocator_{}, data_{allocator_.allocate(MAX_SIZE)}
+    {
+    }
+
+    /// @brief Constructor, preallocates MAX_SIZE memory from the allocator.
+    explicit BoundedVector(const Allocator &allocator)
+        : size_{0U}, allocator_{allocator}, data_{allocator_.allocate(MAX_SIZE)}
     {
     }
 
     /// @brief Constructs container and resizes to MAX_SIZE
-    BoundedVector(const size_type size) : size_{size}, data_{allocator_.allocate(MAX_SIZE)}
+    BoundedVector(const size_type size, const Allocator &allocator = Allocator())
+        : size_{size}, allocator_{allocator}, data_{allocator_.allocate(MAX_SIZE)}
     {
         // Check the size
         if (size_ > MAX_SIZE)
@@ -49,17 +61,19 @@ template <typename T, std::size_t MaxSize> class BoundedVector final
         // Default construct elements
         for (size_type i = 0U; i < size_; ++i)
         {
-            allocator_.construct(data_ + i, T{});
+            AllocatorTraits::construct(allocator_, data_ + i, T{});
         }
     }
 
     /// @brief Copy constructor.
-    BoundedVector(const BoundedVector &other) : size_{other.size_}, data_{allocator_.allocate(MAX_SIZE)}
+    BoundedVector(const BoundedVector &other)
+        : size_{other.size_}, allocator_{AllocatorTraits::select_on_container_copy_construction(other.allocator_)},
+          data_{allocator_.allocate(MAX_SIZE)}
     {
         // Copy only the required contents
         for (size_type i = 0U; i < other.size_; ++i)
         {
-            allocator_.construct(data_ + i, other.data_[i]);
+            AllocatorTraits::construct(allocator_, data_ + i, other.data_[i]);
         }
     }
 
@@ -76,7 +90,7 @@ template <typename T, std::size_t MaxSize> class BoundedVector final
 
     /// @brief Move constructor.
     BoundedVector(BoundedVector &&other) noexcept
-        : size_{other.size_}, data_{other.data_}, allocator_{std::move(other.allocator_)}
+        : size_{other.size_}, allocator_{std::move(other.allocator_)}, data_{other.data_}
     {
         other.size_ = 0U;
         other.data_ = nullptr;
@@ -649,7 +663,7 @@ template <typename T, std::size_t MaxSize> class BoundedVector final
             throw std::runtime_error("Exceeded capacity");
         }
 
-        allocator_.construct(data_ + size_, std::forward<U>(value));
+        AllocatorTraits::construct(allocator_, data_ + size_, std::forward<U>(value));
         ++size_;
     }
 
@@ -664,7 +678,7 @@ template <typename T, std::size_t MaxSize> class BoundedVector final
             throw std::runtime_error("Capacity exceeded.");
         }
 
-        allocator_.construct(data_ + size_, std::forward<Args>(args)...);
+        AllocatorTraits::construct(allocator_, data_ + size_, std::forward<Args>(args)...);
         ++size_;
     }
 
@@ -678,7 +692,7 @@ template <typename T, std::size_t MaxSize> class BoundedVector final
         }
 
         --size_;
-        allocator_.destroy(data_ + size_); // Destroy object
+        AllocatorTraits::destroy(allocator_, data_ + size_); // Destroy object
     }
 
     /// @brief Does not modify the underlying storage.
@@ -688,7 +702,7 @@ template <typename T, std::size_t MaxSize> class BoundedVector final
         while (size_ > 0U)
         {
             --size_;
-            allocator_.destroy(data_ + size_); // Destroy object
+            AllocatorTraits::destroy(allocator_, data_ + size_); // Destroy object
         }
     }
 
@@ -734,9 +748,17 @@ template <typename T, std::size_t MaxSize> class BoundedVector final
         return data_;
     }
 
+    /// @brief Returns the allocator of the container.
+    inline allocator_type get_allocator() const noexcept
+    {
+        return allocator_;
+    }
+
   private:
+    using AllocatorTraits = std::allocator_traits<Allocator>;
+
     size_type size_;
-    std::allocator<T> allocator_;
+    Allocator allocator_;
     T *data_; // Raw pointer to the allocated memory
 };
 
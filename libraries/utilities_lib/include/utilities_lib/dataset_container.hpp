@@ -0,0 +1,182 @@
+#ifndef UTILITIES__DATASET_CONTAINER_HPP
+#define UTILITIES__DATASET_CONTAINER_HPP
+
+#include <utilities_lib/file_operations.hpp> // MappedFile
+
+#include <cstddef>    // std::size_t, std::byte
+#include <cstdint>    // std::int64_t, std::uint32_t, std::uint64_t
+#include <filesystem> // std::filesystem
+#include <fstream>    // std::ofstream
+#include <string>     // std::string
+#include <vector>     // std::vector
+
+namespace utilities_lib
+{
+// Layout of the container, in host byte order:
+// - Header page with the stream table
+// - Payloads, each starting on a page boundary so that mapped payloads are aligned for any point type
+// - Per-stream index of entries sorted by timestamp, page aligned
+inline constexpr std::size_t DATASET_PAGE_SIZE = 4096U;
+inline constexpr std::uint32_t DATASET_VERSION = 1U;
+inline constexpr std::size_t DATASET_MAX_STREAMS = 16U;
+inline constexpr std::size_t DATASET_STREAM_NAME_SIZE = 32U;
+
+/// @brief Type of the payloads of a stream.
+enum class DatasetPayload : std::uint32_t
+{
+    // Points in the layout of data_types_lib::CartesianReturn, width is the number of points
+    POINT_CLOUD = 0U,
+
+    // Decoded 8-bit BGR pixels, rows without padding
+    IMAGE_BGR8 = 1U
+};
+
+/// @brief Index entry of a payload. The payload is LZ4-compressed when it is stored in fewer bytes than its size.
+struct DatasetEntry final
+{
+    std::int64_t timestamp;
+    std::uint64_t offset;
+    std::uint64_t stored_size;
+    std::uint64_t size;
+    std::uint32_t width;
+    std::uint32_t height;
+};
+
+/// @brief Stream table entry of the header.
+struct DatasetStream final
+{
+    char name[DATASET_STREAM_NAME_SIZE];
+    DatasetPayload payload;
+    std::uint32_t reserved;
+    std::uint64_t entry_count;
+    std::uint64_t index_offset;
+};
+
+/// @brief Header of the container, the magic is written last so that unfinished files are rejected.
+struct DatasetHeader final
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t stream_count;
+    DatasetStream streams[DATASET_MAX_STREAMS];
+};
+
+static_assert(sizeof(DatasetHeader) <= DATASET_PAGE_SIZE, "Header must fit into the header page");
+
+/// @brief Writes a packed dataset, payloads are appended one at a time and the indexes are written by finish.
+class DatasetWriter final
+{
+  public:
+    /// @brief Deleted default constructor.
+    DatasetWriter() = delete;
+
+    /// @brief Non-default constructor.
+    /// @param compress - Stores payloads LZ4-compressed where that makes them smaller.
+    /// @throws std::runtime_error if the file can not be created or compression is not supported by the build.
+    DatasetWriter(const std::filesystem::path &file_path, bool compress);
+
+    // Copy and move operations are not allowed.
+    DatasetWriter(const DatasetWriter &) = delete;
+    DatasetWriter(DatasetWriter &&) = delete;
+    DatasetWriter &operator=(const DatasetWriter &) = delete;
+    DatasetWriter &operator=(DatasetWriter &&) = delete;
+
+    /// @brief Checks if the library was built with LZ4.
+    static bool compressionSupported() noexcept;
+
+    /// @brief Adds a stream.
+    /// @return Index of the stream.
+    /// @throws std::runtime_error if the name is too long or the stream table is full.
+    std::size_t addStream(const std::string &name, DatasetPayload payload);
+
+    /// @brief Appends a payload to a stream, payloads of a stream must be added in timestamp order.
+    /// @throws std::runtime_error if the stream does not exist or the file can not be written.
+    void addEntry(std::size_t stream_index, std::int64_t timestamp, const void *payload, std::size_t size,
+                  std::uint32_t width, std::uint32_t height);
+
+    /// @brief Writes the indexes and the header, no entries can be added afterwards.
+    void finish();
+
+  private:
+    std::ofstream file_;
+    bool compress_;
+    bool finished_;
+    std::uint64_t offset_;
+    std::vector<DatasetStream> streams_;
+    std::vector<std::vector<DatasetEntry>> entries_;
+    std::vector<char> compressed_payload_;
+
+    /// @brief Writes the bytes at the current offset and pads the file to the next page boundary.
+    void writePageAligned(const void *data, std::size_t size);
+};
+
+/// @brief Reads a packed dataset through a memory mapping. Entries are looked up in constant time by index, payloads
+/// are read straight from the mapping.
+class DatasetReader final
+{
+  public:
+    /// @brief Deleted default constructor.
+    DatasetReader() = delete;
+
+    /// @brief Non-default constructor, maps the file and validates the header and the indexes.
+    /// @throws std::runtime_error if the file is not a complete dataset of this version.
+    explicit DatasetReader(const std::filesystem::path &file_path);
+
+    // Copy and move operations are not allowed.
+    DatasetReader(const DatasetReader &) = delete;
+    DatasetReader(DatasetReader &&) = delete;
+    DatasetReader &operator=(const DatasetReader &) = delete;
+    DatasetReader &operator=(DatasetReader &&) = delete;
+
+    /// @brief Get the number of streams.
+    inline std::size_t streamCount() const noexcept
+    {
+        return header_->stream_count;
+    }
+
+    /// @brief Get the stream table entry of a stream.
+    inline const DatasetStream &stream(const std::size_t stream_index) const noexcept
+    {
+        return header_->streams[stream_index];
+    }
+
+    /// @brief Finds a stream by name.
+    /// @throws std::runtime_error if there is no stream of that name.
+    std::size_t findStream(const std::string &name) const;
+
+    /// @brief Get the number of entries of a stream.
+    inline std::size_t entryCount(const std::size_t stream_index) const noexcept
+    {
+        return header_->streams[stream_index].entry_count;
+    }
+
+    /// @brief Get an entry of a stream.
+    inline const DatasetEntry &entry(const std::size_t stream_index, const std::size_t entry_index) const noexcept
+    {
+        return indexes_[stream_index][entry_index];
+    }
+
+    /// @brief Finds the first entry of a stream at or after the timestamp, entryCount if there is none.
+    std::size_t seek(std::size_t stream_index, std::int64_t timestamp) const;
+
+    /// @brief Checks that the payload of an entry is inside of the file and that its size can be decompressed from it,
+    /// so that a destination can be sized by entry.size.
+    /// @throws std::runtime_error if the payload is outside of the file or its size is corrupt.
+    void validatePayload(const DatasetEntry &entry) const;
+
+    /// @brief Copies the payload of an entry, decompressing it if needed, destination must hold entry.size bytes.
+    /// @throws std::runtime_error if the payload is not valid or can not be decompressed.
+    void readPayload(const DatasetEntry &entry, void *destination) const;
+
+    /// @brief Advises the kernel that the payload of an entry is read soon (e.g. the next entry of a replayed stream),
+    /// its pages are read ahead in the background.
+    void prefetchPayload(const DatasetEntry &entry) const noexcept;
+
+  private:
+    MappedFile file_;
+    const DatasetHeader *header_;
+    std::vector<const DatasetEntry *> indexes_;
+};
+} // namespace utilities_lib
+
+#endif // UTILITIES__DATASET_CONTAINER_HPP
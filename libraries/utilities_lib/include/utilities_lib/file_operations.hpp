@@ -2,18 +2,93 @@
 
 #include <data_types_lib/cartesian_return.hpp> // CartesianReturn
 
-#include <cstdint>    // std::int64_t
+#include <cstddef>    // std::size_t, std::byte
+#include <cstdint>    // std::int64_t, std::uint8_t
 #include <filesystem> // std::filesystem
 #include <string>     // std::string
 #include <vector>     // std::vector
 
 namespace utilities_lib
 {
+// Access pattern the kernel is advised of for a mapping
+enum class MappedFileAccess : std::uint8_t
+{
+    // Read front to back once, read-ahead is increased and the pages are dropped early
+    SEQUENTIAL,
+
+    // Read at indexed offsets (e.g. the entries of a packed dataset), read-ahead is disabled. Ranges about to be read
+    // are announced by willNeed
+    RANDOM,
+
+    // Whole file is read soon, it is read ahead in the background
+    WILL_NEED
+};
+
+/// @brief Read-only memory mapping of a file. Pages are read from the page cache on first access instead of being
+/// copied into a buffer, the mapping is released by close or on destruction.
+class MappedFile final
+{
+  public:
+    /// @brief Default constructor creates an empty mapping
+    MappedFile() noexcept = default;
+
+    /// @brief Destructor - releases the mapping
+    ~MappedFile() noexcept;
+
+    /// @brief Move constructor, the other mapping is left empty
+    MappedFile(MappedFile &&other) noexcept;
+
+    /// @brief Move assignment operator, the other mapping is left empty
+    MappedFile &operator=(MappedFile &&other) noexcept;
+
+    // Copy operations are not allowed.
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    /// @brief Maps the file, a previous mapping is released first.
+    /// @param access - Access pattern the kernel is advised of.
+    /// @return False if the file could not be mapped, the mapping is left empty.
+    bool open(const std::filesystem::path &file_path, MappedFileAccess access = MappedFileAccess::SEQUENTIAL);
+
+    /// @brief Advises the kernel that a range of the mapping is read soon, its pages are read ahead in the background.
+    /// The range is clamped to the mapping.
+    void willNeed(std::size_t offset, std::size_t size) const noexcept;
+
+    /// @brief Releases the mapping
+    void close() noexcept;
+
+    /// @brief Get the mapped bytes, nullptr if empty
+    inline const std::byte *data() const noexcept
+    {
+        return data_;
+    }
+
+    /// @brief Get the size of the mapping in bytes
+    inline std::size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    /// @brief Checks if nothing is mapped
+    inline bool empty() const noexcept
+    {
+        return (size_ == 0U);
+    }
+
+  private:
+    const std::byte *data_ = nullptr;
+    std::size_t size_ = 0U;
+};
+
 void readFileNamesWithExtensionFromDirectory(const std::filesystem::path &data_path, const std::string &file_extension,
                                              std::vector<std::filesystem::path> &file_paths);
 
 void loadPointCloudDataFromBinFile(const std::filesystem::path &file_path,
                                    std::vector<data_types_lib::CartesianReturn> &point_cloud);
 
+/// @brief Maps a point cloud .bin file instead of reading it into a buffer, the points of the mapping are
+/// data_types_lib::CartesianReturn. The mapping is left empty if the file could not be mapped.
+void mapPointCloudDataFromBinFile(const std::filesystem::path &file_path, MappedFile &point_cloud);
+
 void readTimestampsFromTxtFile(const std::filesystem::path &file_path, std::vector<std::int64_t> &timestamps);
 } // namespace utilities_lib
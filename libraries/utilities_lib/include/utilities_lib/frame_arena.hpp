@@ -0,0 +1,92 @@
+#ifndef UTILITIES__FRAME_ARENA_HPP
+#define UTILITIES__FRAME_ARENA_HPP
+
+#include <cstddef>         // std::size_t, std::byte
+#include <memory_resource> // std::pmr::memory_resource
+#include <vector>          // std::vector
+
+namespace utilities_lib
+{
+/// @brief Monotonic arena of the temporary buffers of a frame. Allocations bump a pointer through one preallocated
+/// region and deallocations are no-ops, the whole frame is released at once by reset. Allocations that do not fit are
+/// served by the upstream resource, and the next reset grows the region to the peak of that frame, so the region
+/// settles at the largest frame and the steady state does not touch the heap.
+///
+/// Containers take the arena as their std::pmr::memory_resource (e.g. std::pmr::vector<float>{&arena}). Buffers
+/// allocated from the arena must not be used after the next reset.
+class FrameArena final : public std::pmr::memory_resource
+{
+  public:
+    /// @brief Deleted default constructor.
+    FrameArena() = delete;
+
+    /// @brief Non-default constructor.
+    /// @param capacity - Size of the preallocated region in bytes.
+    /// @param upstream - Resource of the region and of the allocations that do not fit.
+    explicit FrameArena(std::size_t capacity,
+                        std::pmr::memory_resource *upstream = std::pmr::new_delete_resource());
+
+    /// @brief Destructor.
+    ~FrameArena() override;
+
+    /// @brief Deleted copy constructor.
+    FrameArena(const FrameArena &) = delete;
+
+    /// @brief Deleted copy assignment operator.
+    FrameArena &operator=(const FrameArena &) = delete;
+
+    /// @brief Deleted move constructor.
+    FrameArena(FrameArena &&) = delete;
+
+    /// @brief Deleted move assignment operator.
+    FrameArena &operator=(FrameArena &&) = delete;
+
+    /// @brief Releases the allocations of the frame, to be called at the start of every frame.
+    void reset();
+
+    /// @brief Get the size of the preallocated region in bytes.
+    inline std::size_t capacity() const noexcept
+    {
+        return capacity_;
+    }
+
+    /// @brief Get the bytes allocated from the region since the last reset.
+    inline std::size_t used() const noexcept
+    {
+        return offset_;
+    }
+
+    /// @brief Get the number of allocations served by the upstream resource since construction.
+    inline std::size_t overflowAllocations() const noexcept
+    {
+        return overflow_allocations_;
+    }
+
+  private:
+    // Allocation served by the upstream resource
+    struct OverflowBlock final
+    {
+        void *memory;
+        std::size_t bytes;
+        std::size_t alignment;
+    };
+
+    std::pmr::memory_resource *upstream_;
+    std::byte *buffer_;
+    std::size_t capacity_;
+    std::size_t offset_;
+
+    std::vector<OverflowBlock> overflow_blocks_;
+    std::size_t overflow_bytes_;
+    std::size_t overflow_allocations_;
+
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void *memory, std::size_t bytes, std::size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override;
+
+    /// @brief Returns the overflow blocks to the upstream resource.
+    void releaseOverflowBlocks() noexcept;
+};
+} // namespace utilities_lib
+
+#endif // UTILITIES__FRAME_ARENA_HPP
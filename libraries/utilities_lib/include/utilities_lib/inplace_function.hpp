@@ -0,0 +1,159 @@
+#pragma once
+
+#include <cstddef>     // std::size_t, std::max_align_t, std::nullptr_t
+#include <functional>  // std::bad_function_call
+#include <new>         // ::new, std::launder
+#include <type_traits> // std::decay_t, std::enable_if_t, std::is_same_v
+#include <utility>     // std::forward, std::move
+
+namespace utilities_lib
+{
+template <typename Signature, std::size_t CAPACITY = 48U> class InplaceFunction;
+
+/// @brief Move-only type-erased callable with a small buffer (like std::move_only_function). Callables of up to
+/// CAPACITY bytes with a non-throwing move constructor are stored in the buffer and never allocate, larger callables
+/// are moved to the heap.
+template <typename R, typename... Args, std::size_t CAPACITY> class InplaceFunction<R(Args...), CAPACITY> final
+{
+  public:
+    /// @brief Default constructor creates an empty function
+    InplaceFunction() noexcept = default;
+
+    /// @brief Creates an empty function
+    InplaceFunction(std::nullptr_t) noexcept
+    {
+    }
+
+    /// @brief Stores the callable, in the buffer if it fits
+    template <typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, InplaceFunction>>>
+    InplaceFunction(F &&func)
+    {
+        using Callable = std::decay_t<F>;
+        if constexpr (storesInline<Callable>())
+        {
+            ::new (static_cast<void *>(storage_)) Callable{std::forward<F>(func)};
+            operations_ = &INLINE_OPERATIONS<Callable>;
+        }
+        else
+        {
+            ::new (static_cast<void *>(storage_)) Callable *{new Callable{std::forward<F>(func)}};
+            operations_ = &HEAP_OPERATIONS<Callable>;
+        }
+    }
+
+    /// @brief Move constructor, the other function is left empty
+    InplaceFunction(InplaceFunction &&other) noexcept
+    {
+        moveFrom(other);
+    }
+
+    /// @brief Move assignment operator, the other function is left empty
+    InplaceFunction &operator=(InplaceFunction &&other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            moveFrom(other);
+        }
+        return *this;
+    }
+
+    /// @brief Destroys the stored callable
+    InplaceFunction &operator=(std::nullptr_t) noexcept
+    {
+        reset();
+        return *this;
+    }
+
+    // Copy operations are not allowed.
+    InplaceFunction(const InplaceFunction &) = delete;
+    InplaceFunction &operator=(const InplaceFunction &) = delete;
+
+    /// @brief Destructor - destroys the stored callable
+    ~InplaceFunction() noexcept
+    {
+        reset();
+    }
+
+    /// @brief Invokes the stored callable
+    /// @throws std::bad_function_call if the function is empty
+    inline R operator()(Args... args)
+    {
+        if (operations_ == nullptr)
+        {
+            throw std::bad_function_call();
+        }
+        return operations_->invoke(storage_, std::forward<Args>(args)...);
+    }
+
+    /// @brief Checks if a callable is stored
+    inline explicit operator bool() const noexcept
+    {
+        return (operations_ != nullptr);
+    }
+
+    /// @brief Checks if callables of type F are stored in the buffer, without allocating
+    template <typename F> static constexpr bool storesInline() noexcept
+    {
+        return (sizeof(F) <= CAPACITY) && (alignof(F) <= alignof(std::max_align_t)) &&
+               std::is_nothrow_move_constructible_v<F>;
+    }
+
+  private:
+    // Operations of the stored callable type
+    struct Operations final
+    {
+        R (*invoke)(void *storage, Args &&...args);
+        void (*move)(void *destination, void *source) noexcept;
+        void (*destroy)(void *storage) noexcept;
+    };
+
+    template <typename F> static inline F *inlineCallable(void *storage) noexcept
+    {
+        return std::launder(static_cast<F *>(storage));
+    }
+
+    template <typename F> static inline F *&heapCallable(void *storage) noexcept
+    {
+        return *std::launder(static_cast<F **>(storage));
+    }
+
+    template <typename F>
+    static constexpr Operations INLINE_OPERATIONS{
+        [](void *storage, Args &&...args) -> R { return (*inlineCallable<F>(storage))(std::forward<Args>(args)...); },
+        [](void *destination, void *source) noexcept {
+            F *callable = inlineCallable<F>(source);
+            ::new (destination) F{std::move(*callable)};
+            callable->~F();
+        },
+        [](void *storage) noexcept { inlineCallable<F>(storage)->~F(); }};
+
+    template <typename F>
+    static constexpr Operations HEAP_OPERATIONS{
+        [](void *storage, Args &&...args) -> R { return (*heapCallable<F>(storage))(std::forward<Args>(args)...); },
+        [](void *destination, void *source) noexcept { ::new (destination) F *{heapCallable<F>(source)}; },
+        [](void *storage) noexcept { delete heapCallable<F>(storage); }};
+
+    alignas(std::max_align_t) unsigned char storage_[CAPACITY];
+    const Operations *operations_ = nullptr;
+
+    inline void moveFrom(InplaceFunction &other) noexcept
+    {
+        if (other.operations_ != nullptr)
+        {
+            other.operations_->move(storage_, other.storage_);
+            operations_ = other.operations_;
+            other.operations_ = nullptr;
+        }
+    }
+
+    inline void reset() noexcept
+    {
+        if (operations_ != nullptr)
+        {
+            operations_->destroy(storage_);
+            operations_ = nullptr;
+        }
+    }
+};
+} // namespace utilities_lib
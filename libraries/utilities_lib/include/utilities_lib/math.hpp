@@ -15,6 +15,19 @@ static constexpr inline std::int64_t constexprRound(const double value) noexcept
     return (value > 0.0) ? static_cast<std::int64_t>(value + 0.5) : static_cast<std::int64_t>(value - 0.5);
 }
 
+/// @brief Sine evaluated at compile time by its Taylor series, accurate for |value| <= pi.
+static constexpr inline double constexprSin(const double value) noexcept
+{
+    double term = value;
+    double sum = value;
+    for (std::int32_t n = 1; n < 12; ++n)
+    {
+        term *= -(value * value) / static_cast<double>((2 * n) * (2 * n + 1));
+        sum += term;
+    }
+    return sum;
+}
+
 static constexpr float atan2Approx(const float y, const float x) noexcept
 {
     const float ax = std::fabs(x);
@@ -0,0 +1,218 @@
+#pragma once
+
+#include <utilities_lib/spsc_queue.hpp> // CACHE_LINE_SIZE, nextPowerOfTwo
+
+#include <atomic>    // std::atomic
+#include <cstddef>   // std::size_t
+#include <cstdint>   // std::intptr_t
+#include <new>       // ::new
+#include <stdexcept> // std::runtime_error
+#include <thread>    // std::this_thread::yield
+#include <utility>   // std::move, std::forward
+
+namespace utilities_lib
+{
+/// @brief Fixed-capacity lock-free queue of any number of producer and consumer threads (D. Vyukov's bounded MPMC
+/// queue). Every cell carries a sequence number telling whether it is free for the producer or filled for the
+/// consumer of the current lap, so producers and consumers only contend on their own index.
+template <typename T> class MPMCQueue final
+{
+  public:
+    /// @brief A non-default constructor that allocates the buffer, the capacity is rounded up to a power of two (at
+    /// least 2, a single cell can not tell a free cell of the next lap from a filled one)
+    explicit MPMCQueue(const std::size_t capacity)
+        : capacity_{nextPowerOfTwo((capacity < 2U) ? 2U : capacity)}, mask_{capacity_ - 1U}
+    {
+        if (capacity == 0U)
+        {
+            throw std::runtime_error("Capacity of MPMCQueue must be positive!");
+        }
+
+        cells_ = static_cast<Cell *>(::operator new(capacity_ * sizeof(Cell)));
+        for (std::size_t i = 0U; i < capacity_; ++i)
+        {
+            ::new (&cells_[i].sequence) std::atomic<std::size_t>{i};
+        }
+    }
+
+    /// @brief Destructor - cleans any remaining memory from the buffer
+    ~MPMCQueue() noexcept
+    {
+        // Cells filled in their current lap hold an element
+        const std::size_t enqueue_position = enqueue_position_.load(std::memory_order_acquire);
+        for (std::size_t i = dequeue_position_.load(std::memory_order_acquire); i != enqueue_position; ++i)
+        {
+            Cell &cell = cells_[i & mask_];
+            if (cell.sequence.load(std::memory_order_acquire) == (i + 1U))
+            {
+                cell.value()->~T();
+            }
+        }
+
+        for (std::size_t i = 0U; i < capacity_; ++i)
+        {
+            using Sequence = std::atomic<std::size_t>;
+            cells_[i].sequence.~Sequence();
+        }
+        ::operator delete(cells_);
+    }
+
+    // Copy and move operations are not allowed.
+    MPMCQueue(const MPMCQueue &) = delete;
+    MPMCQueue(MPMCQueue &&) = delete;
+    MPMCQueue &operator=(const MPMCQueue &) = delete;
+    MPMCQueue &operator=(MPMCQueue &&) = delete;
+
+    /// @brief Adds element to the end of the queue
+    /// @return False if the queue is full
+    inline bool tryPush(const T &value)
+    {
+        return tryEmplace(value);
+    }
+
+    /// @brief Adds element to the end of the queue
+    /// @return False if the queue is full, the value is not moved from then
+    inline bool tryPush(T &&value)
+    {
+        return tryEmplace(std::move(value));
+    }
+
+    /// @brief Constructs element at the end of the queue
+    /// @return False if the queue is full
+    template <typename... Args> inline bool tryEmplace(Args &&...args)
+    {
+        std::size_t position = enqueue_position_.load(std::memory_order_relaxed);
+        Cell *cell;
+        while (true)
+        {
+            cell = &cells_[position & mask_];
+            const std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const std::intptr_t lap = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+            if (lap == 0)
+            {
+                // The cell is free in this lap, claim it
+                if (enqueue_position_.compare_exchange_weak(position, position + 1U, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (lap < 0)
+            {
+                // The cell still holds the element of the previous lap
+                return false;
+            }
+            else
+            {
+                // Another producer claimed the position
+                position = enqueue_position_.load(std::memory_order_relaxed);
+            }
+        }
+
+        ::new (cell->value()) T{std::forward<Args>(args)...};
+        cell->sequence.store(position + 1U, std::memory_order_release);
+        return true;
+    }
+
+    /// @brief Removes first element of the queue
+    /// @return False if the queue is empty
+    inline bool tryPop(T &value)
+    {
+        std::size_t position = dequeue_position_.load(std::memory_order_relaxed);
+        Cell *cell;
+        while (true)
+        {
+            cell = &cells_[position & mask_];
+            const std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const std::intptr_t lap =
+                static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position + 1U);
+            if (lap == 0)
+            {
+                // The cell was filled in this lap, claim it
+                if (dequeue_position_.compare_exchange_weak(position, position + 1U, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (lap < 0)
+            {
+                // The cell was not filled yet
+                return false;
+            }
+            else
+            {
+                // Another consumer claimed the position
+                position = dequeue_position_.load(std::memory_order_relaxed);
+            }
+        }
+
+        T *element = cell->value();
+        value = std::move(*element);
+        element->~T();
+
+        // Frees the cell for the producer of the next lap
+        cell->sequence.store(position + capacity_, std::memory_order_release);
+        return true;
+    }
+
+    /// @brief Adds element to the end of the queue, yields while the queue is full
+    inline void push(T value)
+    {
+        while (!tryPush(std::move(value)))
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    /// @brief Removes first element of the queue, yields while the queue is empty
+    inline void pop(T &value)
+    {
+        while (!tryPop(value))
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    /// @brief Checks if the queue is empty, a snapshot while other threads are pushing or popping
+    inline bool empty() const noexcept
+    {
+        return (size() == 0U);
+    }
+
+    /// @brief Retrieves current size of the queue, a snapshot while other threads are pushing or popping
+    inline std::size_t size() const noexcept
+    {
+        const std::size_t dequeue_position = dequeue_position_.load(std::memory_order_acquire);
+        const std::size_t enqueue_position = enqueue_position_.load(std::memory_order_acquire);
+        return (enqueue_position > dequeue_position) ? (enqueue_position - dequeue_position) : 0U;
+    }
+
+    /// @brief Retrieves the capacity of the queue
+    inline std::size_t capacity() const noexcept
+    {
+        return capacity_;
+    }
+
+  private:
+    struct Cell final
+    {
+        std::atomic<std::size_t> sequence;
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        inline T *value() noexcept
+        {
+            return reinterpret_cast<T *>(storage);
+        }
+    };
+
+    // Read-only after construction
+    Cell *cells_;
+    const std::size_t capacity_;
+    const std::size_t mask_;
+
+    // Contended by the producers
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> enqueue_position_{0U};
+
+    // Contended by the consumers
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> dequeue_position_{0U};
+};
+} // namespace utilities_lib
@@ -0,0 +1,189 @@
+#ifndef UTILITIES__PROFILER_HPP
+#define UTILITIES__PROFILER_HPP
+
+#include <utilities_lib/spsc_queue.hpp> // SPSCQueue
+
+#include <atomic>     // std::atomic
+#include <chrono>     // std::chrono
+#include <cstdint>    // std::int64_t, std::uint32_t, std::uint64_t
+#include <filesystem> // std::filesystem
+#include <fstream>    // std::ofstream
+#include <memory>     // std::unique_ptr
+#include <mutex>      // std::mutex
+#include <string>     // std::string
+#include <vector>     // std::vector
+
+#if defined(UTILITIES_LIB_PROFILING_TRACY)
+#include <tracy/Tracy.hpp> // ZoneScopedN
+#endif
+
+namespace utilities_lib
+{
+/// @brief Duration of a zone measured on one thread, in steady clock nanoseconds.
+struct ProfileEvent final
+{
+    std::uint32_t zone;
+    std::uint32_t thread;
+    std::int64_t start;
+    std::int64_t end;
+};
+
+/// @brief Latency of a zone over its most recent samples.
+struct ProfileZoneStatistics final
+{
+    std::string name;
+
+    // Number of samples since the start of the process, the percentiles cover the last SAMPLES_PER_ZONE of them
+    std::uint64_t count;
+
+    double p50_ms;
+    double p99_ms;
+    double max_ms;
+};
+
+/// @brief Process-wide collector of zone latencies. Zones are recorded into a lock-free ring buffer of the recording
+/// thread, so the hot path neither locks nor allocates after the first zone of a thread. A single collector (e.g. a
+/// diagnostics timer) drains the buffers into per-zone sample windows, evaluates their percentiles and optionally
+/// appends the events to a Chrome trace (chrome://tracing, Perfetto). Events of a full buffer are dropped and counted.
+///
+/// Zones are opened with UTILITIES_PROFILE_ZONE, which compiles to nothing unless utilities_lib is built with
+/// UTILITIES_LIB_PROFILING.
+class Profiler final
+{
+  public:
+    // Events buffered per thread between two collections
+    static constexpr std::size_t EVENTS_PER_THREAD = 4096U;
+
+    // Most recent samples of a zone the percentiles are evaluated over
+    static constexpr std::size_t SAMPLES_PER_ZONE = 1024U;
+
+    /// @brief Get the profiler of the process.
+    static Profiler &instance();
+
+    // Copy and move operations are not allowed.
+    Profiler(const Profiler &) = delete;
+    Profiler(Profiler &&) = delete;
+    Profiler &operator=(const Profiler &) = delete;
+    Profiler &operator=(Profiler &&) = delete;
+
+    /// @brief Get the steady clock time in nanoseconds.
+    static inline std::int64_t now() noexcept
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+
+    /// @brief Registers a zone, called once per zone site. Sites of the same name share the zone.
+    /// @return Identifier of the zone.
+    std::uint32_t registerZone(const char *name);
+
+    /// @brief Records a zone of the calling thread, allocates the buffer of the thread on its first zone.
+    void record(std::uint32_t zone, std::int64_t start, std::int64_t end);
+
+    /// @brief Drains the buffers of all threads into the sample windows and the Chrome trace.
+    void collect();
+
+    /// @brief Get the latency of every zone with samples, in the order of registration.
+    std::vector<ProfileZoneStatistics> statistics();
+
+    /// @brief Starts appending the collected events to a Chrome trace file, replaces a running trace.
+    /// @throws std::runtime_error if the file can not be created.
+    void startChromeTrace(const std::filesystem::path &file_path);
+
+    /// @brief Completes the Chrome trace file.
+    void stopChromeTrace();
+
+    /// @brief Get the number of events dropped from full buffers.
+    inline std::uint64_t droppedEvents() const noexcept
+    {
+        return dropped_events_.load(std::memory_order_relaxed);
+    }
+
+  private:
+    struct ThreadBuffer final
+    {
+        explicit ThreadBuffer(std::uint32_t index) : events{EVENTS_PER_THREAD}, thread_index{index}
+        {
+        }
+
+        SPSCQueue<ProfileEvent> events;
+        std::uint32_t thread_index;
+    };
+
+    // Ring of the most recent durations of a zone
+    struct ZoneSamples final
+    {
+        std::vector<std::int64_t> durations;
+        std::size_t next = 0U;
+        std::uint64_t count = 0U;
+    };
+
+    Profiler() = default;
+
+    ~Profiler();
+
+    // Guards the zones, the buffer list, the sample windows and the trace
+    std::mutex mutex_;
+    std::vector<std::string> zone_names_;
+    std::vector<ZoneSamples> zone_samples_;
+
+    // Buffers outlive their threads, events of finished threads are still collected
+    std::vector<std::unique_ptr<ThreadBuffer>> thread_buffers_;
+
+    std::ofstream chrome_trace_;
+    bool chrome_trace_empty_ = true;
+
+    std::vector<std::int64_t> sorted_durations_;
+    std::atomic<std::uint64_t> dropped_events_{0U};
+
+    ThreadBuffer &createThreadBuffer();
+};
+
+/// @brief Records the lifetime of the scope as a zone.
+class ProfileScope final
+{
+  public:
+    explicit ProfileScope(const std::uint32_t zone) noexcept : zone_{zone}, start_{Profiler::now()}
+    {
+    }
+
+    ~ProfileScope()
+    {
+        Profiler::instance().record(zone_, start_, Profiler::now());
+    }
+
+    // Copy and move operations are not allowed.
+    ProfileScope(const ProfileScope &) = delete;
+    ProfileScope(ProfileScope &&) = delete;
+    ProfileScope &operator=(const ProfileScope &) = delete;
+    ProfileScope &operator=(ProfileScope &&) = delete;
+
+  private:
+    std::uint32_t zone_;
+    std::int64_t start_;
+};
+} // namespace utilities_lib
+
+#define UTILITIES_PROFILE_CONCATENATE_IMPL(a, b) a##b
+#define UTILITIES_PROFILE_CONCATENATE(a, b) UTILITIES_PROFILE_CONCATENATE_IMPL(a, b)
+
+#if defined(UTILITIES_LIB_PROFILING_TRACY)
+#define UTILITIES_PROFILE_TRACY_ZONE(name) ZoneScopedN(name)
+#else
+#define UTILITIES_PROFILE_TRACY_ZONE(name) static_cast<void>(0)
+#endif
+
+// Profiles the rest of the enclosing scope as the zone of the name, the name must be a string literal
+#if defined(UTILITIES_LIB_PROFILING)
+#define UTILITIES_PROFILE_ZONE(name)                                                                                  \
+    static const std::uint32_t UTILITIES_PROFILE_CONCATENATE(profile_zone_, __LINE__) =                               \
+        ::utilities_lib::Profiler::instance().registerZone(name);                                                     \
+    const ::utilities_lib::ProfileScope UTILITIES_PROFILE_CONCATENATE(profile_scope_, __LINE__){                      \
+        UTILITIES_PROFILE_CONCATENATE(profile_zone_, __LINE__)};                                                      \
+    UTILITIES_PROFILE_TRACY_ZONE(name)
+#else
+#define UTILITIES_PROFILE_ZONE(name) static_cast<void>(0)
+#endif
+
+#endif // UTILITIES__PROFILER_HPP
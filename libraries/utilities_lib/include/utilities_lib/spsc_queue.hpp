@@ -0,0 +1,167 @@
+#pragma once
+
+#include <atomic>    // std::atomic
+#include <cstddef>   // std::size_t
+#include <new>       // ::new
+#include <stdexcept> // std::runtime_error
+#include <thread>    // std::this_thread::yield
+#include <utility>   // std::move, std::forward
+
+namespace utilities_lib
+{
+// Size of a cache line, keeps the indices written by different threads from sharing one
+inline constexpr std::size_t CACHE_LINE_SIZE = 64U;
+
+/// @brief Rounds up to the next power of two, the capacity of the lock-free queues.
+inline constexpr std::size_t nextPowerOfTwo(const std::size_t value) noexcept
+{
+    std::size_t power = 1U;
+    while (power < value)
+    {
+        power <<= 1U;
+    }
+    return power;
+}
+
+/// @brief Fixed-capacity lock-free queue of a single producer thread and a single consumer thread.
+/// The memory is allocated once in the constructor, the queue never reallocates.
+template <typename T> class SPSCQueue final
+{
+  public:
+    /// @brief A non-default constructor that allocates the buffer, the capacity is rounded up to a power of two
+    explicit SPSCQueue(const std::size_t capacity) : capacity_{nextPowerOfTwo(capacity)}, mask_{capacity_ - 1U}
+    {
+        if (capacity == 0U)
+        {
+            throw std::runtime_error("Capacity of SPSCQueue must be positive!");
+        }
+
+        buffer_ = static_cast<T *>(::operator new(capacity_ * sizeof(T)));
+    }
+
+    /// @brief Destructor - cleans any remaining memory from the buffer
+    ~SPSCQueue() noexcept
+    {
+        const std::size_t tail = tail_.load(std::memory_order_acquire);
+        for (std::size_t i = head_.load(std::memory_order_acquire); i != tail; ++i)
+        {
+            buffer_[i & mask_].~T();
+        }
+        ::operator delete(buffer_);
+    }
+
+    // Copy and move operations are not allowed.
+    SPSCQueue(const SPSCQueue &) = delete;
+    SPSCQueue(SPSCQueue &&) = delete;
+    SPSCQueue &operator=(const SPSCQueue &) = delete;
+    SPSCQueue &operator=(SPSCQueue &&) = delete;
+
+    /// @brief Adds element to the end of the queue, called by the producer thread
+    /// @return False if the queue is full
+    inline bool tryPush(const T &value)
+    {
+        return tryEmplace(value);
+    }
+
+    /// @brief Adds element to the end of the queue, called by the producer thread
+    /// @return False if the queue is full, the value is not moved from then
+    inline bool tryPush(T &&value)
+    {
+        return tryEmplace(std::move(value));
+    }
+
+    /// @brief Constructs element at the end of the queue, called by the producer thread
+    /// @return False if the queue is full
+    template <typename... Args> inline bool tryEmplace(Args &&...args)
+    {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        if ((tail - head_cache_) == capacity_)
+        {
+            // The consumer index is re-read only when the queue looks full
+            head_cache_ = head_.load(std::memory_order_acquire);
+            if ((tail - head_cache_) == capacity_)
+            {
+                return false;
+            }
+        }
+
+        ::new (&buffer_[tail & mask_]) T{std::forward<Args>(args)...};
+        tail_.store(tail + 1U, std::memory_order_release);
+        return true;
+    }
+
+    /// @brief Removes first element of the queue, called by the consumer thread
+    /// @return False if the queue is empty
+    inline bool tryPop(T &value)
+    {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_cache_)
+        {
+            // The producer index is re-read only when the queue looks empty
+            tail_cache_ = tail_.load(std::memory_order_acquire);
+            if (head == tail_cache_)
+            {
+                return false;
+            }
+        }
+
+        T &element = buffer_[head & mask_];
+        value = std::move(element);
+        element.~T();
+        head_.store(head + 1U, std::memory_order_release);
+        return true;
+    }
+
+    /// @brief Adds element to the end of the queue, yields while the queue is full
+    inline void push(T value)
+    {
+        while (!tryPush(std::move(value)))
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    /// @brief Removes first element of the queue, yields while the queue is empty
+    inline void pop(T &value)
+    {
+        while (!tryPop(value))
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    /// @brief Checks if the queue is empty, exact only when called by the producer or the consumer
+    inline bool empty() const noexcept
+    {
+        return (size() == 0U);
+    }
+
+    /// @brief Retrieves current size of the queue, exact only when called by the producer or the consumer
+    inline std::size_t size() const noexcept
+    {
+        // The consumer index is read first, it never passes the producer index read after it
+        const std::size_t head = head_.load(std::memory_order_acquire);
+        return tail_.load(std::memory_order_acquire) - head;
+    }
+
+    /// @brief Retrieves the capacity of the queue
+    inline std::size_t capacity() const noexcept
+    {
+        return capacity_;
+    }
+
+  private:
+    // Read-only after construction
+    T *buffer_;
+    const std::size_t capacity_;
+    const std::size_t mask_;
+
+    // Written by the consumer
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> head_{0U};
+    std::size_t tail_cache_ = 0U;
+
+    // Written by the producer
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> tail_{0U};
+    std::size_t head_cache_ = 0U;
+};
+} // namespace utilities_lib
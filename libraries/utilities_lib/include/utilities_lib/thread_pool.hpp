@@ -1,27 +1,39 @@
 #ifndef UTILITIES__THREAD_POOL_HPP
 #define UTILITIES__THREAD_POOL_HPP
 
-#include <condition_variable> // std::condition_variable
-#include <cstdlib>            // std::size_t
-#include <future>             // std::packaged_task
-#include <mutex>              // std::mutex
-#include <queue>              // std::queue
-#include <thread>             // std::thread
-#include <utility>            // std::move
-#include <vector>             // std::vector
+#include <atomic>                             // std::atomic
+#include <condition_variable>                 // std::condition_variable
+#include <cstdlib>                            // std::size_t
+#include <exception>                          // std::exception_ptr
+#include <future>                             // std::packaged_task
+#include <memory>                             // std::unique_ptr
+#include <mutex>                              // std::mutex
+#include <stdexcept>                          // std::runtime_error
+#include <thread>                             // std::thread
+#include <utilities_lib/inplace_function.hpp> // InplaceFunction
+#include <utility>                            // std::move
+#include <vector>                             // std::vector
 
 namespace utilities_lib
 {
+/// @brief Work-stealing thread pool. Every worker owns a deque, tasks submitted by a worker are pushed to its own
+/// deque and run last-in first-out, idle workers steal the oldest tasks of the other deques. Tasks submitted from
+/// other threads are spread over the deques round-robin.
 class ThreadPool final
 {
   public:
+    // Tasks of up to TASK_CAPACITY bytes of captures are queued without allocating
+    static constexpr std::size_t TASK_CAPACITY = 48U;
+    using Task = InplaceFunction<void(), TASK_CAPACITY>;
+
     /// @brief Deleted default constructor.
     ThreadPool() = delete;
 
     /// @brief Non-default constructor.
-    explicit ThreadPool(std::size_t number_of_threads);
+    /// @param pin_threads - Pins worker i to CPU core i modulo the number of cores (Linux only, ignored elsewhere).
+    explicit ThreadPool(std::size_t number_of_threads, bool pin_threads = false);
 
-    /// @brief Destructor.
+    /// @brief Destructor, runs the queued tasks before joining the workers.
     ~ThreadPool();
 
     /// @brief Deleted copy constructor.
@@ -45,21 +57,31 @@ class ThreadPool final
         std::packaged_task<return_type()> task(std::forward<F>(func));
         std::future<return_type> result = task.get_future();
 
-        {
-            const std::lock_guard<std::mutex> lock(mutex_);
-
-            if (stop_)
-            {
-                throw std::runtime_error("enqueue on stopped ThreadPool");
-            }
+        // The packaged task is moved into the queued task, only its shared state is allocated
+        submit([t = std::move(task)]() mutable { t(); });
+        return result;
+    }
 
-            tasks_.emplace([t = std::move(task)]() mutable { t(); });
+    /// @brief Fire-and-forget submission of a task, without the future of enqueue. The task must not throw, use a
+    /// TaskGroup to wait for tasks and to receive their exceptions.
+    template <class F> void submit(F &&func)
+    {
+        if (stop_.load(std::memory_order_relaxed))
+        {
+            throw std::runtime_error("enqueue on stopped ThreadPool");
         }
 
-        condition_variable_.notify_one();
-        return result;
+        push(Task{std::forward<F>(func)});
     }
 
+    /// @brief Runs func(first, last) over the chunks of [begin, end) of at most grain indices, in parallel on the
+    /// workers and on the calling thread. Returns when every chunk is done.
+    template <class F> void parallelFor(std::size_t begin, std::size_t end, std::size_t grain, F &&func);
+
+    /// @brief Runs one queued task on the calling thread.
+    /// @return False if no task was queued.
+    bool runPendingTask();
+
     /// @brief Get the number of running threads.
     inline std::size_t threadCount() const noexcept
     {
@@ -67,12 +89,187 @@ class ThreadPool final
     }
 
   private:
+    // Ring buffer of tasks, grows by doubling and keeps its capacity so queueing does not allocate in steady state
+    class TaskDeque final
+    {
+      public:
+        static constexpr std::size_t INITIAL_CAPACITY = 256U;
+
+        TaskDeque() : tasks_(INITIAL_CAPACITY), head_{0U}, count_{0U}
+        {
+        }
+
+        inline bool empty() const noexcept
+        {
+            return (count_ == 0U);
+        }
+
+        inline void pushBack(Task &&task)
+        {
+            if (count_ == tasks_.size())
+            {
+                grow();
+            }
+            tasks_[(head_ + count_) & (tasks_.size() - 1U)] = std::move(task);
+            ++count_;
+        }
+
+        inline Task popBack() noexcept
+        {
+            --count_;
+            return std::move(tasks_[(head_ + count_) & (tasks_.size() - 1U)]);
+        }
+
+        inline Task popFront() noexcept
+        {
+            Task task = std::move(tasks_[head_]);
+            head_ = (head_ + 1U) & (tasks_.size() - 1U);
+            --count_;
+            return task;
+        }
+
+      private:
+        // Capacity is a power of two
+        std::vector<Task> tasks_;
+        std::size_t head_;
+        std::size_t count_;
+
+        void grow()
+        {
+            std::vector<Task> grown_tasks(tasks_.size() * 2U);
+            for (std::size_t i = 0U; i < count_; ++i)
+            {
+                grown_tasks[i] = std::move(tasks_[(head_ + i) & (tasks_.size() - 1U)]);
+            }
+            tasks_.swap(grown_tasks);
+            head_ = 0U;
+        }
+    };
+
+    // Deque of a worker, the owner pops from the back and thieves from the front
+    struct alignas(64) WorkerQueue final
+    {
+        std::mutex mutex;
+        TaskDeque tasks;
+    };
+
     std::vector<std::thread> threads_;
-    std::queue<std::packaged_task<void()>> tasks_;
+    std::unique_ptr<WorkerQueue[]> queues_;
+    std::size_t number_of_queues_;
+    std::atomic<std::size_t> next_queue_;
+
+    // Queued tasks and sleeping workers, a submitter wakes a worker only when one sleeps
+    std::atomic<std::size_t> pending_tasks_;
+    std::atomic<std::size_t> sleeping_threads_;
     std::mutex mutex_;
     std::condition_variable condition_variable_;
-    bool stop_;
+    std::atomic<bool> stop_;
+
+    /// @brief Queues the task, to the deque of the calling worker if it belongs to this pool.
+    void push(Task &&task);
+
+    /// @brief Takes a task, from the back of the first deque when it is owned by the caller and from the front of
+    /// the others.
+    bool tryTake(std::size_t first_queue, bool is_owner, Task &task);
+
+    /// @brief Runs and steals tasks until the pool is stopped and no task is queued.
+    void workerLoop(std::size_t worker_index);
 };
+
+/// @brief Joins a group of tasks submitted to a thread pool, like a latch counted up by run and down by the tasks.
+/// The waiting thread runs queued tasks instead of blocking, so groups can be waited for from within a task.
+class TaskGroup final
+{
+  public:
+    explicit TaskGroup(ThreadPool &thread_pool) : thread_pool_{thread_pool}, pending_tasks_{0U}
+    {
+    }
+
+    /// @brief Waits for the remaining tasks, their exceptions are discarded.
+    ~TaskGroup()
+    {
+        waitForTasks();
+    }
+
+    // Copy and move operations are not allowed.
+    TaskGroup(const TaskGroup &) = delete;
+    TaskGroup(TaskGroup &&) = delete;
+    TaskGroup &operator=(const TaskGroup &) = delete;
+    TaskGroup &operator=(TaskGroup &&) = delete;
+
+    /// @brief Submits a task of the group.
+    template <class F> void run(F &&func)
+    {
+        pending_tasks_.fetch_add(1U, std::memory_order_relaxed);
+        thread_pool_.submit([this, task = std::forward<F>(func)]() mutable {
+            try
+            {
+                task();
+            }
+            catch (...)
+            {
+                const std::lock_guard<std::mutex> lock(exception_mutex_);
+                if (exception_ == nullptr)
+                {
+                    exception_ = std::current_exception();
+                }
+            }
+            pending_tasks_.fetch_sub(1U, std::memory_order_release);
+        });
+    }
+
+    /// @brief Waits for the tasks of the group.
+    /// @throws The first exception thrown by a task of the group.
+    void wait()
+    {
+        waitForTasks();
+
+        std::exception_ptr exception;
+        {
+            const std::lock_guard<std::mutex> lock(exception_mutex_);
+            std::swap(exception, exception_);
+        }
+
+        if (exception != nullptr)
+        {
+            std::rethrow_exception(exception);
+        }
+    }
+
+  private:
+    ThreadPool &thread_pool_;
+    std::atomic<std::size_t> pending_tasks_;
+    std::mutex exception_mutex_;
+    std::exception_ptr exception_;
+
+    inline void waitForTasks()
+    {
+        while (pending_tasks_.load(std::memory_order_acquire) > 0U)
+        {
+            // Tasks of the group may be running on the workers while no task is queued
+            if (!thread_pool_.runPendingTask())
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+};
+
+template <class F> void ThreadPool::parallelFor(std::size_t begin, std::size_t end, std::size_t grain, F &&func)
+{
+    if (grain == 0U)
+    {
+        grain = 1U;
+    }
+
+    TaskGroup task_group(*this);
+    for (std::size_t first = begin; first < end; first += grain)
+    {
+        const std::size_t last = ((end - first) > grain) ? (first + grain) : end;
+        task_group.run([&func, first, last]() { func(first, last); });
+    }
+    task_group.wait();
+}
 } // namespace utilities_lib
 
 #endif // UTILITIES__THREAD_POOL_HPP
@@ -6,15 +6,151 @@ extern "C"
 #include "tlsf/tlsf.h"
 }
 
-#include <cstddef>     // std::ptrdiff_t
-#include <cstdlib>     // std::malloc
-#include <cstring>     // std::memset
-#include <memory>      // std::address_of
-#include <stdexcept>   // std::bad_alloc
-#include <type_traits> // std::true_type
+#include <cstddef>     // std::size_t, std::ptrdiff_t, std::max_align_t
+#include <limits>      // std::numeric_limits
+#include <memory>      // std::addressof, std::unique_ptr
+#include <mutex>       // std::mutex
+#include <new>         // std::bad_alloc
+#include <type_traits> // std::true_type, std::false_type
+#include <utility>     // std::forward
+#include <vector>      // std::vector
 
 namespace utilities_lib
 {
+/// @brief Occupancy of a TLSF heap.
+struct TLSFHeapStatistics final
+{
+    // Size of the pool in bytes
+    std::size_t capacity;
+
+    // Bytes of the live allocations, block rounding included
+    std::size_t used_bytes;
+
+    // Peak of the used bytes since construction or the last reset of the mark
+    std::size_t high_water_mark;
+
+    std::size_t live_allocations;
+
+    // Allocations refused because no free block was large enough
+    std::size_t failed_allocations;
+
+    std::size_t free_bytes;
+    std::size_t largest_free_block;
+
+    // 1 - largest free block / free bytes, 0 when the free memory is contiguous
+    double fragmentation;
+};
+
+/// @brief Two-level segregated fit heap over one preallocated pool. Allocations and deallocations are O(1) and never
+/// reach the system allocator, so the heap can back the containers of the real-time path. The pool is reserved
+/// without committing its pages, unless it is locked: then every page is faulted in and locked into RAM at
+/// construction, and no allocation page faults afterwards.
+///
+/// The heap is guarded by a mutex, memory may be released by any thread. Threads that allocate concurrently take
+/// their own heap from TLSFThreadHeaps instead of contending on a shared one.
+class TLSFHeap final
+{
+  public:
+    // Pool of the default heap, reserved but committed only as it is touched
+    static constexpr std::size_t DEFAULT_CAPACITY = std::size_t{1U} << 30U;
+
+    /// @brief Get the heap of the default constructed allocators, created with DEFAULT_CAPACITY on first use.
+    static TLSFHeap &defaultHeap();
+
+    /// @brief Deleted default constructor.
+    TLSFHeap() = delete;
+
+    /// @brief Non-default constructor, maps the pool.
+    /// @param capacity - Size of the pool in bytes.
+    /// @param lock_memory - Commits the pool and locks it into RAM (mlock).
+    /// @throws std::runtime_error if the pool can not be mapped or locked (e.g. RLIMIT_MEMLOCK).
+    explicit TLSFHeap(std::size_t capacity, bool lock_memory = false);
+
+    /// @brief Destructor, unmaps the pool, the allocations must be released before.
+    ~TLSFHeap();
+
+    // Copy and move operations are not allowed, allocators refer to the heap.
+    TLSFHeap(const TLSFHeap &) = delete;
+    TLSFHeap(TLSFHeap &&) = delete;
+    TLSFHeap &operator=(const TLSFHeap &) = delete;
+    TLSFHeap &operator=(TLSFHeap &&) = delete;
+
+    /// @brief Allocates bytes aligned to alignment, a power of two.
+    /// @return Allocated memory or nullptr if the pool is exhausted.
+    [[nodiscard]] void *allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t)) noexcept;
+
+    /// @brief Releases memory allocated from the heap, nullptr is ignored.
+    void deallocate(void *memory) noexcept;
+
+    /// @brief Get the occupancy of the heap, walks the free lists.
+    TLSFHeapStatistics statistics();
+
+    /// @brief Restarts the high water mark from the bytes used now, e.g. after the warm-up frames.
+    void resetHighWaterMark() noexcept;
+
+    /// @brief Get the size of the pool in bytes.
+    inline std::size_t capacity() const noexcept
+    {
+        return capacity_;
+    }
+
+    /// @brief Check if the pool is locked into RAM.
+    inline bool locked() const noexcept
+    {
+        return locked_;
+    }
+
+  private:
+    std::mutex mutex_;
+    tlsf_t tlsf_;
+
+    void *pool_;
+    std::size_t capacity_;
+    bool locked_;
+
+    std::size_t used_bytes_;
+    std::size_t high_water_mark_;
+    std::size_t live_allocations_;
+    std::size_t failed_allocations_;
+};
+
+/// @brief Fixed set of heaps shared out to the threads, so that concurrent allocations do not contend. A thread is
+/// assigned a heap on its first call of any set and keeps it, threads are spread round-robin over the heaps.
+class TLSFThreadHeaps final
+{
+  public:
+    /// @brief Deleted default constructor.
+    TLSFThreadHeaps() = delete;
+
+    /// @brief Non-default constructor, maps the pool of every heap.
+    /// @param number_of_heaps - Number of heaps, typically the number of allocating threads.
+    /// @param capacity - Size of the pool of every heap in bytes.
+    /// @param lock_memory - Commits the pools and locks them into RAM (mlock).
+    /// @throws std::runtime_error if number_of_heaps is 0 or a pool can not be mapped or locked.
+    TLSFThreadHeaps(std::size_t number_of_heaps, std::size_t capacity, bool lock_memory = false);
+
+    /// @brief Get the heap of the calling thread.
+    TLSFHeap &local() noexcept;
+
+    /// @brief Get the number of heaps.
+    inline std::size_t size() const noexcept
+    {
+        return heaps_.size();
+    }
+
+    /// @brief Get a heap by its index.
+    inline TLSFHeap &operator[](const std::size_t index) noexcept
+    {
+        return *heaps_[index];
+    }
+
+  private:
+    std::vector<std::unique_ptr<TLSFHeap>> heaps_;
+};
+
+/// @brief Stateful allocator handle of a TLSFHeap. Copies refer to the same heap and compare equal, allocators of
+/// different heaps do not, so containers propagate the allocator along with the memory. Default constructed
+/// allocators use TLSFHeap::defaultHeap(). The heap must outlive the allocators and their allocations.
 template <typename T> class TLSFAllocator
 {
   public:
@@ -25,30 +161,34 @@ template <typename T> class TLSFAllocator
     using const_reference = const T &;
     using size_type = std::size_t;
     using difference_type = std::ptrdiff_t;
+    using propagate_on_container_copy_assignment = std::true_type;
     using propagate_on_container_move_assignment = std::true_type;
-    using is_always_equal = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+    using is_always_equal = std::false_type;
 
     template <typename U> struct rebind
     {
         using other = TLSFAllocator<U>;
     };
 
-    TLSFAllocator() : tlsf_instance_{TLSF_INIT}
+    TLSFAllocator() : heap_{&TLSFHeap::defaultHeap()}
     {
     }
 
-    TLSFAllocator(const TLSFAllocator &other) : tlsf_instance_(other.tlsf_instance_)
+    explicit TLSFAllocator(TLSFHeap &heap) noexcept : heap_{&heap}
     {
     }
 
-    template <typename U> TLSFAllocator(const TLSFAllocator<U> &other) : tlsf_instance_(other.tlsf_instance_)
-    {
-    }
+    TLSFAllocator(const TLSFAllocator &other) noexcept = default;
 
-    ~TLSFAllocator()
+    template <typename U> TLSFAllocator(const TLSFAllocator<U> &other) noexcept : heap_{&other.heap()}
     {
     }
 
+    TLSFAllocator &operator=(const TLSFAllocator &other) noexcept = default;
+
+    ~TLSFAllocator() = default;
+
     [[nodiscard]] inline pointer address(reference x) const noexcept
     {
         return std::addressof(x);
@@ -59,29 +199,33 @@ template <typename T> class TLSFAllocator
         return std::addressof(x);
     }
 
+    /// @throws std::bad_alloc if the heap is exhausted.
     [[nodiscard]] pointer allocate(size_type n)
     {
-        if (n > 0)
+        if (n == 0U)
         {
-            void *memory = tlsf_malloc(&tlsf_instance_, n * sizeof(T));
-
-            if (nullptr == memory)
-            {
-                // Could not allocate memory
-                throw std::bad_alloc();
-            }
+            return nullptr;
+        }
 
-            return static_cast<pointer>(memory);
+        if (n > (std::numeric_limits<size_type>::max() / sizeof(T)))
+        {
+            throw std::bad_alloc();
         }
-        else
+
+        void *memory = heap_->allocate(n * sizeof(T), alignof(T));
+        if (nullptr == memory)
         {
-            return nullptr;
+            // Could not allocate memory
+            throw std::bad_alloc();
         }
+
+        return static_cast<pointer>(memory);
     }
 
-    inline void deallocate(pointer p, size_type n)
+    inline void deallocate(pointer p, size_type n) noexcept
     {
-        tlsf_free(&tlsf_instance_, p);
+        static_cast<void>(n);
+        heap_->deallocate(p);
     }
 
     template <typename U, typename... Args> inline void construct(U *p, Args &&...args)
@@ -99,20 +243,24 @@ template <typename T> class TLSFAllocator
         p->~U();
     }
 
-    [[nodiscard]] inline bool operator==(const TLSFAllocator &other) const noexcept
+    /// @brief Get the heap the allocator allocates from.
+    [[nodiscard]] inline TLSFHeap &heap() const noexcept
+    {
+        return *heap_;
+    }
+
+    template <typename U> [[nodiscard]] inline bool operator==(const TLSFAllocator<U> &other) const noexcept
     {
-        // assuming all instances of this allocator are interchangeable.
-        return true;
+        return (heap_ == &other.heap());
     }
 
-    [[nodiscard]] inline bool operator!=(const TLSFAllocator &other) const
+    template <typename U> [[nodiscard]] inline bool operator!=(const TLSFAllocator<U> &other) const noexcept
     {
-        // assuming all instances of this allocator are interchangeable.
-        return false;
+        return (heap_ != &other.heap());
     }
 
   private:
-    tlsf_t tlsf_instance_;
+    TLSFHeap *heap_;
 };
 } // namespace utilities_lib
 
@@ -0,0 +1,259 @@
+#include <utilities_lib/dataset_container.hpp>
+
+#include <algorithm> // std::lower_bound
+#include <cstring>   // std::memcmp, std::memcpy, std::strncpy, strnlen
+#include <stdexcept> // std::runtime_error
+
+#if defined(UTILITIES_LIB_WITH_LZ4)
+#include <lz4.h> // LZ4_compress_default, LZ4_decompress_safe
+#endif
+
+namespace utilities_lib
+{
+namespace
+{
+constexpr char DATASET_MAGIC[8] = {'L', 'C', 'F', 'P', 'A', 'C', 'K', '\0'};
+
+// Zeros written to pad the file to page boundaries
+constexpr char PADDING[DATASET_PAGE_SIZE] = {};
+
+// LZ4 expands a stored byte to at most this many bytes, larger sizes of compressed payloads are corrupt
+constexpr std::uint64_t MAX_COMPRESSION_RATIO = 255U;
+
+inline std::uint64_t alignToPage(const std::uint64_t offset) noexcept
+{
+    return (offset + (DATASET_PAGE_SIZE - 1U)) & ~static_cast<std::uint64_t>(DATASET_PAGE_SIZE - 1U);
+}
+} // namespace
+
+DatasetWriter::DatasetWriter(const std::filesystem::path &file_path, bool compress)
+    : file_{file_path, std::ios::binary | std::ios::trunc}, compress_{compress}, finished_{false}, offset_{0U}
+{
+    if (!file_.good())
+    {
+        throw std::runtime_error("Could not create the dataset " + file_path.string());
+    }
+
+    if (compress_ && !compressionSupported())
+    {
+        throw std::runtime_error("Dataset compression requires utilities_lib to be built with LZ4");
+    }
+
+    // The header page is written by finish
+    writePageAligned(PADDING, DATASET_PAGE_SIZE);
+}
+
+bool DatasetWriter::compressionSupported() noexcept
+{
+#if defined(UTILITIES_LIB_WITH_LZ4)
+    return true;
+#else
+    return false;
+#endif
+}
+
+std::size_t DatasetWriter::addStream(const std::string &name, DatasetPayload payload)
+{
+    if (name.size() >= DATASET_STREAM_NAME_SIZE)
+    {
+        throw std::runtime_error("Dataset stream name " + name + " is too long");
+    }
+
+    if (streams_.size() == DATASET_MAX_STREAMS)
+    {
+        throw std::runtime_error("Dataset can not hold more than " + std::to_string(DATASET_MAX_STREAMS) + " streams");
+    }
+
+    DatasetStream stream{};
+    std::strncpy(stream.name, name.c_str(), DATASET_STREAM_NAME_SIZE - 1U);
+    stream.payload = payload;
+
+    streams_.push_back(stream);
+    entries_.emplace_back();
+    return (streams_.size() - 1U);
+}
+
+void DatasetWriter::addEntry(std::size_t stream_index, std::int64_t timestamp, const void *payload, std::size_t size,
+                             std::uint32_t width, std::uint32_t height)
+{
+    if (finished_ || (stream_index >= streams_.size()))
+    {
+        throw std::runtime_error("Entry added to an invalid dataset stream");
+    }
+
+    auto &entries = entries_[stream_index];
+    if (!entries.empty() && (timestamp < entries.back().timestamp))
+    {
+        throw std::runtime_error("Dataset entries must be added in timestamp order");
+    }
+
+    DatasetEntry entry{timestamp, offset_, size, size, width, height};
+    const void *stored_payload = payload;
+
+#if defined(UTILITIES_LIB_WITH_LZ4)
+    // Payloads that do not shrink are stored as they are
+    if (compress_ && (size > 0U) && (size <= static_cast<std::size_t>(LZ4_MAX_INPUT_SIZE)))
+    {
+        compressed_payload_.resize(static_cast<std::size_t>(LZ4_compressBound(static_cast<int>(size))));
+        const int compressed_size =
+            LZ4_compress_default(static_cast<const char *>(payload), compressed_payload_.data(),
+                                 static_cast<int>(size), static_cast<int>(compressed_payload_.size()));
+        if ((compressed_size > 0) && (static_cast<std::size_t>(compressed_size) < size))
+        {
+            entry.stored_size = static_cast<std::uint64_t>(compressed_size);
+            stored_payload = compressed_payload_.data();
+        }
+    }
+#endif
+
+    writePageAligned(stored_payload, entry.stored_size);
+    entries.push_back(entry);
+}
+
+void DatasetWriter::finish()
+{
+    if (finished_)
+    {
+        return;
+    }
+
+    DatasetHeader header{};
+    std::memcpy(header.magic, DATASET_MAGIC, sizeof(DATASET_MAGIC));
+    header.version = DATASET_VERSION;
+    header.stream_count = static_cast<std::uint32_t>(streams_.size());
+
+    for (std::size_t i = 0U; i < streams_.size(); ++i)
+    {
+        streams_[i].entry_count = entries_[i].size();
+        streams_[i].index_offset = offset_;
+        writePageAligned(entries_[i].data(), entries_[i].size() * sizeof(DatasetEntry));
+        header.streams[i] = streams_[i];
+    }
+
+    file_.seekp(0);
+    file_.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file_.close();
+    finished_ = true;
+
+    if (file_.fail())
+    {
+        throw std::runtime_error("Could not write the dataset header");
+    }
+}
+
+void DatasetWriter::writePageAligned(const void *data, std::size_t size)
+{
+    const std::uint64_t next_offset = alignToPage(offset_ + size);
+    file_.write(static_cast<const char *>(data), static_cast<std::streamsize>(size));
+    file_.write(PADDING, static_cast<std::streamsize>(next_offset - offset_ - size));
+
+    if (!file_.good())
+    {
+        throw std::runtime_error("Could not write to the dataset");
+    }
+    offset_ = next_offset;
+}
+
+DatasetReader::DatasetReader(const std::filesystem::path &file_path) : header_{nullptr}
+{
+    // Streams are interleaved in the file and their entries are read by index, read-ahead of the neighbouring pages
+    // would read the entries of the other streams. Payloads are announced by prefetchPayload and readPayload instead
+    if (!file_.open(file_path, MappedFileAccess::RANDOM))
+    {
+        throw std::runtime_error("Could not map the dataset " + file_path.string());
+    }
+
+    // Mappings start on a page boundary, the header and the indexes are read in place
+    header_ = reinterpret_cast<const DatasetHeader *>(file_.data());
+    if ((file_.size() < DATASET_PAGE_SIZE) || (std::memcmp(header_->magic, DATASET_MAGIC, sizeof(DATASET_MAGIC)) != 0))
+    {
+        throw std::runtime_error(file_path.string() + " is not a complete dataset");
+    }
+
+    if ((header_->version != DATASET_VERSION) || (header_->stream_count > DATASET_MAX_STREAMS))
+    {
+        throw std::runtime_error("Unsupported dataset version " + std::to_string(header_->version));
+    }
+
+    indexes_.reserve(header_->stream_count);
+    for (std::size_t i = 0U; i < header_->stream_count; ++i)
+    {
+        const DatasetStream &stream = header_->streams[i];
+        if ((stream.index_offset > file_.size()) || ((stream.index_offset % DATASET_PAGE_SIZE) != 0U) ||
+            (stream.entry_count > ((file_.size() - stream.index_offset) / sizeof(DatasetEntry))))
+        {
+            throw std::runtime_error("Index of the dataset stream " + std::to_string(i) + " is outside of the file");
+        }
+        indexes_.push_back(reinterpret_cast<const DatasetEntry *>(file_.data() + stream.index_offset));
+    }
+}
+
+std::size_t DatasetReader::findStream(const std::string &name) const
+{
+    for (std::size_t i = 0U; i < streamCount(); ++i)
+    {
+        const char *stream_name = header_->streams[i].name;
+        if (std::string{stream_name, strnlen(stream_name, DATASET_STREAM_NAME_SIZE)} == name)
+        {
+            return i;
+        }
+    }
+
+    throw std::runtime_error("Dataset has no stream " + name);
+}
+
+std::size_t DatasetReader::seek(std::size_t stream_index, std::int64_t timestamp) const
+{
+    const DatasetEntry *first = indexes_[stream_index];
+    const DatasetEntry *last = first + entryCount(stream_index);
+    const DatasetEntry *found = std::lower_bound(
+        first, last, timestamp, [](const DatasetEntry &entry, std::int64_t value) { return entry.timestamp < value; });
+    return static_cast<std::size_t>(found - first);
+}
+
+void DatasetReader::validatePayload(const DatasetEntry &entry) const
+{
+    if ((entry.offset > file_.size()) || (entry.stored_size > (file_.size() - entry.offset)) ||
+        (entry.stored_size > entry.size))
+    {
+        throw std::runtime_error("Dataset payload is outside of the file");
+    }
+
+    if ((entry.stored_size < entry.size) && ((entry.size / MAX_COMPRESSION_RATIO) > entry.stored_size))
+    {
+        throw std::runtime_error("Size of the compressed dataset payload is corrupt");
+    }
+}
+
+void DatasetReader::readPayload(const DatasetEntry &entry, void *destination) const
+{
+    validatePayload(entry);
+
+    // Pages of the payload are requested at once instead of faulting them in one by one, unless already prefetched
+    file_.willNeed(entry.offset, entry.stored_size);
+
+    const std::byte *stored_payload = file_.data() + entry.offset;
+    if (entry.stored_size == entry.size)
+    {
+        std::memcpy(destination, stored_payload, entry.size);
+        return;
+    }
+
+#if defined(UTILITIES_LIB_WITH_LZ4)
+    const int decompressed_size =
+        LZ4_decompress_safe(reinterpret_cast<const char *>(stored_payload), static_cast<char *>(destination),
+                            static_cast<int>(entry.stored_size), static_cast<int>(entry.size));
+    if ((decompressed_size < 0) || (static_cast<std::uint64_t>(decompressed_size) != entry.size))
+    {
+        throw std::runtime_error("Could not decompress the dataset payload");
+    }
+#else
+    throw std::runtime_error("Dataset payload is compressed, utilities_lib was built without LZ4");
+#endif
+}
+
+void DatasetReader::prefetchPayload(const DatasetEntry &entry) const noexcept
+{
+    file_.willNeed(entry.offset, entry.stored_size);
+}
+} // namespace utilities_lib
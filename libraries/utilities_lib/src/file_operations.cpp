@@ -1,6 +1,6 @@
 #include <utilities_lib/file_operations.hpp>
 
-#include <algorithm> // std::sort
+#include <algorithm> // std::sort, std::min
 #include <cstring>   // std::memcpy
 #include <ctime>     // std::tm
 #include <fstream>   // std::ifstream
@@ -8,9 +8,104 @@
 #include <iostream>  // std::cout
 #include <sstream>   // std::stringstream
 #include <string>    // std::string
+#include <utility>   // std::swap
+
+// POSIX
+#include <fcntl.h>    // open
+#include <sys/mman.h> // mmap, munmap, madvise
+#include <sys/stat.h> // fstat
+#include <unistd.h>   // close, sysconf
 
 namespace utilities_lib
 {
+MappedFile::~MappedFile() noexcept
+{
+    close();
+}
+
+MappedFile::MappedFile(MappedFile &&other) noexcept : data_{other.data_}, size_{other.size_}
+{
+    other.data_ = nullptr;
+    other.size_ = 0U;
+}
+
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept
+{
+    if (this != &other)
+    {
+        close();
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+    }
+    return *this;
+}
+
+bool MappedFile::open(const std::filesystem::path &file_path, const MappedFileAccess access)
+{
+    close();
+
+    const int file_descriptor = ::open(file_path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (file_descriptor < 0)
+    {
+        return false;
+    }
+
+    struct stat file_status;
+    if ((::fstat(file_descriptor, &file_status) != 0) || (file_status.st_size <= 0))
+    {
+        ::close(file_descriptor);
+        return false;
+    }
+
+    // The mapping keeps its own reference to the file, the descriptor is not needed afterwards
+    const std::size_t file_size = static_cast<std::size_t>(file_status.st_size);
+    void *memory = ::mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+    ::close(file_descriptor);
+    if (memory == MAP_FAILED)
+    {
+        return false;
+    }
+
+    int advice = MADV_SEQUENTIAL;
+    if (access == MappedFileAccess::RANDOM)
+    {
+        advice = MADV_RANDOM;
+    }
+    else if (access == MappedFileAccess::WILL_NEED)
+    {
+        advice = MADV_WILLNEED;
+    }
+    static_cast<void>(::madvise(memory, file_size, advice));
+
+    data_ = static_cast<const std::byte *>(memory);
+    size_ = file_size;
+    return true;
+}
+
+void MappedFile::willNeed(const std::size_t offset, const std::size_t size) const noexcept
+{
+    if ((data_ == nullptr) || (offset >= size_))
+    {
+        return;
+    }
+
+    // The advised range has to start on a page boundary, mappings start on one
+    static const auto page_size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    const std::size_t first = offset - (offset % page_size);
+    const std::size_t last = offset + std::min(size, size_ - offset);
+    static_cast<void>(::madvise(const_cast<std::byte *>(data_) + first, last - first, MADV_WILLNEED));
+}
+
+void MappedFile::close() noexcept
+{
+    if (data_ != nullptr)
+    {
+        static_cast<void>(::munmap(const_cast<std::byte *>(data_), size_));
+        data_ = nullptr;
+        size_ = 0U;
+    }
+}
+
 void readFileNamesWithExtensionFromDirectory(const std::filesystem::path &data_path, const std::string &file_extension,
                                              std::vector<std::filesystem::path> &file_paths)
 {
@@ -73,6 +168,20 @@ void loadPointCloudDataFromBinFile(const std::filesystem::path &file_path,
     input_file.close();
 }
 
+void mapPointCloudDataFromBinFile(const std::filesystem::path &file_path, MappedFile &point_cloud)
+{
+    if (!point_cloud.open(file_path))
+    {
+        std::cerr << "Could not map the file: " << file_path << std::endl;
+        return;
+    }
+
+    if (point_cloud.size() % sizeof(data_types_lib::CartesianReturn) != 0)
+    {
+        std::cerr << "File size is not a multiple of point size, potential data misalignment." << std::endl;
+    }
+}
+
 void readTimestampsFromTxtFile(const std::filesystem::path &file_path, std::vector<std::int64_t> &timestamps)
 {
     // Clear cache
@@ -0,0 +1,97 @@
+#include <utilities_lib/frame_arena.hpp>
+
+#include <cstdint> // std::uintptr_t
+
+namespace utilities_lib
+{
+namespace
+{
+constexpr std::size_t REGION_ALIGNMENT = alignof(std::max_align_t);
+
+// Overflow blocks tracked without reallocating, a frame with more overflows reallocates the list once
+constexpr std::size_t RESERVED_OVERFLOW_BLOCKS = 64U;
+} // namespace
+
+FrameArena::FrameArena(std::size_t capacity, std::pmr::memory_resource *upstream)
+    : upstream_{upstream}, buffer_{nullptr}, capacity_{capacity}, offset_{0U}, overflow_bytes_{0U},
+      overflow_allocations_{0U}
+{
+    if (capacity_ > 0U)
+    {
+        buffer_ = static_cast<std::byte *>(upstream_->allocate(capacity_, REGION_ALIGNMENT));
+    }
+    overflow_blocks_.reserve(RESERVED_OVERFLOW_BLOCKS);
+}
+
+FrameArena::~FrameArena()
+{
+    releaseOverflowBlocks();
+    if (buffer_ != nullptr)
+    {
+        upstream_->deallocate(buffer_, capacity_, REGION_ALIGNMENT);
+    }
+}
+
+void FrameArena::reset()
+{
+    // The region grows to the peak of the frame, alignment padding of the overflowed allocations included
+    if (overflow_bytes_ > 0U)
+    {
+        const std::size_t new_capacity = offset_ + overflow_bytes_;
+        releaseOverflowBlocks();
+
+        if (buffer_ != nullptr)
+        {
+            upstream_->deallocate(buffer_, capacity_, REGION_ALIGNMENT);
+            buffer_ = nullptr;
+        }
+        buffer_ = static_cast<std::byte *>(upstream_->allocate(new_capacity, REGION_ALIGNMENT));
+        capacity_ = new_capacity;
+    }
+
+    offset_ = 0U;
+    overflow_bytes_ = 0U;
+}
+
+void *FrameArena::do_allocate(std::size_t bytes, std::size_t alignment)
+{
+    // Padding aligns the address, so alignments above the alignment of the region are honoured as well
+    const auto address = reinterpret_cast<std::uintptr_t>(buffer_) + offset_;
+    const std::size_t padding = static_cast<std::size_t>((alignment - (address % alignment)) % alignment);
+    if ((buffer_ != nullptr) && (padding <= (capacity_ - offset_)) && (bytes <= (capacity_ - offset_ - padding)))
+    {
+        offset_ += padding;
+        void *memory = buffer_ + offset_;
+        offset_ += bytes;
+        return memory;
+    }
+
+    void *memory = upstream_->allocate(bytes, alignment);
+    overflow_blocks_.push_back(OverflowBlock{memory, bytes, alignment});
+    overflow_bytes_ += bytes + alignment;
+    ++overflow_allocations_;
+    return memory;
+}
+
+void FrameArena::do_deallocate(void *memory, std::size_t bytes, std::size_t alignment)
+{
+    // Memory of the frame is released by reset
+    static_cast<void>(memory);
+    static_cast<void>(bytes);
+    static_cast<void>(alignment);
+}
+
+bool FrameArena::do_is_equal(const std::pmr::memory_resource &other) const noexcept
+{
+    return (this == &other);
+}
+
+void FrameArena::releaseOverflowBlocks() noexcept
+{
+    for (const auto &block : overflow_blocks_)
+    {
+        upstream_->deallocate(block.memory, block.bytes, block.alignment);
+    }
+    overflow_blocks_.clear();
+}
+} // namespace utilities_lib
@@ -0,0 +1,155 @@
+#include <utilities_lib/profiler.hpp>
+
+#include <algorithm> // std::max, std::max_element, std::nth_element
+#include <cstddef>   // std::ptrdiff_t
+#include <stdexcept> // std::runtime_error
+
+namespace utilities_lib
+{
+namespace
+{
+constexpr double NANOSECONDS_TO_MILLISECONDS = 1e-6;
+constexpr double NANOSECONDS_TO_MICROSECONDS = 1e-3;
+
+// Nearest-rank percentile of the samples, which are partially sorted in place
+double percentileMs(std::vector<std::int64_t> &durations, const std::size_t percent)
+{
+    const std::size_t rank = ((durations.size() * percent) + 99U) / 100U;
+    const auto nth = durations.begin() + static_cast<std::ptrdiff_t>(std::max<std::size_t>(rank, 1U) - 1U);
+    std::nth_element(durations.begin(), nth, durations.end());
+    return static_cast<double>(*nth) * NANOSECONDS_TO_MILLISECONDS;
+}
+} // namespace
+
+Profiler &Profiler::instance()
+{
+    static Profiler profiler;
+    return profiler;
+}
+
+Profiler::~Profiler()
+{
+    stopChromeTrace();
+}
+
+std::uint32_t Profiler::registerZone(const char *name)
+{
+    const std::lock_guard<std::mutex> lock(mutex_);
+    for (std::size_t zone = 0U; zone < zone_names_.size(); ++zone)
+    {
+        if (zone_names_[zone] == name)
+        {
+            return static_cast<std::uint32_t>(zone);
+        }
+    }
+
+    zone_names_.emplace_back(name);
+    zone_samples_.emplace_back();
+    zone_samples_.back().durations.reserve(SAMPLES_PER_ZONE);
+    return static_cast<std::uint32_t>(zone_names_.size() - 1U);
+}
+
+void Profiler::record(std::uint32_t zone, std::int64_t start, std::int64_t end)
+{
+    // Every thread produces into its own buffer, the collector is the single consumer
+    thread_local ThreadBuffer *thread_buffer = nullptr;
+    if (thread_buffer == nullptr)
+    {
+        thread_buffer = &createThreadBuffer();
+    }
+
+    if (!thread_buffer->events.tryPush(ProfileEvent{zone, thread_buffer->thread_index, start, end}))
+    {
+        dropped_events_.fetch_add(1U, std::memory_order_relaxed);
+    }
+}
+
+Profiler::ThreadBuffer &Profiler::createThreadBuffer()
+{
+    const std::lock_guard<std::mutex> lock(mutex_);
+    thread_buffers_.push_back(std::make_unique<ThreadBuffer>(static_cast<std::uint32_t>(thread_buffers_.size())));
+    return *thread_buffers_.back();
+}
+
+void Profiler::collect()
+{
+    const std::lock_guard<std::mutex> lock(mutex_);
+    ProfileEvent event{};
+    for (const auto &thread_buffer : thread_buffers_)
+    {
+        while (thread_buffer->events.tryPop(event))
+        {
+            ZoneSamples &samples = zone_samples_[event.zone];
+            const std::int64_t duration = event.end - event.start;
+            if (samples.durations.size() < SAMPLES_PER_ZONE)
+            {
+                samples.durations.push_back(duration);
+            }
+            else
+            {
+                samples.durations[samples.next] = duration;
+            }
+            samples.next = (samples.next + 1U) % SAMPLES_PER_ZONE;
+            ++samples.count;
+
+            // Complete events, timestamps and durations in microseconds
+            if (chrome_trace_.is_open())
+            {
+                chrome_trace_ << (chrome_trace_empty_ ? "\n" : ",\n") << "{\"name\":\"" << zone_names_[event.zone]
+                              << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << event.thread
+                              << ",\"ts\":" << (static_cast<double>(event.start) * NANOSECONDS_TO_MICROSECONDS)
+                              << ",\"dur\":" << (static_cast<double>(duration) * NANOSECONDS_TO_MICROSECONDS) << "}";
+                chrome_trace_empty_ = false;
+            }
+        }
+    }
+}
+
+std::vector<ProfileZoneStatistics> Profiler::statistics()
+{
+    const std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<ProfileZoneStatistics> zone_statistics;
+    for (std::size_t zone = 0U; zone < zone_samples_.size(); ++zone)
+    {
+        const ZoneSamples &samples = zone_samples_[zone];
+        if (samples.durations.empty())
+        {
+            continue;
+        }
+
+        sorted_durations_.assign(samples.durations.begin(), samples.durations.end());
+        const double max_ms =
+            static_cast<double>(*std::max_element(sorted_durations_.begin(), sorted_durations_.end())) *
+            NANOSECONDS_TO_MILLISECONDS;
+        const double p99_ms = percentileMs(sorted_durations_, 99U);
+        const double p50_ms = percentileMs(sorted_durations_, 50U);
+        zone_statistics.push_back({zone_names_[zone], samples.count, p50_ms, p99_ms, max_ms});
+    }
+    return zone_statistics;
+}
+
+void Profiler::startChromeTrace(const std::filesystem::path &file_path)
+{
+    stopChromeTrace();
+
+    const std::lock_guard<std::mutex> lock(mutex_);
+    chrome_trace_.open(file_path, std::ios::trunc);
+    if (!chrome_trace_.good())
+    {
+        chrome_trace_.close();
+        throw std::runtime_error("Could not create the Chrome trace " + file_path.string());
+    }
+    chrome_trace_ << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    chrome_trace_empty_ = true;
+}
+
+void Profiler::stopChromeTrace()
+{
+    const std::lock_guard<std::mutex> lock(mutex_);
+    if (chrome_trace_.is_open())
+    {
+        chrome_trace_ << "\n]}\n";
+        chrome_trace_.close();
+    }
+}
+} // namespace utilities_lib
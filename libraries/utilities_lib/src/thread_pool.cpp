@@ -1,31 +1,54 @@
 #include <utilities_lib/thread_pool.hpp>
 
+#if defined(__linux__)
+#include <pthread.h> // pthread_setaffinity_np
+#include <sched.h>   // cpu_set_t
+#endif
+
 namespace utilities_lib
 {
-ThreadPool::ThreadPool(std::size_t number_of_threads) : stop_(false)
+namespace
 {
-    for (std::size_t i = 0U; i < number_of_threads; ++i)
+// Pool and deque of the calling thread when it is a worker
+thread_local const ThreadPool *current_pool = nullptr;
+thread_local std::size_t current_worker = 0U;
+
+void pinCurrentThread(const std::size_t worker_index)
+{
+#if defined(__linux__)
+    const unsigned int number_of_cores = std::thread::hardware_concurrency();
+    if (number_of_cores == 0U)
     {
-        threads_.emplace_back([this]() {
-            while (true)
-            {
-                std::packaged_task<void()> task;
-                {
-                    std::unique_lock<std::mutex> lock(mutex_);
+        return;
+    }
 
-                    condition_variable_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    CPU_SET(worker_index % number_of_cores, &cpu_set);
 
-                    if (stop_)
-                    {
-                        return;
-                    }
+    // Best effort, the worker keeps running unpinned where the affinity can not be set (e.g. restricted cpusets)
+    static_cast<void>(pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set));
+#else
+    static_cast<void>(worker_index);
+#endif
+}
+} // namespace
 
-                    task = std::move(tasks_.front());
-                    tasks_.pop();
-                }
+ThreadPool::ThreadPool(std::size_t number_of_threads, bool pin_threads)
+    : number_of_queues_{(number_of_threads > 0U) ? number_of_threads : 1U}, next_queue_{0U}, pending_tasks_{0U},
+      sleeping_threads_{0U}, stop_{false}
+{
+    // Without workers the tasks are run by the threads waiting for them
+    queues_ = std::make_unique<WorkerQueue[]>(number_of_queues_);
 
-                task();
+    for (std::size_t i = 0U; i < number_of_threads; ++i)
+    {
+        threads_.emplace_back([this, i, pin_threads]() {
+            if (pin_threads)
+            {
+                pinCurrentThread(i);
             }
+            workerLoop(i);
         });
     }
 }
@@ -43,4 +66,91 @@ ThreadPool::~ThreadPool()
         thread.join();
     }
 }
+
+void ThreadPool::push(Task &&task)
+{
+    const std::size_t queue_index = (current_pool == this)
+                                        ? current_worker
+                                        : (next_queue_.fetch_add(1U, std::memory_order_relaxed) % number_of_queues_);
+
+    // Counted before it is queued, a worker may take it right away
+    pending_tasks_.fetch_add(1U);
+    {
+        const std::lock_guard<std::mutex> lock(queues_[queue_index].mutex);
+        queues_[queue_index].tasks.pushBack(std::move(task));
+    }
+
+    // The counters are sequentially consistent, either the sleeping worker is seen or it sees the pending task
+    if (sleeping_threads_.load() > 0U)
+    {
+        {
+            const std::lock_guard<std::mutex> lock(mutex_);
+        }
+        condition_variable_.notify_one();
+    }
+}
+
+bool ThreadPool::tryTake(const std::size_t first_queue, const bool is_owner, Task &task)
+{
+    for (std::size_t offset = 0U; offset < number_of_queues_; ++offset)
+    {
+        WorkerQueue &queue = queues_[(first_queue + offset) % number_of_queues_];
+        const std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty())
+        {
+            continue;
+        }
+
+        // The owner continues with its most recent task, which is likely still in its cache
+        task = (is_owner && (offset == 0U)) ? queue.tasks.popBack() : queue.tasks.popFront();
+
+        pending_tasks_.fetch_sub(1U);
+        return true;
+    }
+
+    return false;
+}
+
+bool ThreadPool::runPendingTask()
+{
+    const bool is_worker = (current_pool == this);
+    const std::size_t first_queue =
+        is_worker ? current_worker : (next_queue_.load(std::memory_order_relaxed) % number_of_queues_);
+
+    Task task;
+    if (!tryTake(first_queue, is_worker, task))
+    {
+        return false;
+    }
+
+    task();
+    return true;
+}
+
+void ThreadPool::workerLoop(const std::size_t worker_index)
+{
+    current_pool = this;
+    current_worker = worker_index;
+
+    while (true)
+    {
+        Task task;
+        if (tryTake(worker_index, true, task))
+        {
+            task();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        sleeping_threads_.fetch_add(1U);
+        condition_variable_.wait(lock, [this] { return stop_ || (pending_tasks_.load() > 0U); });
+        sleeping_threads_.fetch_sub(1U);
+
+        // Queued tasks are run before the worker stops
+        if (stop_ && (pending_tasks_.load() == 0U))
+        {
+            return;
+        }
+    }
+}
 } // namespace utilities_lib
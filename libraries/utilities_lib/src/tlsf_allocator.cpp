@@ -0,0 +1,146 @@
+#include <utilities_lib/tlsf_allocator.hpp>
+
+#include <sys/mman.h> // mmap, mlock, munmap
+
+#include <atomic>    // std::atomic
+#include <stdexcept> // std::runtime_error
+#include <string>    // std::to_string
+
+namespace utilities_lib
+{
+namespace
+{
+// Alignment of every TLSF block, larger alignments take the aligned allocation path
+constexpr std::size_t TLSF_ALIGNMENT = sizeof(std::size_t);
+
+// Index of the calling thread, counted over the process
+std::size_t threadIndex() noexcept
+{
+    static std::atomic<std::size_t> next_thread_index{0U};
+    thread_local const std::size_t thread_index = next_thread_index.fetch_add(1U, std::memory_order_relaxed);
+    return thread_index;
+}
+} // namespace
+
+TLSFHeap &TLSFHeap::defaultHeap()
+{
+    // Never destroyed, containers of static storage may release their memory during exit
+    static TLSFHeap *const heap = new TLSFHeap{DEFAULT_CAPACITY};
+    return *heap;
+}
+
+TLSFHeap::TLSFHeap(std::size_t capacity, bool lock_memory)
+    : tlsf_{}, pool_{nullptr}, capacity_{capacity}, locked_{false}, used_bytes_{0U}, high_water_mark_{0U},
+      live_allocations_{0U}, failed_allocations_{0U}
+{
+    if (capacity_ == 0U)
+    {
+        throw std::runtime_error("TLSF heap capacity must be greater than 0");
+    }
+
+    // Unlocked pools only reserve the address space, locked pools are committed up front
+    const int flags = MAP_PRIVATE | MAP_ANONYMOUS | (lock_memory ? MAP_POPULATE : MAP_NORESERVE);
+    pool_ = mmap(nullptr, capacity_, PROT_READ | PROT_WRITE, flags, -1, 0);
+    if (pool_ == MAP_FAILED)
+    {
+        throw std::runtime_error("Could not map the TLSF pool of " + std::to_string(capacity_) + " bytes");
+    }
+
+    if (lock_memory)
+    {
+        if (mlock(pool_, capacity_) != 0)
+        {
+            munmap(pool_, capacity_);
+            throw std::runtime_error("Could not lock the TLSF pool of " + std::to_string(capacity_) +
+                                     " bytes, check RLIMIT_MEMLOCK");
+        }
+        locked_ = true;
+    }
+
+    tlsf_.pool = pool_;
+    tlsf_.capacity = capacity_;
+}
+
+TLSFHeap::~TLSFHeap()
+{
+    // Unmapping unlocks the pages as well
+    munmap(pool_, capacity_);
+}
+
+void *TLSFHeap::allocate(std::size_t bytes, std::size_t alignment) noexcept
+{
+    // Aligned blocks are sized in whole alignments
+    const std::size_t size = (bytes == 0U) ? 1U : bytes;
+    const std::lock_guard<std::mutex> lock(mutex_);
+    void *memory = (alignment <= TLSF_ALIGNMENT)
+                       ? tlsf_malloc(&tlsf_, size)
+                       : tlsf_aalloc(&tlsf_, alignment, ((size + alignment - 1U) / alignment) * alignment);
+
+    if (memory == nullptr)
+    {
+        ++failed_allocations_;
+        return nullptr;
+    }
+
+    used_bytes_ += tlsf_usable_size(memory);
+    high_water_mark_ = (used_bytes_ > high_water_mark_) ? used_bytes_ : high_water_mark_;
+    ++live_allocations_;
+    return memory;
+}
+
+void TLSFHeap::deallocate(void *memory) noexcept
+{
+    if (memory == nullptr)
+    {
+        return;
+    }
+
+    const std::lock_guard<std::mutex> lock(mutex_);
+    used_bytes_ -= tlsf_usable_size(memory);
+    --live_allocations_;
+    tlsf_free(&tlsf_, memory);
+}
+
+TLSFHeapStatistics TLSFHeap::statistics()
+{
+    const std::lock_guard<std::mutex> lock(mutex_);
+    TLSFHeapStatistics statistics{};
+    statistics.capacity = capacity_;
+    statistics.used_bytes = used_bytes_;
+    statistics.high_water_mark = high_water_mark_;
+    statistics.live_allocations = live_allocations_;
+    statistics.failed_allocations = failed_allocations_;
+
+    tlsf_free_statistics(&tlsf_, &statistics.free_bytes, &statistics.largest_free_block);
+    statistics.fragmentation =
+        (statistics.free_bytes > 0U)
+            ? (1.0 - (static_cast<double>(statistics.largest_free_block) / static_cast<double>(statistics.free_bytes)))
+            : 0.0;
+    return statistics;
+}
+
+void TLSFHeap::resetHighWaterMark() noexcept
+{
+    const std::lock_guard<std::mutex> lock(mutex_);
+    high_water_mark_ = used_bytes_;
+}
+
+TLSFThreadHeaps::TLSFThreadHeaps(std::size_t number_of_heaps, std::size_t capacity, bool lock_memory)
+{
+    if (number_of_heaps == 0U)
+    {
+        throw std::runtime_error("Number of TLSF heaps must be greater than 0");
+    }
+
+    heaps_.reserve(number_of_heaps);
+    for (std::size_t i = 0U; i < number_of_heaps; ++i)
+    {
+        heaps_.push_back(std::make_unique<TLSFHeap>(capacity, lock_memory));
+    }
+}
+
+TLSFHeap &TLSFThreadHeaps::local() noexcept
+{
+    return *heaps_[threadIndex() % heaps_.size()];
+}
+} // namespace utilities_lib
@@ -0,0 +1,198 @@
+#include <utilities_lib/dataset_container.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>  // std::generate
+#include <cstdint>    // std::uint8_t
+#include <filesystem> // std::filesystem
+#include <fstream>    // std::ofstream
+#include <stdexcept>  // std::runtime_error
+#include <vector>     // std::vector
+
+using namespace utilities_lib;
+
+namespace
+{
+std::filesystem::path datasetPath(const std::string &file_name)
+{
+    return std::filesystem::temp_directory_path() / file_name;
+}
+
+std::vector<std::uint8_t> makePayload(const std::size_t size, const std::uint8_t seed)
+{
+    // Written through the iterators of the sized buffer, GCC reported the indexed stores as overflows
+    // (-Wstringop-overflow)
+    std::vector<std::uint8_t> payload(size);
+    std::size_t i = 0U;
+    std::generate(payload.begin(), payload.end(),
+                  [&i, seed]() { return static_cast<std::uint8_t>((i++ / 64U) + seed); });
+    return payload;
+}
+
+void writeDataset(const std::filesystem::path &file_path, const bool compress)
+{
+    DatasetWriter writer{file_path, compress};
+    const std::size_t lidar = writer.addStream("lidar", DatasetPayload::POINT_CLOUD);
+    const std::size_t camera = writer.addStream("camera_1", DatasetPayload::IMAGE_BGR8);
+
+    for (std::uint8_t i = 0U; i < 5U; ++i)
+    {
+        const auto points = makePayload(1600U + i, i);
+        writer.addEntry(lidar, 100 * i, points.data(), points.size(), 100U, 1U);
+
+        const auto pixels = makePayload(4U * 3U * 2U, i);
+        writer.addEntry(camera, (100 * i) + 50, pixels.data(), pixels.size(), 4U, 2U);
+    }
+    writer.finish();
+}
+
+void expectDatasetContents(const DatasetReader &reader)
+{
+    ASSERT_EQ(reader.streamCount(), 2U);
+    const std::size_t lidar = reader.findStream("lidar");
+    const std::size_t camera = reader.findStream("camera_1");
+    EXPECT_EQ(reader.stream(lidar).payload, DatasetPayload::POINT_CLOUD);
+    EXPECT_EQ(reader.stream(camera).payload, DatasetPayload::IMAGE_BGR8);
+    ASSERT_EQ(reader.entryCount(lidar), 5U);
+    ASSERT_EQ(reader.entryCount(camera), 5U);
+
+    for (std::uint8_t i = 0U; i < 5U; ++i)
+    {
+        const DatasetEntry &entry = reader.entry(lidar, i);
+        EXPECT_EQ(entry.timestamp, 100 * i);
+        EXPECT_EQ(entry.offset % DATASET_PAGE_SIZE, 0U);
+
+        std::vector<std::uint8_t> points(entry.size);
+        reader.readPayload(entry, points.data());
+        EXPECT_EQ(points, makePayload(1600U + i, i));
+
+        const DatasetEntry &image_entry = reader.entry(camera, i);
+        EXPECT_EQ(image_entry.width, 4U);
+        EXPECT_EQ(image_entry.height, 2U);
+
+        std::vector<std::uint8_t> pixels(image_entry.size);
+        reader.readPayload(image_entry, pixels.data());
+        EXPECT_EQ(pixels, makePayload(4U * 3U * 2U, i));
+    }
+}
+} // namespace
+
+// Test payloads and indexes are read back
+TEST(DatasetContainerTest, RoundTrip)
+{
+    const auto file_path = datasetPath("utilities_lib_test_dataset.pack");
+    writeDataset(file_path, false);
+
+    const DatasetReader reader{file_path};
+    expectDatasetContents(reader);
+    EXPECT_THROW(reader.findStream("camera_2"), std::runtime_error);
+
+    std::filesystem::remove(file_path);
+}
+
+// Test compressed payloads are read back and stored in fewer bytes
+TEST(DatasetContainerTest, CompressedRoundTrip)
+{
+    const auto file_path = datasetPath("utilities_lib_test_dataset_lz4.pack");
+    if (!DatasetWriter::compressionSupported())
+    {
+        EXPECT_THROW(DatasetWriter(file_path, true), std::runtime_error);
+        std::filesystem::remove(file_path);
+        GTEST_SKIP() << "utilities_lib was built without LZ4";
+    }
+
+    writeDataset(file_path, true);
+
+    const DatasetReader reader{file_path};
+    expectDatasetContents(reader);
+
+    const DatasetEntry &entry = reader.entry(reader.findStream("lidar"), 0U);
+    EXPECT_LT(entry.stored_size, entry.size);
+
+    std::filesystem::remove(file_path);
+}
+
+// Test seeking by timestamp
+TEST(DatasetContainerTest, Seek)
+{
+    const auto file_path = datasetPath("utilities_lib_test_dataset_seek.pack");
+    writeDataset(file_path, false);
+
+    const DatasetReader reader{file_path};
+    const std::size_t lidar = reader.findStream("lidar");
+    EXPECT_EQ(reader.seek(lidar, -1), 0U);
+    EXPECT_EQ(reader.seek(lidar, 100), 1U);
+    EXPECT_EQ(reader.seek(lidar, 101), 2U);
+    EXPECT_EQ(reader.seek(lidar, 1000), reader.entryCount(lidar));
+
+    std::filesystem::remove(file_path);
+}
+
+// Test entries must be added in timestamp order
+TEST(DatasetContainerTest, UnorderedEntries)
+{
+    const auto file_path = datasetPath("utilities_lib_test_dataset_order.pack");
+    DatasetWriter writer{file_path, false};
+    const std::size_t lidar = writer.addStream("lidar", DatasetPayload::POINT_CLOUD);
+
+    const auto points = makePayload(16U, 0U);
+    writer.addEntry(lidar, 100, points.data(), points.size(), 1U, 1U);
+    EXPECT_THROW(writer.addEntry(lidar, 50, points.data(), points.size(), 1U, 1U), std::runtime_error);
+    EXPECT_THROW(writer.addEntry(lidar + 1U, 200, points.data(), points.size(), 1U, 1U), std::runtime_error);
+
+    std::filesystem::remove(file_path);
+}
+
+// Test unfinished and foreign files are rejected
+TEST(DatasetContainerTest, InvalidFiles)
+{
+    const auto unfinished_path = datasetPath("utilities_lib_test_dataset_unfinished.pack");
+    {
+        DatasetWriter writer{unfinished_path, false};
+        const std::size_t lidar = writer.addStream("lidar", DatasetPayload::POINT_CLOUD);
+        const auto points = makePayload(16U, 0U);
+        writer.addEntry(lidar, 0, points.data(), points.size(), 1U, 1U);
+    }
+    EXPECT_THROW(DatasetReader{unfinished_path}, std::runtime_error);
+
+    const auto foreign_path = datasetPath("utilities_lib_test_dataset_foreign.pack");
+    {
+        std::ofstream foreign_file{foreign_path, std::ios::binary};
+        foreign_file << "2011-09-26 13:02:25.964389445";
+    }
+    EXPECT_THROW(DatasetReader{foreign_path}, std::runtime_error);
+    EXPECT_THROW(DatasetReader{datasetPath("utilities_lib_test_dataset_missing.pack")}, std::runtime_error);
+
+    std::filesystem::remove(unfinished_path);
+    std::filesystem::remove(foreign_path);
+}
+
+// Test entries with payloads outside of the file or corrupt sizes are rejected before they are read
+TEST(DatasetContainerTest, CorruptEntries)
+{
+    const auto file_path = datasetPath("utilities_lib_test_dataset_corrupt.pack");
+    writeDataset(file_path, false);
+
+    const DatasetReader reader{file_path};
+    const DatasetEntry &entry = reader.entry(reader.findStream("lidar"), 0U);
+    EXPECT_NO_THROW(reader.validatePayload(entry));
+
+    DatasetEntry outside_entry = entry;
+    outside_entry.offset = std::filesystem::file_size(file_path);
+    outside_entry.stored_size = 1U;
+    outside_entry.size = 1U;
+    EXPECT_THROW(reader.validatePayload(outside_entry), std::runtime_error);
+
+    DatasetEntry truncated_entry = entry;
+    truncated_entry.stored_size = entry.size + 1U;
+    EXPECT_THROW(reader.validatePayload(truncated_entry), std::runtime_error);
+
+    // A compressed payload can not expand to an arbitrary size
+    DatasetEntry oversized_entry = entry;
+    oversized_entry.size = entry.stored_size * 1000U;
+    EXPECT_THROW(reader.validatePayload(oversized_entry), std::runtime_error);
+    std::vector<std::uint8_t> points(entry.size);
+    EXPECT_THROW(reader.readPayload(oversized_entry, points.data()), std::runtime_error);
+
+    std::filesystem::remove(file_path);
+}
@@ -0,0 +1,106 @@
+#include <utilities_lib/file_operations.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstring>    // std::memcmp
+#include <filesystem> // std::filesystem
+#include <fstream>    // std::ofstream
+#include <utility>    // std::move
+#include <vector>     // std::vector
+
+using namespace utilities_lib;
+
+namespace
+{
+std::filesystem::path writePointCloudFile(const std::string &file_name,
+                                          const std::vector<data_types_lib::CartesianReturn> &points)
+{
+    const auto file_path = std::filesystem::temp_directory_path() / file_name;
+    std::ofstream output_file{file_path, std::ios::binary};
+    output_file.write(reinterpret_cast<const char *>(points.data()),
+                      static_cast<std::streamsize>(points.size() * sizeof(data_types_lib::CartesianReturn)));
+    return file_path;
+}
+} // namespace
+
+// Test the mapping matches the loaded points
+TEST(FileOperationsTest, MapPointCloudMatchesLoad)
+{
+    std::vector<data_types_lib::CartesianReturn> points(100U);
+    for (std::size_t i = 0U; i < points.size(); ++i)
+    {
+        points[i].x = static_cast<float>(i);
+        points[i].y = -static_cast<float>(i);
+        points[i].z = 0.5F * static_cast<float>(i);
+        points[i].intensity = 0.25F;
+    }
+    const auto file_path = writePointCloudFile("utilities_lib_test_cloud.bin", points);
+
+    std::vector<data_types_lib::CartesianReturn> loaded_points;
+    loadPointCloudDataFromBinFile(file_path, loaded_points);
+
+    MappedFile mapped_points;
+    mapPointCloudDataFromBinFile(file_path, mapped_points);
+
+    ASSERT_EQ(mapped_points.size(), points.size() * sizeof(data_types_lib::CartesianReturn));
+    ASSERT_EQ(loaded_points.size(), points.size());
+    EXPECT_EQ(std::memcmp(mapped_points.data(), loaded_points.data(), mapped_points.size()), 0);
+
+    std::filesystem::remove(file_path);
+}
+
+// Test missing files leave the mapping empty
+TEST(FileOperationsTest, MapMissingFile)
+{
+    MappedFile mapped_file;
+    EXPECT_FALSE(mapped_file.open(std::filesystem::temp_directory_path() / "utilities_lib_missing_file.bin"));
+    EXPECT_TRUE(mapped_file.empty());
+    EXPECT_EQ(mapped_file.data(), nullptr);
+}
+
+// Test moving and closing the mapping
+TEST(FileOperationsTest, MoveAndClose)
+{
+    const auto file_path = writePointCloudFile("utilities_lib_test_move.bin", {data_types_lib::CartesianReturn{}});
+
+    MappedFile mapped_file;
+    ASSERT_TRUE(mapped_file.open(file_path));
+
+    MappedFile moved_file{std::move(mapped_file)};
+    EXPECT_TRUE(mapped_file.empty());
+    EXPECT_EQ(moved_file.size(), sizeof(data_types_lib::CartesianReturn));
+
+    moved_file.close();
+    EXPECT_TRUE(moved_file.empty());
+
+    std::filesystem::remove(file_path);
+}
+
+// Test every access advice maps the same bytes, and advised ranges are clamped to the mapping
+TEST(FileOperationsTest, AccessAdvice)
+{
+    std::vector<data_types_lib::CartesianReturn> points(5000U);
+    for (std::size_t i = 0U; i < points.size(); ++i)
+    {
+        points[i].x = static_cast<float>(i);
+    }
+    const auto file_path = writePointCloudFile("utilities_lib_test_advice.bin", points);
+
+    for (const auto access : {MappedFileAccess::SEQUENTIAL, MappedFileAccess::RANDOM, MappedFileAccess::WILL_NEED})
+    {
+        MappedFile mapped_file;
+        ASSERT_TRUE(mapped_file.open(file_path, access));
+        ASSERT_EQ(mapped_file.size(), points.size() * sizeof(data_types_lib::CartesianReturn));
+
+        mapped_file.willNeed(4097U, 100U);
+        mapped_file.willNeed(mapped_file.size() - 1U, 4096U);
+        mapped_file.willNeed(mapped_file.size(), 1U);
+        EXPECT_EQ(std::memcmp(mapped_file.data(), points.data(), mapped_file.size()), 0);
+    }
+
+    MappedFile empty_file;
+    empty_file.willNeed(0U, 1U);
+    EXPECT_TRUE(empty_file.empty());
+
+    std::filesystem::remove(file_path);
+}
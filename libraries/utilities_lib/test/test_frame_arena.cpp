@@ -0,0 +1,130 @@
+#include <utilities_lib/frame_arena.hpp>
+#include <utilities_lib/thread_pool.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <memory_resource>
+#include <new>
+
+using namespace utilities_lib;
+
+// Allocation counter hook, every allocation of the test binary goes through the replaced operator new
+namespace
+{
+std::atomic<std::size_t> heap_allocations{0U};
+} // namespace
+
+void *operator new(std::size_t size)
+{
+    ++heap_allocations;
+    if (void *memory = std::malloc((size > 0U) ? size : 1U))
+    {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void *memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+// Test allocations within the capacity
+TEST(FrameArenaTest, AllocateWithinCapacity)
+{
+    FrameArena arena(1024U);
+    EXPECT_EQ(arena.capacity(), 1024U);
+    EXPECT_EQ(arena.used(), 0U);
+
+    void *first = arena.allocate(100U, 4U);
+    void *second = arena.allocate(100U, 64U);
+    EXPECT_NE(first, nullptr);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(second) % 64U, 0U);
+    EXPECT_GE(arena.used(), 200U);
+    EXPECT_EQ(arena.overflowAllocations(), 0U);
+}
+
+// Test reset, the memory of the previous frame is reused
+TEST(FrameArenaTest, Reset)
+{
+    FrameArena arena(1024U);
+    void *first = arena.allocate(100U, 8U);
+    arena.deallocate(first, 100U, 8U);
+
+    arena.reset();
+    EXPECT_EQ(arena.used(), 0U);
+    EXPECT_EQ(arena.allocate(100U, 8U), first);
+}
+
+// Test overflow, the region grows to the peak of the overflowed frame
+TEST(FrameArenaTest, OverflowGrowsRegion)
+{
+    FrameArena arena(256U);
+    EXPECT_NE(arena.allocate(200U, 8U), nullptr);
+    EXPECT_NE(arena.allocate(200U, 8U), nullptr);
+    EXPECT_EQ(arena.overflowAllocations(), 1U);
+
+    arena.reset();
+    EXPECT_GE(arena.capacity(), 400U);
+
+    EXPECT_NE(arena.allocate(200U, 8U), nullptr);
+    EXPECT_NE(arena.allocate(200U, 8U), nullptr);
+    EXPECT_EQ(arena.overflowAllocations(), 1U);
+}
+
+// Test the steady state of per-frame std::pmr containers, no heap allocation after the first frame
+TEST(FrameArenaTest, SteadyStateWithoutHeapAllocations)
+{
+    FrameArena arena(64U);
+
+    std::size_t allocations_after_first_frame = 0U;
+    for (int frame = 0; frame < 10; ++frame)
+    {
+        arena.reset();
+        {
+            std::pmr::vector<float> points{&arena};
+            std::pmr::vector<std::uint32_t> indices{&arena};
+            for (int i = 0; i < 1000; ++i)
+            {
+                points.push_back(static_cast<float>(i));
+                indices.push_back(static_cast<std::uint32_t>(i));
+            }
+        }
+
+        if (frame == 0)
+        {
+            allocations_after_first_frame = heap_allocations.load();
+        }
+    }
+
+    EXPECT_EQ(heap_allocations.load(), allocations_after_first_frame);
+}
+
+// Test the steady state of the grouped thread pool tasks, queueing does not allocate
+TEST(FrameArenaTest, ThreadPoolTasksWithoutHeapAllocations)
+{
+    ThreadPool pool(2);
+    std::atomic<int> counter = 0;
+
+    const auto runFrame = [&pool, &counter]() {
+        pool.parallelFor(0U, 64U, 1U, [&counter](std::size_t, std::size_t) { counter++; });
+    };
+
+    runFrame();
+    const std::size_t allocations_after_first_frame = heap_allocations.load();
+    for (int frame = 0; frame < 10; ++frame)
+    {
+        runFrame();
+    }
+
+    EXPECT_EQ(heap_allocations.load(), allocations_after_first_frame);
+    EXPECT_EQ(counter, 11 * 64);
+}
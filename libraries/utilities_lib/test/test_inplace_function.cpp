@@ -0,0 +1,92 @@
+#include <utilities_lib/inplace_function.hpp>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <future>
+#include <memory>
+
+using namespace utilities_lib;
+
+// Test default constructor
+TEST(InplaceFunctionTest, DefaultConstructor)
+{
+    InplaceFunction<void()> function;
+    EXPECT_FALSE(function);
+    EXPECT_THROW(function(), std::bad_function_call);
+}
+
+// Test invocation with arguments and return value
+TEST(InplaceFunctionTest, Invoke)
+{
+    const int offset = 2;
+    InplaceFunction<int(int, int)> function = [offset](int a, int b) { return a + b + offset; };
+    EXPECT_TRUE(function);
+    EXPECT_EQ(function(3, 4), 9);
+}
+
+// Test move-only callables
+TEST(InplaceFunctionTest, MoveOnlyCallable)
+{
+    auto value = std::make_unique<int>(42);
+    InplaceFunction<int()> function = [value = std::move(value)]() { return *value; };
+    EXPECT_EQ(function(), 42);
+
+    std::packaged_task<int()> task([]() { return 7; });
+    std::future<int> future = task.get_future();
+    InplaceFunction<void()> task_function = std::move(task);
+    task_function();
+    EXPECT_EQ(future.get(), 7);
+}
+
+// Test move construction and assignment, the moved from function is left empty
+TEST(InplaceFunctionTest, Move)
+{
+    InplaceFunction<int()> function = []() { return 1; };
+    InplaceFunction<int()> moved_function = std::move(function);
+    EXPECT_FALSE(function);
+    EXPECT_EQ(moved_function(), 1);
+
+    function = []() { return 2; };
+    moved_function = std::move(function);
+    EXPECT_FALSE(function);
+    EXPECT_EQ(moved_function(), 2);
+}
+
+// Test storage of small and large callables
+TEST(InplaceFunctionTest, Storage)
+{
+    using Function = InplaceFunction<int(), 32U>;
+
+    const std::array<int, 4> small_array{1, 2, 3, 4};
+    auto small_callable = [small_array]() { return small_array[3]; };
+    EXPECT_TRUE(Function::storesInline<decltype(small_callable)>());
+
+    // Larger captures are moved to the heap
+    const std::array<int, 64> large_array{1};
+    auto large_callable = [large_array]() { return large_array[0]; };
+    EXPECT_FALSE(Function::storesInline<decltype(large_callable)>());
+
+    Function function = large_callable;
+    Function moved_function = std::move(function);
+    EXPECT_EQ(moved_function(), 1);
+}
+
+// Test destruction of the stored callable
+TEST(InplaceFunctionTest, DestroysCallable)
+{
+    const auto element = std::make_shared<int>(1);
+    {
+        InplaceFunction<void()> function = [element]() {};
+        EXPECT_EQ(element.use_count(), 2);
+
+        InplaceFunction<void()> moved_function = std::move(function);
+        EXPECT_EQ(element.use_count(), 2);
+
+        moved_function = nullptr;
+        EXPECT_EQ(element.use_count(), 1);
+
+        function = [element]() {};
+    }
+    EXPECT_EQ(element.use_count(), 1);
+}
@@ -0,0 +1,127 @@
+#include <utilities_lib/mpmc_queue.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace utilities_lib;
+
+// Test constructor with capacity
+TEST(MPMCQueueTest, ConstructorWithCapacity)
+{
+    MPMCQueue<int> queue(10); // Rounded up to 16
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.size(), 0);
+    EXPECT_EQ(queue.capacity(), 16);
+
+    MPMCQueue<int> single_queue(1); // At least 2 cells
+    EXPECT_EQ(single_queue.capacity(), 2);
+}
+
+// Test zero capacity
+TEST(MPMCQueueTest, ZeroCapacity)
+{
+    EXPECT_THROW(MPMCQueue<int>{0}, std::runtime_error);
+}
+
+// Test push and pop functionality
+TEST(MPMCQueueTest, PushAndPop)
+{
+    MPMCQueue<int> queue(4);
+    EXPECT_TRUE(queue.tryPush(1));
+    EXPECT_TRUE(queue.tryPush(2));
+
+    EXPECT_FALSE(queue.empty());
+    EXPECT_EQ(queue.size(), 2);
+
+    int value = 0;
+    EXPECT_TRUE(queue.tryPop(value));
+    EXPECT_EQ(value, 1);
+    EXPECT_EQ(queue.size(), 1);
+
+    EXPECT_TRUE(queue.tryPop(value));
+    EXPECT_EQ(value, 2);
+    EXPECT_TRUE(queue.empty());
+    EXPECT_FALSE(queue.tryPop(value));
+}
+
+// Test the full condition, the queue never reallocates
+TEST(MPMCQueueTest, FullQueue)
+{
+    MPMCQueue<int> queue(2);
+    EXPECT_TRUE(queue.tryPush(1));
+    EXPECT_TRUE(queue.tryPush(2));
+    EXPECT_FALSE(queue.tryPush(3));
+    EXPECT_EQ(queue.size(), 2);
+}
+
+// Test wrap-around functionality
+TEST(MPMCQueueTest, WrapAround)
+{
+    MPMCQueue<int> queue(2);
+    int value = 0;
+    for (int i = 0; i < 10; ++i)
+    {
+        EXPECT_TRUE(queue.tryPush(i));
+        EXPECT_TRUE(queue.tryPop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_TRUE(queue.empty());
+}
+
+// Test destruction of the remaining elements
+TEST(MPMCQueueTest, DestroysRemainingElements)
+{
+    const auto element = std::make_shared<int>(1);
+    {
+        MPMCQueue<std::shared_ptr<int>> queue(4);
+        queue.push(element);
+        queue.push(element);
+        EXPECT_EQ(element.use_count(), 3);
+    }
+    EXPECT_EQ(element.use_count(), 1);
+}
+
+// Test several producers and consumers, every element is popped exactly once
+TEST(MPMCQueueTest, ProducersConsumers)
+{
+    static constexpr int NUMBER_OF_THREADS = 4;
+    static constexpr int ELEMENTS_PER_PRODUCER = 25000;
+    MPMCQueue<int> queue(64);
+
+    std::atomic<long long> sum = 0;
+    std::atomic<int> popped = 0;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < NUMBER_OF_THREADS; ++t)
+    {
+        threads.emplace_back([&queue, t]() {
+            for (int i = 0; i < ELEMENTS_PER_PRODUCER; ++i)
+            {
+                queue.push((t * ELEMENTS_PER_PRODUCER) + i);
+            }
+        });
+        threads.emplace_back([&queue, &sum, &popped]() {
+            for (int i = 0; i < ELEMENTS_PER_PRODUCER; ++i)
+            {
+                int value = 0;
+                queue.pop(value);
+                sum += value;
+                ++popped;
+            }
+        });
+    }
+
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    const long long number_of_elements = NUMBER_OF_THREADS * ELEMENTS_PER_PRODUCER;
+    EXPECT_EQ(popped, number_of_elements);
+    EXPECT_EQ(sum, (number_of_elements * (number_of_elements - 1)) / 2);
+    EXPECT_TRUE(queue.empty());
+}
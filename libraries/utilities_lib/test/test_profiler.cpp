@@ -0,0 +1,127 @@
+#include <utilities_lib/profiler.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>  // std::find_if
+#include <cstdint>    // std::int64_t
+#include <filesystem> // std::filesystem
+#include <fstream>    // std::ifstream
+#include <iterator>   // std::istreambuf_iterator
+#include <string>     // std::string
+#include <thread>     // std::thread
+#include <vector>     // std::vector
+
+using namespace utilities_lib;
+
+namespace
+{
+constexpr std::int64_t MILLISECOND = 1000000;
+
+const ProfileZoneStatistics *findZone(const std::vector<ProfileZoneStatistics> &statistics, const std::string &name)
+{
+    const auto zone = std::find_if(statistics.begin(), statistics.end(),
+                                   [&name](const ProfileZoneStatistics &entry) { return entry.name == name; });
+    return (zone == statistics.end()) ? nullptr : &(*zone);
+}
+} // namespace
+
+// Test percentiles of the recorded durations
+TEST(ProfilerTest, Percentiles)
+{
+    Profiler &profiler = Profiler::instance();
+    const std::uint32_t zone = profiler.registerZone("test.percentiles");
+    EXPECT_EQ(profiler.registerZone("test.percentiles"), zone);
+
+    for (std::int64_t duration = 1; duration <= 100; ++duration)
+    {
+        profiler.record(zone, 0, duration * MILLISECOND);
+    }
+    profiler.collect();
+
+    const auto statistics = profiler.statistics();
+    const ProfileZoneStatistics *percentiles = findZone(statistics, "test.percentiles");
+    ASSERT_NE(percentiles, nullptr);
+    EXPECT_EQ(percentiles->count, 100U);
+    EXPECT_DOUBLE_EQ(percentiles->p50_ms, 50.0);
+    EXPECT_DOUBLE_EQ(percentiles->p99_ms, 99.0);
+    EXPECT_DOUBLE_EQ(percentiles->max_ms, 100.0);
+}
+
+// Test zones of several threads are collected, the percentiles cover the most recent samples
+TEST(ProfilerTest, ScopedZonesOfThreads)
+{
+    std::vector<std::thread> threads;
+    for (int thread = 0; thread < 4; ++thread)
+    {
+        threads.emplace_back([]() {
+            for (int i = 0; i < 600; ++i)
+            {
+                UTILITIES_PROFILE_ZONE("test.threads");
+            }
+        });
+    }
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    Profiler &profiler = Profiler::instance();
+    profiler.collect();
+
+    const auto statistics = profiler.statistics();
+    const ProfileZoneStatistics *zone = findZone(statistics, "test.threads");
+#if defined(UTILITIES_LIB_PROFILING)
+    ASSERT_NE(zone, nullptr);
+    EXPECT_EQ(zone->count, 2400U);
+    EXPECT_LE(zone->p50_ms, zone->p99_ms);
+    EXPECT_LE(zone->p99_ms, zone->max_ms);
+#else
+    EXPECT_EQ(zone, nullptr);
+#endif
+}
+
+// Test events of a full buffer are dropped and counted
+TEST(ProfilerTest, FullBuffer)
+{
+    Profiler &profiler = Profiler::instance();
+    const std::uint32_t zone = profiler.registerZone("test.full_buffer");
+    profiler.collect();
+
+    const std::uint64_t dropped_events = profiler.droppedEvents();
+    for (std::size_t i = 0U; i < (Profiler::EVENTS_PER_THREAD + 10U); ++i)
+    {
+        profiler.record(zone, 0, MILLISECOND);
+    }
+    EXPECT_GE(profiler.droppedEvents(), dropped_events + 10U);
+
+    profiler.collect();
+    const auto statistics = profiler.statistics();
+    const ProfileZoneStatistics *full_buffer = findZone(statistics, "test.full_buffer");
+    ASSERT_NE(full_buffer, nullptr);
+    EXPECT_LE(full_buffer->count, Profiler::EVENTS_PER_THREAD);
+    EXPECT_DOUBLE_EQ(full_buffer->max_ms, 1.0);
+}
+
+// Test collected events are written as complete events of a Chrome trace
+TEST(ProfilerTest, ChromeTrace)
+{
+    const auto file_path = std::filesystem::temp_directory_path() / "utilities_lib_test_profiler_trace.json";
+    Profiler &profiler = Profiler::instance();
+    const std::uint32_t zone = profiler.registerZone("test.chrome_trace");
+    profiler.collect();
+
+    profiler.startChromeTrace(file_path);
+    profiler.record(zone, 2000, 5000);
+    profiler.collect();
+    profiler.stopChromeTrace();
+
+    std::ifstream trace_file{file_path};
+    const std::string trace{std::istreambuf_iterator<char>(trace_file), std::istreambuf_iterator<char>()};
+    EXPECT_EQ(trace.rfind("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", 0U), 0U);
+    EXPECT_NE(trace.find("{\"name\":\"test.chrome_trace\",\"ph\":\"X\""), std::string::npos);
+    EXPECT_NE(trace.find("\"ts\":2,\"dur\":3}"), std::string::npos);
+    EXPECT_EQ(trace.substr(trace.size() - 4U), "\n]}\n");
+
+    EXPECT_THROW(profiler.startChromeTrace(file_path / "missing" / "trace.json"), std::runtime_error);
+    std::filesystem::remove(file_path);
+}
@@ -0,0 +1,108 @@
+#include <utilities_lib/spsc_queue.hpp>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <thread>
+
+using namespace utilities_lib;
+
+// Test constructor with capacity
+TEST(SPSCQueueTest, ConstructorWithCapacity)
+{
+    SPSCQueue<int> queue(10); // Rounded up to 16
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.size(), 0);
+    EXPECT_EQ(queue.capacity(), 16);
+}
+
+// Test zero capacity
+TEST(SPSCQueueTest, ZeroCapacity)
+{
+    EXPECT_THROW(SPSCQueue<int>{0}, std::runtime_error);
+}
+
+// Test push and pop functionality
+TEST(SPSCQueueTest, PushAndPop)
+{
+    SPSCQueue<int> queue(4);
+    EXPECT_TRUE(queue.tryPush(1));
+    EXPECT_TRUE(queue.tryPush(2));
+
+    EXPECT_FALSE(queue.empty());
+    EXPECT_EQ(queue.size(), 2);
+
+    int value = 0;
+    EXPECT_TRUE(queue.tryPop(value));
+    EXPECT_EQ(value, 1);
+    EXPECT_EQ(queue.size(), 1);
+
+    EXPECT_TRUE(queue.tryPop(value));
+    EXPECT_EQ(value, 2);
+    EXPECT_TRUE(queue.empty());
+    EXPECT_FALSE(queue.tryPop(value));
+}
+
+// Test the full condition, the queue never reallocates
+TEST(SPSCQueueTest, FullQueue)
+{
+    SPSCQueue<int> queue(2);
+    EXPECT_TRUE(queue.tryPush(1));
+    EXPECT_TRUE(queue.tryPush(2));
+    EXPECT_FALSE(queue.tryPush(3));
+    EXPECT_EQ(queue.size(), 2);
+}
+
+// Test wrap-around functionality
+TEST(SPSCQueueTest, WrapAround)
+{
+    SPSCQueue<int> queue(4);
+    int value = 0;
+    for (int i = 0; i < 10; ++i)
+    {
+        EXPECT_TRUE(queue.tryPush(i));
+        EXPECT_TRUE(queue.tryPop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_TRUE(queue.empty());
+}
+
+// Test destruction of the remaining elements
+TEST(SPSCQueueTest, DestroysRemainingElements)
+{
+    const auto element = std::make_shared<int>(1);
+    {
+        SPSCQueue<std::shared_ptr<int>> queue(4);
+        queue.push(element);
+        queue.push(element);
+        EXPECT_EQ(element.use_count(), 3);
+    }
+    EXPECT_EQ(element.use_count(), 1);
+}
+
+// Test a producer and a consumer on their own threads
+TEST(SPSCQueueTest, ProducerConsumer)
+{
+    static constexpr int NUMBER_OF_ELEMENTS = 100000;
+    SPSCQueue<int> queue(64);
+
+    std::thread producer([&queue]() {
+        for (int i = 0; i < NUMBER_OF_ELEMENTS; ++i)
+        {
+            queue.push(i);
+        }
+    });
+
+    // Elements arrive in order
+    bool in_order = true;
+    for (int i = 0; i < NUMBER_OF_ELEMENTS; ++i)
+    {
+        int value = -1;
+        queue.pop(value);
+        in_order = in_order && (value == i);
+    }
+    producer.join();
+
+    EXPECT_TRUE(in_order);
+    EXPECT_TRUE(queue.empty());
+}
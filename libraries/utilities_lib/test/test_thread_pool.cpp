@@ -4,6 +4,9 @@
 
 #include <atomic>
 #include <chrono>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
 
 using namespace utilities_lib;
 
@@ -52,3 +55,88 @@ TEST_F(ThreadPoolTest, DestructorBehavior)
     // No direct way to test destructor behavior, but reaching here without
     // a crash or deadlock indicates that the destructor likely behaved correctly.
 }
+
+TEST_F(ThreadPoolTest, SubmitWithTaskGroup)
+{
+    ThreadPool pool(4);
+
+    std::atomic<int> counter = 0;
+    TaskGroup task_group(pool);
+    for (int i = 0; i < 1000; ++i)
+    {
+        task_group.run([&counter]() { counter++; });
+    }
+    task_group.wait();
+
+    EXPECT_EQ(counter, 1000);
+}
+
+TEST_F(ThreadPoolTest, TaskGroupRethrowsException)
+{
+    ThreadPool pool(2);
+
+    std::atomic<int> counter = 0;
+    TaskGroup task_group(pool);
+    task_group.run([]() { throw std::runtime_error("task failed"); });
+    task_group.run([&counter]() { counter++; });
+
+    EXPECT_THROW(task_group.wait(), std::runtime_error);
+    EXPECT_EQ(counter, 1);
+}
+
+TEST_F(ThreadPoolTest, ParallelForCoversRange)
+{
+    ThreadPool pool(4);
+
+    // Every index is visited exactly once, the last chunk is shorter than the grain
+    std::vector<int> visits(1003, 0);
+    pool.parallelFor(0U, visits.size(), 10U, [&visits](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; ++i)
+        {
+            visits[i]++;
+        }
+    });
+
+    EXPECT_EQ(std::accumulate(visits.begin(), visits.end(), 0), 1003);
+    for (const int visit : visits)
+    {
+        EXPECT_EQ(visit, 1);
+    }
+}
+
+TEST_F(ThreadPoolTest, NestedParallelFor)
+{
+    ThreadPool pool(2);
+
+    // Tasks waiting for their own parallel loops run the queued tasks instead of blocking the workers
+    std::atomic<int> counter = 0;
+    pool.parallelFor(0U, 8U, 1U, [&pool, &counter](std::size_t, std::size_t) {
+        pool.parallelFor(0U, 100U, 10U, [&counter](std::size_t first, std::size_t last) {
+            counter += static_cast<int>(last - first);
+        });
+    });
+
+    EXPECT_EQ(counter, 800);
+}
+
+TEST_F(ThreadPoolTest, WithoutWorkers)
+{
+    ThreadPool pool(0);
+
+    // Tasks are run by the waiting thread
+    int counter = 0;
+    pool.parallelFor(0U, 10U, 3U, [&counter](std::size_t first, std::size_t last) {
+        counter += static_cast<int>(last - first);
+    });
+
+    EXPECT_EQ(counter, 10);
+}
+
+TEST_F(ThreadPoolTest, PinnedWorkers)
+{
+    ThreadPool pool(2, true);
+
+    auto future = pool.enqueue([]() { return 42; });
+    EXPECT_EQ(future.get(), 42);
+    EXPECT_EQ(pool.threadCount(), 2);
+}
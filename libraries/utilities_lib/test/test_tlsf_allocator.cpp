@@ -1,10 +1,13 @@
+#include <utilities_lib/bounded_vector.hpp>
 #include <utilities_lib/tlsf_allocator.hpp>
 
 #include <gtest/gtest.h>
 
 #include <cassert>
+#include <cstdint>
 #include <iostream>
 #include <string>
+#include <thread>
 #include <vector>
 
 using namespace utilities_lib;
@@ -106,3 +109,157 @@ TEST_F(TLSFAllocatorTest, AddManyElementsWithReserve)
     EXPECT_EQ(test_vector_.size(), 0);
     EXPECT_EQ(allocated_elements, 0);
 }
+
+// Test case for heaps not sharing their pools
+TEST(TLSFHeapTest, IndependentHeaps)
+{
+    TLSFHeap first_heap{1U << 20U};
+    TLSFHeap second_heap{1U << 20U};
+
+    auto *first = static_cast<std::uint64_t *>(first_heap.allocate(sizeof(std::uint64_t)));
+    auto *second = static_cast<std::uint64_t *>(second_heap.allocate(sizeof(std::uint64_t)));
+    ASSERT_NE(first, nullptr);
+    ASSERT_NE(second, nullptr);
+    EXPECT_NE(first, second);
+
+    *first = 1U;
+    *second = 2U;
+    EXPECT_EQ(*first, 1U);
+    EXPECT_EQ(*second, 2U);
+
+    first_heap.deallocate(first);
+    second_heap.deallocate(second);
+}
+
+// Test case for the occupancy statistics
+TEST(TLSFHeapTest, Statistics)
+{
+    constexpr std::size_t CAPACITY = 1U << 20U;
+    TLSFHeap heap{CAPACITY};
+
+    TLSFHeapStatistics statistics = heap.statistics();
+    EXPECT_EQ(statistics.capacity, CAPACITY);
+    EXPECT_EQ(statistics.used_bytes, 0U);
+    EXPECT_EQ(statistics.free_bytes, CAPACITY);
+    EXPECT_DOUBLE_EQ(statistics.fragmentation, 0.0);
+
+    std::vector<void *> blocks;
+    for (std::size_t i = 0U; i < 8U; ++i)
+    {
+        blocks.push_back(heap.allocate(1024U));
+        ASSERT_NE(blocks.back(), nullptr);
+    }
+
+    statistics = heap.statistics();
+    EXPECT_EQ(statistics.live_allocations, 8U);
+    EXPECT_GE(statistics.used_bytes, 8U * 1024U);
+    EXPECT_EQ(statistics.high_water_mark, statistics.used_bytes);
+
+    // Every other block released leaves holes in front of the last block
+    for (std::size_t i = 0U; i < blocks.size(); i += 2U)
+    {
+        heap.deallocate(blocks[i]);
+    }
+
+    statistics = heap.statistics();
+    EXPECT_EQ(statistics.live_allocations, 4U);
+    EXPECT_LT(statistics.used_bytes, statistics.high_water_mark);
+    EXPECT_GT(statistics.fragmentation, 0.0);
+    EXPECT_LT(statistics.largest_free_block, statistics.free_bytes);
+
+    heap.resetHighWaterMark();
+    EXPECT_EQ(heap.statistics().high_water_mark, statistics.used_bytes);
+
+    for (std::size_t i = 1U; i < blocks.size(); i += 2U)
+    {
+        heap.deallocate(blocks[i]);
+    }
+
+    statistics = heap.statistics();
+    EXPECT_EQ(statistics.used_bytes, 0U);
+    EXPECT_EQ(statistics.free_bytes, CAPACITY);
+    EXPECT_DOUBLE_EQ(statistics.fragmentation, 0.0);
+}
+
+// Test case for an exhausted pool
+TEST(TLSFHeapTest, Exhaustion)
+{
+    TLSFHeap heap{4096U};
+    EXPECT_EQ(heap.allocate(8192U), nullptr);
+    EXPECT_EQ(heap.statistics().failed_allocations, 1U);
+
+    TLSFAllocator<std::uint8_t> allocator{heap};
+    EXPECT_THROW(static_cast<void>(allocator.allocate(8192U)), std::bad_alloc);
+}
+
+// Test case for over-aligned allocations
+TEST(TLSFHeapTest, AlignedAllocation)
+{
+    TLSFHeap heap{1U << 20U};
+    for (const std::size_t alignment : {16U, 64U, 4096U})
+    {
+        void *memory = heap.allocate(100U, alignment);
+        ASSERT_NE(memory, nullptr);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(memory) % alignment, 0U);
+        heap.deallocate(memory);
+    }
+}
+
+// Test case for allocators comparing equal only on the same heap
+TEST(TLSFHeapTest, AllocatorEquality)
+{
+    TLSFHeap first_heap{1U << 16U};
+    TLSFHeap second_heap{1U << 16U};
+
+    const TLSFAllocator<float> first{first_heap};
+    const TLSFAllocator<double> rebound{first};
+    const TLSFAllocator<float> second{second_heap};
+
+    EXPECT_TRUE(first == rebound);
+    EXPECT_TRUE(first != second);
+    EXPECT_EQ(&rebound.heap(), &first_heap);
+}
+
+// Test case for a bounded vector backed by a heap
+TEST(TLSFHeapTest, BoundedVectorBackend)
+{
+    TLSFHeap heap{1U << 20U};
+    {
+        BoundedVector<std::uint32_t, 1000U, TLSFAllocator<std::uint32_t>> vector{TLSFAllocator<std::uint32_t>{heap}};
+        EXPECT_EQ(heap.statistics().live_allocations, 1U);
+        EXPECT_GE(heap.statistics().used_bytes, 1000U * sizeof(std::uint32_t));
+
+        for (std::uint32_t i = 0U; i < 1000U; ++i)
+        {
+            vector.push_back(static_cast<std::uint32_t>(i));
+        }
+
+        const auto copy{vector};
+        EXPECT_EQ(copy.get_allocator(), vector.get_allocator());
+        EXPECT_EQ(copy[999U], 999U);
+        EXPECT_EQ(heap.statistics().live_allocations, 2U);
+    }
+    EXPECT_EQ(heap.statistics().live_allocations, 0U);
+}
+
+// Test case for threads keeping their heap
+TEST(TLSFHeapTest, ThreadHeaps)
+{
+    TLSFThreadHeaps heaps{2U, 1U << 20U};
+    ASSERT_EQ(heaps.size(), 2U);
+
+    TLSFHeap *main_heap = &heaps.local();
+    EXPECT_EQ(&heaps.local(), main_heap);
+
+    TLSFHeap *worker_heap = nullptr;
+    std::thread worker{[&heaps, &worker_heap]() {
+        worker_heap = &heaps.local();
+        std::vector<int, TLSFAllocator<int>> values{TLSFAllocator<int>{*worker_heap}};
+        values.assign(1000U, 1);
+    }};
+    worker.join();
+
+    EXPECT_NE(worker_heap, main_heap);
+    EXPECT_EQ(worker_heap->statistics().live_allocations, 0U);
+    EXPECT_GT(worker_heap->statistics().high_water_mark, 0U);
+}
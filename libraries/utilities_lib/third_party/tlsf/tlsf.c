@@ -7,7 +7,6 @@
 
 #include <stdbool.h>
 #include <string.h>
-#include <sys/mman.h>
 
 #include "tlsf.h"
 
@@ -472,39 +471,14 @@ INLINE tlsf_block_t *block_find_free(tlsf_t *t, size_t size)
 
 void *tlsf_resize(tlsf_t *t, size_t req_size)
 {
-    // Get page size at runtime
-    const size_t PAGE = (size_t)sysconf(_SC_PAGESIZE);
-
-    // Calculate MAX_PAGES based on TLSF_MAX_SIZE and PAGE
-    const size_t MAX_PAGES = 20 * TLSF_MAX_SIZE / PAGE;
-
-    static size_t curr_pages = 0;
-    static void *start_addr = 0;
-
-    (void)t;
-
-    if (!start_addr)
-    {
-        start_addr =
-            mmap(0, MAX_PAGES * PAGE, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE | MAP_NORESERVE, -1, 0);
-    }
-
-    size_t req_pages = (req_size + PAGE - 1) / PAGE;
-    if (req_pages > MAX_PAGES)
+    // The pool is preallocated by the owner of the instance, the arena grows and shrinks within it without touching
+    // the system allocator, so the pages stay resident (and locked, if the owner locked them)
+    if (!t->pool || req_size > t->capacity)
     {
         return 0;
     }
 
-    if (req_pages != curr_pages)
-    {
-        if (req_pages < curr_pages)
-        {
-            madvise((char *)start_addr + PAGE * req_pages, (size_t)(curr_pages - req_pages) * PAGE, MADV_DONTNEED);
-        }
-        curr_pages = req_pages;
-    }
-
-    return start_addr;
+    return t->pool;
 }
 
 void *tlsf_malloc(tlsf_t *t, size_t size)
@@ -603,6 +577,39 @@ void *tlsf_realloc(tlsf_t *t, void *mem, size_t size)
     return mem;
 }
 
+size_t tlsf_usable_size(const void *mem)
+{
+    if (UNLIKELY(!mem))
+        return 0;
+
+    return block_size(block_from_payload((void *)mem));
+}
+
+void tlsf_free_statistics(const tlsf_t *t, size_t *free_bytes, size_t *largest_free_block)
+{
+    /* The pool beyond the arena is free and contiguous, the last block of the arena is never free */
+    size_t tail = t->capacity > t->size ? t->capacity - t->size : 0;
+    size_t total = tail, largest = tail;
+    for (uint32_t i = 0; i < FL_COUNT; ++i)
+    {
+        if (!(t->fl & (1U << i)))
+            continue;
+
+        for (uint32_t j = 0; j < SL_COUNT; ++j)
+        {
+            for (tlsf_block_t *block = t->block[i][j]; block; block = block->next_free)
+            {
+                size_t size = block_size(block);
+                total += size;
+                largest = size > largest ? size : largest;
+            }
+        }
+    }
+
+    *free_bytes = total;
+    *largest_free_block = largest;
+}
+
 #ifdef TLSF_ENABLE_CHECK
 #include <stdio.h>
 #include <stdlib.h>
@@ -12,7 +12,6 @@ extern "C"
 
 #include <stddef.h>
 #include <stdint.h>
-#include <unistd.h>
 
 #define _TLSF_SL_COUNT 16
 #if __SIZE_WIDTH__ == 64
@@ -23,15 +22,23 @@ extern "C"
 #define _TLSF_FL_MAX 30
 #endif
 #define TLSF_MAX_SIZE (((size_t)1 << (_TLSF_FL_MAX - 1)) - sizeof(size_t))
-#define TLSF_INIT ((tlsf_t){.size = 0})
+#define TLSF_INIT ((tlsf_t){.size = 0, .pool = NULL, .capacity = 0})
 
     typedef struct
     {
         uint32_t fl, sl[_TLSF_FL_COUNT];
         struct tlsf_block *block[_TLSF_FL_COUNT][_TLSF_SL_COUNT];
         size_t size;
+
+        /* Pool the arena grows into, the arena never exceeds the capacity */
+        void *pool;
+        size_t capacity;
     } tlsf_t;
 
+    /**
+     * Resizes the arena within the pool of the instance, returns the start of the pool.
+     * On failure (no pool or insufficient capacity), returns NULL.
+     */
     void *tlsf_resize(tlsf_t *, size_t);
     void *tlsf_aalloc(tlsf_t *, size_t, size_t);
 
@@ -47,6 +54,16 @@ extern "C"
      */
     void tlsf_free(tlsf_t *, void *);
 
+    /**
+     * Returns the usable size of a previously allocated memory, given the pointer.
+     */
+    size_t tlsf_usable_size(const void *);
+
+    /**
+     * Reports the free bytes of the pool and the largest contiguous free block, walks the free lists.
+     */
+    void tlsf_free_statistics(const tlsf_t *, size_t *free_bytes, size_t *largest_free_block);
+
 #ifdef TLSF_ENABLE_CHECK
     void tlsf_check(tlsf_t *);
 #else
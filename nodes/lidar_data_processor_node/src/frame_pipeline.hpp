@@ -0,0 +1,133 @@
+#ifndef FRAME_PIPELINE_HPP
+#define FRAME_PIPELINE_HPP
+
+#include <atomic>                                              // std::atomic
+#include <chrono>                                              // std::chrono::microseconds
+#include <cstddef>                                             // std::size_t
+#include <cstdint>                                             // std::uint32_t
+#include <data_types_lib/point_cloud_soa.hpp>                  // PointCloudSoA
+#include <data_types_lib/point_cloud_view.hpp>                 // PointCloudView
+#include <data_types_lib/reserved_clustering_label.hpp>        // ClusteringLabel
+#include <data_types_lib/segmentation_label.hpp>               // SegmentationLabel
+#include <lidar_processing_lib/filtering/convex_quad_crop.hpp> // CropIndices
+#include <sensor_msgs/msg/point_cloud2.hpp>                    // sensor_msgs::msg::PointCloud2
+#include <stdexcept>                                           // std::runtime_error
+#include <std_msgs/msg/header.hpp>                             // std_msgs::msg::Header
+#include <thread>                                              // std::this_thread
+#include <utilities_lib/spsc_queue.hpp>                        // SPSCQueue
+#include <vector>                                              // std::vector
+
+/// @brief Buffers of a frame passed between the processing stages, frames are reused so the buffers keep their
+/// capacity across frames.
+struct Frame final
+{
+    // Owns the input message in the pipelined mode, the clouds below view its buffer
+    sensor_msgs::msg::PointCloud2::UniquePtr input_message;
+    std_msgs::msg::Header header;
+    data_types_lib::PointCloudView input_cloud;
+
+    // Points kept by the crop, as indices of the input cloud
+    lidar_processing_lib::filtering::CropIndices crop_indices;
+
+    // Cropped points decoded once, with the range and azimuth channels shared by the later stages
+    data_types_lib::PointCloudSoA cropped_cloud;
+
+    // Labels of the cropped points
+    std::vector<data_types_lib::SegmentationLabel> segmentation_labels;
+
+    // OBSTACLE and TRANSITIONAL_OBSTACLE points of the cropped cloud, as indices of the cropped cloud
+    std::vector<std::uint32_t> obstacle_indices;
+    data_types_lib::PointCloudSoA obstacle_cloud;
+
+    // Labels of the obstacle points
+    std::vector<data_types_lib::ClusteringLabel> clustering_labels;
+
+    /// @brief Preallocates the buffers for clouds of up to max_cloud_size points.
+    inline void reserve(const std::size_t max_cloud_size)
+    {
+        crop_indices.reserve(max_cloud_size);
+        cropped_cloud.reserve(max_cloud_size);
+        segmentation_labels.reserve(max_cloud_size);
+        obstacle_indices.reserve(max_cloud_size);
+        obstacle_cloud.reserve(max_cloud_size);
+        clustering_labels.reserve(max_cloud_size);
+    }
+};
+
+/// @brief Lock-free link of frames from one stage thread to the next. The link holds at most capacity frames for the
+/// consuming stage: the consumer skips the oldest frames beyond the capacity so it always continues with the latest
+/// frames (latest frame wins). The frames are dropped by the consumer, the producer only pushes, so the link is a
+/// single producer single consumer queue sized for every frame of the pipeline.
+class FrameLink final
+{
+  public:
+    /// @brief A non-default constructor that allocates the queue, number_of_frames is the number of frames of the
+    /// pipeline, none of them is ever rejected by the link
+    inline FrameLink(const std::size_t capacity, const std::size_t number_of_frames)
+        : frames_{number_of_frames}, capacity_{capacity}
+    {
+        if (capacity == 0U)
+        {
+            throw std::runtime_error("Capacity of FrameLink must be positive!");
+        }
+    }
+
+    /// @brief Appends the frame, called by the producing stage. Never waits, the link holds every frame.
+    inline void push(Frame *frame)
+    {
+        frames_.push(frame);
+    }
+
+    /// @brief Removes the oldest frame within the capacity, passes the older frames to drop_frame first. Called by the
+    /// consuming stage, waits while the link is empty and returns nullptr once the link is closed.
+    template <typename DropFrame> inline Frame *pop(DropFrame &&drop_frame)
+    {
+        // Frames arrive at the sensor rate, the consumer spins briefly for a frame pushed right after the previous
+        // one and sleeps otherwise
+        std::uint32_t attempts = 0U;
+        while (frames_.empty())
+        {
+            if (closed_.load(std::memory_order_acquire))
+            {
+                return nullptr;
+            }
+            if (++attempts < SPIN_ATTEMPTS)
+            {
+                std::this_thread::yield();
+            }
+            else
+            {
+                std::this_thread::sleep_for(WAIT_INTERVAL);
+            }
+        }
+        if (closed_.load(std::memory_order_acquire))
+        {
+            return nullptr;
+        }
+
+        Frame *frame = nullptr;
+        while (frames_.size() > capacity_)
+        {
+            frames_.tryPop(frame);
+            drop_frame(frame);
+        }
+        frames_.tryPop(frame);
+        return frame;
+    }
+
+    /// @brief Stops the consumer, frames are not popped from a closed link anymore.
+    inline void close() noexcept
+    {
+        closed_.store(true, std::memory_order_release);
+    }
+
+  private:
+    static constexpr std::uint32_t SPIN_ATTEMPTS = 64U;
+    static constexpr std::chrono::microseconds WAIT_INTERVAL{100};
+
+    utilities_lib::SPSCQueue<Frame *> frames_;
+    const std::size_t capacity_;
+    std::atomic<bool> closed_{false};
+};
+
+#endif // FRAME_PIPELINE_HPP
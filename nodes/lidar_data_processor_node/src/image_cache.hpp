@@ -0,0 +1,81 @@
+#ifndef IMAGE_CACHE_HPP
+#define IMAGE_CACHE_HPP
+
+#include <cstddef>                   // std::size_t
+#include <cstdint>                   // std::int64_t
+#include <mutex>                     // std::mutex, std::lock_guard
+#include <sensor_msgs/msg/image.hpp> // sensor_msgs::msg::Image
+#include <std_msgs/msg/header.hpp>   // std_msgs::msg::Header, builtin_interfaces::msg::Time
+#include <utility>                   // std::move
+#include <vector>                    // std::vector
+
+/// @brief Latest images of a camera, bounded so the cache holds at most capacity images. A new image replaces the
+/// oldest one once the cache is full. Images are pushed by the subscription and looked up by the stage fusing the
+/// clouds, the shared pointers keep a looked up image alive after it was replaced.
+class ImageCache final
+{
+  public:
+    using ImageConstSharedPtr = sensor_msgs::msg::Image::ConstSharedPtr;
+
+    /// @brief Preallocates the cache, must be called before the subscription is created.
+    inline void reserve(const std::size_t capacity)
+    {
+        images_.assign((capacity > 0U) ? capacity : 1U, nullptr);
+        next_ = 0U;
+    }
+
+    /// @brief Stores the image, replaces the oldest image of a full cache.
+    inline void push(ImageConstSharedPtr image)
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        images_[next_] = std::move(image);
+        next_ = (next_ + 1U) % images_.size();
+    }
+
+    /// @brief Returns the image stamped closest to the stamp, nullptr when no image is within max_offset_ns of it. Of
+    /// images equally close to the stamp the newest one is returned.
+    inline ImageConstSharedPtr findClosest(const builtin_interfaces::msg::Time &stamp,
+                                           const std::int64_t max_offset_ns) const
+    {
+        const std::int64_t stamp_ns = toNanoseconds(stamp);
+
+        std::lock_guard<std::mutex> lock{mutex_};
+        ImageConstSharedPtr closest_image;
+        std::int64_t closest_offset_ns = max_offset_ns;
+
+        // Images are visited from the newest to the oldest, an older image must be strictly closer to replace it
+        const std::size_t number_of_images = images_.size();
+        for (std::size_t age = 0U; age < number_of_images; ++age)
+        {
+            const ImageConstSharedPtr &image = images_[(next_ + number_of_images - 1U - age) % number_of_images];
+            if (image == nullptr)
+            {
+                continue;
+            }
+
+            const std::int64_t offset_ns = toNanoseconds(image->header.stamp) - stamp_ns;
+            const std::int64_t absolute_offset_ns = (offset_ns < 0) ? -offset_ns : offset_ns;
+            const bool is_closer = (closest_image == nullptr) ? (absolute_offset_ns <= closest_offset_ns)
+                                                              : (absolute_offset_ns < closest_offset_ns);
+            if (is_closer)
+            {
+                closest_image = image;
+                closest_offset_ns = absolute_offset_ns;
+            }
+        }
+
+        return closest_image;
+    }
+
+  private:
+    mutable std::mutex mutex_;
+    std::vector<ImageConstSharedPtr> images_;
+    std::size_t next_ = 0U;
+
+    static inline std::int64_t toNanoseconds(const builtin_interfaces::msg::Time &stamp) noexcept
+    {
+        return (static_cast<std::int64_t>(stamp.sec) * 1'000'000'000) + static_cast<std::int64_t>(stamp.nanosec);
+    }
+};
+
+#endif // IMAGE_CACHE_HPP
@@ -1,143 +1,160 @@
-// Configuration
-#include "processing_configuration.hpp"
-
-// Processing
-#include <lidar_processing_lib/segmentation/depth_image_segmenter.hpp>
-#include <lidar_processing_lib/segmentation/ransac_segmenter.hpp>
-
-// ROS2
-#include <rclcpp/executors.hpp>                    // rclcpp::spin
-#include <rclcpp/node.hpp>                         // rclcpp::Node
-#include <rclcpp/publisher.hpp>                    // rclcpp::Publisher
-#include <rclcpp/qos.hpp>                          // rclcpp::QoS
-#include <rclcpp/subscription.hpp>                 // rclcpp::Subscription
-#include <rclcpp/timer.hpp>                        // rclcpp::TimerBase
-#include <rclcpp/utilities.hpp>                    // rclcpp::shutdown
-#include <sensor_msgs/msg/image.hpp>               // sensor_msgs::msg::Image
-#include <sensor_msgs/msg/point_cloud2.hpp>        // sensor_msgs::msg::PointCloud2
-#include <sensor_msgs/msg/point_field.hpp>         // sensor_msgs::msg::PointField
-#include <visualization_msgs/msg/marker_array.hpp> // visualization_msgs::msg::MarkerArray
-
-// STL
-#include <chrono>     // std::chrono
-#include <cstring>    // std::memcpy
-#include <exception>  // std::exception
-#include <functional> // std::bind
-#include <iostream>   // std::cerr
-#include <string>     // std::string
-#include <tuple>      // std::tuple
-#include <vector>     // std::vector
-
-class LidarDataProcessorNode final : public rclcpp::Node
+#include "lidar_data_processor_node.hpp"
+
+void LidarDataProcessorNode::initializeOutputCloud(PointCloud2 &cloud)
 {
-  public:
-    static constexpr std::uint32_t MAX_CLOUD_SIZE = 250'000U;
+    // name, offset, type, count
+    static const std::vector<std::tuple<std::string, std::uint32_t, std::uint8_t, std::uint32_t>> fields = {
+        {"x", offsetof(pcl::PointXYZRGB, x), PointField::FLOAT32, 1},
+        {"y", offsetof(pcl::PointXYZRGB, y), PointField::FLOAT32, 1},
+        {"z", offsetof(pcl::PointXYZRGB, z), PointField::FLOAT32, 1},
+        {"rgb", offsetof(pcl::PointXYZRGB, rgb), PointField::UINT32, 1}};
 
-    using PointCloud2 = sensor_msgs::msg::PointCloud2;
-    using PointField = sensor_msgs::msg::PointField;
-    using MarkerArray = visualization_msgs::msg::MarkerArray;
+    cloud.fields.clear();
+    for (const auto &field : fields)
+    {
+        sensor_msgs::msg::PointField field_cache;
+        field_cache.name = std::get<0>(field);
+        field_cache.offset = std::get<1>(field);
+        field_cache.datatype = std::get<2>(field);
+        field_cache.count = std::get<3>(field);
+        cloud.fields.emplace_back(std::move(field_cache));
+    }
 
-    // Copy and move operations are not allowed.
-    LidarDataProcessorNode(const LidarDataProcessorNode &) = delete;
-    LidarDataProcessorNode(LidarDataProcessorNode &&) = delete;
-    LidarDataProcessorNode &operator=(const LidarDataProcessorNode &) = delete;
-    LidarDataProcessorNode &operator=(LidarDataProcessorNode &&) = delete;
+    cloud.is_dense = true;
+    cloud.is_bigendian = false;
+    cloud.height = 1;
+    cloud.width = 0;
+    cloud.point_step = sizeof(pcl::PointXYZRGB);
+    cloud.row_step = 0;
+}
 
-    /// @brief Constructor of the node.
-    LidarDataProcessorNode();
+void LidarDataProcessorNode::startPipeline(const std::uint32_t queue_capacity)
+{
+    if (queue_capacity == 0U)
+    {
+        throw std::runtime_error("Queue capacity of the pipeline must be positive!");
+    }
 
-    /// @brief Destructor of the node.
-    ~LidarDataProcessorNode() = default;
+    // Without stale frames a frame can be in ingestion, in each stage thread and in each link at the same time, so a
+    // free frame is available to the subscription thread unless a stage falls behind by more frames than the pipeline
+    // holds. The links and the free queue hold every frame, pushing never waits
+    static constexpr std::size_t NUMBER_OF_STAGE_THREADS = 3U;
+    const std::size_t number_of_frames = 1U + NUMBER_OF_STAGE_THREADS + (NUMBER_OF_STAGE_THREADS * queue_capacity);
 
-    /// @brief Replay sensor data.
-    void run(const PointCloud2 &input_message);
+    frames_.resize(number_of_frames);
+    free_frames_ = std::make_unique<utilities_lib::MPMCQueue<Frame *>>(number_of_frames);
+    segmentation_link_ = std::make_unique<FrameLink>(queue_capacity, number_of_frames);
+    clustering_link_ = std::make_unique<FrameLink>(queue_capacity, number_of_frames);
+    publication_link_ = std::make_unique<FrameLink>(queue_capacity, number_of_frames);
 
-  private:
-    // A subscriber that receives raw lidar data.
-    rclcpp::Subscription<PointCloud2>::SharedPtr subscriber_;
+    for (auto &frame : frames_)
+    {
+        frame.reserve(MAX_CLOUD_SIZE);
+        free_frames_->push(&frame);
+    }
 
-    // Ground segmentation data publishers
-    rclcpp::Publisher<PointCloud2>::SharedPtr publisher_unknown_cloud_;
-    PointCloud2 unknown_cloud_;
+    stage_threads_.emplace_back(&LidarDataProcessorNode::runStage, this, std::ref(*segmentation_link_),
+                                clustering_link_.get(), &LidarDataProcessorNode::segmentFrame);
+    stage_threads_.emplace_back(&LidarDataProcessorNode::runStage, this, std::ref(*clustering_link_),
+                                publication_link_.get(), &LidarDataProcessorNode::clusterFrame);
+    stage_threads_.emplace_back(&LidarDataProcessorNode::runStage, this, std::ref(*publication_link_), nullptr,
+                                &LidarDataProcessorNode::publishFrame);
 
-    rclcpp::Publisher<PointCloud2>::SharedPtr publisher_ground_cloud_;
-    PointCloud2 ground_cloud_;
+    pipelined_ = true;
+}
+
+LidarDataProcessorNode::~LidarDataProcessorNode()
+{
+    // Frames still queued are dropped, the stage threads finish the frames they are processing
+    if (pipelined_)
+    {
+        segmentation_link_->close();
+        clustering_link_->close();
+        publication_link_->close();
+    }
 
-    rclcpp::Publisher<PointCloud2>::SharedPtr publisher_obstacle_cloud_;
-    PointCloud2 obstacle_cloud_;
+    for (auto &stage_thread : stage_threads_)
+    {
+        stage_thread.join();
+    }
 
-    // Obstacle clusters
-    rclcpp::Publisher<PointCloud2>::SharedPtr publisher_clustered_cloud_;
-    PointCloud2 clustered_cloud_;
+    if (chrome_trace_)
+    {
+        utilities_lib::Profiler::instance().collect();
+        utilities_lib::Profiler::instance().stopChromeTrace();
+    }
+}
 
-    // Polygonization publication
-    rclcpp::Publisher<MarkerArray>::SharedPtr publisher_polygonized_cloud_;
-    MarkerArray polygonized_cloud_;
+void LidarDataProcessorNode::runStage(FrameLink &input_link, FrameLink *output_link,
+                                      void (LidarDataProcessorNode::*process)(Frame &))
+{
+    // Latest frame wins, the stage skips the frames it did not start in time for the newer ones
+    const auto drop_frame = [this](Frame *dropped_frame) { dropFrame(dropped_frame); };
+    while (Frame *frame = input_link.pop(drop_frame))
+    {
+        try
+        {
+            (this->*process)(*frame);
+        }
+        catch (const std::exception &exception)
+        {
+            RCLCPP_ERROR(this->get_logger(), "Dropped frame: %s", exception.what());
+            recycleFrame(frame);
+            continue;
+        }
 
-    // Configuration
-    ProcessingConfiguration processing_configuration_;
+        if (output_link == nullptr)
+        {
+            recycleFrame(frame);
+            continue;
+        }
 
-    // Processing
-    lidar_processing_lib::segmentation::ISegmenter::UniquePtr segmenter_ptr_;
-    pcl::PointCloud<pcl::PointXYZI> segmenter_input_cloud_;
-    std::vector<data_types_lib::SegmentationLabel> segmentation_labels_;
+        output_link->push(frame);
+    }
+}
 
-    /// @brief Reserve memory.
-    void initialize();
-};
+void LidarDataProcessorNode::recycleFrame(Frame *frame)
+{
+    frame->input_message.reset();
+    free_frames_->push(frame);
+}
 
-void LidarDataProcessorNode::initialize()
+void LidarDataProcessorNode::dropFrame(Frame *frame)
 {
-    unknown_cloud_.data.reserve(MAX_CLOUD_SIZE * sizeof(pcl::PointXYZRGB));
-    ground_cloud_.data.reserve(MAX_CLOUD_SIZE * sizeof(pcl::PointXYZRGB));
-    obstacle_cloud_.data.reserve(MAX_CLOUD_SIZE * sizeof(pcl::PointXYZRGB));
-    clustered_cloud_.data.reserve(MAX_CLOUD_SIZE * sizeof(pcl::PointXYZRGB));
+    const std::uint64_t dropped_frames = ++dropped_frames_;
+    RCLCPP_WARN(this->get_logger(), "Dropped a frame for a newer one, %lu frames dropped",
+                static_cast<unsigned long>(dropped_frames));
+    recycleFrame(frame);
+}
 
+void LidarDataProcessorNode::initialize()
+{
     // TODO: Reserve markers when used
-    segmenter_input_cloud_.points.reserve(MAX_CLOUD_SIZE);
-    segmentation_labels_.reserve(MAX_CLOUD_SIZE);
+    serial_frame_.reserve(MAX_CLOUD_SIZE);
 
-    // name, offset, type, count
-    std::vector<std::tuple<std::string, std::uint32_t, std::uint8_t, std::uint32_t>> fields = {
-        {"x", offsetof(pcl::PointXYZRGB, x), PointField::FLOAT32, 1},
-        {"y", offsetof(pcl::PointXYZRGB, y), PointField::FLOAT32, 1},
-        {"z", offsetof(pcl::PointXYZRGB, z), PointField::FLOAT32, 1},
-        {"rgb", offsetof(pcl::PointXYZRGB, rgb), PointField::UINT32, 1}};
+    initializeOutputCloud(unknown_cloud_);
+    initializeOutputCloud(ground_cloud_);
+    initializeOutputCloud(obstacle_cloud_);
+    initializeOutputCloud(clustered_cloud_);
+    initializeOutputCloud(colorized_cloud_);
 
-    const auto setFields = [&fields](PointCloud2 &cloud) -> void {
-        for (const auto &field : fields)
-        {
-            sensor_msgs::msg::PointField field_cache;
-            field_cache.name = std::get<0>(field);
-            field_cache.offset = std::get<1>(field);
-            field_cache.datatype = std::get<2>(field);
-            field_cache.count = std::get<3>(field);
-            cloud.fields.emplace_back(std::move(field_cache));
-        }
-    };
+    static constexpr std::size_t MAX_OUTPUT_CLOUD_BYTES = MAX_CLOUD_SIZE * sizeof(pcl::PointXYZRGB);
+    unknown_cloud_.data.reserve(MAX_OUTPUT_CLOUD_BYTES);
+    ground_cloud_.data.reserve(MAX_OUTPUT_CLOUD_BYTES);
+    obstacle_cloud_.data.reserve(MAX_OUTPUT_CLOUD_BYTES);
+    clustered_cloud_.data.reserve(MAX_OUTPUT_CLOUD_BYTES);
+    colorized_cloud_.data.reserve(MAX_OUTPUT_CLOUD_BYTES);
 
-    setFields(unknown_cloud_);
-    setFields(ground_cloud_);
-    setFields(obstacle_cloud_);
-    setFields(clustered_cloud_);
-
-    unknown_cloud_.is_dense = true;
-    unknown_cloud_.is_bigendian = false;
-    unknown_cloud_.height = 1;
-    unknown_cloud_.point_step = sizeof(pcl::PointXYZRGB);
-
-    ground_cloud_.is_dense = true;
-    ground_cloud_.is_bigendian = false;
-    ground_cloud_.height = 1;
-    ground_cloud_.point_step = sizeof(pcl::PointXYZRGB);
-
-    obstacle_cloud_.is_dense = true;
-    obstacle_cloud_.is_bigendian = false;
-    obstacle_cloud_.height = 1;
-    obstacle_cloud_.point_step = sizeof(pcl::PointXYZRGB);
+    // Handed over and loaned buffers are replaced by messages of the pool, one frame of output clouds ahead. The
+    // output clouds share the middleware, so one publisher tells whether the messages are loaned
+    if (use_intra_process_comms_ || publisher_unknown_cloud_->can_loan_messages())
+    {
+        output_message_pool_.start(unknown_cloud_, MAX_OUTPUT_CLOUD_BYTES, NUMBER_OF_OUTPUT_CLOUDS);
+    }
 }
 
-LidarDataProcessorNode::LidarDataProcessorNode() : rclcpp::Node{"data_processor_node"}
+LidarDataProcessorNode::LidarDataProcessorNode(const rclcpp::NodeOptions &options)
+    : rclcpp::Node{"data_processor_node", options}, use_intra_process_comms_{options.use_intra_process_comms()}
 {
     // Declare parameters
     this->declare_parameter<std::string>("subscription_topics.input_cloud");
@@ -145,14 +162,60 @@ LidarDataProcessorNode::LidarDataProcessorNode() : rclcpp::Node{"data_processor_
     this->declare_parameter<std::string>("publication_topics.segmentation.ground_cloud");
     this->declare_parameter<std::string>("publication_topics.segmentation.obstacle_cloud");
     this->declare_parameter<std::string>("publication_topics.clustering.clustered_cloud");
+    this->declare_parameter<std::string>("publication_topics.fusion.colorized_cloud");
     this->declare_parameter<std::string>("publication_topics.polygonization.polygonized_cloud");
+    this->declare_parameter<std::string>("publication_topics.diagnostics");
+
+    this->declare_parameter<double>("diagnostics.period");
+    this->declare_parameter<double>("diagnostics.frame_budget_ms");
+    this->declare_parameter<std::string>("diagnostics.chrome_trace_path");
 
     this->declare_parameter<double>("processing_configuration.height_offset");
     this->declare_parameter<std::vector<double>>("processing_configuration.bounding_box");
+    this->declare_parameter<double>("processing_configuration.max_distance");
+    this->declare_parameter<std::string>("processing_configuration.sensor.model");
+    this->declare_parameter<double>("processing_configuration.sensor.custom.min_elevation_deg");
+    this->declare_parameter<double>("processing_configuration.sensor.custom.vertical_field_of_view_deg");
+    this->declare_parameter<double>("processing_configuration.sensor.custom.vertical_resolution_deg");
+    this->declare_parameter<double>("processing_configuration.sensor.custom.horizontal_resolution_deg");
+    this->declare_parameter<std::int64_t>("processing_configuration.sensor.custom.max_cloud_points");
     this->declare_parameter<std::string>("processing_configuration.segmentation.algorithm");
     this->declare_parameter<double>("processing_configuration.segmentation.ransac.orthogonal_distance_threshold");
     this->declare_parameter<std::int64_t>("processing_configuration.segmentation.ransac.number_of_iterations");
     this->declare_parameter<std::int64_t>("processing_configuration.segmentation.ransac.thread_count");
+    this->declare_parameter<std::int64_t>("processing_configuration.segmentation.ransac.horizontal_traversal_bands");
+    this->declare_parameter<bool>("processing_configuration.segmentation.ransac.adaptive.enabled");
+    this->declare_parameter<double>("processing_configuration.segmentation.ransac.adaptive.confidence");
+    this->declare_parameter<std::int64_t>("processing_configuration.segmentation.ransac.adaptive.min_iterations");
+    this->declare_parameter<std::int64_t>(
+        "processing_configuration.segmentation.ransac.adaptive.preemptive_sample_size");
+    this->declare_parameter<double>("processing_configuration.segmentation.ransac.adaptive.preemptive_rejection_ratio");
+    this->declare_parameter<bool>("processing_configuration.segmentation.ransac.adaptive.warm_start");
+    this->declare_parameter<bool>("processing_configuration.segmentation.temporal.enabled");
+    this->declare_parameter<std::int64_t>("processing_configuration.segmentation.temporal.max_cell_age");
+    this->declare_parameter<double>("processing_configuration.segmentation.temporal.cell_tolerance");
+    this->declare_parameter<double>("processing_configuration.segmentation.temporal.plane_inlier_retention");
+    this->declare_parameter<std::int64_t>("processing_configuration.segmentation.temporal.max_plane_age");
+    this->declare_parameter<std::string>("processing_configuration.clustering.algorithm");
+    this->declare_parameter<double>("processing_configuration.clustering.euclidean.cluster_tolerance");
+    this->declare_parameter<std::int64_t>("processing_configuration.clustering.euclidean.min_cluster_size");
+    this->declare_parameter<std::int64_t>("processing_configuration.clustering.euclidean.max_cluster_size");
+    this->declare_parameter<double>("processing_configuration.clustering.range_image.angle_threshold_deg");
+    this->declare_parameter<std::int64_t>("processing_configuration.clustering.range_image.min_cluster_size");
+    this->declare_parameter<std::int64_t>("processing_configuration.clustering.range_image.max_cluster_size");
+    this->declare_parameter<double>("processing_configuration.clustering.dbscan.epsilon");
+    this->declare_parameter<std::int64_t>("processing_configuration.clustering.dbscan.min_points");
+    this->declare_parameter<std::int64_t>("processing_configuration.clustering.dbscan.thread_count");
+    this->declare_parameter<bool>("processing_configuration.pipeline.enabled");
+    this->declare_parameter<std::int64_t>("processing_configuration.pipeline.queue_capacity");
+    this->declare_parameter<bool>("processing_configuration.fusion.enabled");
+    this->declare_parameter<std::string>("processing_configuration.fusion.calibration_path");
+    this->declare_parameter<std::vector<std::string>>("processing_configuration.fusion.camera_topics");
+    this->declare_parameter<std::vector<std::int64_t>>("processing_configuration.fusion.camera_indices");
+    this->declare_parameter<std::int64_t>("processing_configuration.fusion.cache_size");
+    this->declare_parameter<double>("processing_configuration.fusion.max_time_offset");
+    this->declare_parameter<std::int64_t>("processing_configuration.fusion.thread_count");
+    this->declare_parameter<std::string>("processing_configuration.fusion.points");
 
     processing_configuration_.height_offset = this->get_parameter("processing_configuration.height_offset").as_double();
 
@@ -168,6 +231,22 @@ LidarDataProcessorNode::LidarDataProcessorNode() : rclcpp::Node{"data_processor_
     processing_configuration_.bounding_box[3].x = bounding_box[6];
     processing_configuration_.bounding_box[3].y = bounding_box[7];
 
+    processing_configuration_.max_distance =
+        this->get_parameter("processing_configuration.max_distance").as_double();
+
+    auto &sensor_configuration = processing_configuration_.sensor;
+    sensor_configuration.model = this->get_parameter("processing_configuration.sensor.model").as_string();
+    sensor_configuration.min_elevation_deg =
+        this->get_parameter("processing_configuration.sensor.custom.min_elevation_deg").as_double();
+    sensor_configuration.vertical_field_of_view_deg =
+        this->get_parameter("processing_configuration.sensor.custom.vertical_field_of_view_deg").as_double();
+    sensor_configuration.vertical_resolution_deg =
+        this->get_parameter("processing_configuration.sensor.custom.vertical_resolution_deg").as_double();
+    sensor_configuration.horizontal_resolution_deg =
+        this->get_parameter("processing_configuration.sensor.custom.horizontal_resolution_deg").as_double();
+    sensor_configuration.max_cloud_points =
+        this->get_parameter("processing_configuration.sensor.custom.max_cloud_points").as_int();
+
     processing_configuration_.segmentation.algorithm =
         this->get_parameter("processing_configuration.segmentation.algorithm").as_string();
 
@@ -177,6 +256,84 @@ LidarDataProcessorNode::LidarDataProcessorNode() : rclcpp::Node{"data_processor_
         this->get_parameter("processing_configuration.segmentation.ransac.number_of_iterations").as_int();
     processing_configuration_.segmentation.ransac.thread_count =
         this->get_parameter("processing_configuration.segmentation.ransac.thread_count").as_int();
+    processing_configuration_.segmentation.ransac.horizontal_traversal_bands =
+        this->get_parameter("processing_configuration.segmentation.ransac.horizontal_traversal_bands").as_int();
+
+    auto &adaptive_configuration = processing_configuration_.segmentation.ransac.adaptive;
+    adaptive_configuration.enabled =
+        this->get_parameter("processing_configuration.segmentation.ransac.adaptive.enabled").as_bool();
+    adaptive_configuration.confidence =
+        this->get_parameter("processing_configuration.segmentation.ransac.adaptive.confidence").as_double();
+    adaptive_configuration.min_iterations =
+        this->get_parameter("processing_configuration.segmentation.ransac.adaptive.min_iterations").as_int();
+    adaptive_configuration.preemptive_sample_size =
+        this->get_parameter("processing_configuration.segmentation.ransac.adaptive.preemptive_sample_size").as_int();
+    adaptive_configuration.preemptive_rejection_ratio =
+        this->get_parameter("processing_configuration.segmentation.ransac.adaptive.preemptive_rejection_ratio")
+            .as_double();
+    adaptive_configuration.warm_start =
+        this->get_parameter("processing_configuration.segmentation.ransac.adaptive.warm_start").as_bool();
+
+    auto &temporal_configuration = processing_configuration_.segmentation.temporal;
+    temporal_configuration.enabled =
+        this->get_parameter("processing_configuration.segmentation.temporal.enabled").as_bool();
+    temporal_configuration.max_cell_age =
+        this->get_parameter("processing_configuration.segmentation.temporal.max_cell_age").as_int();
+    temporal_configuration.cell_tolerance =
+        this->get_parameter("processing_configuration.segmentation.temporal.cell_tolerance").as_double();
+    temporal_configuration.plane_inlier_retention =
+        this->get_parameter("processing_configuration.segmentation.temporal.plane_inlier_retention").as_double();
+    temporal_configuration.max_plane_age =
+        this->get_parameter("processing_configuration.segmentation.temporal.max_plane_age").as_int();
+
+    processing_configuration_.clustering.algorithm =
+        this->get_parameter("processing_configuration.clustering.algorithm").as_string();
+
+    auto &euclidean_configuration = processing_configuration_.clustering.euclidean;
+    euclidean_configuration.cluster_tolerance =
+        this->get_parameter("processing_configuration.clustering.euclidean.cluster_tolerance").as_double();
+    euclidean_configuration.min_cluster_size =
+        this->get_parameter("processing_configuration.clustering.euclidean.min_cluster_size").as_int();
+    euclidean_configuration.max_cluster_size =
+        this->get_parameter("processing_configuration.clustering.euclidean.max_cluster_size").as_int();
+
+    auto &range_image_configuration = processing_configuration_.clustering.range_image;
+    range_image_configuration.angle_threshold_deg =
+        this->get_parameter("processing_configuration.clustering.range_image.angle_threshold_deg").as_double();
+    range_image_configuration.min_cluster_size =
+        this->get_parameter("processing_configuration.clustering.range_image.min_cluster_size").as_int();
+    range_image_configuration.max_cluster_size =
+        this->get_parameter("processing_configuration.clustering.range_image.max_cluster_size").as_int();
+
+    auto &dbscan_configuration = processing_configuration_.clustering.dbscan;
+    dbscan_configuration.epsilon =
+        this->get_parameter("processing_configuration.clustering.dbscan.epsilon").as_double();
+    dbscan_configuration.min_points =
+        this->get_parameter("processing_configuration.clustering.dbscan.min_points").as_int();
+    dbscan_configuration.thread_count =
+        this->get_parameter("processing_configuration.clustering.dbscan.thread_count").as_int();
+
+    auto &pipeline_configuration = processing_configuration_.pipeline;
+    pipeline_configuration.enabled = this->get_parameter("processing_configuration.pipeline.enabled").as_bool();
+    pipeline_configuration.queue_capacity =
+        this->get_parameter("processing_configuration.pipeline.queue_capacity").as_int();
+
+    auto &fusion_configuration = processing_configuration_.fusion;
+    fusion_configuration.enabled = this->get_parameter("processing_configuration.fusion.enabled").as_bool();
+    fusion_configuration.calibration_path =
+        this->get_parameter("processing_configuration.fusion.calibration_path").as_string();
+    fusion_configuration.camera_topics =
+        this->get_parameter("processing_configuration.fusion.camera_topics").as_string_array();
+    for (const auto camera_index :
+         this->get_parameter("processing_configuration.fusion.camera_indices").as_integer_array())
+    {
+        fusion_configuration.camera_indices.push_back(static_cast<std::uint32_t>(camera_index));
+    }
+    fusion_configuration.cache_size = this->get_parameter("processing_configuration.fusion.cache_size").as_int();
+    fusion_configuration.max_time_offset =
+        this->get_parameter("processing_configuration.fusion.max_time_offset").as_double();
+    fusion_configuration.thread_count = this->get_parameter("processing_configuration.fusion.thread_count").as_int();
+    fusion_configuration.points = this->get_parameter("processing_configuration.fusion.points").as_string();
 
     // QoS
     rclcpp::QoS qos(2);
@@ -197,9 +354,19 @@ LidarDataProcessorNode::LidarDataProcessorNode() : rclcpp::Node{"data_processor_
     qos.deadline(std::chrono::seconds(1));
 
     // Subscriber(s)
-    subscriber_ =
-        this->create_subscription<PointCloud2>(this->get_parameter("subscription_topics.input_cloud").as_string(), qos,
-                                               std::bind(&LidarDataProcessorNode::run, this, std::placeholders::_1));
+    // Taking ownership of the message lets intra-process publishers hand it over without a copy
+    subscriber_ = this->create_subscription<PointCloud2>(
+        this->get_parameter("subscription_topics.input_cloud").as_string(), qos,
+        [this](PointCloud2::UniquePtr input_message) {
+            if (pipelined_)
+            {
+                enqueue(std::move(input_message));
+            }
+            else
+            {
+                run(*input_message);
+            }
+        });
 
     // Publisher(s)
     publisher_unknown_cloud_ = this->create_publisher<PointCloud2>(
@@ -210,157 +377,694 @@ LidarDataProcessorNode::LidarDataProcessorNode() : rclcpp::Node{"data_processor_
         this->get_parameter("publication_topics.segmentation.obstacle_cloud").as_string(), qos);
     publisher_clustered_cloud_ = this->create_publisher<PointCloud2>(
         this->get_parameter("publication_topics.clustering.clustered_cloud").as_string(), qos);
+    publisher_colorized_cloud_ = this->create_publisher<PointCloud2>(
+        this->get_parameter("publication_topics.fusion.colorized_cloud").as_string(), qos);
     publisher_polygonized_cloud_ = this->create_publisher<MarkerArray>(
         this->get_parameter("publication_topics.polygonization.polygonized_cloud").as_string(), qos);
+    publisher_diagnostics_ = this->create_publisher<DiagnosticArray>(
+        this->get_parameter("publication_topics.diagnostics").as_string(), qos);
+
+    // Diagnostics, the zones are collected on the timer instead of the processing threads
+    frame_budget_ms_ = this->get_parameter("diagnostics.frame_budget_ms").as_double();
+    if (pipeline_configuration.enabled)
+    {
+        budgeted_zones_ = {"lidar_data_processor.ingestion", "lidar_data_processor.segmentation",
+                           "lidar_data_processor.clustering", "lidar_data_processor.publication"};
+    }
+    else
+    {
+        budgeted_zones_ = {"lidar_data_processor.frame"};
+    }
+    const double diagnostics_period = this->get_parameter("diagnostics.period").as_double();
+    if (diagnostics_period <= 0.0)
+    {
+        throw std::runtime_error("Period of the diagnostics must be positive!");
+    }
+    diagnostics_timer_ = this->create_wall_timer(std::chrono::duration<double>(diagnostics_period),
+                                                 [this]() { publishDiagnostics(); });
+
+    const std::string chrome_trace_path = this->get_parameter("diagnostics.chrome_trace_path").as_string();
+    if (!chrome_trace_path.empty())
+    {
+        utilities_lib::Profiler::instance().startChromeTrace(chrome_trace_path);
+        chrome_trace_ = true;
+    }
 
     // Reserve memory
     initialize();
 
+    // Returns of the ego vehicle and of the far field are cropped off before any processing
+    using ConvexQuadCrop = lidar_processing_lib::filtering::ConvexQuadCrop;
+    std::array<lidar_processing_lib::filtering::QuadCorner, ConvexQuadCrop::NUMBER_OF_CORNERS> crop_corners;
+    for (std::size_t i = 0U; i < crop_corners.size(); ++i)
+    {
+        crop_corners[i] = {processing_configuration_.bounding_box[i].x, processing_configuration_.bounding_box[i].y};
+    }
+    crop_ptr_ = std::make_unique<ConvexQuadCrop>(crop_corners, processing_configuration_.max_distance);
+
+    // Sensors known at compile time are projected with compile-time image dimensions
+    lidar_processing_lib::segmentation::SensorProfile sensor_profile;
+    if (sensor_configuration.model == "custom")
+    {
+        sensor_profile.min_elevation_deg = sensor_configuration.min_elevation_deg;
+        sensor_profile.vertical_field_of_view_deg = sensor_configuration.vertical_field_of_view_deg;
+        sensor_profile.vertical_resolution_deg = sensor_configuration.vertical_resolution_deg;
+        sensor_profile.horizontal_resolution_deg = sensor_configuration.horizontal_resolution_deg;
+        sensor_profile.max_cloud_points = sensor_configuration.max_cloud_points;
+    }
+    else
+    {
+        sensor_profile = lidar_processing_lib::segmentation::sensorProfile(sensor_configuration.model);
+    }
+
+    // Depth image segmentation and range image clustering share the depth image of the input cloud in the serial mode
+    if ((processing_configuration_.segmentation.algorithm == "depth_image_segmentation") ||
+        (processing_configuration_.clustering.algorithm == "range_image"))
+    {
+        depth_image_ = std::make_shared<lidar_processing_lib::segmentation::DepthImage>(sensor_profile);
+    }
+
+    // The range image clusterer builds its own depth image of the obstacle points when the stages are pipelined
+    std::shared_ptr<lidar_processing_lib::segmentation::DepthImage> clustering_depth_image = depth_image_;
+    if (pipeline_configuration.enabled && (processing_configuration_.clustering.algorithm == "range_image"))
+    {
+        clustering_depth_image = std::make_shared<lidar_processing_lib::segmentation::DepthImage>(sensor_profile);
+    }
+
+    lidar_processing_lib::segmentation::TemporalGroundConfiguration temporal_ground_configuration;
+    temporal_ground_configuration.enabled = temporal_configuration.enabled;
+    temporal_ground_configuration.max_cell_age = temporal_configuration.max_cell_age;
+    temporal_ground_configuration.cell_tolerance = temporal_configuration.cell_tolerance;
+    temporal_ground_configuration.plane_inlier_retention = temporal_configuration.plane_inlier_retention;
+    temporal_ground_configuration.max_plane_age = temporal_configuration.max_plane_age;
+
     // Choose segmentation algorithm
     if (processing_configuration_.segmentation.algorithm == "ransac")
     {
+        lidar_processing_lib::segmentation::RansacAdaptiveConfiguration ransac_adaptive_configuration;
+        ransac_adaptive_configuration.enabled = adaptive_configuration.enabled;
+        ransac_adaptive_configuration.confidence = adaptive_configuration.confidence;
+        ransac_adaptive_configuration.min_iterations = adaptive_configuration.min_iterations;
+        ransac_adaptive_configuration.preemptive_sample_size = adaptive_configuration.preemptive_sample_size;
+        ransac_adaptive_configuration.preemptive_rejection_ratio = adaptive_configuration.preemptive_rejection_ratio;
+        ransac_adaptive_configuration.warm_start = adaptive_configuration.warm_start;
+
         segmenter_ptr_ = lidar_processing_lib::segmentation::ISegmenter::createUnique<
             lidar_processing_lib::segmentation::RansacSegmenter>(
             processing_configuration_.height_offset,
             processing_configuration_.segmentation.ransac.orthogonal_distance_threshold,
-            processing_configuration_.segmentation.ransac.number_of_iterations);
+            processing_configuration_.segmentation.ransac.number_of_iterations,
+            processing_configuration_.segmentation.ransac.thread_count, ransac_adaptive_configuration,
+            processing_configuration_.segmentation.ransac.horizontal_traversal_bands, temporal_ground_configuration);
+        ransac_segmenter_ =
+            static_cast<const lidar_processing_lib::segmentation::RansacSegmenter *>(segmenter_ptr_.get());
+
+        build_depth_image_ = (depth_image_ != nullptr) && !pipeline_configuration.enabled;
     }
     else if (processing_configuration_.segmentation.algorithm == "depth_image_segmentation")
     {
         segmenter_ptr_ = lidar_processing_lib::segmentation::ISegmenter::createUnique<
-            lidar_processing_lib::segmentation::DepthImageSegmenter>();
+            lidar_processing_lib::segmentation::DepthImageSegmenter>(depth_image_, temporal_ground_configuration);
     }
     else
     {
         throw std::runtime_error("Unknown segmentation algorithm!");
     }
+
+    // Choose clustering algorithm
+    if (processing_configuration_.clustering.algorithm == "euclidean")
+    {
+        clusterer_ptr_ = lidar_processing_lib::clustering::IClusterer::createUnique<
+            lidar_processing_lib::clustering::CartesianEuclideanClusterer>(
+            euclidean_configuration.cluster_tolerance, euclidean_configuration.min_cluster_size,
+            euclidean_configuration.max_cluster_size);
+    }
+    else if (processing_configuration_.clustering.algorithm == "dbscan")
+    {
+        clusterer_ptr_ = lidar_processing_lib::clustering::IClusterer::createUnique<
+            lidar_processing_lib::clustering::CartesianDBSCAN>(
+            dbscan_configuration.epsilon, dbscan_configuration.min_points, dbscan_configuration.thread_count);
+    }
+    else if (processing_configuration_.clustering.algorithm == "range_image")
+    {
+        clusterer_ptr_ = lidar_processing_lib::clustering::IClusterer::createUnique<
+            lidar_processing_lib::clustering::RangeImageClusterer>(
+            clustering_depth_image, range_image_configuration.angle_threshold_deg,
+            range_image_configuration.min_cluster_size, range_image_configuration.max_cluster_size);
+        if (!pipeline_configuration.enabled)
+        {
+            range_image_clusterer_ =
+                static_cast<lidar_processing_lib::clustering::RangeImageClusterer *>(clusterer_ptr_.get());
+        }
+    }
+    else
+    {
+        throw std::runtime_error("Unknown clustering algorithm!");
+    }
+
+    // Every camera projects with its lidar to image matrix, composed once from the calibration
+    if (fusion_configuration.enabled)
+    {
+        // The serial mode processes the frames on the executor thread of the subscriptions, which would then not
+        // receive the camera images while a frame is processed
+        if (!pipeline_configuration.enabled)
+        {
+            throw std::runtime_error("Fusion needs the pipelined mode!");
+        }
+
+        if (fusion_configuration.camera_topics.empty() ||
+            (fusion_configuration.camera_topics.size() != fusion_configuration.camera_indices.size()))
+        {
+            throw std::runtime_error("Fusion needs one Kitti camera index per camera topic!");
+        }
+
+        if ((fusion_configuration.points != "segmented") && (fusion_configuration.points != "obstacles"))
+        {
+            throw std::runtime_error("Unknown points of the fusion!");
+        }
+        colorize_obstacles_ = (fusion_configuration.points == "obstacles");
+
+        std::vector<lidar_processing_lib::fusion::CameraCalibration> calibrations;
+        for (const auto camera_index : fusion_configuration.camera_indices)
+        {
+            calibrations.push_back(lidar_processing_lib::fusion::loadKittiCameraCalibration(
+                fusion_configuration.calibration_path, camera_index));
+        }
+        colorizer_ptr_ = std::make_unique<lidar_processing_lib::fusion::PointCloudColorizer>(
+            std::move(calibrations), fusion_configuration.thread_count);
+        max_time_offset_ns_ =
+            static_cast<std::int64_t>(static_cast<double>(fusion_configuration.max_time_offset) * 1e9);
+
+        const std::size_t number_of_cameras = fusion_configuration.camera_topics.size();
+        image_caches_ = std::vector<ImageCache>(number_of_cameras);
+        fused_images_.resize(number_of_cameras);
+        fused_image_views_.resize(number_of_cameras);
+        colorized_rgb_.reserve(MAX_CLOUD_SIZE);
+        colorized_cameras_.reserve(MAX_CLOUD_SIZE);
+
+        // Images are shared with the cache instead of being copied out of the message
+        for (std::size_t camera = 0U; camera < number_of_cameras; ++camera)
+        {
+            image_caches_[camera].reserve(fusion_configuration.cache_size);
+            camera_subscribers_.push_back(this->create_subscription<Image>(
+                fusion_configuration.camera_topics[camera], qos,
+                [this, camera](Image::ConstSharedPtr image) { image_caches_[camera].push(std::move(image)); }));
+        }
+    }
+
+    if (pipeline_configuration.enabled)
+    {
+        startPipeline(pipeline_configuration.queue_capacity);
+    }
 }
 
-void LidarDataProcessorNode::run(const PointCloud2 &input_message)
+data_types_lib::PointCloudLayout LidarDataProcessorNode::resolveLayout(const PointCloud2 &message)
 {
-    RCLCPP_INFO(this->get_logger(), "%s", "Received_message");
+    data_types_lib::PointCloudLayout layout;
+    layout.point_step = message.point_step;
 
-    // Transfer points from the message to the processing format
-    pcl::PointXYZI point_cache;
-    segmenter_input_cloud_.points.clear();
-    for (std::uint32_t i = 0U; i < input_message.height; ++i)
+    for (const auto &field : message.fields)
     {
-        const std::uint32_t row_offset = i * input_message.row_step;
+        if ((field.datatype != PointField::FLOAT32) || (field.count < 1U))
+        {
+            continue;
+        }
 
-        for (std::uint32_t j = 0U; j < input_message.width; ++j)
+        if (field.name == "x")
         {
-            // Offset to the start of the point
-            const std::uint32_t point_offset = row_offset + (j * input_message.point_step);
+            layout.x_offset = field.offset;
+        }
+        else if (field.name == "y")
+        {
+            layout.y_offset = field.offset;
+        }
+        else if (field.name == "z")
+        {
+            layout.z_offset = field.offset;
+        }
+        else if (field.name == "intensity")
+        {
+            layout.intensity_offset = field.offset;
+        }
+    }
+
+    return layout;
+}
 
-            // Copy the point data
-            std::memcpy(&point_cache, &input_message.data[point_offset], input_message.point_step);
-            segmenter_input_cloud_.points.push_back(point_cache);
+bool LidarDataProcessorNode::haveSameFields(const std::vector<PointField> &fields,
+                                            const std::vector<PointField> &other_fields)
+{
+    if (fields.size() != other_fields.size())
+    {
+        return false;
+    }
+
+    for (std::size_t i = 0U; i < fields.size(); ++i)
+    {
+        if ((fields[i].offset != other_fields[i].offset) || (fields[i].datatype != other_fields[i].datatype) ||
+            (fields[i].count != other_fields[i].count) || (fields[i].name != other_fields[i].name))
+        {
+            return false;
         }
     }
-    segmenter_input_cloud_.width = input_message.width;
-    segmenter_input_cloud_.height = input_message.height;
 
-    // Crop off point cloud to the bounding box
+    return true;
+}
 
-    // Segment
-    segmenter_ptr_->run(segmenter_input_cloud_, segmentation_labels_);
+void LidarDataProcessorNode::packSegmentedClouds(const Frame &frame)
+{
+    static constexpr auto LABEL_TO_CLOUD_INDEX = makeLabelToCloudIndexTable();
 
-    // Convert and publish
-    pcl::PointXYZRGB unknown_point_cache{0.0F, 0.0F, 0.0F, 255U, 255U, 0U};  // Yellow
-    pcl::PointXYZRGB ground_point_cache{0.0F, 0.0F, 0.0F, 220U, 220U, 220U}; // Ground
-    pcl::PointXYZRGB obstacle_point_cache{0.0F, 0.0F, 0.0F, 0U, 255U, 0U};   // Obstacle
+    const std::array<PointCloud2 *, NUMBER_OF_SEGMENTED_CLOUDS> segmented_clouds{&unknown_cloud_, &ground_cloud_,
+                                                                                 &obstacle_cloud_};
 
-    unknown_cloud_.data.clear();
-    ground_cloud_.data.clear();
-    obstacle_cloud_.data.clear();
+    std::array<pcl::PointXYZRGB, NUMBER_OF_SEGMENTED_CLOUDS> point_caches{
+        pcl::PointXYZRGB{0.0F, 0.0F, 0.0F, 255U, 255U, 0U},   // Yellow
+        pcl::PointXYZRGB{0.0F, 0.0F, 0.0F, 220U, 220U, 220U}, // Ground
+        pcl::PointXYZRGB{0.0F, 0.0F, 0.0F, 0U, 255U, 0U}};    // Obstacle
 
-    std::uint32_t point_index = 0U;
+    // Count points of each cloud so that every output buffer is sized exactly once
+    std::array<std::uint32_t, NUMBER_OF_SEGMENTED_CLOUDS + 1U> point_counts{};
+    for (const auto label : frame.segmentation_labels)
+    {
+        ++point_counts[LABEL_TO_CLOUD_INDEX[static_cast<std::uint8_t>(label)]];
+    }
+
+    if (point_counts[DISCARDED_CLOUD_INDEX] > 0U)
+    {
+        RCLCPP_ERROR(this->get_logger(), "Discarded %u points with invalid segmentation labels",
+                     point_counts[DISCARDED_CLOUD_INDEX]);
+    }
+
+    std::array<std::uint8_t *, NUMBER_OF_SEGMENTED_CLOUDS> write_positions{};
+    for (std::uint8_t cloud_index = 0U; cloud_index < NUMBER_OF_SEGMENTED_CLOUDS; ++cloud_index)
+    {
+        auto &segmented_cloud = *segmented_clouds[cloud_index];
+        segmented_cloud.header = frame.header;
+        segmented_cloud.width = point_counts[cloud_index];
+        segmented_cloud.row_step = segmented_cloud.width * segmented_cloud.point_step;
+        segmented_cloud.data.resize(segmented_cloud.row_step);
+        write_positions[cloud_index] = segmented_cloud.data.data();
+    }
 
-    for (std::uint32_t i = 0U; i < input_message.height; ++i)
+    // Scatter points in a single pass, the label selects the output cloud and its colour
+    for (std::size_t i = 0U; i < frame.segmentation_labels.size(); ++i)
     {
-        for (std::uint32_t j = 0U; j < input_message.width; ++j)
+        const std::uint8_t cloud_index =
+            LABEL_TO_CLOUD_INDEX[static_cast<std::uint8_t>(frame.segmentation_labels[i])];
+        if (cloud_index == DISCARDED_CLOUD_INDEX)
         {
-            // Offset to the start of the point
-            const auto &point = segmenter_input_cloud_.points[point_index];
-
-            constexpr auto copyPoint = [](const pcl::PointXYZI &point, pcl::PointXYZRGB &point_cache,
-                                          PointCloud2 &cloud) -> void {
-                point_cache.x = point.x;
-                point_cache.y = point.y;
-                point_cache.z = point.z;
-                const auto current_size = cloud.data.size();
-                cloud.data.resize(current_size + sizeof(point_cache));
-                std::memcpy(cloud.data.data() + current_size, &point_cache, sizeof(point_cache));
-            };
-
-            switch (segmentation_labels_[point_index])
-            {
-            case data_types_lib::SegmentationLabel::UNKNOWN: {
-                copyPoint(point, unknown_point_cache, unknown_cloud_);
-                break;
-            }
-            case data_types_lib::SegmentationLabel::GROUND: {
-                copyPoint(point, ground_point_cache, ground_cloud_);
-                break;
-            }
-            case data_types_lib::SegmentationLabel::OBSTACLE: {
-                copyPoint(point, obstacle_point_cache, obstacle_cloud_);
-                break;
-            }
-            case data_types_lib::SegmentationLabel::TRANSITIONAL_GROUND: {
-                copyPoint(point, ground_point_cache, ground_cloud_);
-                break;
-            }
-            case data_types_lib::SegmentationLabel::TRANSITIONAL_OBSTACLE: {
-                copyPoint(point, obstacle_point_cache, obstacle_cloud_);
-                break;
-            }
-            default: {
-                RCLCPP_ERROR(this->get_logger(), "Provided invalid segmentation label: %u",
-                             static_cast<std::uint32_t>(segmentation_labels_[point_index]));
-                break;
-            }
-            }
+            continue;
+        }
+
+        const auto point = frame.cropped_cloud.points[i];
+        auto &point_cache = point_caches[cloud_index];
+        point_cache.x = point.x;
+        point_cache.y = point.y;
+        point_cache.z = point.z;
+
+        std::memcpy(write_positions[cloud_index], &point_cache, sizeof(point_cache));
+        write_positions[cloud_index] += sizeof(point_cache);
+    }
+}
+
+void LidarDataProcessorNode::packClusteredCloud(const Frame &frame)
+{
+    // Neighbouring clusters are likely to have consecutive labels, so consecutive colours are kept distinct
+    static const std::array<pcl::PointXYZRGB, 8U> cluster_colours{
+        pcl::PointXYZRGB{0.0F, 0.0F, 0.0F, 230U, 25U, 75U},   pcl::PointXYZRGB{0.0F, 0.0F, 0.0F, 60U, 180U, 75U},
+        pcl::PointXYZRGB{0.0F, 0.0F, 0.0F, 0U, 130U, 200U},   pcl::PointXYZRGB{0.0F, 0.0F, 0.0F, 245U, 130U, 48U},
+        pcl::PointXYZRGB{0.0F, 0.0F, 0.0F, 145U, 30U, 180U},  pcl::PointXYZRGB{0.0F, 0.0F, 0.0F, 70U, 240U, 240U},
+        pcl::PointXYZRGB{0.0F, 0.0F, 0.0F, 240U, 50U, 230U},  pcl::PointXYZRGB{0.0F, 0.0F, 0.0F, 210U, 245U, 60U}};
+
+    // Outliers and unclustered points are not published
+    std::uint32_t point_count = 0U;
+    for (const auto label : frame.clustering_labels)
+    {
+        point_count += (label >= 0) ? 1U : 0U;
+    }
+
+    clustered_cloud_.header = frame.header;
+    clustered_cloud_.width = point_count;
+    clustered_cloud_.row_step = clustered_cloud_.width * clustered_cloud_.point_step;
+    clustered_cloud_.data.resize(clustered_cloud_.row_step);
+
+    std::uint8_t *write_position = clustered_cloud_.data.data();
+    for (std::size_t i = 0U; i < frame.clustering_labels.size(); ++i)
+    {
+        const auto label = frame.clustering_labels[i];
+        if (label < 0)
+        {
+            continue;
+        }
+
+        const auto point = frame.obstacle_cloud.points[i];
+        auto point_cache = cluster_colours[static_cast<std::size_t>(label) % cluster_colours.size()];
+        point_cache.x = point.x;
+        point_cache.y = point.y;
+        point_cache.z = point.z;
+
+        std::memcpy(write_position, &point_cache, sizeof(point_cache));
+        write_position += sizeof(point_cache);
+    }
+}
+
+bool LidarDataProcessorNode::ingestFrame(Frame &frame, const PointCloud2 &input_message)
+{
+    UTILITIES_PROFILE_ZONE("lidar_data_processor.ingestion");
+
+    // A publisher may reorder or rename the fields at the same point step
+    if ((input_layout_.point_step != input_message.point_step) || !haveSameFields(input_fields_, input_message.fields))
+    {
+        input_layout_ = resolveLayout(input_message);
+        input_fields_ = input_message.fields;
+    }
+
+    if (!input_layout_.isValid())
+    {
+        RCLCPP_ERROR(this->get_logger(), "%s", "Input cloud does not contain FLOAT32 x, y and z fields");
+        return false;
+    }
+
+    if (input_message.data.size() < (static_cast<std::size_t>(input_message.row_step) * input_message.height))
+    {
+        RCLCPP_ERROR(this->get_logger(), "%s", "Input cloud data is smaller than row_step * height");
+        return false;
+    }
+
+    // Points of a row are read up to width * point_step bytes past the start of the row
+    if (input_message.row_step < (static_cast<std::size_t>(input_message.width) * input_message.point_step))
+    {
+        RCLCPP_ERROR(this->get_logger(), "%s", "Input cloud row_step is smaller than width * point_step");
+        return false;
+    }
+
+    // View points in place, without copying them out of the message
+    frame.header = input_message.header;
+    frame.input_cloud = data_types_lib::PointCloudView{input_message.data.data(), input_message.width,
+                                                       input_message.height, input_message.row_step, input_layout_};
+
+    // Crop off point cloud to the bounding box and the maximum distance, only the kept points are decoded into the
+    // structure-of-arrays cloud of the later stages
+    crop_ptr_->run(frame.input_cloud, frame.crop_indices);
+    lidar_processing_lib::filtering::ingestPointCloud(
+        data_types_lib::PointCloudView{frame.input_cloud, frame.crop_indices.data(), frame.crop_indices.size()},
+        frame.cropped_cloud);
+
+    return true;
+}
+
+void LidarDataProcessorNode::segmentFrame(Frame &frame)
+{
+    UTILITIES_PROFILE_ZONE("lidar_data_processor.segmentation");
+
+    segmenter_ptr_->run(frame.cropped_cloud, frame.segmentation_labels);
+    if (ransac_segmenter_ != nullptr)
+    {
+        reclassified_points_ += ransac_segmenter_->reclassifiedPoints();
+    }
 
-            ++point_index;
+    // Obstacle points are selected in the order of the cropped cloud, as they are packed
+    frame.obstacle_indices.clear();
+    for (std::size_t i = 0U; i < frame.segmentation_labels.size(); ++i)
+    {
+        const auto label = frame.segmentation_labels[i];
+        if ((label == data_types_lib::SegmentationLabel::OBSTACLE) ||
+            (label == data_types_lib::SegmentationLabel::TRANSITIONAL_OBSTACLE))
+        {
+            frame.obstacle_indices.push_back(static_cast<std::uint32_t>(i));
         }
     }
+    lidar_processing_lib::filtering::selectPoints(frame.cropped_cloud, frame.obstacle_indices.data(),
+                                                  frame.obstacle_indices.size(), frame.obstacle_cloud);
+}
 
-    unknown_cloud_.width = unknown_cloud_.data.size() / sizeof(pcl::PointXYZRGB);
-    unknown_cloud_.header = input_message.header;
+void LidarDataProcessorNode::clusterFrame(Frame &frame)
+{
+    UTILITIES_PROFILE_ZONE("lidar_data_processor.clustering");
 
-    ground_cloud_.width = ground_cloud_.data.size() / sizeof(pcl::PointXYZRGB);
-    ground_cloud_.header = input_message.header;
+    if (range_image_clusterer_ != nullptr)
+    {
+        // Labels of the obstacle points come in the order of the cropped cloud, as the obstacle cloud was collected
+        if (build_depth_image_)
+        {
+            depth_image_->build(frame.cropped_cloud);
+        }
+        range_image_clusterer_->clusterObstacles(frame.segmentation_labels, frame.clustering_labels);
+    }
+    else
+    {
+        clusterer_ptr_->run(frame.obstacle_cloud, frame.clustering_labels);
+    }
+}
 
-    obstacle_cloud_.width = obstacle_cloud_.data.size() / sizeof(pcl::PointXYZRGB);
-    obstacle_cloud_.header = input_message.header;
+lidar_processing_lib::fusion::CameraImageView LidarDataProcessorNode::viewImage(const Image &image)
+{
+    using lidar_processing_lib::fusion::ImageEncoding;
 
-    // Publish
-    publisher_unknown_cloud_->publish(unknown_cloud_);
-    publisher_ground_cloud_->publish(ground_cloud_);
-    publisher_obstacle_cloud_->publish(obstacle_cloud_);
+    lidar_processing_lib::fusion::CameraImageView image_view;
+    if (((image.encoding != "bgr8") && (image.encoding != "rgb8")) ||
+        (image.data.size() < (static_cast<std::size_t>(image.step) * image.height)))
+    {
+        return image_view;
+    }
+
+    image_view.data = image.data.data();
+    image_view.width = image.width;
+    image_view.height = image.height;
+    image_view.row_step = image.step;
+    image_view.encoding = (image.encoding == "rgb8") ? ImageEncoding::RGB8 : ImageEncoding::BGR8;
+    return image_view;
 }
 
-int main(int argc, char **argv)
+void LidarDataProcessorNode::packColorizedCloud(const Frame &frame, const data_types_lib::PointCloudSoA &cloud)
 {
-    rclcpp::init(argc, argv);
-    rclcpp::install_signal_handlers();
+    using lidar_processing_lib::fusion::PointCloudColorizer;
+
+    // Points not seen by any camera are not published
+    std::uint32_t point_count = 0U;
+    for (const auto camera : colorized_cameras_)
+    {
+        point_count += (camera != PointCloudColorizer::NO_CAMERA) ? 1U : 0U;
+    }
 
+    colorized_cloud_.header = frame.header;
+    colorized_cloud_.width = point_count;
+    colorized_cloud_.row_step = colorized_cloud_.width * colorized_cloud_.point_step;
+    colorized_cloud_.data.resize(colorized_cloud_.row_step);
+
+    std::uint8_t *write_position = colorized_cloud_.data.data();
+    pcl::PointXYZRGB point_cache;
+    for (std::size_t i = 0U; i < colorized_cameras_.size(); ++i)
+    {
+        if (colorized_cameras_[i] == PointCloudColorizer::NO_CAMERA)
+        {
+            continue;
+        }
+
+        const auto point = cloud.points[i];
+        point_cache.x = point.x;
+        point_cache.y = point.y;
+        point_cache.z = point.z;
+        point_cache.rgba = 0xFF000000U | colorized_rgb_[i];
+
+        std::memcpy(write_position, &point_cache, sizeof(point_cache));
+        write_position += sizeof(point_cache);
+    }
+}
+
+void LidarDataProcessorNode::fuseFrame(const Frame &frame)
+{
+    UTILITIES_PROFILE_ZONE("lidar_data_processor.fusion");
+
+    const data_types_lib::PointCloudSoA &cloud = colorize_obstacles_ ? frame.obstacle_cloud : frame.cropped_cloud;
+
+    // The subscriptions may replace the cached images meanwhile, the looked up images are kept until the frame is
+    // packed
+    for (std::size_t camera = 0U; camera < image_caches_.size(); ++camera)
+    {
+        fused_images_[camera] = image_caches_[camera].findClosest(frame.header.stamp, max_time_offset_ns_);
+        fused_image_views_[camera] = (fused_images_[camera] != nullptr)
+                                         ? viewImage(*fused_images_[camera])
+                                         : lidar_processing_lib::fusion::CameraImageView{};
+        if (fused_image_views_[camera].data == nullptr)
+        {
+            ++missing_camera_images_;
+        }
+    }
+
+    colorizer_ptr_->run(cloud, fused_image_views_, colorized_rgb_, colorized_cameras_);
+    packColorizedCloud(frame, cloud);
+
+    for (auto &fused_image : fused_images_)
+    {
+        fused_image.reset();
+    }
+}
+
+void LidarDataProcessorNode::publishFrame(Frame &frame)
+{
+    UTILITIES_PROFILE_ZONE("lidar_data_processor.publication");
+
+    packSegmentedClouds(frame);
+    packClusteredCloud(frame);
+    if (colorizer_ptr_ != nullptr)
+    {
+        fuseFrame(frame);
+    }
+
+    output_message_copies_ = 0U;
+    publishCloud(*publisher_unknown_cloud_, unknown_cloud_);
+    publishCloud(*publisher_ground_cloud_, ground_cloud_);
+    publishCloud(*publisher_obstacle_cloud_, obstacle_cloud_);
+    publishCloud(*publisher_clustered_cloud_, clustered_cloud_);
+    if (colorizer_ptr_ != nullptr)
+    {
+        publishCloud(*publisher_colorized_cloud_, colorized_cloud_);
+    }
+}
+
+void LidarDataProcessorNode::run(const PointCloud2 &input_message)
+{
+    RCLCPP_INFO(this->get_logger(), "%s", "Received_message");
+
+    // Latency of the whole frame, the stages of the pipelined mode overlap and are profiled separately
+    UTILITIES_PROFILE_ZONE("lidar_data_processor.frame");
+
+    if (!ingestFrame(serial_frame_, input_message))
+    {
+        return;
+    }
+
+    // A failing stage drops the frame as in the pipelined mode, the node keeps processing the next ones
     try
     {
-        auto node = std::make_shared<LidarDataProcessorNode>();
-        rclcpp::spin(node);
+        segmentFrame(serial_frame_);
+        clusterFrame(serial_frame_);
+        publishFrame(serial_frame_);
     }
-    catch (const std::exception &ex)
+    catch (const std::exception &exception)
     {
-        std::cerr << "Exception: " << ex.what() << std::endl;
+        RCLCPP_ERROR(this->get_logger(), "Dropped frame: %s", exception.what());
     }
-    catch (...)
+}
+
+void LidarDataProcessorNode::enqueue(PointCloud2::UniquePtr input_message)
+{
+    RCLCPP_INFO(this->get_logger(), "%s", "Received_message");
+
+    // Free frames run out only while a stage is behind by more frames than the pipeline holds
+    Frame *frame = nullptr;
+    if (!free_frames_->tryPop(frame))
     {
-        std::cerr << "Unknown exception." << std::endl;
+        RCLCPP_ERROR(this->get_logger(), "%s", "No free frame, dropped the input message");
+        return;
     }
 
-    rclcpp::shutdown();
+    // The views of the frame point into the owned message buffer
+    frame->input_message = std::move(input_message);
+    if (!ingestFrame(*frame, *frame->input_message))
+    {
+        recycleFrame(frame);
+        return;
+    }
 
-    return 0;
+    segmentation_link_->push(frame);
 }
+
+void LidarDataProcessorNode::publishDiagnostics()
+{
+    using DiagnosticStatus = diagnostic_msgs::msg::DiagnosticStatus;
+    using KeyValue = diagnostic_msgs::msg::KeyValue;
+
+    const auto key_value = [](const char *key, const auto value) {
+        KeyValue entry;
+        entry.key = key;
+        entry.value = std::to_string(value);
+        return entry;
+    };
+
+    utilities_lib::Profiler &profiler = utilities_lib::Profiler::instance();
+    profiler.collect();
+
+    diagnostics_.header.stamp = this->now();
+    diagnostics_.status.clear();
+    for (const auto &zone : profiler.statistics())
+    {
+        DiagnosticStatus status;
+        status.name = "lidar_data_processor_node: " + zone.name;
+        status.hardware_id = "lidar";
+        const bool is_budgeted =
+            (std::find(budgeted_zones_.begin(), budgeted_zones_.end(), zone.name) != budgeted_zones_.end());
+        const bool over_budget = is_budgeted && (zone.p99_ms > frame_budget_ms_);
+        status.level = over_budget ? DiagnosticStatus::WARN : DiagnosticStatus::OK;
+        if (!is_budgeted)
+        {
+            status.message = "No budget";
+        }
+        else
+        {
+            status.message = over_budget ? "p99 latency exceeds the frame budget" : "Within the frame budget";
+        }
+        status.values = {key_value("count", zone.count), key_value("p50_ms", zone.p50_ms),
+                         key_value("p99_ms", zone.p99_ms), key_value("max_ms", zone.max_ms)};
+        diagnostics_.status.push_back(std::move(status));
+    }
+
+    // Counters of the node, reported once per period instead of once per frame
+    DiagnosticStatus status;
+    status.name = "lidar_data_processor_node";
+    status.hardware_id = "lidar";
+    status.level = DiagnosticStatus::OK;
+    status.message = "Processing";
+    status.values = {key_value("dropped_frames", dropped_frames_.load()),
+                     key_value("output_message_copies", output_message_copies_.load()),
+                     key_value("output_message_pool_misses", output_message_pool_.misses()),
+                     key_value("missing_camera_images", missing_camera_images_.load()),
+                     key_value("reclassified_points", reclassified_points_.load()),
+                     key_value("dropped_profile_events", profiler.droppedEvents())};
+    diagnostics_.status.push_back(std::move(status));
+
+    publisher_diagnostics_->publish(diagnostics_);
+}
+
+void LidarDataProcessorNode::publishCloud(rclcpp::Publisher<PointCloud2> &publisher, PointCloud2 &cloud)
+{
+    // Middleware owned memory (e.g. shared memory transports), the loaned message is published without serialization
+    if (publisher.can_loan_messages())
+    {
+        // The buffer is moved into the loaned message, the cloud continues with a preallocated message of the pool
+        auto loaned_message = publisher.borrow_loaned_message();
+        std::swap(loaned_message.get(), cloud);
+        cloud = std::move(*output_message_pool_.take());
+        publisher.publish(std::move(loaned_message));
+        return;
+    }
+
+    // Subscribers of other processes (e.g. RViz) get the message serialized, also when it is handed over
+    const std::size_t intra_process_subscriptions = publisher.get_intra_process_subscription_count();
+    if (publisher.get_subscription_count() > intra_process_subscriptions)
+    {
+        ++output_message_copies_;
+    }
+
+    // Ownership of the buffer is passed to the intra-process subscribers, the cloud continues with a preallocated
+    // message of the pool. rclcpp copies the message for each further subscriber taking ownership (counted as copies,
+    // subscribers of shared messages share one)
+    if (use_intra_process_comms_ && (intra_process_subscriptions > 0U))
+    {
+        output_message_copies_ += static_cast<std::uint32_t>(intra_process_subscriptions - 1U);
+
+        PointCloud2::UniquePtr message = output_message_pool_.take();
+        std::swap(*message, cloud);
+        publisher.publish(std::move(message));
+        return;
+    }
+
+    // Only serialized, the buffer is kept for the next frame
+    publisher.publish(cloud);
+}
+
+// Loadable into a component container
+#include <rclcpp_components/register_node_macro.hpp>
+RCLCPP_COMPONENTS_REGISTER_NODE(LidarDataProcessorNode)
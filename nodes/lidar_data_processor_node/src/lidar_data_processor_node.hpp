@@ -0,0 +1,296 @@
+#ifndef LIDAR_DATA_PROCESSOR_NODE_HPP
+#define LIDAR_DATA_PROCESSOR_NODE_HPP
+
+// Configuration
+#include "processing_configuration.hpp"
+
+// Pipelining
+#include "frame_pipeline.hpp"
+
+// Output messages handed over in the intra-process mode
+#include "message_pool.hpp"
+
+// Camera synchronization
+#include "image_cache.hpp"
+
+// Data types
+#include <data_types_lib/point_cloud_view.hpp> // PointCloudView, PointCloudLayout
+
+// Utilities
+#include <utilities_lib/mpmc_queue.hpp> // MPMCQueue
+#include <utilities_lib/profiler.hpp>   // Profiler, UTILITIES_PROFILE_ZONE
+
+// Processing
+#include <lidar_processing_lib/clustering/cartesian_dbscan.hpp>
+#include <lidar_processing_lib/clustering/cartesian_euclidean_clusterer.hpp>
+#include <lidar_processing_lib/clustering/range_image_clusterer.hpp>
+#include <lidar_processing_lib/filtering/convex_quad_crop.hpp>
+#include <lidar_processing_lib/filtering/point_cloud_ingest.hpp>
+#include <lidar_processing_lib/fusion/camera_calibration.hpp>
+#include <lidar_processing_lib/fusion/point_cloud_colorizer.hpp>
+#include <lidar_processing_lib/segmentation/depth_image.hpp>
+#include <lidar_processing_lib/segmentation/depth_image_segmenter.hpp>
+#include <lidar_processing_lib/segmentation/ransac_segmenter.hpp>
+
+// ROS2
+#include <diagnostic_msgs/msg/diagnostic_array.hpp> // diagnostic_msgs::msg::DiagnosticArray
+#include <rclcpp/node.hpp>                          // rclcpp::Node
+#include <rclcpp/node_options.hpp>                  // rclcpp::NodeOptions
+#include <rclcpp/publisher.hpp>                     // rclcpp::Publisher
+#include <rclcpp/qos.hpp>                           // rclcpp::QoS
+#include <rclcpp/subscription.hpp>                  // rclcpp::Subscription
+#include <rclcpp/timer.hpp>                         // rclcpp::TimerBase
+#include <sensor_msgs/msg/image.hpp>                // sensor_msgs::msg::Image
+#include <sensor_msgs/msg/point_cloud2.hpp>         // sensor_msgs::msg::PointCloud2
+#include <sensor_msgs/msg/point_field.hpp>          // sensor_msgs::msg::PointField
+#include <std_msgs/msg/header.hpp>                  // std_msgs::msg::Header
+#include <visualization_msgs/msg/marker_array.hpp>  // visualization_msgs::msg::MarkerArray
+
+// STL
+#include <algorithm>  // std::find
+#include <array>      // std::array
+#include <atomic>     // std::atomic
+#include <chrono>     // std::chrono
+#include <cstring>    // std::memcpy
+#include <exception>  // std::exception
+#include <functional> // std::ref
+#include <memory>     // std::make_unique, std::shared_ptr
+#include <string>     // std::string
+#include <thread>     // std::thread
+#include <tuple>      // std::tuple
+#include <utility>    // std::swap
+#include <vector>     // std::vector
+
+class LidarDataProcessorNode final : public rclcpp::Node
+{
+  public:
+    static constexpr std::uint32_t MAX_CLOUD_SIZE = 250'000U;
+
+    using PointCloud2 = sensor_msgs::msg::PointCloud2;
+    using PointField = sensor_msgs::msg::PointField;
+    using Image = sensor_msgs::msg::Image;
+    using MarkerArray = visualization_msgs::msg::MarkerArray;
+    using DiagnosticArray = diagnostic_msgs::msg::DiagnosticArray;
+    using Header = std_msgs::msg::Header;
+
+    // Clouds published by the segmentation stage
+    static constexpr std::uint8_t UNKNOWN_CLOUD_INDEX = 0U;
+    static constexpr std::uint8_t GROUND_CLOUD_INDEX = 1U;
+    static constexpr std::uint8_t OBSTACLE_CLOUD_INDEX = 2U;
+    static constexpr std::uint8_t NUMBER_OF_SEGMENTED_CLOUDS = 3U;
+
+    // Points with invalid labels are not published
+    static constexpr std::uint8_t DISCARDED_CLOUD_INDEX = NUMBER_OF_SEGMENTED_CLOUDS;
+
+    // Segmented, clustered and colorized clouds published per frame
+    static constexpr std::size_t NUMBER_OF_OUTPUT_CLOUDS = NUMBER_OF_SEGMENTED_CLOUDS + 2U;
+
+    // Copy and move operations are not allowed.
+    LidarDataProcessorNode(const LidarDataProcessorNode &) = delete;
+    LidarDataProcessorNode(LidarDataProcessorNode &&) = delete;
+    LidarDataProcessorNode &operator=(const LidarDataProcessorNode &) = delete;
+    LidarDataProcessorNode &operator=(LidarDataProcessorNode &&) = delete;
+
+    /// @brief Constructor of the node.
+    /// @param options - With use_intra_process_comms enabled, messages are exchanged by std::unique_ptr with nodes of
+    /// the same process.
+    explicit LidarDataProcessorNode(const rclcpp::NodeOptions &options = rclcpp::NodeOptions{});
+
+    /// @brief Destructor of the node, stops the stage threads of the pipelined mode and completes the Chrome trace.
+    ~LidarDataProcessorNode();
+
+    /// @brief Replay sensor data.
+    void run(const PointCloud2 &input_message);
+
+    /// @brief Hands the message over to the stage threads of the pipelined mode, the frame is processed while the
+    /// next messages are received.
+    void enqueue(PointCloud2::UniquePtr input_message);
+
+  private:
+    // A subscriber that receives raw lidar data.
+    rclcpp::Subscription<PointCloud2>::SharedPtr subscriber_;
+
+    // Ground segmentation data publishers
+    rclcpp::Publisher<PointCloud2>::SharedPtr publisher_unknown_cloud_;
+    PointCloud2 unknown_cloud_;
+
+    rclcpp::Publisher<PointCloud2>::SharedPtr publisher_ground_cloud_;
+    PointCloud2 ground_cloud_;
+
+    rclcpp::Publisher<PointCloud2>::SharedPtr publisher_obstacle_cloud_;
+    PointCloud2 obstacle_cloud_;
+
+    // Obstacle clusters
+    rclcpp::Publisher<PointCloud2>::SharedPtr publisher_clustered_cloud_;
+    PointCloud2 clustered_cloud_;
+
+    // Points coloured by the cameras
+    rclcpp::Publisher<PointCloud2>::SharedPtr publisher_colorized_cloud_;
+    PointCloud2 colorized_cloud_;
+
+    // Polygonization publication
+    rclcpp::Publisher<MarkerArray>::SharedPtr publisher_polygonized_cloud_;
+    MarkerArray polygonized_cloud_;
+
+    // Latency of the profiling zones, published periodically
+    rclcpp::Publisher<DiagnosticArray>::SharedPtr publisher_diagnostics_;
+    rclcpp::TimerBase::SharedPtr diagnostics_timer_;
+    DiagnosticArray diagnostics_;
+
+    // Zones processing a whole frame on their thread whose p99 latency exceeds the budget are reported with the WARN
+    // level, the frame zone in the serial mode and the stage zones in the pipelined mode. Nested zones are not graded
+    double frame_budget_ms_ = 100.0;
+    std::vector<std::string> budgeted_zones_;
+
+    // Collected zones are appended to a Chrome trace file when a trace path is configured
+    bool chrome_trace_ = false;
+
+    // Configuration
+    ProcessingConfiguration processing_configuration_;
+
+    // Processing
+    std::unique_ptr<lidar_processing_lib::filtering::ConvexQuadCrop> crop_ptr_;
+
+    lidar_processing_lib::segmentation::ISegmenter::UniquePtr segmenter_ptr_;
+    lidar_processing_lib::clustering::IClusterer::UniquePtr clusterer_ptr_;
+
+    // Non-owning view of segmenter_ptr_ when the ground is segmented by RANSAC, and the points reclassified by its
+    // horizontal traversal since the start
+    const lidar_processing_lib::segmentation::RansacSegmenter *ransac_segmenter_ = nullptr;
+    std::atomic<std::uint64_t> reclassified_points_{0U};
+
+    // Depth image of the input cloud shared by the depth image segmenter and the range image clusterer, the node builds
+    // it when the segmenter does not. Not shared in the pipelined mode, where the stages work on different frames
+    std::shared_ptr<lidar_processing_lib::segmentation::DepthImage> depth_image_;
+    bool build_depth_image_ = false;
+
+    // Non-owning view of clusterer_ptr_ when the obstacles are clustered in the shared depth image
+    lidar_processing_lib::clustering::RangeImageClusterer *range_image_clusterer_ = nullptr;
+
+    // Fusion, the latest images of each camera are cached by their subscriptions and the image closest to the cloud
+    // is looked up when the frame is published. Buffers below are only used by the publication stage
+    std::vector<rclcpp::Subscription<Image>::SharedPtr> camera_subscribers_;
+    std::vector<ImageCache> image_caches_;
+    std::unique_ptr<lidar_processing_lib::fusion::PointCloudColorizer> colorizer_ptr_;
+    std::int64_t max_time_offset_ns_ = 0;
+    bool colorize_obstacles_ = false;
+    std::vector<ImageCache::ImageConstSharedPtr> fused_images_;
+    std::vector<lidar_processing_lib::fusion::CameraImageView> fused_image_views_;
+    std::vector<std::uint32_t> colorized_rgb_;
+    std::vector<std::uint8_t> colorized_cameras_;
+
+    // Camera images missing from the fused frames, not received within the time offset or of an unknown encoding
+    std::atomic<std::uint64_t> missing_camera_images_{0U};
+
+    // Buffers of the frame processed on the subscription thread when the pipelined mode is disabled
+    Frame serial_frame_;
+
+    // Pipelined mode, ingestion and crop run on the subscription thread and each following stage on its own thread.
+    // Frames are recycled through the free queue by every stage, the links between the stages skip their oldest
+    // frames beyond the queue capacity.
+    bool pipelined_ = false;
+    std::vector<Frame> frames_;
+    std::unique_ptr<utilities_lib::MPMCQueue<Frame *>> free_frames_{nullptr};
+    std::unique_ptr<FrameLink> segmentation_link_{nullptr};
+    std::unique_ptr<FrameLink> clustering_link_{nullptr};
+    std::unique_ptr<FrameLink> publication_link_{nullptr};
+    std::vector<std::thread> stage_threads_;
+    std::atomic<std::uint64_t> dropped_frames_{0U};
+
+    // Output messages are handed over to the middleware instead of being copied
+    bool use_intra_process_comms_;
+
+    // Deep copies of the output messages made in the last frame (by the node or by rclcpp)
+    std::atomic<std::uint32_t> output_message_copies_{0U};
+
+    // Replacements of the output clouds handed over to intra-process subscribers
+    MessagePool output_message_pool_;
+
+    // Field offsets of the input messages, resolved once per topic and re-resolved only if the point step or the fields
+    // of the messages change
+    data_types_lib::PointCloudLayout input_layout_;
+    std::vector<PointField> input_fields_;
+
+    /// @brief Reserve memory.
+    void initialize();
+
+    /// @brief Allocates the frames and starts the stage threads of the pipelined mode.
+    void startPipeline(std::uint32_t queue_capacity);
+
+    /// @brief Processes the frames of the input link until it is closed and passes them to the output link, the last
+    /// stage (no output link) recycles them.
+    void runStage(FrameLink &input_link, FrameLink *output_link, void (LidarDataProcessorNode::*process)(Frame &));
+
+    /// @brief Returns the frame and its input message to the free queue.
+    void recycleFrame(Frame *frame);
+
+    /// @brief Recycles a frame that was not processed to the end, a newer frame took its place.
+    void dropFrame(Frame *frame);
+
+    /// @brief Stage 1, views the input message and crops it. Returns false when the message can not be processed.
+    bool ingestFrame(Frame &frame, const PointCloud2 &input_message);
+
+    /// @brief Stage 2, segments the cropped cloud and collects the obstacle points.
+    void segmentFrame(Frame &frame);
+
+    /// @brief Stage 3, clusters the obstacle points.
+    void clusterFrame(Frame &frame);
+
+    /// @brief Stage 4, packs and publishes the output clouds.
+    void publishFrame(Frame &frame);
+
+    /// @brief Colours the points of the frame with the images closest to it, part of the publication stage.
+    void fuseFrame(const Frame &frame);
+
+    /// @brief Collects the profiling zones and publishes their latency percentiles, one status per zone.
+    void publishDiagnostics();
+
+    /// @brief Finds the byte offsets of the x, y, z and intensity fields of the message.
+    static data_types_lib::PointCloudLayout resolveLayout(const PointCloud2 &message);
+
+    /// @brief Returns true if both field lists have the same names, offsets, types and counts in the same order.
+    static bool haveSameFields(const std::vector<PointField> &fields, const std::vector<PointField> &other_fields);
+
+    /// @brief Maps every value of the label type to the index of the segmented cloud its points are published in.
+    static constexpr std::array<std::uint8_t, 256U> makeLabelToCloudIndexTable() noexcept
+    {
+        std::array<std::uint8_t, 256U> table{};
+        for (auto &cloud_index : table)
+        {
+            cloud_index = DISCARDED_CLOUD_INDEX;
+        }
+
+        table[static_cast<std::uint8_t>(data_types_lib::SegmentationLabel::UNKNOWN)] = UNKNOWN_CLOUD_INDEX;
+        table[static_cast<std::uint8_t>(data_types_lib::SegmentationLabel::GROUND)] = GROUND_CLOUD_INDEX;
+        table[static_cast<std::uint8_t>(data_types_lib::SegmentationLabel::OBSTACLE)] = OBSTACLE_CLOUD_INDEX;
+        table[static_cast<std::uint8_t>(data_types_lib::SegmentationLabel::TRANSITIONAL_GROUND)] = GROUND_CLOUD_INDEX;
+        table[static_cast<std::uint8_t>(data_types_lib::SegmentationLabel::TRANSITIONAL_OBSTACLE)] =
+            OBSTACLE_CLOUD_INDEX;
+
+        return table;
+    }
+
+    /// @brief Packs the segmented points of the frame into the unknown, ground and obstacle clouds.
+    void packSegmentedClouds(const Frame &frame);
+
+    /// @brief Packs the clustered obstacle points of the frame into the clustered cloud, each cluster is given its own
+    /// colour.
+    void packClusteredCloud(const Frame &frame);
+
+    /// @brief Packs the points of the cloud seen by a camera into the colorized cloud, with the colour of their pixel.
+    void packColorizedCloud(const Frame &frame, const data_types_lib::PointCloudSoA &cloud);
+
+    /// @brief Views the data of a bgr8 or rgb8 image, the view has no data for images of other encodings.
+    static lidar_processing_lib::fusion::CameraImageView viewImage(const Image &image);
+
+    /// @brief Sets the fields and the layout of an output cloud of pcl::PointXYZRGB points.
+    static void initializeOutputCloud(PointCloud2 &cloud);
+
+    /// @brief Publishes an output cloud with the fewest copies the middleware allows.
+    /// Loaned messages are used when the RMW can loan them, the cloud is moved into the loan. In the intra-process
+    /// mode the cloud is swapped with a message of the pool and handed over, when no intra-process subscriber would
+    /// take it the cloud is published by reference and keeps its buffer.
+    void publishCloud(rclcpp::Publisher<PointCloud2> &publisher, PointCloud2 &cloud);
+};
+
+#endif // LIDAR_DATA_PROCESSOR_NODE_HPP
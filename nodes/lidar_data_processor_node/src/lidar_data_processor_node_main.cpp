@@ -0,0 +1,34 @@
+#include "lidar_data_processor_node.hpp"
+
+// ROS2
+#include <rclcpp/executors.hpp> // rclcpp::spin
+#include <rclcpp/utilities.hpp> // rclcpp::init, rclcpp::shutdown
+
+// STL
+#include <exception> // std::exception
+#include <iostream>  // std::cerr
+#include <memory>    // std::make_shared
+
+int main(int argc, char **argv)
+{
+    rclcpp::init(argc, argv);
+    rclcpp::install_signal_handlers();
+
+    try
+    {
+        auto node = std::make_shared<LidarDataProcessorNode>();
+        rclcpp::spin(node);
+    }
+    catch (const std::exception &ex)
+    {
+        std::cerr << "Exception: " << ex.what() << std::endl;
+    }
+    catch (...)
+    {
+        std::cerr << "Unknown exception." << std::endl;
+    }
+
+    rclcpp::shutdown();
+
+    return 0;
+}
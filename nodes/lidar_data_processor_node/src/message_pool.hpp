@@ -0,0 +1,126 @@
+#ifndef MESSAGE_POOL_HPP
+#define MESSAGE_POOL_HPP
+
+#include <atomic>                           // std::atomic
+#include <condition_variable>               // std::condition_variable
+#include <cstddef>                          // std::size_t
+#include <cstdint>                          // std::uint64_t
+#include <memory>                           // std::make_unique
+#include <mutex>                            // std::mutex, std::lock_guard, std::unique_lock
+#include <sensor_msgs/msg/point_cloud2.hpp> // sensor_msgs::msg::PointCloud2
+#include <thread>                           // std::thread
+#include <utility>                          // std::move
+#include <vector>                           // std::vector
+
+/// @brief Preallocated output messages for the intra-process hand-off. A message published by std::unique_ptr is owned
+/// by its subscribers and its buffer does not come back, so the output cloud continues with a message of the pool.
+/// The pool allocates and prefaults the replacements on its own thread, off the publication path.
+class MessagePool final
+{
+  public:
+    using PointCloud2 = sensor_msgs::msg::PointCloud2;
+
+    MessagePool() = default;
+
+    /// @brief Destructor, stops the refill thread.
+    inline ~MessagePool()
+    {
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            stopped_ = true;
+        }
+        not_full_.notify_all();
+
+        if (refill_thread_.joinable())
+        {
+            refill_thread_.join();
+        }
+    }
+
+    // Copy and move operations are not allowed.
+    MessagePool(const MessagePool &) = delete;
+    MessagePool(MessagePool &&) = delete;
+    MessagePool &operator=(const MessagePool &) = delete;
+    MessagePool &operator=(MessagePool &&) = delete;
+
+    /// @brief Fills the pool with copies of the prototype holding a prefaulted buffer of buffer_size bytes and starts
+    /// the refill thread. Must be called once, before the first take.
+    inline void start(const PointCloud2 &prototype, const std::size_t buffer_size, const std::size_t capacity)
+    {
+        prototype_ = prototype;
+        buffer_size_ = buffer_size;
+        capacity_ = (capacity > 0U) ? capacity : 1U;
+
+        messages_.reserve(capacity_);
+        while (messages_.size() < capacity_)
+        {
+            messages_.push_back(makeMessage());
+        }
+
+        refill_thread_ = std::thread{&MessagePool::refill, this};
+    }
+
+    /// @brief Removes a message of the pool, allocates it on the calling thread when the pool ran empty.
+    inline PointCloud2::UniquePtr take()
+    {
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            if (!messages_.empty())
+            {
+                PointCloud2::UniquePtr message = std::move(messages_.back());
+                messages_.pop_back();
+                not_full_.notify_one();
+                return message;
+            }
+        }
+
+        ++misses_;
+        return makeMessage();
+    }
+
+    /// @brief Get the number of messages allocated by take because the pool was empty.
+    inline std::uint64_t misses() const noexcept
+    {
+        return misses_.load();
+    }
+
+  private:
+    std::mutex mutex_;
+    std::condition_variable not_full_;
+    std::vector<PointCloud2::UniquePtr> messages_;
+    std::thread refill_thread_;
+    PointCloud2 prototype_;
+    std::size_t buffer_size_ = 0U;
+    std::size_t capacity_ = 0U;
+    std::atomic<std::uint64_t> misses_{0U};
+    bool stopped_ = false;
+
+    // Resizing writes the whole buffer, so its pages are mapped before the message is taken
+    inline PointCloud2::UniquePtr makeMessage() const
+    {
+        auto message = std::make_unique<PointCloud2>(prototype_);
+        message->data.resize(buffer_size_);
+        message->data.clear();
+        return message;
+    }
+
+    inline void refill()
+    {
+        std::unique_lock<std::mutex> lock{mutex_};
+        while (true)
+        {
+            not_full_.wait(lock, [this]() { return stopped_ || (messages_.size() < capacity_); });
+            if (stopped_)
+            {
+                return;
+            }
+
+            lock.unlock();
+            PointCloud2::UniquePtr message = makeMessage();
+            lock.lock();
+            messages_.push_back(std::move(message));
+        }
+    }
+};
+
+#endif // MESSAGE_POOL_HPP
@@ -13,24 +13,116 @@ struct PointXY
     float y;
 };
 
+struct SensorConfiguration final
+{
+    // "hdl64e", "vlp32c", "os1_128" or "custom"
+    std::string model;
+
+    // Geometry of a custom sensor
+    float min_elevation_deg;
+    float vertical_field_of_view_deg;
+    float vertical_resolution_deg;
+    float horizontal_resolution_deg;
+    std::uint32_t max_cloud_points;
+};
+
+struct RansacAdaptiveTerminationConfiguration final
+{
+    bool enabled;
+    float confidence;
+    std::uint32_t min_iterations;
+    std::uint32_t preemptive_sample_size;
+    float preemptive_rejection_ratio;
+    bool warm_start;
+};
+
 struct RansacConfiguration final
 {
     float orthogonal_distance_threshold;
     std::uint32_t number_of_iterations;
     std::uint32_t thread_count;
+    std::uint32_t horizontal_traversal_bands;
+    RansacAdaptiveTerminationConfiguration adaptive;
+};
+
+struct TemporalSegmentationConfiguration final
+{
+    bool enabled;
+    std::uint32_t max_cell_age;
+    float cell_tolerance;
+    float plane_inlier_retention;
+    std::uint32_t max_plane_age;
 };
 
 struct SegmentationConfiguration final
 {
     std::string algorithm;
     RansacConfiguration ransac;
+    TemporalSegmentationConfiguration temporal;
+};
+
+struct EuclideanClusteringConfiguration final
+{
+    float cluster_tolerance;
+    std::uint32_t min_cluster_size;
+    std::uint32_t max_cluster_size;
+};
+
+struct RangeImageClusteringConfiguration final
+{
+    float angle_threshold_deg;
+    std::uint32_t min_cluster_size;
+    std::uint32_t max_cluster_size;
+};
+
+struct DbscanClusteringConfiguration final
+{
+    float epsilon;
+    std::uint32_t min_points;
+    std::uint32_t thread_count;
+};
+
+struct ClusteringConfiguration final
+{
+    std::string algorithm;
+    EuclideanClusteringConfiguration euclidean;
+    RangeImageClusteringConfiguration range_image;
+    DbscanClusteringConfiguration dbscan;
+};
+
+struct PipelineConfiguration final
+{
+    bool enabled;
+    std::uint32_t queue_capacity;
+};
+
+struct FusionConfiguration final
+{
+    bool enabled;
+    std::string calibration_path;
+
+    // Image topic and Kitti camera index of each camera, in order of priority
+    std::vector<std::string> camera_topics;
+    std::vector<std::uint32_t> camera_indices;
+
+    std::uint32_t cache_size;
+    float max_time_offset;
+    std::uint32_t thread_count;
+
+    // "segmented" colours the cropped cloud, "obstacles" only the obstacle points
+    std::string points;
 };
 
 struct ProcessingConfiguration final
 {
     float height_offset;
     std::array<PointXY, 4> bounding_box;
+    float max_distance;
+    SensorConfiguration sensor;
     SegmentationConfiguration segmentation;
+    ClusteringConfiguration clustering;
+    PipelineConfiguration pipeline;
+    FusionConfiguration fusion;
 };
 
 #endif // PROCESSING_CONFIGURATION_HPP
@@ -0,0 +1,117 @@
+/// Local
+#include <data_types_lib/cartesian_return.hpp>
+#include <utilities_lib/dataset_container.hpp>
+#include <utilities_lib/file_operations.hpp>
+
+// OpenCV
+#include <opencv2/opencv.hpp> // cv::
+
+// STL
+#include <cstdint>    // std::int64_t
+#include <cstring>    // std::strcmp
+#include <exception>  // std::exception
+#include <filesystem> // std::filesystem
+#include <iostream>   // std::cout, std::cerr
+#include <stdexcept>  // std::runtime_error
+#include <string>     // std::string
+#include <vector>     // std::vector
+
+// Packs Kitti sensor folders (timestamps.txt and data/) into a single dataset file, replayed by the
+// sensor_data_publisher_node through replay.dataset_path. Streams are named after the sensors of the node config.
+//
+// dataset_packer [--lz4] <output file> <sensor name>=<sensor folder> ...
+// e.g. dataset_packer drive_0013.pack lidar=.../velodyne_points camera_1=.../image_00
+namespace
+{
+void packSensor(utilities_lib::DatasetWriter &writer, const std::string &sensor_name,
+                const std::filesystem::path &data_path)
+{
+    std::vector<std::int64_t> timestamps;
+    utilities_lib::readTimestampsFromTxtFile(data_path / "timestamps.txt", timestamps);
+
+    // Point clouds are stored as they are, images are stored decoded so that the replay does not decode them
+    std::vector<std::filesystem::path> file_paths;
+    utilities_lib::readFileNamesWithExtensionFromDirectory(data_path / "data", ".bin", file_paths);
+    const bool point_clouds = !file_paths.empty();
+    if (!point_clouds)
+    {
+        utilities_lib::readFileNamesWithExtensionFromDirectory(data_path / "data", ".png", file_paths);
+    }
+
+    if (timestamps.empty() || (file_paths.size() != timestamps.size()))
+    {
+        throw std::runtime_error("The number of messages does not match the number of timestamps in " +
+                                 data_path.string() + ": " + std::to_string(file_paths.size()) + " vs " +
+                                 std::to_string(timestamps.size()));
+    }
+
+    const std::size_t stream_index =
+        writer.addStream(sensor_name, point_clouds ? utilities_lib::DatasetPayload::POINT_CLOUD
+                                                   : utilities_lib::DatasetPayload::IMAGE_BGR8);
+
+    for (std::size_t i = 0U; i < file_paths.size(); ++i)
+    {
+        if (point_clouds)
+        {
+            utilities_lib::MappedFile point_cloud_file;
+            utilities_lib::mapPointCloudDataFromBinFile(file_paths[i], point_cloud_file);
+            const std::size_t number_of_points = point_cloud_file.size() / sizeof(data_types_lib::CartesianReturn);
+            writer.addEntry(stream_index, timestamps[i], point_cloud_file.data(),
+                            number_of_points * sizeof(data_types_lib::CartesianReturn),
+                            static_cast<std::uint32_t>(number_of_points), 1U);
+        }
+        else
+        {
+            // Decoded rows are continuous, bgr8 without padding
+            const cv::Mat image = cv::imread(file_paths[i].string(), cv::IMREAD_COLOR);
+            if (image.empty())
+            {
+                throw std::runtime_error("Could not decode the file: " + file_paths[i].string());
+            }
+            writer.addEntry(stream_index, timestamps[i], image.data, image.total() * image.elemSize(),
+                            static_cast<std::uint32_t>(image.cols), static_cast<std::uint32_t>(image.rows));
+        }
+    }
+
+    std::cout << "Packed " << file_paths.size() << " messages of " << sensor_name << std::endl;
+}
+} // namespace
+
+int main(int argc, char **argv)
+{
+    int argument = 1;
+    const bool compress = (argc > argument) && (std::strcmp(argv[argument], "--lz4") == 0);
+    if (compress)
+    {
+        ++argument;
+    }
+
+    if ((argc - argument) < 2)
+    {
+        std::cerr << "Usage: dataset_packer [--lz4] <output file> <sensor name>=<sensor folder> ..." << std::endl;
+        return 1;
+    }
+
+    try
+    {
+        utilities_lib::DatasetWriter writer{argv[argument++], compress};
+        for (; argument < argc; ++argument)
+        {
+            const std::string sensor{argv[argument]};
+            const std::size_t separator = sensor.find('=');
+            if (separator == std::string::npos)
+            {
+                throw std::runtime_error("Expected <sensor name>=<sensor folder>, got " + sensor);
+            }
+            packSensor(writer, sensor.substr(0U, separator), sensor.substr(separator + 1U));
+        }
+        writer.finish();
+    }
+    catch (const std::exception &ex)
+    {
+        std::cerr << "Exception: " << ex.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,124 @@
+#include "replay_scheduler.hpp"
+
+// STL
+#include <algorithm> // std::min, std::make_heap, std::push_heap, std::pop_heap
+#include <cerrno>    // EINTR
+#include <chrono>    // std::chrono
+#include <ctime>     // clock_nanosleep, timespec
+#include <limits>    // std::numeric_limits
+#include <stdexcept> // std::runtime_error
+#include <string>    // std::to_string
+
+namespace
+{
+// Long sleeps are split so that a stop request is noticed
+constexpr std::int64_t MAXIMUM_SLEEP = 50000000;
+
+// Period at which a message that is not decoded yet is retried
+constexpr std::int64_t DISPATCH_RETRY_PERIOD = 100000;
+
+inline std::int64_t now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+// Sleeps until an absolute steady clock deadline in nanoseconds, a deadline in the past returns immediately
+void sleepUntil(const std::int64_t deadline, const std::atomic<bool> &stop)
+{
+    std::int64_t current_time = now();
+    while (!stop && (current_time < deadline))
+    {
+        // The steady clock is CLOCK_MONOTONIC, absolute deadlines do not accumulate the wake-up latency
+        const std::int64_t wake_up = std::min(deadline, current_time + MAXIMUM_SLEEP);
+        const timespec request{static_cast<std::time_t>(wake_up / 1000000000), static_cast<long>(wake_up % 1000000000)};
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &request, nullptr) == EINTR)
+        {
+        }
+        current_time = now();
+    }
+}
+
+// Orders the heap by the earliest timestamp first
+inline bool later(const std::int64_t lhs_timestamp, const std::int64_t rhs_timestamp)
+{
+    return lhs_timestamp > rhs_timestamp;
+}
+} // namespace
+
+ReplayScheduler::ReplayScheduler(double rate) : rate_{rate}
+{
+    if (!isValidRate(rate_))
+    {
+        throw std::runtime_error("Replay rate " + std::to_string(rate_) + " is outside of [" +
+                                 std::to_string(MIN_RATE) + ", " + std::to_string(MAX_RATE) +
+                                 "], replaying as fast as possible is UNTHROTTLED (" + std::to_string(UNTHROTTLED) +
+                                 ", the replay.unthrottled parameter)!");
+    }
+}
+
+void ReplayScheduler::addStream(Stream stream)
+{
+    if (stream.size == 0U)
+    {
+        return;
+    }
+    streams_.push_back(std::move(stream));
+}
+
+void ReplayScheduler::run(const std::atomic<bool> &stop)
+{
+    if (streams_.empty())
+    {
+        sleepUntil(std::numeric_limits<std::int64_t>::max(), stop);
+        return;
+    }
+
+    std::int64_t earliest_timestamp = std::numeric_limits<std::int64_t>::max();
+    for (const Stream &stream : streams_)
+    {
+        earliest_timestamp = std::min(earliest_timestamp, stream.timestamp(0U));
+    }
+
+    const auto compare = [](const Event &lhs, const Event &rhs) { return later(lhs.timestamp, rhs.timestamp); };
+    events_.reserve(streams_.size());
+
+    // Every loop of the recording starts at the current time
+    while (!stop)
+    {
+        const std::int64_t loop_start = now();
+
+        events_.clear();
+        for (std::size_t i = 0U; i < streams_.size(); ++i)
+        {
+            events_.push_back({streams_[i].timestamp(0U), i, 0U});
+        }
+        std::make_heap(events_.begin(), events_.end(), compare);
+
+        while (!stop && !events_.empty())
+        {
+            std::pop_heap(events_.begin(), events_.end(), compare);
+            const Event event = events_.back();
+            events_.pop_back();
+
+            if (rate_ != UNTHROTTLED)
+            {
+                const double offset = static_cast<double>(event.timestamp - earliest_timestamp) / rate_;
+                sleepUntil(loop_start + static_cast<std::int64_t>(offset), stop);
+            }
+
+            const Stream &stream = streams_[event.stream];
+            while (!stop && !stream.dispatch(event.message, now()))
+            {
+                sleepUntil(now() + DISPATCH_RETRY_PERIOD, stop);
+            }
+
+            const std::size_t next_message = event.message + 1U;
+            if (next_message < stream.size)
+            {
+                events_.push_back({stream.timestamp(next_message), event.stream, next_message});
+                std::push_heap(events_.begin(), events_.end(), compare);
+            }
+        }
+    }
+}
@@ -0,0 +1,178 @@
+#ifndef REPLAY_SCHEDULER_HPP
+#define REPLAY_SCHEDULER_HPP
+
+// ROS2
+#include <rclcpp/publisher.hpp> // rclcpp::Publisher
+
+// STL
+#include <atomic>             // std::atomic
+#include <condition_variable> // std::condition_variable
+#include <cstdint>            // std::int64_t
+#include <functional>         // std::function
+#include <mutex>              // std::mutex
+#include <thread>             // std::thread
+#include <utility>            // std::move
+#include <vector>             // std::vector
+
+/// @brief Sets the header stamp of a message.
+/// @param timestamp - Stamp in nanoseconds.
+template <typename MessageType> inline void setTimestamp(MessageType &message, const std::int64_t timestamp)
+{
+    message.header.stamp.sec = static_cast<std::int32_t>(static_cast<double>(timestamp) * 1e-9);
+    message.header.stamp.nanosec = static_cast<std::uint32_t>(
+        timestamp - static_cast<std::int64_t>(static_cast<double>(message.header.stamp.sec) * 1e9));
+}
+
+/// @brief Publishes the messages of a sensor on its own thread, so that a large publish of one sensor does not delay
+/// the messages of the others.
+template <typename MessageType> class PublicationThread final
+{
+  public:
+    using Publisher = typename rclcpp::Publisher<MessageType>::SharedPtr;
+
+    // Called with every message once it is published, e.g. to recycle its buffer
+    using Release = std::function<void(MessageType *)>;
+
+    /// @brief Deleted default constructor.
+    PublicationThread() = delete;
+
+    /// @brief Non-default constructor, starts the thread.
+    PublicationThread(Publisher publisher, Release release)
+        : publisher_{std::move(publisher)}, release_{std::move(release)}, thread_{[this]() { loop(); }}
+    {
+    }
+
+    /// @brief Destructor, publishes the handed over message and stops the thread.
+    ~PublicationThread()
+    {
+        {
+            const std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        condition_variable_.notify_all();
+        thread_.join();
+    }
+
+    // Copy and move operations are not allowed.
+    PublicationThread(const PublicationThread &) = delete;
+    PublicationThread(PublicationThread &&) = delete;
+    PublicationThread &operator=(const PublicationThread &) = delete;
+    PublicationThread &operator=(PublicationThread &&) = delete;
+
+    /// @brief Hands a message over to be published, blocks while the previous message is being published. Empty
+    /// messages are released without being published.
+    /// @param stamp - Header stamp of the message in nanoseconds.
+    void publish(MessageType *message, const std::int64_t stamp)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        condition_variable_.wait(lock, [this]() { return (message_ == nullptr); });
+        message_ = message;
+        stamp_ = stamp;
+        lock.unlock();
+        condition_variable_.notify_all();
+    }
+
+  private:
+    Publisher publisher_;
+    Release release_;
+
+    std::mutex mutex_;
+    std::condition_variable condition_variable_;
+    MessageType *message_ = nullptr;
+    std::int64_t stamp_ = 0;
+    bool stop_ = false;
+
+    std::thread thread_;
+
+    void loop()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true)
+        {
+            condition_variable_.wait(lock, [this]() { return stop_ || (message_ != nullptr); });
+            if (message_ == nullptr)
+            {
+                return;
+            }
+
+            MessageType *message = message_;
+            const std::int64_t stamp = stamp_;
+            lock.unlock();
+
+            if (!message->data.empty())
+            {
+                setTimestamp(*message, stamp);
+                publisher_->publish(*message);
+            }
+            release_(message);
+
+            lock.lock();
+            message_ = nullptr;
+            condition_variable_.notify_all();
+        }
+    }
+};
+
+/// @brief Replays streams of timestamped messages in timestamp order. The streams are merged through a min-heap on
+/// their next timestamp and the scheduler sleeps until the exact deadline of the earliest message, the recording is
+/// replayed in a loop.
+class ReplayScheduler final
+{
+  public:
+    struct Stream final
+    {
+        // Number of messages of the stream
+        std::size_t size;
+
+        // Recording timestamp of a message in nanoseconds
+        std::function<std::int64_t(std::size_t)> timestamp;
+
+        // Hands a message over to be published with the stamp in nanoseconds
+        // Returns false if the message is not available yet, the dispatch is retried
+        std::function<bool(std::size_t, std::int64_t)> dispatch;
+    };
+
+    // Timed replay speeds relative to the recording
+    static constexpr double MIN_RATE = 0.5;
+    static constexpr double MAX_RATE = 10.0;
+
+    // Rate of the unthrottled replay, every message is dispatched as soon as the previous one of the sensor is
+    // published. The publishers return without waiting for the subscribers, so the replay gets no backpressure from
+    // them and a subscriber falling behind drops messages according to its QoS
+    static constexpr double UNTHROTTLED = 0.0;
+
+    /// @brief Deleted default constructor.
+    ReplayScheduler() = delete;
+
+    /// @brief Non-default constructor.
+    /// @param rate - Replay speed relative to the recording, within [MIN_RATE, MAX_RATE], or UNTHROTTLED.
+    /// @throws std::runtime_error if the rate is neither.
+    explicit ReplayScheduler(double rate);
+
+    /// @brief Checks that the rate is within [MIN_RATE, MAX_RATE] or UNTHROTTLED.
+    static inline bool isValidRate(const double rate) noexcept
+    {
+        return (rate == UNTHROTTLED) || ((rate >= MIN_RATE) && (rate <= MAX_RATE));
+    }
+
+    /// @brief Adds a stream, streams without messages are ignored.
+    void addStream(Stream stream);
+
+    /// @brief Replays the streams, blocks until stop is set.
+    void run(const std::atomic<bool> &stop);
+
+  private:
+    // Next message of a stream, ordered by timestamp
+    struct Event final
+    {
+        std::int64_t timestamp;
+        std::size_t stream;
+        std::size_t message;
+    };
+
+    double rate_;
+    std::vector<Stream> streams_;
+    std::vector<Event> events_;
+};
+
+#endif // REPLAY_SCHEDULER_HPP
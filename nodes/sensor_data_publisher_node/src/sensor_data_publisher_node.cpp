@@ -1,95 +1,93 @@
-/// Local
-#include <data_types_lib/cartesian_return.hpp>
-#include <utilities_lib/file_operations.hpp>
-
-// ROS2
-#include <rclcpp/executors.hpp>             // rclcpp::spin
-#include <rclcpp/logging.hpp>               // RCLCPP_INFO
-#include <rclcpp/node.hpp>                  // rclcpp::Node
-#include <rclcpp/publisher.hpp>             // rclcpp::Publisher
-#include <rclcpp/qos.hpp>                   // rclcpp::QoS
-#include <rclcpp/timer.hpp>                 // rclcpp::TimerBase
-#include <rclcpp/utilities.hpp>             // rclcpp::shutdown
-#include <sensor_msgs/msg/image.hpp>        // sensor_msgs::msg::Image
-#include <sensor_msgs/msg/point_cloud2.hpp> // sensor_msgs::msg::PointCloud2
-#include <sensor_msgs/msg/point_field.hpp>  // sensor_msgs::msg::PointField
-
-// STL
-#include <chrono>    // std::chrono
-#include <exception> // std::exception
-#include <iostream>  // std::cerr
-#include <iterator>  // std::distance
-#include <limits>    // std::numeric_limits
-#include <thread>    // std::this_thread
-#include <tuple>     // std::tuple
-#include <utility>   // std::pair
+#include "sensor_data_publisher_node.hpp"
 
 // OpenCV
 #include <opencv2/opencv.hpp> // cv::
 
-class SensorDataPublisherNode final : public rclcpp::Node
+namespace
 {
-    // Forward declaration
-    template <typename MessageType> struct PublicationInfo;
+// Files of the message cache decoded by a task
+constexpr std::size_t CACHE_LOAD_GRAIN = 4U;
 
-  public:
-    using PointCloud2 = sensor_msgs::msg::PointCloud2;
-    using Image = sensor_msgs::msg::Image;
+// Images are published as bgr8
+constexpr std::uint32_t IMAGE_CHANNELS = 3U;
 
-    // Copy and move operations are not allowed.
-    SensorDataPublisherNode(const SensorDataPublisherNode &) = delete;
-    SensorDataPublisherNode(SensorDataPublisherNode &&) = delete;
-    SensorDataPublisherNode &operator=(const SensorDataPublisherNode &) = delete;
-    SensorDataPublisherNode &operator=(SensorDataPublisherNode &&) = delete;
-
-    /// @brief Constructor of the node.
-    SensorDataPublisherNode();
-
-    /// @brief Default destructor.
-    ~SensorDataPublisherNode() = default;
-
-    /// @brief Replay sensor data.
-    void run();
+// Reads the image size from the header chunk of a PNG file, which directly follows the signature
+bool readPngImageSize(const utilities_lib::MappedFile &image_file, std::uint32_t &width, std::uint32_t &height)
+{
+    constexpr std::uint8_t PNG_SIGNATURE[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    constexpr std::size_t WIDTH_OFFSET = 16U;
+    constexpr std::size_t HEIGHT_OFFSET = 20U;
 
-  private:
-    template <typename MessageType> struct PublicationInfo final
+    if ((image_file.size() < (HEIGHT_OFFSET + 4U)) ||
+        (std::memcmp(image_file.data(), PNG_SIGNATURE, sizeof(PNG_SIGNATURE)) != 0) ||
+        (std::memcmp(image_file.data() + 12U, "IHDR", 4U) != 0))
     {
-        // Messages containing <time, message>
-        std::vector<std::pair<std::int64_t, MessageType>> stamped_messages;
+        return false;
+    }
 
-        // Data publisher for MessageType
-        typename rclcpp::Publisher<MessageType>::SharedPtr publisher{nullptr};
+    // Both are big-endian
+    const auto readBigEndian = [&image_file](const std::size_t offset) {
+        const auto *bytes = reinterpret_cast<const std::uint8_t *>(image_file.data() + offset);
+        return (static_cast<std::uint32_t>(bytes[0]) << 24U) | (static_cast<std::uint32_t>(bytes[1]) << 16U) |
+               (static_cast<std::uint32_t>(bytes[2]) << 8U) | static_cast<std::uint32_t>(bytes[3]);
     };
 
-    // Message cache
-    PublicationInfo<PointCloud2> point_cloud_info_{};
-    PublicationInfo<Image> camera_1_info_{};
-    PublicationInfo<Image> camera_2_info_{};
-    PublicationInfo<Image> camera_3_info_{};
-    PublicationInfo<Image> camera_4_info_{};
-
-    /// @brief Load point cloud messages.
-    void loadCache(const std::filesystem::path &data_path, const std::string &topic_name,
-                   PublicationInfo<PointCloud2> &info);
+    width = readBigEndian(WIDTH_OFFSET);
+    height = readBigEndian(HEIGHT_OFFSET);
+    return (width > 0U) && (height > 0U);
+}
 
-    /// @brief Load camera messages.
-    void loadCache(const std::filesystem::path &data_path, const std::string &topic_name, PublicationInfo<Image> &info);
+// Fields of the point cloud messages
+// <field name, field offset, field type, field count>
+void addPointFields(sensor_msgs::msg::PointCloud2 &point_cloud_message)
+{
+    const std::vector<std::tuple<std::string, std::uint32_t, std::uint8_t, std::uint32_t>> fields = {
+        {"x", offsetof(data_types_lib::CartesianReturn, x), sensor_msgs::msg::PointField::FLOAT32, 1},
+        {"y", offsetof(data_types_lib::CartesianReturn, y), sensor_msgs::msg::PointField::FLOAT32, 1},
+        {"z", offsetof(data_types_lib::CartesianReturn, z), sensor_msgs::msg::PointField::FLOAT32, 1},
+        {"intensity", offsetof(data_types_lib::CartesianReturn, intensity), sensor_msgs::msg::PointField::FLOAT32,
+         1}};
+
+    point_cloud_message.fields.reserve(fields.size());
+    for (const auto &field : fields)
+    {
+        sensor_msgs::msg::PointField field_cache;
+        field_cache.name = std::get<0>(field);
+        field_cache.offset = std::get<1>(field);
+        field_cache.datatype = std::get<2>(field);
+        field_cache.count = std::get<3>(field);
+        point_cloud_message.fields.push_back(std::move(field_cache));
+    }
+}
 
-    /// @brief Helper method to get the earliest timestamp.
-    template <typename MessageType> std::int64_t getEarliestTimestamp(const PublicationInfo<MessageType> &info) const;
+void setPointCloudLayout(sensor_msgs::msg::PointCloud2 &point_cloud_message, const std::size_t number_of_points,
+                         const std::string &frame_id)
+{
+    point_cloud_message.height = 1;
+    point_cloud_message.width = number_of_points;
+    point_cloud_message.is_bigendian = false;
+    point_cloud_message.point_step = sizeof(data_types_lib::CartesianReturn);
+    point_cloud_message.row_step = sizeof(data_types_lib::CartesianReturn) * number_of_points;
+    point_cloud_message.is_dense = true;
+    point_cloud_message.header.frame_id = frame_id;
+
+    if (point_cloud_message.fields.empty())
+    {
+        addPointFields(point_cloud_message);
+    }
+}
 
-    /// @brief Shifts timestamp of each sensor to the common time point.
-    template <typename MessageType> void shiftTimestamps(PublicationInfo<MessageType> &info, std::int64_t time_offset);
+// Payload of the dataset streams replayed as MessageType
+template <typename MessageType>
+constexpr utilities_lib::DatasetPayload DATASET_PAYLOAD = utilities_lib::DatasetPayload::IMAGE_BGR8;
 
-    /// @brief Check iterator and publish.
-    /// @returns True if message was published.
-    template <typename MessageType>
-    bool tryPublishMessage(PublicationInfo<MessageType> &info,
-                           typename std::vector<std::pair<std::int64_t, MessageType>>::iterator &message_iterator,
-                           const std::int64_t elapsed_time_point);
-};
+template <>
+constexpr utilities_lib::DatasetPayload DATASET_PAYLOAD<sensor_msgs::msg::PointCloud2> =
+    utilities_lib::DatasetPayload::POINT_CLOUD;
+} // namespace
 
-SensorDataPublisherNode::SensorDataPublisherNode() : rclcpp::Node{"sensor_data_publisher_node"}
+SensorDataPublisherNode::SensorDataPublisherNode(const rclcpp::NodeOptions &options)
+    : rclcpp::Node{"sensor_data_publisher_node", options}
 {
     // Declare parameters
     this->declare_parameter<std::string>("lidar.data_path");
@@ -112,6 +110,33 @@ SensorDataPublisherNode::SensorDataPublisherNode() : rclcpp::Node{"sensor_data_p
     this->declare_parameter<std::string>("camera_4.topic");
     this->declare_parameter<std::int32_t>("camera_4.sensor_id");
 
+    this->declare_parameter<bool>("replay.streaming");
+    this->declare_parameter<std::int32_t>("replay.look_ahead");
+    this->declare_parameter<std::string>("replay.dataset_path");
+    this->declare_parameter<double>("replay.rate");
+    this->declare_parameter<bool>("replay.unthrottled");
+
+    // A packed dataset replaces the sensor folders and is always streamed
+    const std::string dataset_path = this->get_parameter("replay.dataset_path").as_string();
+    if (!dataset_path.empty())
+    {
+        dataset_ = std::make_unique<utilities_lib::DatasetReader>(dataset_path);
+    }
+
+    streaming_ = (dataset_ != nullptr) || this->get_parameter("replay.streaming").as_bool();
+
+    // Checked before the replay thread creates the scheduler
+    const bool is_unthrottled = this->get_parameter("replay.unthrottled").as_bool();
+    replay_rate_ = is_unthrottled ? ReplayScheduler::UNTHROTTLED : this->get_parameter("replay.rate").as_double();
+    if (!ReplayScheduler::isValidRate(replay_rate_))
+    {
+        throw std::runtime_error("replay.rate must be within " + std::to_string(ReplayScheduler::MIN_RATE) + " and " +
+                                 std::to_string(ReplayScheduler::MAX_RATE) +
+                                 ", set replay.unthrottled to replay as fast as possible!");
+    }
+    const std::size_t look_ahead =
+        static_cast<std::size_t>(std::max(this->get_parameter("replay.look_ahead").as_int(), std::int64_t{1}));
+
     // Specify QoS
     rclcpp::QoS qos{2};
     qos.keep_last(2);
@@ -129,89 +154,157 @@ SensorDataPublisherNode::SensorDataPublisherNode() : rclcpp::Node{"sensor_data_p
     // node as "dead" or "unresponsive"
     qos.deadline(std::chrono::seconds(1));
 
-    // LiDAR publisher
-    try
-    {
-        loadCache(this->get_parameter("lidar.data_path").as_string(), this->get_parameter("lidar.topic").as_string(),
-                  point_cloud_info_);
+    // Sensors are loaded in parallel, and the files of each sensor are decoded on the same pool
+    utilities_lib::ThreadPool thread_pool{std::max(std::thread::hardware_concurrency(), 1U)};
 
-        point_cloud_info_.publisher =
-            this->create_publisher<PointCloud2>(this->get_parameter("lidar.topic").as_string(), qos);
+    // OpenCV runs single-threaded while the pool decodes, so that the decoders do not oversubscribe the cores
+    const int opencv_threads = cv::getNumThreads();
+    cv::setNumThreads(0);
 
-        RCLCPP_INFO(this->get_logger(), "%s", "Created LiDAR publisher.");
+    bool point_cloud_loaded = false;
+    bool camera_1_loaded = false;
+    bool camera_2_loaded = false;
+    bool camera_3_loaded = false;
+    bool camera_4_loaded = false;
+    {
+        utilities_lib::TaskGroup task_group{thread_pool};
+        task_group.run([&]() {
+            point_cloud_loaded =
+                loadSensor("lidar", ".bin", look_ahead, thread_pool, point_cloud_info_, point_cloud_stream_);
+        });
+        task_group.run([&]() {
+            camera_1_loaded = loadSensor("camera_1", ".png", look_ahead, thread_pool, camera_1_info_, camera_1_stream_);
+        });
+        task_group.run([&]() {
+            camera_2_loaded = loadSensor("camera_2", ".png", look_ahead, thread_pool, camera_2_info_, camera_2_stream_);
+        });
+        task_group.run([&]() {
+            camera_3_loaded = loadSensor("camera_3", ".png", look_ahead, thread_pool, camera_3_info_, camera_3_stream_);
+        });
+        task_group.run([&]() {
+            camera_4_loaded = loadSensor("camera_4", ".png", look_ahead, thread_pool, camera_4_info_, camera_4_stream_);
+        });
+        task_group.wait();
     }
-    catch (const std::exception &ex)
+
+    cv::setNumThreads(opencv_threads);
+
+    // LiDAR publisher
+    if (point_cloud_loaded)
     {
-        RCLCPP_INFO(this->get_logger(), "Exception: %s", ex.what());
+        createPublisher("lidar", qos, point_cloud_info_, point_cloud_stream_);
+        RCLCPP_INFO(this->get_logger(), "%s", "Created LiDAR publisher.");
     }
 
     // Camera 1 publisher
-    try
+    if (camera_1_loaded)
     {
-        loadCache(this->get_parameter("camera_1.data_path").as_string(),
-                  this->get_parameter("camera_1.topic").as_string(), camera_1_info_);
-
-        camera_1_info_.publisher =
-            this->create_publisher<Image>(this->get_parameter("camera_1.topic").as_string(), qos);
-
+        createPublisher("camera_1", qos, camera_1_info_, camera_1_stream_);
         RCLCPP_INFO(this->get_logger(), "%s", "Created Camera 1 publisher.");
     }
-    catch (const std::exception &ex)
-    {
-        RCLCPP_INFO(this->get_logger(), "Exception: %s", ex.what());
-    }
 
     // Camera 2 publisher
-    try
+    if (camera_2_loaded)
     {
-        loadCache(this->get_parameter("camera_2.data_path").as_string(),
-                  this->get_parameter("camera_2.topic").as_string(), camera_2_info_);
-
-        camera_2_info_.publisher =
-            this->create_publisher<Image>(this->get_parameter("camera_2.topic").as_string(), qos);
-
+        createPublisher("camera_2", qos, camera_2_info_, camera_2_stream_);
         RCLCPP_INFO(this->get_logger(), "%s", "Created Camera 2 publisher.");
     }
-    catch (const std::exception &ex)
+
+    // Camera 3 publisher
+    if (camera_3_loaded)
     {
-        RCLCPP_INFO(this->get_logger(), "Exception: %s", ex.what());
+        createPublisher("camera_3", qos, camera_3_info_, camera_3_stream_);
+        RCLCPP_INFO(this->get_logger(), "%s", "Created Camera 3 publisher.");
     }
 
-    // Camera 3 publisher
-    try
+    // Camera 4 publisher
+    if (camera_4_loaded)
     {
-        loadCache(this->get_parameter("camera_3.data_path").as_string(),
-                  this->get_parameter("camera_3.topic").as_string(), camera_3_info_);
+        createPublisher("camera_4", qos, camera_4_info_, camera_4_stream_);
+        RCLCPP_INFO(this->get_logger(), "%s", "Created Camera 4 publisher.");
+    }
 
-        camera_3_info_.publisher =
-            this->create_publisher<Image>(this->get_parameter("camera_3.topic").as_string(), qos);
+    // Start replay
+    if (streaming_)
+    {
+        prefetch_thread_ = std::thread([this]() { prefetch(); });
+    }
+    replay_thread_ = std::thread([this]() { run(); });
+}
 
-        RCLCPP_INFO(this->get_logger(), "%s", "Created Camera 3 publisher.");
+SensorDataPublisherNode::~SensorDataPublisherNode()
+{
+    stop_replay_ = true;
+    if (replay_thread_.joinable())
+    {
+        replay_thread_.join();
     }
-    catch (const std::exception &ex)
+    if (prefetch_thread_.joinable())
     {
-        RCLCPP_INFO(this->get_logger(), "Exception: %s", ex.what());
+        prefetch_thread_.join();
     }
 
-    // Camera 4 publisher
+    // Publication threads return streamed messages to their stream, they are stopped before the streams are destroyed
+    point_cloud_info_.publication.reset();
+    camera_1_info_.publication.reset();
+    camera_2_info_.publication.reset();
+    camera_3_info_.publication.reset();
+    camera_4_info_.publication.reset();
+}
+
+template <typename MessageType>
+bool SensorDataPublisherNode::loadSensor(const std::string &sensor_name, const std::string &file_extension,
+                                         const std::size_t look_ahead, utilities_lib::ThreadPool &thread_pool,
+                                         PublicationInfo<MessageType> &info, StreamInfo<MessageType> &stream)
+{
     try
     {
-        loadCache(this->get_parameter("camera_4.data_path").as_string(),
-                  this->get_parameter("camera_4.topic").as_string(), camera_4_info_);
-
-        camera_4_info_.publisher =
-            this->create_publisher<Image>(this->get_parameter("camera_4.topic").as_string(), qos);
-
-        RCLCPP_INFO(this->get_logger(), "%s", "Created Camera 4 publisher.");
+        const std::string data_path = this->get_parameter(sensor_name + ".data_path").as_string();
+        const std::string topic_name = this->get_parameter(sensor_name + ".topic").as_string();
+        if (dataset_ != nullptr)
+        {
+            openDatasetStream(sensor_name, topic_name, look_ahead, stream);
+        }
+        else if (streaming_)
+        {
+            openStream(data_path, file_extension, topic_name, look_ahead, stream);
+        }
+        else
+        {
+            loadCache(data_path, file_extension, topic_name, thread_pool, info);
+        }
+        return true;
     }
     catch (const std::exception &ex)
     {
         RCLCPP_INFO(this->get_logger(), "Exception: %s", ex.what());
+
+        // Without a publisher nothing of the sensor is replayed
+        info.stamped_messages.clear();
+        stream.timestamps.clear();
+        return false;
     }
 }
 
-void SensorDataPublisherNode::loadCache(const std::filesystem::path &data_path, const std::string &topic_name,
-                                        PublicationInfo<PointCloud2> &info)
+template <typename MessageType>
+void SensorDataPublisherNode::createPublisher(const std::string &sensor_name, const rclcpp::QoS &qos,
+                                              PublicationInfo<MessageType> &info, StreamInfo<MessageType> &stream)
+{
+    info.publisher = this->create_publisher<MessageType>(this->get_parameter(sensor_name + ".topic").as_string(), qos);
+
+    // Streamed messages are returned to the prefetch thread once published
+    typename PublicationThread<MessageType>::Release release = [](MessageType *) {};
+    if (streaming_)
+    {
+        release = [&stream](MessageType *message) { stream.free_messages->push(message); };
+    }
+    info.publication = std::make_unique<PublicationThread<MessageType>>(info.publisher, std::move(release));
+}
+
+template <typename MessageType>
+void SensorDataPublisherNode::loadCache(const std::filesystem::path &data_path, const std::string &file_extension,
+                                        const std::string &topic_name, utilities_lib::ThreadPool &thread_pool,
+                                        PublicationInfo<MessageType> &info)
 {
     // Check if the directory exists
     if (!std::filesystem::exists(data_path))
@@ -228,88 +321,45 @@ void SensorDataPublisherNode::loadCache(const std::filesystem::path &data_path,
     // Check if timestamps were loaded
     if (!timestamps.empty())
     {
-        // Reserve memory for stamped messages
-        info.stamped_messages.reserve(timestamps.size());
-
         // Read data files
         std::vector<std::filesystem::path> file_paths;
         file_paths.reserve(timestamps.size());
 
         const auto data_folder = data_path / "data";
-        utilities_lib::readFileNamesWithExtensionFromDirectory(data_folder, ".bin", file_paths);
+        utilities_lib::readFileNamesWithExtensionFromDirectory(data_folder, file_extension, file_paths);
 
         // Check the number of files match the number of timestamps
         if (file_paths.size() != timestamps.size())
         {
-            throw std::runtime_error("The number of messages does not match the number of timestamps.");
+            throw std::runtime_error("The number of messages does not match the number of timestamps: " +
+                                     std::to_string(file_paths.size()) + " vs " + std::to_string(timestamps.size()));
         }
 
-        // Fields to be used when populating messages
-        // <field name, field offset, field type, field count>
-        const std::vector<std::tuple<std::string, std::uint32_t, std::uint8_t, std::uint32_t>> fields = {
-            {"x", offsetof(data_types_lib::CartesianReturn, x), sensor_msgs::msg::PointField::FLOAT32, 1},
-            {"y", offsetof(data_types_lib::CartesianReturn, y), sensor_msgs::msg::PointField::FLOAT32, 1},
-            {"z", offsetof(data_types_lib::CartesianReturn, z), sensor_msgs::msg::PointField::FLOAT32, 1},
-            {"intensity", offsetof(data_types_lib::CartesianReturn, intensity), sensor_msgs::msg::PointField::FLOAT32,
-             1}};
-
-        // Aggregate messages into cache
-        point_cloud_info_.stamped_messages.reserve(timestamps.size());
-        for (std::size_t message_number = 0U; message_number < timestamps.size(); ++message_number)
-        {
-            const auto &timestamp = timestamps[message_number];
-            const auto &file_path = file_paths[message_number];
-
-            // Read lidar cloud
-            std::vector<data_types_lib::CartesianReturn> point_cloud_data;
-            utilities_lib::loadPointCloudDataFromBinFile(file_path, point_cloud_data);
-
-            if (point_cloud_data.empty())
-            {
-                std::cerr << "Empty binary file, skipping." << std::endl;
-                continue;
-            }
-
-            // Construct output message
-            PointCloud2 point_cloud_message;
-            point_cloud_message.height = 1;
-            point_cloud_message.width = point_cloud_data.size();
-            point_cloud_message.is_bigendian = false;
-            point_cloud_message.point_step = sizeof(data_types_lib::CartesianReturn);
-            point_cloud_message.row_step = sizeof(data_types_lib::CartesianReturn) * point_cloud_data.size();
-            point_cloud_message.is_dense = true;
-            point_cloud_message.header.frame_id = topic_name;
-
-            // Set timestamp
-            point_cloud_message.header.stamp.sec = static_cast<std::int32_t>(static_cast<double>(timestamp) * 1e-9);
-            point_cloud_message.header.stamp.nanosec = static_cast<std::uint32_t>(
-                timestamp - static_cast<std::int64_t>(static_cast<double>(point_cloud_message.header.stamp.sec) * 1e9));
-
-            // Populate fields
-            point_cloud_message.fields.reserve(fields.size());
-            for (const auto &field : fields)
+        // Every file is decoded into its own slot of the message cache, in parallel
+        info.stamped_messages.resize(timestamps.size());
+        thread_pool.parallelFor(0U, timestamps.size(), CACHE_LOAD_GRAIN, [&](std::size_t first, std::size_t last) {
+            for (std::size_t message_number = first; message_number < last; ++message_number)
             {
-                sensor_msgs::msg::PointField field_cache;
-                field_cache.name = std::get<0>(field);
-                field_cache.offset = std::get<1>(field);
-                field_cache.datatype = std::get<2>(field);
-                field_cache.count = std::get<3>(field);
-                point_cloud_message.fields.push_back(std::move(field_cache));
+                auto &stamped_message = info.stamped_messages[message_number];
+                stamped_message.first = timestamps[message_number];
+                decodeMessage(file_paths[message_number], topic_name, stamped_message.second);
+                setTimestamp(stamped_message.second, stamped_message.first);
             }
-
-            // Copy the point cloud data
-            point_cloud_message.data.resize(sizeof(data_types_lib::CartesianReturn) * point_cloud_data.size());
-            std::memcpy(point_cloud_message.data.data(), point_cloud_data.data(),
-                        sizeof(data_types_lib::CartesianReturn) * point_cloud_data.size());
-
-            // Add message to the message cache
-            point_cloud_info_.stamped_messages.emplace_back(timestamp, std::move(point_cloud_message));
-        }
+        });
+
+        // Files that could not be decoded are skipped
+        info.stamped_messages.erase(std::remove_if(info.stamped_messages.begin(), info.stamped_messages.end(),
+                                                   [](const auto &stamped_message) {
+                                                       return stamped_message.second.data.empty();
+                                                   }),
+                                    info.stamped_messages.end());
     }
 }
 
-void SensorDataPublisherNode::loadCache(const std::filesystem::path &data_path, const std::string &topic_name,
-                                        PublicationInfo<Image> &info)
+template <typename MessageType>
+void SensorDataPublisherNode::openStream(const std::filesystem::path &data_path, const std::string &file_extension,
+                                         const std::string &topic_name, const std::size_t look_ahead,
+                                         StreamInfo<MessageType> &stream)
 {
     // Check if the directory exists
     if (!std::filesystem::exists(data_path))
@@ -318,214 +368,300 @@ void SensorDataPublisherNode::loadCache(const std::filesystem::path &data_path,
     }
 
     // Load timestamps
-    std::vector<std::int64_t> timestamps;
-    const auto timestamps_path = data_path / "timestamps.txt";
-    utilities_lib::readTimestampsFromTxtFile(timestamps_path, timestamps);
-    timestamps.shrink_to_fit();
+    utilities_lib::readTimestampsFromTxtFile(data_path / "timestamps.txt", stream.timestamps);
+    stream.timestamps.shrink_to_fit();
 
     // Check if timestamps were loaded
-    if (!timestamps.empty())
+    if (!stream.timestamps.empty())
     {
-        // Reserve memory for stamped messages
-        info.stamped_messages.reserve(timestamps.size());
-
-        // Read data files
-        std::vector<std::filesystem::path> file_paths;
-        file_paths.reserve(timestamps.size());
-
-        const auto data_folder = data_path / "data";
-        utilities_lib::readFileNamesWithExtensionFromDirectory(data_folder, ".png", file_paths);
+        // Only the file names are read, the files are decoded during the replay
+        stream.file_paths.reserve(stream.timestamps.size());
+        utilities_lib::readFileNamesWithExtensionFromDirectory(data_path / "data", file_extension, stream.file_paths);
 
         // Check the number of files match the number of timestamps
-        if (file_paths.size() != timestamps.size())
+        if (stream.file_paths.size() != stream.timestamps.size())
         {
             throw std::runtime_error("The number of messages does not match the number of timestamps: " +
-                                     std::to_string(file_paths.size()) + " vs " + std::to_string(timestamps.size()));
+                                     std::to_string(stream.file_paths.size()) + " vs " +
+                                     std::to_string(stream.timestamps.size()));
         }
 
-        // Aggregate messages into cache
-        point_cloud_info_.stamped_messages.reserve(timestamps.size());
-        for (std::size_t message_number = 0U; message_number < timestamps.size(); ++message_number)
-        {
-            const auto &timestamp = timestamps[message_number];
-
-            // Read data from the file
-            const cv::Mat image = cv::imread(file_paths[message_number], cv::IMREAD_COLOR);
+        stream.frame_id = topic_name;
+        allocateLookAhead(look_ahead, stream);
+    }
+}
 
-            // Convert image into image message format
-            Image image_message;
+template <typename MessageType>
+void SensorDataPublisherNode::openDatasetStream(const std::string &sensor_name, const std::string &topic_name,
+                                                const std::size_t look_ahead, StreamInfo<MessageType> &stream)
+{
+    stream.dataset_stream = dataset_->findStream(sensor_name);
+    if (dataset_->stream(stream.dataset_stream).payload != DATASET_PAYLOAD<MessageType>)
+    {
+        throw std::runtime_error("Dataset stream " + sensor_name + " does not hold messages of the sensor.");
+    }
 
-            image_message.header.frame_id = topic_name;
-            image_message.height = image.rows;
-            image_message.width = image.cols;
-            image_message.encoding = "bgr8"; // For color image, adjust if using grayscale or other types
-            image_message.is_bigendian = false;
-            image_message.step = image.step;
+    // Timestamps are taken from the index, nothing is parsed
+    const std::size_t number_of_entries = dataset_->entryCount(stream.dataset_stream);
+    stream.timestamps.resize(number_of_entries);
+    for (std::size_t i = 0U; i < number_of_entries; ++i)
+    {
+        stream.timestamps[i] = dataset_->entry(stream.dataset_stream, i).timestamp;
+    }
 
-            // Set timestamp
-            image_message.header.stamp.sec = static_cast<std::int32_t>(static_cast<double>(timestamp) * 1e-9);
-            image_message.header.stamp.nanosec = static_cast<std::uint32_t>(
-                timestamp - static_cast<std::int64_t>(static_cast<double>(image_message.header.stamp.sec) * 1e9));
+    if (!stream.timestamps.empty())
+    {
+        stream.frame_id = topic_name;
+        allocateLookAhead(look_ahead, stream);
+    }
+}
 
-            // Copy byte data
-            image_message.data.resize(image_message.step * image_message.height);
-            std::memcpy(&image_message.data[0], image.data, image_message.step * image_message.height);
+template <typename MessageType>
+void SensorDataPublisherNode::allocateLookAhead(const std::size_t look_ahead, StreamInfo<MessageType> &stream)
+{
+    // One message more than the look-ahead, the replay holds the next message outside of the queues
+    stream.messages.resize(look_ahead + 1U);
+    stream.decoded_messages = std::make_unique<utilities_lib::SPSCQueue<MessageType *>>(stream.messages.size());
+    stream.free_messages = std::make_unique<utilities_lib::SPSCQueue<MessageType *>>(stream.messages.size());
+    for (auto &message : stream.messages)
+    {
+        stream.free_messages->push(&message);
+    }
+}
 
-            // Add message to the message cache
-            info.stamped_messages.emplace_back(timestamp, std::move(image_message));
+void SensorDataPublisherNode::prefetch()
+{
+    while (rclcpp::ok() && !stop_replay_)
+    {
+        // One message per stream and round, so that a stream with a full window does not hold back the others
+        bool decoded = tryDecodeMessage(point_cloud_stream_);
+        decoded = tryDecodeMessage(camera_1_stream_) || decoded;
+        decoded = tryDecodeMessage(camera_2_stream_) || decoded;
+        decoded = tryDecodeMessage(camera_3_stream_) || decoded;
+        decoded = tryDecodeMessage(camera_4_stream_) || decoded;
+
+        // Every window is full
+        if (!decoded)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
         }
     }
 }
 
 template <typename MessageType>
-std::int64_t SensorDataPublisherNode::getEarliestTimestamp(const PublicationInfo<MessageType> &info) const
+bool SensorDataPublisherNode::tryDecodeMessage(StreamInfo<MessageType> &stream)
+{
+    MessageType *message = nullptr;
+    if (stream.timestamps.empty() || !stream.free_messages->tryPop(message))
+    {
+        return false;
+    }
+
+    if (dataset_ != nullptr)
+    {
+        decodeMessage(dataset_->entry(stream.dataset_stream, stream.next_entry), stream.frame_id, *message);
+    }
+    else
+    {
+        decodeMessage(stream.file_paths[stream.next_entry], stream.frame_id, *message);
+    }
+    stream.decoded_messages->push(message);
+
+    // The stream is decoded in a loop, like it is replayed
+    stream.next_entry = (stream.next_entry + 1U) % stream.timestamps.size();
+
+    // The next payload of the stream is read from disk in the background while the window is published
+    if (dataset_ != nullptr)
+    {
+        dataset_->prefetchPayload(dataset_->entry(stream.dataset_stream, stream.next_entry));
+    }
+    return true;
+}
+
+void SensorDataPublisherNode::decodeMessage(const std::filesystem::path &file_path, const std::string &frame_id,
+                                            PointCloud2 &message)
 {
-    return info.stamped_messages.empty() ? std::numeric_limits<std::int64_t>::max()
-                                         : info.stamped_messages.front().first;
+    // Points are copied from the page cache into the message, a recycled message keeps its capacity
+    utilities_lib::MappedFile point_cloud_file;
+    utilities_lib::mapPointCloudDataFromBinFile(file_path, point_cloud_file);
+    const std::size_t number_of_points = point_cloud_file.size() / sizeof(data_types_lib::CartesianReturn);
+
+    setPointCloudLayout(message, number_of_points, frame_id);
+
+    // Empty files leave the message empty, it is skipped by the replay
+    message.data.resize(sizeof(data_types_lib::CartesianReturn) * number_of_points);
+    if (!message.data.empty())
+    {
+        std::memcpy(message.data.data(), point_cloud_file.data(), message.data.size());
+    }
 }
 
-template <typename MessageType>
-void SensorDataPublisherNode::shiftTimestamps(PublicationInfo<MessageType> &info, std::int64_t time_offset)
+void SensorDataPublisherNode::decodeMessage(const std::filesystem::path &file_path, const std::string &frame_id,
+                                            Image &message)
 {
-    for (auto &message : info.stamped_messages)
+    // The encoded image is decoded from the page cache, without reading it into a buffer
+    utilities_lib::MappedFile image_file;
+    std::uint32_t width = 0U;
+    std::uint32_t height = 0U;
+    if (!image_file.open(file_path) || !readPngImageSize(image_file, width, height))
+    {
+        // Files that can not be decoded leave the message empty, they are skipped by the replay
+        std::cerr << "Could not decode the file: " << file_path << std::endl;
+        message.data.clear();
+        return;
+    }
+
+    message.header.frame_id = frame_id;
+    message.height = height;
+    message.width = width;
+    message.encoding = "bgr8"; // For color image, adjust if using grayscale or other types
+    message.is_bigendian = false;
+    message.step = width * IMAGE_CHANNELS;
+
+    // The image is decoded straight into the data of the message, while the matrix wraps it the decoder does not
+    // allocate
+    message.data.resize(message.step * message.height);
+    cv::Mat decoded_image(static_cast<int>(height), static_cast<int>(width), CV_8UC3, message.data.data(),
+                          message.step);
+    const cv::Mat encoded_image(1, static_cast<int>(image_file.size()), CV_8UC1,
+                                const_cast<std::byte *>(image_file.data()));
+    cv::imdecode(encoded_image, cv::IMREAD_COLOR, &decoded_image);
+
+    if (decoded_image.empty())
+    {
+        std::cerr << "Could not decode the file: " << file_path << std::endl;
+        message.data.clear();
+    }
+    else if (decoded_image.data != message.data.data())
     {
-        message.first += time_offset;
+        // The decoder reallocated, e.g. for an image rotated by its metadata
+        message.height = decoded_image.rows;
+        message.width = decoded_image.cols;
+        message.step = decoded_image.step;
+        message.data.assign(decoded_image.data, decoded_image.data + (message.step * message.height));
     }
 }
 
-template <typename MessageType>
-bool SensorDataPublisherNode::tryPublishMessage(
-    PublicationInfo<MessageType> &info,
-    typename std::vector<std::pair<std::int64_t, MessageType>>::iterator &message_iterator,
-    const std::int64_t elapsed_time_point)
+void SensorDataPublisherNode::decodeMessage(const utilities_lib::DatasetEntry &entry, const std::string &frame_id,
+                                            PointCloud2 &message)
 {
-    bool published = false;
+    setPointCloudLayout(message, entry.width, frame_id);
 
-    if (message_iterator != info.stamped_messages.end())
+    // Points are copied, or decompressed, from the mapped dataset into the message
+    if (!readDatasetPayload(entry, sizeof(data_types_lib::CartesianReturn) * static_cast<std::uint64_t>(entry.width),
+                            message.data))
     {
-        if (elapsed_time_point >=
-            info.stamped_messages[std::distance(info.stamped_messages.begin(), message_iterator)].first)
-        {
-            // Update timestamp
-            message_iterator->second.header.stamp.sec =
-                static_cast<std::int32_t>(static_cast<double>(elapsed_time_point) * 1e-9);
-            message_iterator->second.header.stamp.nanosec = static_cast<std::uint32_t>(
-                elapsed_time_point -
-                static_cast<std::int64_t>(static_cast<double>(message_iterator->second.header.stamp.sec) * 1e9));
-
-            // Publish
-            info.publisher->publish(message_iterator->second);
-            ++message_iterator;
-            published = true;
-        }
+        message.data.clear();
     }
+}
 
-    return published;
+void SensorDataPublisherNode::decodeMessage(const utilities_lib::DatasetEntry &entry, const std::string &frame_id,
+                                            Image &message)
+{
+    message.header.frame_id = frame_id;
+    message.height = entry.height;
+    message.width = entry.width;
+    message.encoding = "bgr8";
+    message.is_bigendian = false;
+    message.step = entry.width * IMAGE_CHANNELS;
+
+    // Pixels are stored decoded, they are copied, or decompressed, from the mapped dataset into the message
+    if (!readDatasetPayload(entry, static_cast<std::uint64_t>(entry.width) * IMAGE_CHANNELS * entry.height,
+                            message.data))
+    {
+        message.data.clear();
+    }
 }
 
-void SensorDataPublisherNode::run()
+bool SensorDataPublisherNode::readDatasetPayload(const utilities_lib::DatasetEntry &entry,
+                                                 const std::uint64_t message_size,
+                                                 std::vector<std::uint8_t> &data) const
 {
-    // Initialize iterators for each sensor's messages
-    auto point_cloud_iterator = point_cloud_info_.stamped_messages.begin();
-    auto camera_1_iterator = camera_1_info_.stamped_messages.begin();
-    auto camera_2_iterator = camera_2_info_.stamped_messages.begin();
-    auto camera_3_iterator = camera_3_info_.stamped_messages.begin();
-    auto camera_4_iterator = camera_4_info_.stamped_messages.begin();
-
-    // Find the earliest timestamp across all sensors
-    const std::int64_t earliest_timestamp_nanosec =
-        std::min({getEarliestTimestamp(point_cloud_info_), getEarliestTimestamp(camera_1_info_),
-                  getEarliestTimestamp(camera_2_info_), getEarliestTimestamp(camera_3_info_),
-                  getEarliestTimestamp(camera_4_info_)});
-
-    // Get the start time
-    const auto start_time = std::chrono::steady_clock::now();
-
-    // Shift timestamps for all sensors towards the earliest timestamp
-    const auto start_time_nanosec =
-        std::chrono::duration_cast<std::chrono::nanoseconds>(start_time.time_since_epoch()).count();
-
-    const std::int64_t time_offset = start_time_nanosec - earliest_timestamp_nanosec;
-
-    shiftTimestamps(point_cloud_info_, time_offset);
-    shiftTimestamps(camera_1_info_, time_offset);
-    shiftTimestamps(camera_2_info_, time_offset);
-    shiftTimestamps(camera_3_info_, time_offset);
-    shiftTimestamps(camera_4_info_, time_offset);
-
-    // Publish indefinitely
-    while (rclcpp::ok())
-    {
-        const auto current_time_point_nanosec =
-            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
-                .count();
-
-        // Publish next message from each sensor if the timestamp is reached
-        const bool point_cloud_message_published =
-            tryPublishMessage(point_cloud_info_, point_cloud_iterator, current_time_point_nanosec);
-        const bool camera_1_message_published =
-            tryPublishMessage(camera_1_info_, camera_1_iterator, current_time_point_nanosec);
-        const bool camera_2_message_published =
-            tryPublishMessage(camera_2_info_, camera_2_iterator, current_time_point_nanosec);
-        const bool camera_3_message_published =
-            tryPublishMessage(camera_3_info_, camera_3_iterator, current_time_point_nanosec);
-        const bool camera_4_message_published =
-            tryPublishMessage(camera_4_info_, camera_4_iterator, current_time_point_nanosec);
-
-        // If all messages were published, wraparound
-        if ((point_cloud_iterator == point_cloud_info_.stamped_messages.end()) &&
-            (camera_1_iterator == camera_1_info_.stamped_messages.end()) &&
-            (camera_2_iterator == camera_2_info_.stamped_messages.end()) &&
-            (camera_3_iterator == camera_3_info_.stamped_messages.end()) &&
-            (camera_4_iterator == camera_4_info_.stamped_messages.end()))
+    try
+    {
+        // A corrupt size is rejected before the message is sized by it
+        if (entry.size != message_size)
         {
-            // Reset iterators
-            point_cloud_iterator = point_cloud_info_.stamped_messages.begin();
-            camera_1_iterator = camera_1_info_.stamped_messages.begin();
-            camera_2_iterator = camera_2_info_.stamped_messages.begin();
-            camera_3_iterator = camera_3_info_.stamped_messages.begin();
-            camera_4_iterator = camera_4_info_.stamped_messages.begin();
-
-            // Recalculate earliest time point
-            const std::int64_t earliest_timestamp_nanosec =
-                std::min({getEarliestTimestamp(point_cloud_info_), getEarliestTimestamp(camera_1_info_),
-                          getEarliestTimestamp(camera_2_info_), getEarliestTimestamp(camera_3_info_),
-                          getEarliestTimestamp(camera_4_info_)});
-
-            // Shift timestamps to the latest time point
-            const std::int64_t time_offset = current_time_point_nanosec - earliest_timestamp_nanosec;
-
-            shiftTimestamps(point_cloud_info_, time_offset);
-            shiftTimestamps(camera_1_info_, time_offset);
-            shiftTimestamps(camera_2_info_, time_offset);
-            shiftTimestamps(camera_3_info_, time_offset);
-            shiftTimestamps(camera_4_info_, time_offset);
+            throw std::runtime_error("Size of the dataset payload does not match its message");
         }
+        dataset_->validatePayload(entry);
 
-        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        data.resize(entry.size);
+        dataset_->readPayload(entry, data.data());
+        return true;
+    }
+    catch (const std::exception &ex)
+    {
+        // The entry is skipped by the replay
+        std::cerr << "Exception: " << ex.what() << std::endl;
+        return false;
     }
 }
 
-int main(int argc, char **argv)
+template <typename MessageType>
+bool SensorDataPublisherNode::isStreamPrimed(const StreamInfo<MessageType> &stream) const
 {
-    rclcpp::init(argc, argv);
-    rclcpp::install_signal_handlers();
+    return stream.timestamps.empty() || !stream.decoded_messages->empty();
+}
 
-    try
+template <typename MessageType>
+void SensorDataPublisherNode::addReplayStream(ReplayScheduler &scheduler, PublicationInfo<MessageType> &info,
+                                              StreamInfo<MessageType> &stream)
+{
+    // Sensor was not loaded
+    if (info.publication == nullptr)
     {
-        auto node = std::make_shared<SensorDataPublisherNode>();
-        node->run();
+        return;
     }
-    catch (const std::exception &ex)
+
+    PublicationThread<MessageType> &publication = *info.publication;
+    if (streaming_)
     {
-        std::cerr << "Exception: " << ex.what() << std::endl;
+        // Messages are decoded in replay order, the next decoded message is the one to be dispatched
+        scheduler.addStream({stream.timestamps.size(),
+                             [&stream](const std::size_t message_number) { return stream.timestamps[message_number]; },
+                             [&stream, &publication](const std::size_t, const std::int64_t stamp) {
+                                 MessageType *message = nullptr;
+                                 if (!stream.decoded_messages->tryPop(message))
+                                 {
+                                     return false;
+                                 }
+                                 publication.publish(message, stamp);
+                                 return true;
+                             }});
     }
-    catch (...)
+    else
     {
-        std::cerr << "Unknown exception." << std::endl;
+        scheduler.addStream(
+            {info.stamped_messages.size(),
+             [&info](const std::size_t message_number) { return info.stamped_messages[message_number].first; },
+             [&info, &publication](const std::size_t message_number, const std::int64_t stamp) {
+                 publication.publish(&info.stamped_messages[message_number].second, stamp);
+                 return true;
+             }});
     }
+}
 
-    rclcpp::shutdown();
+void SensorDataPublisherNode::run()
+{
+    // The replay starts once the first message of every stream is decoded
+    while (streaming_ && !stop_replay_ &&
+           !(isStreamPrimed(point_cloud_stream_) && isStreamPrimed(camera_1_stream_) &&
+             isStreamPrimed(camera_2_stream_) && isStreamPrimed(camera_3_stream_) && isStreamPrimed(camera_4_stream_)))
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
 
-    return 0;
+    ReplayScheduler scheduler{replay_rate_};
+    addReplayStream(scheduler, point_cloud_info_, point_cloud_stream_);
+    addReplayStream(scheduler, camera_1_info_, camera_1_stream_);
+    addReplayStream(scheduler, camera_2_info_, camera_2_stream_);
+    addReplayStream(scheduler, camera_3_info_, camera_3_stream_);
+    addReplayStream(scheduler, camera_4_info_, camera_4_stream_);
+
+    scheduler.run(stop_replay_);
 }
+
+// Loadable into a component container
+#include <rclcpp_components/register_node_macro.hpp>
+RCLCPP_COMPONENTS_REGISTER_NODE(SensorDataPublisherNode)
@@ -0,0 +1,186 @@
+#ifndef SENSOR_DATA_PUBLISHER_NODE_HPP
+#define SENSOR_DATA_PUBLISHER_NODE_HPP
+
+/// Local
+#include "replay_scheduler.hpp"
+
+#include <data_types_lib/cartesian_return.hpp>
+#include <utilities_lib/dataset_container.hpp>
+#include <utilities_lib/file_operations.hpp>
+#include <utilities_lib/spsc_queue.hpp>
+#include <utilities_lib/thread_pool.hpp>
+
+// ROS2
+#include <rclcpp/logging.hpp>               // RCLCPP_INFO
+#include <rclcpp/node.hpp>                  // rclcpp::Node
+#include <rclcpp/node_options.hpp>          // rclcpp::NodeOptions
+#include <rclcpp/publisher.hpp>             // rclcpp::Publisher
+#include <rclcpp/qos.hpp>                   // rclcpp::QoS
+#include <rclcpp/timer.hpp>                 // rclcpp::TimerBase
+#include <rclcpp/utilities.hpp>             // rclcpp::shutdown
+#include <sensor_msgs/msg/image.hpp>        // sensor_msgs::msg::Image
+#include <sensor_msgs/msg/point_cloud2.hpp> // sensor_msgs::msg::PointCloud2
+#include <sensor_msgs/msg/point_field.hpp>  // sensor_msgs::msg::PointField
+
+// STL
+#include <algorithm> // std::max, std::min
+#include <atomic>    // std::atomic
+#include <chrono>    // std::chrono
+#include <cstring>   // std::memcpy
+#include <exception> // std::exception
+#include <iostream>  // std::cerr
+#include <iterator>  // std::distance
+#include <limits>    // std::numeric_limits
+#include <memory>    // std::unique_ptr
+#include <stdexcept> // std::runtime_error
+#include <thread>    // std::thread, std::this_thread
+#include <tuple>     // std::tuple
+#include <utility>   // std::pair
+
+class SensorDataPublisherNode final : public rclcpp::Node
+{
+    // Forward declaration
+    template <typename MessageType> struct PublicationInfo;
+    template <typename MessageType> struct StreamInfo;
+
+  public:
+    using PointCloud2 = sensor_msgs::msg::PointCloud2;
+    using Image = sensor_msgs::msg::Image;
+
+    // Copy and move operations are not allowed.
+    SensorDataPublisherNode(const SensorDataPublisherNode &) = delete;
+    SensorDataPublisherNode(SensorDataPublisherNode &&) = delete;
+    SensorDataPublisherNode &operator=(const SensorDataPublisherNode &) = delete;
+    SensorDataPublisherNode &operator=(SensorDataPublisherNode &&) = delete;
+
+    /// @brief Constructor of the node, starts replaying sensor data on a separate thread. The recording is either
+    /// preloaded into memory or streamed from disk through a bounded look-ahead window.
+    explicit SensorDataPublisherNode(const rclcpp::NodeOptions &options = rclcpp::NodeOptions{});
+
+    /// @brief Destructor, stops the replay.
+    ~SensorDataPublisherNode();
+
+    /// @brief Replay sensor data, blocks until the replay is stopped.
+    void run();
+
+  private:
+    template <typename MessageType> struct PublicationInfo final
+    {
+        // Messages containing <time, message>
+        std::vector<std::pair<std::int64_t, MessageType>> stamped_messages;
+
+        // Data publisher for MessageType
+        typename rclcpp::Publisher<MessageType>::SharedPtr publisher{nullptr};
+
+        // Thread publishing the messages of the sensor, cached or streamed
+        std::unique_ptr<PublicationThread<MessageType>> publication{nullptr};
+    };
+
+    template <typename MessageType> struct StreamInfo final
+    {
+        // Recording of the sensor, files or dataset entries are decoded by the prefetch thread ahead of their timestamp
+        std::vector<std::int64_t> timestamps;
+        std::vector<std::filesystem::path> file_paths;
+        std::size_t dataset_stream{0U};
+        std::string frame_id;
+
+        // Message buffers are recycled, decoded messages go to the replay thread and published ones come back
+        std::vector<MessageType> messages;
+        std::unique_ptr<utilities_lib::SPSCQueue<MessageType *>> decoded_messages{nullptr};
+        std::unique_ptr<utilities_lib::SPSCQueue<MessageType *>> free_messages{nullptr};
+
+        // Next file or dataset entry to be decoded, owned by the prefetch thread
+        std::size_t next_entry{0U};
+    };
+
+    // Message cache
+    PublicationInfo<PointCloud2> point_cloud_info_{};
+    PublicationInfo<Image> camera_1_info_{};
+    PublicationInfo<Image> camera_2_info_{};
+    PublicationInfo<Image> camera_3_info_{};
+    PublicationInfo<Image> camera_4_info_{};
+
+    // Message streams, decoded from the sensor folders or from a packed dataset
+    bool streaming_{false};
+    std::unique_ptr<utilities_lib::DatasetReader> dataset_{nullptr};
+    StreamInfo<PointCloud2> point_cloud_stream_{};
+    StreamInfo<Image> camera_1_stream_{};
+    StreamInfo<Image> camera_2_stream_{};
+    StreamInfo<Image> camera_3_stream_{};
+    StreamInfo<Image> camera_4_stream_{};
+
+    // Replay speed relative to the recording, or ReplayScheduler::UNTHROTTLED
+    double replay_rate_{1.0};
+
+    // Replay runs independently of the executor, so that the node can be loaded into a component container
+    std::atomic<bool> stop_replay_{false};
+    std::thread replay_thread_;
+    std::thread prefetch_thread_;
+
+    /// @brief Load or open the recording of a sensor, exceptions are logged.
+    /// @returns True if the recording was loaded.
+    template <typename MessageType>
+    bool loadSensor(const std::string &sensor_name, const std::string &file_extension, std::size_t look_ahead,
+                    utilities_lib::ThreadPool &thread_pool, PublicationInfo<MessageType> &info,
+                    StreamInfo<MessageType> &stream);
+
+    /// @brief Create the publisher of a sensor.
+    template <typename MessageType>
+    void createPublisher(const std::string &sensor_name, const rclcpp::QoS &qos, PublicationInfo<MessageType> &info,
+                         StreamInfo<MessageType> &stream);
+
+    /// @brief Load the messages of a sensor, the files are decoded in parallel on the thread pool.
+    template <typename MessageType>
+    void loadCache(const std::filesystem::path &data_path, const std::string &file_extension,
+                   const std::string &topic_name, utilities_lib::ThreadPool &thread_pool,
+                   PublicationInfo<MessageType> &info);
+
+    /// @brief Open a sensor stream, reads the timestamps and file names and allocates the look-ahead messages.
+    template <typename MessageType>
+    void openStream(const std::filesystem::path &data_path, const std::string &file_extension,
+                    const std::string &topic_name, std::size_t look_ahead, StreamInfo<MessageType> &stream);
+
+    /// @brief Open a sensor stream of the packed dataset, the stream is named after the sensor.
+    template <typename MessageType>
+    void openDatasetStream(const std::string &sensor_name, const std::string &topic_name, std::size_t look_ahead,
+                           StreamInfo<MessageType> &stream);
+
+    /// @brief Allocate the look-ahead messages of a stream.
+    template <typename MessageType> void allocateLookAhead(std::size_t look_ahead, StreamInfo<MessageType> &stream);
+
+    /// @brief Decode the files of every stream ahead of the replay, blocks until the replay is stopped or ROS is shut
+    /// down.
+    void prefetch();
+
+    /// @brief Decode the next file of the stream into a free message.
+    /// @returns True if a message was decoded.
+    template <typename MessageType> bool tryDecodeMessage(StreamInfo<MessageType> &stream);
+
+    /// @brief Decode a point cloud file into the message, the message is left empty if the file can not be read.
+    void decodeMessage(const std::filesystem::path &file_path, const std::string &frame_id, PointCloud2 &message);
+
+    /// @brief Decode an image file into the message, the message is left empty if the file can not be decoded.
+    void decodeMessage(const std::filesystem::path &file_path, const std::string &frame_id, Image &message);
+
+    /// @brief Decode a point cloud entry of the dataset into the message, the message is left empty if it is invalid.
+    void decodeMessage(const utilities_lib::DatasetEntry &entry, const std::string &frame_id, PointCloud2 &message);
+
+    /// @brief Decode an image entry of the dataset into the message, the message is left empty if it is invalid.
+    void decodeMessage(const utilities_lib::DatasetEntry &entry, const std::string &frame_id, Image &message);
+
+    /// @brief Read the payload of a dataset entry into data, sized once entry.size is validated against the size of
+    /// the decoded message and the bounds of the dataset.
+    /// @returns False if the payload is not valid or could not be read, the exception is logged.
+    bool readDatasetPayload(const utilities_lib::DatasetEntry &entry, std::uint64_t message_size,
+                            std::vector<std::uint8_t> &data) const;
+
+    /// @brief Checks if the first message of the stream is decoded.
+    template <typename MessageType> bool isStreamPrimed(const StreamInfo<MessageType> &stream) const;
+
+    /// @brief Add the messages of a sensor to the replay, cached or streamed.
+    template <typename MessageType>
+    void addReplayStream(ReplayScheduler &scheduler, PublicationInfo<MessageType> &info,
+                         StreamInfo<MessageType> &stream);
+};
+
+#endif // SENSOR_DATA_PUBLISHER_NODE_HPP
@@ -0,0 +1,210 @@
+/// Local
+#include <lidar_processing_lib/batch/batch_segmenter.hpp>
+#include <lidar_processing_lib/filtering/convex_quad_crop.hpp>
+#include <lidar_processing_lib/segmentation/depth_image.hpp>
+#include <lidar_processing_lib/segmentation/depth_image_segmenter.hpp>
+#include <lidar_processing_lib/segmentation/ransac_segmenter.hpp>
+#include <lidar_processing_lib/segmentation/sensor_profile.hpp>
+#include <lidar_processing_lib/segmentation/temporal_ground_model.hpp>
+
+// STL
+#include <array>      // std::array
+#include <cstddef>    // std::size_t
+#include <cstdint>    // std::uint32_t
+#include <cstring>    // std::strcmp, std::strncmp
+#include <exception>  // std::exception
+#include <filesystem> // std::filesystem
+#include <iomanip>    // std::setprecision
+#include <iostream>   // std::cout, std::cerr
+#include <memory>     // std::make_shared
+#include <stdexcept>  // std::runtime_error
+#include <string>     // std::string, std::stof, std::stoll
+
+// Segments a recorded sequence offline on all cores and writes a .label file per cloud, one SegmentationLabel byte
+// per point. The segmenters are configured as by the defaults of lidar_data_processor_node.param.yaml.
+//
+// batch_segmentation [options] <sequence folder> <output folder>
+// e.g. batch_segmentation --workers 64 .../2011_09_26_drive_0013_sync/velodyne_points labels/drive_0013
+namespace
+{
+namespace batch = lidar_processing_lib::batch;
+namespace segmentation = lidar_processing_lib::segmentation;
+
+constexpr const char *USAGE =
+    "Usage: batch_segmentation [options] <sequence folder> <output folder>\n"
+    "  --algorithm <ransac|depth_image_segmentation>  segmentation algorithm (default ransac)\n"
+    "  --workers <n>                                  parallel segmenters, 0 uses every core (default 0)\n"
+    "  --pin-threads                                  pins the workers to the cores\n"
+    "  --sensor <hdl64e|vlp32c|os1_128>               sensor geometry of the depth image (default hdl64e)\n"
+    "  --height-offset <m>                            height of the lidar above the ground (default 1.73)\n"
+    "  --max-distance <m>                             horizontal distance of the cropped far field (default 80)\n"
+    "  --incremental                                  reuses the ground model between consecutive frames\n"
+    "  --warm-up-frames <n>                           frames segmented before the run of every incremental worker\n"
+    "                                                 to rebuild its ground model (default 10)";
+
+// Contour of the Kitti recording vehicle w.r.t. the lidar frame, as in the node config
+constexpr std::array<lidar_processing_lib::filtering::QuadCorner,
+                     lidar_processing_lib::filtering::ConvexQuadCrop::NUMBER_OF_CORNERS>
+    VEHICLE_CORNERS{{{2.79F, 0.8F}, {2.79F, -0.8F}, {-1.62F, -0.8F}, {-1.62F, 0.8F}}};
+
+// Hypotheses are scored on the worker itself, the frames are the unit of parallelism
+constexpr float RANSAC_ORTHOGONAL_DISTANCE_THRESHOLD = 0.2F;
+constexpr std::uint32_t RANSAC_NUMBER_OF_ITERATIONS = 150U;
+constexpr std::uint32_t RANSAC_THREAD_COUNT = 1U;
+
+struct Options final
+{
+    std::string algorithm = "ransac";
+    std::string sensor = "hdl64e";
+    float height_offset = 1.73F;
+    float max_distance = 80.0F;
+    batch::BatchSegmentationConfiguration configuration;
+    std::filesystem::path sequence_path;
+    std::filesystem::path output_path;
+};
+
+Options parseOptions(int argc, char **argv)
+{
+    Options options;
+    int argument = 1;
+    const auto value = [&](const char *option) -> std::string {
+        if ((argument + 1) >= argc)
+        {
+            throw std::runtime_error(std::string{"Missing the value of "} + option);
+        }
+        return argv[++argument];
+    };
+
+    // Parsed as signed, std::stoul would wrap a negative count around to a huge one
+    const auto count = [&](const char *option) -> std::size_t {
+        const std::string text = value(option);
+        std::size_t parsed_length = 0U;
+        const long long parsed_count = std::stoll(text, &parsed_length);
+        if ((parsed_count < 0) || (parsed_length != text.size()))
+        {
+            throw std::runtime_error(std::string{"Invalid value of "} + option + ": " + text);
+        }
+        return static_cast<std::size_t>(parsed_count);
+    };
+
+    for (; (argument < argc) && (std::strncmp(argv[argument], "--", 2U) == 0); ++argument)
+    {
+        if (std::strcmp(argv[argument], "--algorithm") == 0)
+        {
+            options.algorithm = value("--algorithm");
+        }
+        else if (std::strcmp(argv[argument], "--workers") == 0)
+        {
+            options.configuration.number_of_workers = count("--workers");
+        }
+        else if (std::strcmp(argv[argument], "--pin-threads") == 0)
+        {
+            options.configuration.pin_threads = true;
+        }
+        else if (std::strcmp(argv[argument], "--sensor") == 0)
+        {
+            options.sensor = value("--sensor");
+        }
+        else if (std::strcmp(argv[argument], "--height-offset") == 0)
+        {
+            options.height_offset = std::stof(value("--height-offset"));
+        }
+        else if (std::strcmp(argv[argument], "--max-distance") == 0)
+        {
+            options.max_distance = std::stof(value("--max-distance"));
+        }
+        else if (std::strcmp(argv[argument], "--incremental") == 0)
+        {
+            options.configuration.incremental = true;
+        }
+        else if (std::strcmp(argv[argument], "--warm-up-frames") == 0)
+        {
+            options.configuration.warm_up_frames = count("--warm-up-frames");
+        }
+        else
+        {
+            throw std::runtime_error(std::string{"Unknown option "} + argv[argument]);
+        }
+    }
+
+    if ((argc - argument) != 2)
+    {
+        throw std::runtime_error("Expected <sequence folder> <output folder>");
+    }
+    options.sequence_path = argv[argument];
+    options.output_path = argv[argument + 1];
+    return options;
+}
+
+batch::BatchSegmenter::SegmenterFactory segmenterFactory(const Options &options)
+{
+    segmentation::TemporalGroundConfiguration temporal_configuration;
+    temporal_configuration.enabled = options.configuration.incremental;
+
+    if (options.algorithm == "ransac")
+    {
+        return [height_offset = options.height_offset, temporal_configuration]() {
+            return segmentation::ISegmenter::createUnique<segmentation::RansacSegmenter>(
+                height_offset, RANSAC_ORTHOGONAL_DISTANCE_THRESHOLD, RANSAC_NUMBER_OF_ITERATIONS, RANSAC_THREAD_COUNT,
+                segmentation::RansacAdaptiveConfiguration{}, 1U, temporal_configuration);
+        };
+    }
+
+    if (options.algorithm == "depth_image_segmentation")
+    {
+        // Every worker projects into its own depth image
+        const segmentation::SensorProfile sensor_profile = segmentation::sensorProfile(options.sensor);
+        return [sensor_profile, temporal_configuration]() {
+            return segmentation::ISegmenter::createUnique<segmentation::DepthImageSegmenter>(
+                std::make_shared<segmentation::DepthImage>(sensor_profile), temporal_configuration);
+        };
+    }
+
+    throw std::runtime_error("Unknown segmentation algorithm!");
+}
+} // namespace
+
+int main(int argc, char **argv)
+{
+    Options options;
+    try
+    {
+        options = parseOptions(argc, argv);
+    }
+    catch (const std::exception &ex)
+    {
+        std::cerr << ex.what() << "\n" << USAGE << std::endl;
+        return 1;
+    }
+
+    try
+    {
+        batch::BatchSegmenter batch_segmenter{
+            segmenterFactory(options), options.configuration,
+            std::make_shared<lidar_processing_lib::filtering::ConvexQuadCrop>(VEHICLE_CORNERS, options.max_distance)};
+
+        const batch::BatchSegmentationStatistics statistics =
+            batch_segmenter.run(options.sequence_path, options.output_path);
+
+        std::cout << std::fixed << std::setprecision(2) << "Segmented " << statistics.number_of_frames << " frames ("
+                  << (static_cast<double>(statistics.number_of_points) * 1e-6) << "M points) on "
+                  << statistics.number_of_workers << " workers in " << statistics.wall_time_s << " s\n"
+                  << "  " << statistics.frames_per_second << " frames/s, "
+                  << (statistics.points_per_second * 1e-6) << "M points/s" << std::endl;
+
+        // Realtime factor is only known from the timestamps of the recording
+        if (statistics.sequence_duration_s > 0.0)
+        {
+            std::cout << "  " << statistics.sequence_duration_s << " s of recording, " << statistics.realtime_factor
+                      << "x realtime (" << (statistics.realtime_factor / 60.0) << " h of data per minute)"
+                      << std::endl;
+        }
+    }
+    catch (const std::exception &ex)
+    {
+        std::cerr << "Exception: " << ex.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}